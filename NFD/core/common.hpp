@@ -44,6 +44,15 @@
 #define FINAL_UNLESS_WITH_TESTS final
 #endif
 
+/** \def NFD_PREFETCH(addr)
+ *  \brief hints the processor to bring the cache line at \p addr into cache
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define NFD_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define NFD_PREFETCH(addr) static_cast<void>(addr)
+#endif
+
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -92,6 +92,7 @@ struct FaceParams
   optional<ssize_t> mtu;
   bool wantLocalFields = false;
   bool wantLpReliability = false;
+  bool wantLpAggregation = false;
   boost::logic::tribool wantCongestionMarking = boost::logic::indeterminate;
 };
 
@@ -30,6 +30,18 @@
 #include "socket-utils.hpp"
 #include "daemon/global.hpp"
 
+#ifdef HAVE_IO_URING
+#include "io-uring.hpp"
+#endif
+
+#ifdef HAVE_UDP_GSO
+#include <netinet/in.h>  // for SOL_UDP
+#include <netinet/udp.h> // for UDP_SEGMENT and UDP_GRO
+#endif
+
+#include <sys/socket.h>  // for sendmsg(), recvmsg(), and SO_TIMESTAMPNS
+
+#include <algorithm>
 #include <array>
 
 namespace nfd {
@@ -39,6 +51,20 @@ struct Unicast {};
 struct Multicast {};
 
 /** \brief Implements Transport for datagram-based protocols.
+ *
+ *  If the io_uring backend is enabled, unicast transports are serviced by the global IoUring
+ *  instance instead of Boost.Asio. Multicast transports always use Boost.Asio, because they
+ *  need the sender address of every datagram, which multishot receive does not provide.
+ *
+ *  If segmentation offload is requested on a unicast UDP socket, packets sent during the same
+ *  event loop iteration are queued and runs of equal-size datagrams are handed to the kernel
+ *  in a single sendmsg() call with UDP_SEGMENT (GSO). On the receive side, UDP_GRO lets the
+ *  kernel coalesce consecutive datagrams from the peer, which are read with one recvmsg() call
+ *  and split into packets that share a single buffer.
+ *
+ *  On Linux, unless the io_uring backend is used, SO_TIMESTAMPNS is enabled on the socket and
+ *  datagrams are read with recvmsg(), so that every incoming packet carries the time at which
+ *  the kernel received it (Transport::Packet::rxTime).
  *
  *  \tparam Protocol a datagram-based protocol in Boost.Asio
  */
@@ -51,9 +77,11 @@ public:
   /** \brief Construct datagram transport.
    *
    *  \param socket Protocol-specific socket for the created transport
+   *  \param wantSegmentationOffload whether to use UDP GSO/GRO on a unicast UDP socket;
+   *                                 ignored if not supported by the platform or the socket
    */
   explicit
-  DatagramTransport(typename protocol::socket&& socket);
+  DatagramTransport(typename protocol::socket&& socket, bool wantSegmentationOffload = false);
 
   ssize_t
   getSendQueueLength() override;
@@ -62,7 +90,8 @@ public:
    */
   void
   receiveDatagram(const uint8_t* buffer, size_t nBytesReceived,
-                  const boost::system::error_code& error);
+                  const boost::system::error_code& error,
+                  time::steady_clock::TimePoint rxTime = {});
 
 protected:
   void
@@ -77,9 +106,51 @@ protected:
   void
   handleReceive(const boost::system::error_code& error, size_t nBytesReceived);
 
+  void
+  startReceive();
+
+#ifdef HAVE_IO_URING
+  void
+  handleUringReceive(int result, const uint8_t* data);
+#endif
+
+#ifdef __linux__
+  void
+  enableRxTimestamps();
+
+  /** \brief Read one datagram, or one GRO-coalesced run of datagrams, with recvmsg()
+   */
+  void
+  handleMessageReceive(const boost::system::error_code& error);
+#endif
+
+#ifdef HAVE_UDP_GSO
+  void
+  enableSegmentationOffload();
+
+  /** \brief Send queued packets, coalescing runs of equal-size datagrams with UDP_SEGMENT
+   */
+  void
+  flushSendQueue();
+
+  /** \brief Send m_sendQueue[first, last) in one sendmsg() call
+   *  \return the result of sendmsg()
+   */
+  ssize_t
+  sendSegments(size_t first, size_t last);
+
+  void
+  receiveSegment(const ndn::ConstBufferPtr& buffer, size_t offset, size_t length,
+                 time::steady_clock::TimePoint rxTime);
+#endif
+
   void
   processErrorCode(const boost::system::error_code& error);
 
+  void
+  deliverDatagram(bool isOk, Block&& element, size_t nBytesReceived,
+                  time::steady_clock::TimePoint rxTime);
+
   bool
   hasRecentlyReceived() const;
 
@@ -92,19 +163,48 @@ protected:
 protected:
   typename protocol::socket m_socket;
   typename protocol::endpoint m_sender;
+  TxQueueLengthCache m_txQueueLength;
 
   NFD_LOG_MEMBER_DECL();
 
 private:
   std::array<uint8_t, ndn::MAX_NDN_PACKET_SIZE> m_receiveBuffer;
   bool m_hasRecentlyReceived;
+#ifdef HAVE_IO_URING
+  IoUring* m_ioUring;
+#endif
+#ifdef __linux__
+  /// whether datagrams are read with recvmsg(), for receive timestamps or GRO
+  bool m_useRecvmsg = false;
+#endif
+#ifdef HAVE_UDP_GSO
+  /// UDP_MAX_SEGMENTS of the oldest kernels that support UDP_SEGMENT
+  static constexpr size_t MAX_GSO_SEGMENTS = 64;
+  /// total payload per sendmsg(), leaving room for IP and UDP headers within 64 KiB
+  static constexpr size_t MAX_GSO_BYTES = 65000;
+
+  /// maximum number of segments passed in one sendmsg() call, zero if GSO is disabled
+  size_t m_maxGsoSegments = 0;
+  /// largest segment size the kernel has accepted for offload
+  size_t m_maxGsoSegmentSize = std::numeric_limits<uint16_t>::max();
+  std::vector<Block> m_sendQueue;
+  /// total size of packets in m_sendQueue
+  size_t m_sendQueueBytes = 0;
+  bool m_isFlushScheduled = false;
+  /// receive buffer large enough for a coalesced datagram, empty if GRO is disabled
+  std::vector<uint8_t> m_groBuffer;
+#endif
 };
 
 
 template<class T, class U>
-DatagramTransport<T, U>::DatagramTransport(typename DatagramTransport::protocol::socket&& socket)
+DatagramTransport<T, U>::DatagramTransport(typename DatagramTransport::protocol::socket&& socket,
+                                           bool wantSegmentationOffload)
   : m_socket(std::move(socket))
   , m_hasRecentlyReceived(false)
+#ifdef HAVE_IO_URING
+  , m_ioUring(std::is_same<U, Unicast>::value ? getGlobalIoUring() : nullptr)
+#endif
 {
   boost::asio::socket_base::send_buffer_size sendBufferSizeOption;
   boost::system::error_code error;
@@ -117,20 +217,43 @@ DatagramTransport<T, U>::DatagramTransport(typename DatagramTransport::protocol:
     this->setSendQueueCapacity(sendBufferSizeOption.value());
   }
 
-  m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_sender,
-                              [this] (auto&&... args) {
-                                this->handleReceive(std::forward<decltype(args)>(args)...);
-                              });
+#ifdef HAVE_IO_URING
+  if (m_ioUring != nullptr) {
+    // unicast sockets are connected, so every datagram comes from the remote endpoint
+    m_sender = m_socket.remote_endpoint(error);
+  }
+#endif
+
+#ifdef HAVE_UDP_GSO
+  if (wantSegmentationOffload && std::is_same<U, Unicast>::value) {
+    enableSegmentationOffload();
+  }
+#endif
+
+#ifdef __linux__
+  enableRxTimestamps();
+#endif
+
+  startReceive();
 }
 
 template<class T, class U>
 ssize_t
 DatagramTransport<T, U>::getSendQueueLength()
 {
-  ssize_t queueLength = getTxQueueLength(m_socket.native_handle());
-  if (queueLength == QUEUE_ERROR) {
-    NFD_LOG_FACE_WARN("Failed to obtain send queue length from socket: " << std::strerror(errno));
+  ssize_t queueLength = m_txQueueLength.get([this] {
+    ssize_t queueLength = getTxQueueLength(m_socket.native_handle());
+    if (queueLength == QUEUE_ERROR) {
+      NFD_LOG_FACE_WARN("Failed to obtain send queue length from socket: " << std::strerror(errno));
+    }
+    return queueLength;
+  });
+#ifdef HAVE_UDP_GSO
+  // packets waiting to be passed to the kernel in one sendmsg() call
+  if (m_sendQueueBytes > 0) {
+    return m_sendQueueBytes + std::max<ssize_t>(0, queueLength);
   }
+#endif
   return queueLength;
 }
 
@@ -147,6 +270,11 @@ DatagramTransport<T, U>::doClose()
     m_socket.cancel(error);
     m_socket.close(error);
   }
+#ifdef HAVE_IO_URING
+  if (m_ioUring != nullptr) {
+    m_ioUring->cancel(this);
+  }
+#endif
 
   // Ensure that the Transport stays alive at least until
   // all pending handlers are dispatched
@@ -161,6 +289,30 @@ DatagramTransport<T, U>::doSend(Transport::Packet&& packet)
 {
   NFD_LOG_FACE_TRACE(__func__);
 
+#ifdef HAVE_IO_URING
+  if (m_ioUring != nullptr) {
+    m_ioUring->send(this, m_socket.native_handle(), packet.packet, 0, [this] (int result, const uint8_t*) {
+      if (result < 0)
+        this->handleSend(boost::system::error_code(-result, boost::system::system_category()), 0);
+      else
+        this->handleSend({}, result);
+    });
+    return;
+  }
+#endif
+
+#ifdef HAVE_UDP_GSO
+  if (m_maxGsoSegments > 0) {
+    m_sendQueueBytes += packet.packet.size();
+    m_sendQueue.push_back(std::move(packet.packet));
+    if (!m_isFlushScheduled) {
+      m_isFlushScheduled = true;
+      getGlobalIoService().post([this] { this->flushSendQueue(); });
+    }
+    return;
+  }
+#endif
+
   m_socket.async_send(boost::asio::buffer(packet.packet),
                       // packet.packet is copied into the lambda to retain the underlying Buffer
                       [this, p = packet.packet] (auto&&... args) {
@@ -171,7 +323,8 @@ DatagramTransport<T, U>::doSend(Transport::Packet&& packet)
 template<class T, class U>
 void
 DatagramTransport<T, U>::receiveDatagram(const uint8_t* buffer, size_t nBytesReceived,
-                                         const boost::system::error_code& error)
+                                         const boost::system::error_code& error,
+                                         time::steady_clock::TimePoint rxTime)
 {
   if (error)
     return processErrorCode(error);
@@ -181,6 +334,14 @@ DatagramTransport<T, U>::receiveDatagram(const uint8_t* buffer, size_t nBytesRec
   bool isOk = false;
   Block element;
   std::tie(isOk, element) = Block::fromBuffer(buffer, nBytesReceived);
+  deliverDatagram(isOk, std::move(element), nBytesReceived, rxTime);
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::deliverDatagram(bool isOk, Block&& element, size_t nBytesReceived,
+                                         time::steady_clock::TimePoint rxTime)
+{
   if (!isOk) {
     NFD_LOG_FACE_WARN("Failed to parse incoming packet from " << m_sender);
     // This packet won't extend the face lifetime
@@ -195,6 +356,7 @@ DatagramTransport<T, U>::receiveDatagram(const uint8_t* buffer, size_t nBytesRec
 
   Transport::Packet tp(std::move(element));
   tp.remoteEndpoint = makeEndpointId(m_sender);
+  tp.rxTime = rxTime;
   this->receive(std::move(tp));
 }
 
@@ -205,11 +367,322 @@ DatagramTransport<T, U>::handleReceive(const boost::system::error_code& error, s
   receiveDatagram(m_receiveBuffer.data(), nBytesReceived, error);
 
   if (m_socket.is_open())
-    m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_sender,
-                                [this] (auto&&... args) {
-                                  this->handleReceive(std::forward<decltype(args)>(args)...);
-                                });
+    startReceive();
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::startReceive()
+{
+#ifdef HAVE_IO_URING
+  if (m_ioUring != nullptr) {
+    m_ioUring->receive(this, m_socket.native_handle(),
+                       [this] (int result, const uint8_t* data) { this->handleUringReceive(result, data); });
+    return;
+  }
+#endif
+
+#ifdef __linux__
+  if (m_useRecvmsg) {
+    // wait for readability only, the receive timestamp and the GRO segment size
+    // are obtained from recvmsg() ancillary data
+    m_socket.async_receive(boost::asio::null_buffers(),
+                           [this] (const auto& error, size_t) { this->handleMessageReceive(error); });
+    return;
+  }
+#endif
+
+  m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_sender,
+                              [this] (auto&&... args) {
+                                this->handleReceive(std::forward<decltype(args)>(args)...);
+                              });
+}
+
+#ifdef HAVE_IO_URING
+template<class T, class U>
+void
+DatagramTransport<T, U>::handleUringReceive(int result, const uint8_t* data)
+{
+  if (result < 0) {
+    receiveDatagram(nullptr, 0, boost::system::error_code(-result, boost::system::system_category()));
+
+    // the multishot receive has terminated, resubmit it if the error was ignored
+    if (m_socket.is_open() && getState() == TransportState::UP)
+      startReceive();
+    return;
+  }
+
+  receiveDatagram(data, result, {});
+}
+#endif
+
+#ifdef __linux__
+template<class T, class U>
+void
+DatagramTransport<T, U>::enableRxTimestamps()
+{
+#ifdef HAVE_IO_URING
+  if (m_ioUring != nullptr) {
+    // multishot receive does not return ancillary data
+    return;
+  }
+#endif
+
+  // recvmsg() is invoked directly on the socket
+  boost::system::error_code error;
+  m_socket.non_blocking(true, error);
+  if (error) {
+    NFD_LOG_FACE_WARN("Failed to make socket non-blocking: " << error.message());
+    return;
+  }
+
+  int value = 1;
+  if (::setsockopt(m_socket.native_handle(), SOL_SOCKET, SO_TIMESTAMPNS, &value, sizeof(value)) < 0) {
+    NFD_LOG_FACE_WARN("Failed to enable receive timestamps: " << std::strerror(errno));
+    return;
+  }
+  m_useRecvmsg = true;
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::handleMessageReceive(const boost::system::error_code& error)
+{
+  if (error) {
+    receiveDatagram(nullptr, 0, error);
+    if (m_socket.is_open())
+      startReceive();
+    return;
+  }
+
+  uint8_t* buffer = m_receiveBuffer.data();
+  size_t bufferSize = m_receiveBuffer.size();
+#ifdef HAVE_UDP_GSO
+  if (!m_groBuffer.empty()) {
+    buffer = m_groBuffer.data();
+    bufferSize = m_groBuffer.size();
+  }
+#endif
+
+  iovec iov;
+  iov.iov_base = buffer;
+  iov.iov_len = bufferSize;
+  alignas(cmsghdr) uint8_t control[CMSG_SPACE(sizeof(int)) + CMSG_SPACE(sizeof(timespec))];
+
+  msghdr msg{};
+  msg.msg_name = m_sender.data();
+  msg.msg_namelen = static_cast<socklen_t>(m_sender.capacity());
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  ssize_t result = ::recvmsg(m_socket.native_handle(), &msg, 0);
+  if (result < 0) {
+    if (errno != EAGAIN && errno != EWOULDBLOCK)
+      receiveDatagram(nullptr, 0, boost::system::error_code(errno, boost::system::system_category()));
+  }
+  else {
+    m_sender.resize(msg.msg_namelen);
+
+    auto nBytesReceived = static_cast<size_t>(result);
+#ifdef HAVE_UDP_GSO
+    size_t segmentSize = nBytesReceived;
+#endif
+    time::steady_clock::TimePoint rxTime;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+        timespec ts;
+        std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+        rxTime = convertRxTimestamp(ts.tv_sec, ts.tv_nsec);
+      }
+#ifdef HAVE_UDP_GSO
+      else if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+        int groSize = 0;
+        std::memcpy(&groSize, CMSG_DATA(cmsg), sizeof(groSize));
+        if (groSize > 0)
+          segmentSize = static_cast<size_t>(groSize);
+      }
+#endif
+    }
+
+#ifdef HAVE_UDP_GSO
+    if (segmentSize < nBytesReceived) {
+      // the segments share one buffer, so that each of them is parsed without another copy
+      auto sharedBuffer = make_shared<const ndn::Buffer>(buffer, nBytesReceived);
+      for (size_t offset = 0; offset < nBytesReceived && m_socket.is_open(); offset += segmentSize) {
+        receiveSegment(sharedBuffer, offset, std::min(segmentSize, nBytesReceived - offset), rxTime);
+      }
+    }
+    else
+#endif
+    {
+      receiveDatagram(buffer, nBytesReceived, {}, rxTime);
+    }
+  }
+
+  if (m_socket.is_open())
+    startReceive();
+}
+#endif
+
+#ifdef HAVE_UDP_GSO
+template<class T, class U>
+void
+DatagramTransport<T, U>::enableSegmentationOffload()
+{
+#ifdef HAVE_IO_URING
+  if (m_ioUring != nullptr) {
+    NFD_LOG_FACE_DEBUG("Segmentation offload is not used with the io_uring backend");
+    return;
+  }
+#endif
+
+  // sendmsg() and recvmsg() are invoked directly on the connected socket
+  boost::system::error_code error;
+  m_sender = m_socket.remote_endpoint(error);
+  m_socket.non_blocking(true, error);
+  if (error) {
+    NFD_LOG_FACE_WARN("Failed to make socket non-blocking: " << error.message());
+    return;
+  }
+
+  // the segment size is passed with every sendmsg(), a zero default is accepted by any kernel
+  // that supports UDP_SEGMENT
+  int value = 0;
+  if (::setsockopt(m_socket.native_handle(), SOL_UDP, UDP_SEGMENT, &value, sizeof(value)) < 0) {
+    NFD_LOG_FACE_WARN("Failed to enable UDP GSO: " << std::strerror(errno));
+  }
+  else {
+    m_maxGsoSegments = MAX_GSO_SEGMENTS;
+  }
+
+  value = 1;
+  if (::setsockopt(m_socket.native_handle(), SOL_UDP, UDP_GRO, &value, sizeof(value)) < 0) {
+    NFD_LOG_FACE_WARN("Failed to enable UDP GRO: " << std::strerror(errno));
+  }
+  else {
+    m_groBuffer.resize(std::numeric_limits<uint16_t>::max());
+    m_useRecvmsg = true;
+  }
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::flushSendQueue()
+{
+  m_isFlushScheduled = false;
+
+  size_t first = 0;
+  while (first < m_sendQueue.size() && m_socket.is_open()) {
+    // every segment but the last must have the same size, and the last one cannot be larger
+    size_t segmentSize = m_sendQueue[first].size();
+    size_t totalSize = segmentSize;
+    size_t last = first + 1;
+    if (segmentSize <= m_maxGsoSegmentSize) {
+      while (last < m_sendQueue.size() && last - first < m_maxGsoSegments &&
+             m_sendQueue[last - 1].size() == segmentSize &&
+             m_sendQueue[last].size() <= segmentSize &&
+             totalSize + m_sendQueue[last].size() <= MAX_GSO_BYTES) {
+        totalSize += m_sendQueue[last].size();
+        ++last;
+      }
+    }
+
+    ssize_t result = sendSegments(first, last);
+    int errnum = errno;
+    if (result < 0 && last - first > 1 && (errnum == EINVAL || errnum == EIO)) {
+      if (errnum == EINVAL) {
+        // segments larger than the path MTU cannot be offloaded, as they would need IP fragmentation
+        NFD_LOG_FACE_DEBUG("Not using UDP GSO for segments of " << segmentSize << " bytes");
+        m_maxGsoSegmentSize = segmentSize - 1;
+      }
+      else {
+        // the egress device cannot offload checksums
+        NFD_LOG_FACE_WARN("Disabling UDP GSO: " << std::strerror(errnum));
+        m_maxGsoSegments = 1;
+      }
+      last = first + 1;
+      result = sendSegments(first, last);
+      errnum = errno;
+    }
+
+    if (result < 0 && (errnum == EAGAIN || errnum == EWOULDBLOCK)) {
+      // the socket send buffer is full, resume when the socket becomes writable
+      for (size_t i = 0; i < first; ++i) {
+        m_sendQueueBytes -= m_sendQueue[i].size();
+      }
+      m_sendQueue.erase(m_sendQueue.begin(), m_sendQueue.begin() + first);
+      m_isFlushScheduled = true;
+      m_socket.async_send(boost::asio::null_buffers(), [this] (const auto& error, size_t) {
+        if (error) {
+          m_isFlushScheduled = false;
+          m_sendQueue.clear();
+          m_sendQueueBytes = 0;
+          return this->processErrorCode(error);
+        }
+        this->flushSendQueue();
+      });
+      return;
+    }
+
+    if (result < 0)
+      handleSend(boost::system::error_code(errnum, boost::system::system_category()), 0);
+    else
+      handleSend({}, static_cast<size_t>(result));
+    first = last;
+  }
+
+  m_sendQueue.clear();
+  m_sendQueueBytes = 0;
+}
+
+template<class T, class U>
+ssize_t
+DatagramTransport<T, U>::sendSegments(size_t first, size_t last)
+{
+  BOOST_ASSERT(first < last && last - first <= MAX_GSO_SEGMENTS);
+
+  std::array<iovec, MAX_GSO_SEGMENTS> iov;
+  size_t nSegments = last - first;
+  for (size_t i = 0; i < nSegments; ++i) {
+    const Block& block = m_sendQueue[first + i];
+    iov[i].iov_base = const_cast<uint8_t*>(block.wire());
+    iov[i].iov_len = block.size();
+  }
+
+  msghdr msg{};
+  msg.msg_iov = iov.data();
+  msg.msg_iovlen = nSegments;
+
+  alignas(cmsghdr) uint8_t control[CMSG_SPACE(sizeof(uint16_t))] = {};
+  if (nSegments > 1) {
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    auto segmentSize = static_cast<uint16_t>(iov[0].iov_len);
+    std::memcpy(CMSG_DATA(cmsg), &segmentSize, sizeof(segmentSize));
+  }
+
+  return ::sendmsg(m_socket.native_handle(), &msg, 0);
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::receiveSegment(const ndn::ConstBufferPtr& buffer, size_t offset, size_t length,
+                                        time::steady_clock::TimePoint rxTime)
+{
+  NFD_LOG_FACE_TRACE("Received: " << length << " bytes from " << m_sender);
+
+  bool isOk = false;
+  Block element;
+  std::tie(isOk, element) = Block::fromBuffer(buffer, offset);
+  deliverDatagram(isOk, std::move(element), length, rxTime);
 }
+#endif
 
 template<class T, class U>
 void
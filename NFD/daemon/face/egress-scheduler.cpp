@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "egress-scheduler.hpp"
+#include "link-service.hpp"
+#include "daemon/global.hpp"
+
+#include <cmath>
+
+namespace nfd {
+namespace face {
+
+NFD_LOG_INIT(EgressScheduler);
+
+constexpr size_t EgressScheduler::N_TRAFFIC_CLASSES;
+
+EgressScheduler::EgressScheduler(const Options& options, const LinkService* linkService)
+  : m_options(options)
+  , m_linkService(linkService)
+  , m_tokens(options.burstSize)
+  , m_lastRefill(time::steady_clock::now())
+{
+}
+
+void
+EgressScheduler::setOptions(const Options& options)
+{
+  // account for the time elapsed so far at the old rate
+  this->refillTokens();
+
+  m_options = options;
+  m_tokens = std::min(m_tokens, static_cast<double>(m_options.burstSize));
+
+  m_dequeueTimer.cancel();
+  m_isWaitingForTokens = false;
+  this->dequeue();
+}
+
+void
+EgressScheduler::enqueue(Block&& frame, TrafficClass tc)
+{
+  if (m_options.rateLimit == 0) {
+    BOOST_ASSERT(m_nFrames == 0);
+    this->afterDequeue(frame);
+    return;
+  }
+
+  ClassQueue& queue = this->getQueue(tc);
+  if (queue.nBytes + frame.size() > m_options.queueLimit) {
+    NFD_LOG_FACE_DEBUG("dropping " << tc << " frame: queue limit exceeded");
+    this->onQueueOverflow(tc);
+    return;
+  }
+
+  queue.nBytes += frame.size();
+  m_nBytes += frame.size();
+  ++m_nFrames;
+  queue.frames.push_back(std::move(frame));
+
+  if (!m_isWaitingForTokens) {
+    this->dequeue();
+  }
+}
+
+void
+EgressScheduler::refillTokens()
+{
+  auto now = time::steady_clock::now();
+  if (m_options.rateLimit == 0) {
+    m_tokens = m_options.burstSize;
+  }
+  else {
+    double elapsed = time::duration_cast<time::duration<double>>(now - m_lastRefill).count();
+    m_tokens = std::min(m_tokens + elapsed * m_options.rateLimit, static_cast<double>(m_options.burstSize));
+  }
+  m_lastRefill = now;
+}
+
+void
+EgressScheduler::dequeue()
+{
+  m_isWaitingForTokens = false;
+  this->refillTokens();
+
+  while (m_nFrames > 0) {
+    if (m_options.rateLimit != 0 && m_tokens <= 0) {
+      // wait until the token bucket is positive again
+      auto wait = time::nanoseconds(static_cast<time::nanoseconds::rep>(-m_tokens * 1e9 / m_options.rateLimit) + 1);
+      NFD_LOG_FACE_TRACE("waiting " << wait << " for tokens, queued=" << m_nFrames);
+      m_isWaitingForTokens = true;
+      m_dequeueTimer = getScheduler().schedule(wait, [this] { this->dequeue(); });
+      return;
+    }
+
+    this->release(this->selectClass());
+  }
+}
+
+EgressScheduler::TrafficClass
+EgressScheduler::selectClass()
+{
+  BOOST_ASSERT(m_nFrames > 0);
+
+  if (!this->getQueue(TrafficClass::CONTROL).frames.empty()) {
+    return TrafficClass::CONTROL;
+  }
+
+  // deficit round robin between Interest and Data; terminates because at least one of them
+  // is non-empty and its deficit grows by a quantum on every turn
+  while (true) {
+    ClassQueue& queue = this->getQueue(m_drrTurn);
+    if (!queue.frames.empty()) {
+      if (!m_hasDrrQuantum) {
+        queue.deficit += m_drrTurn == TrafficClass::INTEREST ? m_options.interestQuantum :
+                                                               m_options.dataQuantum;
+        m_hasDrrQuantum = true;
+      }
+      if (queue.frames.front().size() <= queue.deficit) {
+        return m_drrTurn;
+      }
+    }
+
+    m_drrTurn = m_drrTurn == TrafficClass::INTEREST ? TrafficClass::DATA : TrafficClass::INTEREST;
+    m_hasDrrQuantum = false;
+  }
+}
+
+void
+EgressScheduler::release(TrafficClass tc)
+{
+  ClassQueue& queue = this->getQueue(tc);
+  BOOST_ASSERT(!queue.frames.empty());
+
+  Block frame = std::move(queue.frames.front());
+  queue.frames.pop_front();
+  queue.nBytes -= frame.size();
+  m_nBytes -= frame.size();
+  --m_nFrames;
+
+  if (tc != TrafficClass::CONTROL) {
+    BOOST_ASSERT(frame.size() <= queue.deficit);
+    // a class that empties its queue does not keep its deficit for the next round
+    queue.deficit = queue.frames.empty() ? 0 : queue.deficit - frame.size();
+  }
+  if (m_options.rateLimit != 0) {
+    m_tokens -= frame.size();
+  }
+
+  this->afterDequeue(frame);
+}
+
+std::ostream&
+operator<<(std::ostream& os, EgressScheduler::TrafficClass tc)
+{
+  switch (tc) {
+    case EgressScheduler::TrafficClass::CONTROL:
+      return os << "control";
+    case EgressScheduler::TrafficClass::INTEREST:
+      return os << "Interest";
+    case EgressScheduler::TrafficClass::DATA:
+      return os << "Data";
+  }
+  return os << static_cast<int>(tc);
+}
+
+std::ostream&
+operator<<(std::ostream& os, const FaceLogHelper<EgressScheduler>& flh)
+{
+  if (flh.obj.getLinkService() == nullptr) {
+    os << "[id=0,local=unknown,remote=unknown] ";
+  }
+  else {
+    os << FaceLogHelper<LinkService>(*flh.obj.getLinkService());
+  }
+  return os;
+}
+
+} // namespace face
+} // namespace nfd
@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_EGRESS_SCHEDULER_HPP
+#define NFD_DAEMON_FACE_EGRESS_SCHEDULER_HPP
+
+#include "core/common.hpp"
+#include "face-log.hpp"
+
+#include <array>
+#include <deque>
+
+namespace nfd {
+namespace face {
+
+class LinkService;
+
+/** \brief paces and orders outgoing link-layer frames of a face
+ *
+ *  Frames are classified into three traffic classes. When a rate limit is set, frames are
+ *  released at that rate by a token bucket, and frames waiting for tokens are queued per class.
+ *  The control class is served first; the Interest and Data classes share the remaining rate
+ *  by deficit round robin, so that an Interest waits behind at most one quantum of Data.
+ *  Without a rate limit, frames are released immediately and the scheduler holds no state.
+ */
+class EgressScheduler : noncopyable
+{
+public:
+  enum class TrafficClass {
+    CONTROL,  ///< Nacks and frames without network-layer packets, e.g., IDLE packets
+    INTEREST,
+    DATA,
+  };
+
+  static constexpr size_t N_TRAFFIC_CLASSES = 3;
+
+  /** \brief Options that control the behavior of EgressScheduler
+   */
+  struct Options
+  {
+    /** \brief egress rate limit in octets per second
+     *
+     *  Zero means the rate is unlimited, and disables queueing.
+     */
+    uint64_t rateLimit = 0;
+
+    /** \brief token bucket depth in octets
+     *
+     *  This is the largest burst sent back to back after the face has been idle. Must be positive.
+     */
+    size_t burstSize = 16384;
+
+    /** \brief octets served per deficit round robin round from the Interest class
+     */
+    size_t interestQuantum = 8800;
+
+    /** \brief octets served per deficit round robin round from the Data class
+     */
+    size_t dataQuantum = 8800;
+
+    /** \brief maximum octets queued in each traffic class
+     *
+     *  A frame that would exceed this limit is dropped.
+     */
+    size_t queueLimit = 262144;
+  };
+
+  explicit
+  EgressScheduler(const Options& options, const LinkService* linkService = nullptr);
+
+  /** \brief set options for the scheduler
+   *
+   *  If the rate limit is removed, all queued frames are released immediately.
+   */
+  void
+  setOptions(const Options& options);
+
+  /** \return LinkService that owns this instance
+   *
+   *  This is only used for logging, and may be nullptr.
+   */
+  const LinkService*
+  getLinkService() const;
+
+  /** \brief submit a frame for transmission
+   *
+   *  The frame is released through afterDequeue, either immediately or when the token bucket
+   *  allows it, unless it is dropped because its traffic class exceeds Options::queueLimit.
+   */
+  void
+  enqueue(Block&& frame, TrafficClass tc);
+
+  /** \brief count of queued frames
+   */
+  size_t
+  size() const;
+
+  /** \brief total size of queued frames, in octets
+   */
+  size_t
+  getQueuedBytes() const;
+
+  /** \brief signals when a frame is released for transmission
+   */
+  signal::Signal<EgressScheduler, Block> afterDequeue;
+
+  /** \brief signals when a frame is dropped because its traffic class is full
+   */
+  signal::Signal<EgressScheduler, TrafficClass> onQueueOverflow;
+
+private:
+  struct ClassQueue
+  {
+    std::deque<Block> frames;
+    size_t nBytes = 0;
+    size_t deficit = 0; ///< deficit counter, used by the Interest and Data classes
+  };
+
+  /** \brief add tokens accumulated since the last refill
+   */
+  void
+  refillTokens();
+
+  /** \brief release queued frames while tokens are available
+   */
+  void
+  dequeue();
+
+  /** \brief pick the traffic class of the next frame to release
+   *  \pre at least one frame is queued
+   */
+  TrafficClass
+  selectClass();
+
+  void
+  release(TrafficClass tc);
+
+  ClassQueue&
+  getQueue(TrafficClass tc)
+  {
+    return m_queues[static_cast<size_t>(tc)];
+  }
+
+private:
+  Options m_options;
+  const LinkService* m_linkService;
+  std::array<ClassQueue, N_TRAFFIC_CLASSES> m_queues;
+  size_t m_nFrames = 0;
+  size_t m_nBytes = 0;
+
+  /// available tokens in octets; negative after a frame larger than the available tokens is sent
+  double m_tokens;
+  time::steady_clock::TimePoint m_lastRefill;
+
+  /// class whose turn it is in deficit round robin, either INTEREST or DATA
+  TrafficClass m_drrTurn = TrafficClass::INTEREST;
+  /// whether the class whose turn it is has received its quantum for this round
+  bool m_hasDrrQuantum = false;
+
+  scheduler::ScopedEventId m_dequeueTimer;
+  bool m_isWaitingForTokens = false;
+};
+
+std::ostream&
+operator<<(std::ostream& os, EgressScheduler::TrafficClass tc);
+
+std::ostream&
+operator<<(std::ostream& os, const FaceLogHelper<EgressScheduler>& flh);
+
+inline const LinkService*
+EgressScheduler::getLinkService() const
+{
+  return m_linkService;
+}
+
+inline size_t
+EgressScheduler::size() const
+{
+  return m_nFrames;
+}
+
+inline size_t
+EgressScheduler::getQueuedBytes() const
+{
+  return m_nBytes;
+}
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_EGRESS_SCHEDULER_HPP
@@ -27,6 +27,10 @@
 #include "generic-link-service.hpp"
 #include "multicast-ethernet-transport.hpp"
 
+#ifdef HAVE_AF_XDP
+#include "xdp-helper.hpp"
+#endif
+
 #include <boost/range/adaptors.hpp>
 #include <boost/range/algorithm/copy.hpp>
 
@@ -63,6 +67,8 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
   //   mcast yes
   //   mcast_group 01:00:5E:00:17:AA
   //   mcast_ad_hoc no
+  //   packet_ring no
+  //   mcast_xdp no
   //   whitelist
   //   {
   //     *
@@ -74,6 +80,8 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
 
   UnicastConfig unicastConfig;
   MulticastConfig mcastConfig;
+  bool wantPacketRing = false;
+  bool wantXdp = false;
 
   if (configSection) {
     // listen and mcast default to 'yes' but only if face_system.ether section is present
@@ -108,6 +116,28 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
         bool wantAdHoc = ConfigFile::parseYesNo(pair, "face_system.ether");
         mcastConfig.linkType = wantAdHoc ? ndn::nfd::LINK_TYPE_AD_HOC : ndn::nfd::LINK_TYPE_MULTI_ACCESS;
       }
+      else if (key == "mcast_aggregation") {
+        mcastConfig.wantAggregation = ConfigFile::parseYesNo(pair, "face_system.ether");
+      }
+      else if (key == "packet_ring") {
+        wantPacketRing = ConfigFile::parseYesNo(pair, "face_system.ether");
+#ifndef __linux__
+        if (wantPacketRing) {
+          NDN_THROW(ConfigFile::Error("face_system.ether.packet_ring is only supported on Linux"));
+        }
+#endif
+      }
+      else if (key == "mcast_xdp") {
+        wantXdp = ConfigFile::parseYesNo(pair, "face_system.ether");
+#ifndef HAVE_AF_XDP
+        if (wantXdp) {
+          NDN_THROW(ConfigFile::Error("face_system.ether.mcast_xdp is not supported on this platform"));
+        }
+#endif
+      }
+      else if (key == "mcast_xdp_multiqueue") {
+        mcastConfig.wantXdpMultiQueue = ConfigFile::parseYesNo(pair, "face_system.ether");
+      }
       else if (key == "whitelist") {
         mcastConfig.netifPredicate.parseWhitelist(value);
       }
@@ -120,6 +150,10 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
     }
   }
 
+  unicastConfig.backend = wantPacketRing ? EthernetTransport::Backend::PACKET_RING :
+                                           EthernetTransport::Backend::PCAP;
+  mcastConfig.backend = wantXdp ? EthernetTransport::Backend::XDP : unicastConfig.backend;
+
   if (context.isDryRun) {
     return;
   }
@@ -131,6 +165,9 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
     if (m_unicastConfig.idleTimeout != unicastConfig.idleTimeout && !m_channels.empty()) {
       NFD_LOG_WARN("Idle timeout setting applies to new Ethernet channels only");
     }
+    if (m_unicastConfig.backend != unicastConfig.backend && !m_channels.empty()) {
+      NFD_LOG_WARN("Packet ring setting applies to new Ethernet channels only");
+    }
   }
   else if (m_unicastConfig.isEnabled && !m_channels.empty()) {
     NFD_LOG_WARN("Cannot disable Ethernet channels after initialization");
@@ -148,6 +185,15 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
     if (m_mcastConfig.linkType != mcastConfig.linkType && !m_mcastFaces.empty()) {
       NFD_LOG_WARN("Cannot change ad hoc setting on existing faces");
     }
+    if (m_mcastConfig.wantAggregation != mcastConfig.wantAggregation && !m_mcastFaces.empty()) {
+      NFD_LOG_WARN("Cannot change aggregation setting on existing faces");
+    }
+    if (m_mcastConfig.backend != mcastConfig.backend && !m_mcastFaces.empty()) {
+      NFD_LOG_WARN("Cannot change packet ring or XDP setting on existing faces");
+    }
+    if (m_mcastConfig.wantXdpMultiQueue != mcastConfig.wantXdpMultiQueue && !m_mcastFaces.empty()) {
+      NFD_LOG_WARN("Cannot change XDP multi-queue setting on existing faces");
+    }
     if (m_mcastConfig.group != mcastConfig.group) {
       NFD_LOG_INFO("changing multicast group from " << m_mcastConfig.group <<
                    " to " << mcastConfig.group);
@@ -223,7 +269,7 @@ EthernetFactory::createChannel(const shared_ptr<const ndn::net::NetworkInterface
   if (it != m_channels.end())
     return it->second;
 
-  auto channel = std::make_shared<EthernetChannel>(localEndpoint, idleTimeout);
+  auto channel = std::make_shared<EthernetChannel>(localEndpoint, idleTimeout, m_unicastConfig.backend);
   m_channels[localEndpoint->getName()] = channel;
   return channel;
 }
@@ -249,9 +295,32 @@ EthernetFactory::createMulticastFace(const ndn::net::NetworkInterface& netif,
   GenericLinkService::Options opts;
   opts.allowFragmentation = true;
   opts.allowReassembly = true;
+  opts.allowAggregation = m_mcastConfig.wantAggregation;
+
+  auto backend = m_mcastConfig.backend;
+#ifdef HAVE_AF_XDP
+  if (backend == EthernetTransport::Backend::XDP && !m_mcastConfig.wantXdpMultiQueue) {
+    // the XDP program only redirects frames received on queue 0, so NDN frames arriving on
+    // other queues would be lost unless the operator steers them to queue 0
+    try {
+      uint32_t nQueues = XdpHelper::getRxQueueCount(netif.getName());
+      if (nQueues > 1) {
+        NFD_LOG_WARN(netif.getName() << " has " << nQueues << " receive queues, not using AF_XDP;"
+                     " set mcast_xdp_multiqueue after steering NDN frames to queue 0");
+        backend = m_unicastConfig.backend;
+      }
+    }
+    catch (const XdpHelper::Error& e) {
+      NFD_LOG_WARN("Cannot get receive queue count of " << netif.getName() << ", not using AF_XDP: "
+                   << e.what());
+      backend = m_unicastConfig.backend;
+    }
+  }
+#endif
 
   auto linkService = make_unique<GenericLinkService>(opts);
-  auto transport = make_unique<MulticastEthernetTransport>(netif, address, m_mcastConfig.linkType);
+  auto transport = make_unique<MulticastEthernetTransport>(netif, address, m_mcastConfig.linkType,
+                                                           backend);
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
 
   m_mcastFaces[key] = face;
@@ -110,6 +110,7 @@ private:
     bool isEnabled = false;
     bool wantListen = false;
     time::nanoseconds idleTimeout = 10_min;
+    EthernetTransport::Backend backend = EthernetTransport::Backend::PCAP;
   };
   UnicastConfig m_unicastConfig;
 
@@ -119,6 +120,9 @@ private:
     ethernet::Address group = ethernet::getDefaultMulticastAddress();
     ndn::nfd::LinkType linkType = ndn::nfd::LINK_TYPE_MULTI_ACCESS;
     NetworkInterfacePredicate netifPredicate;
+    bool wantAggregation = false;
+    EthernetTransport::Backend backend = EthernetTransport::Backend::PCAP;
+    bool wantXdpMultiQueue = false;
   };
   MulticastConfig m_mcastConfig;
 
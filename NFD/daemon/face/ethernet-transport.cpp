@@ -29,7 +29,8 @@
 
 #include <pcap/pcap.h>
 
-#include <cstring> // for memcpy()
+#include <cerrno>
+#include <cstring> // for memcpy(), strerror()
 
 #include <boost/endian/conversion.hpp>
 
@@ -39,9 +40,9 @@ namespace face {
 NFD_LOG_INIT(EthernetTransport);
 
 EthernetTransport::EthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
-                                     const ethernet::Address& remoteEndpoint)
+                                     const ethernet::Address& remoteEndpoint,
+                                     Backend backend)
   : m_socket(getGlobalIoService())
-  , m_pcap(localEndpoint.getName())
   , m_srcAddress(localEndpoint.getEthernetAddress())
   , m_destAddress(remoteEndpoint)
   , m_interfaceName(localEndpoint.getName())
@@ -50,12 +51,45 @@ EthernetTransport::EthernetTransport(const ndn::net::NetworkInterface& localEndp
   , m_nDropped(0)
 #endif
 {
-  try {
-    m_pcap.activate(DLT_EN10MB);
-    m_socket.assign(m_pcap.getFd());
-  }
-  catch (const PcapHelper::Error& e) {
-    NDN_THROW_NESTED(Error(e.what()));
+  switch (backend) {
+  case Backend::PCAP:
+    try {
+      m_pcap = make_unique<PcapHelper>(localEndpoint.getName());
+      m_pcap->activate(DLT_EN10MB);
+      m_socket.assign(m_pcap->getFd());
+    }
+    catch (const PcapHelper::Error& e) {
+      NDN_THROW_NESTED(Error(e.what()));
+    }
+    break;
+  case Backend::PACKET_RING:
+#ifdef __linux__
+    try {
+      m_ring = make_unique<PacketRingHelper>(localEndpoint.getName(), localEndpoint.getMtu());
+      m_ring->activate();
+      m_socket.assign(m_ring->getFd());
+    }
+    catch (const PacketRingHelper::Error& e) {
+      NDN_THROW_NESTED(Error(e.what()));
+    }
+    break;
+#else
+    NDN_THROW(Error("Packet ring is only supported on Linux"));
+#endif
+  case Backend::XDP:
+#ifdef HAVE_AF_XDP
+    try {
+      m_xdp = make_unique<XdpHelper>(localEndpoint.getName(), localEndpoint.getMtu());
+      m_xdp->activate();
+      m_socket.assign(m_xdp->getFd());
+    }
+    catch (const XdpHelper::Error& e) {
+      NDN_THROW_NESTED(Error(e.what()));
+    }
+    break;
+#else
+    NDN_THROW(Error("AF_XDP is not supported on this platform"));
+#endif
   }
 
   m_netifStateConn = localEndpoint.onStateChanged.connect(
@@ -78,7 +112,19 @@ EthernetTransport::doClose()
     m_socket.cancel(error);
     m_socket.close(error);
   }
-  m_pcap.close();
+  if (m_pcap) {
+    m_pcap->close();
+  }
+#ifdef __linux__
+  if (m_ring) {
+    m_ring->close();
+  }
+#endif
+#ifdef HAVE_AF_XDP
+  if (m_xdp) {
+    m_xdp->close();
+  }
+#endif
 
   // Ensure that the Transport stays alive at least
   // until all pending handlers are dispatched
@@ -127,9 +173,58 @@ EthernetTransport::sendPacket(const ndn::Block& block)
   buffer.prependByteArray(m_destAddress.data(), m_destAddress.size());
 
   // send the frame
-  int sent = pcap_inject(m_pcap, buffer.buf(), buffer.size());
+  ssize_t sent = 0;
+  std::string err;
+#ifdef HAVE_AF_XDP
+  if (m_xdp) {
+    sent = m_xdp->send(buffer.buf(), buffer.size());
+    if (sent < 0 && errno == ENOBUFS) {
+      NFD_LOG_FACE_DEBUG("No free transmit frame: DROP");
+      return;
+    }
+    if (sent < 0) {
+      err = std::strerror(errno);
+    }
+    else if (!m_isFlushPending) {
+      m_isFlushPending = true;
+      getGlobalIoService().post([this] {
+        m_isFlushPending = false;
+        m_xdp->flush();
+      });
+    }
+  }
+  else
+#endif
+#ifdef __linux__
+  if (m_ring) {
+    sent = m_ring->send(buffer.buf(), buffer.size());
+    if (sent < 0 && errno == ENOBUFS) {
+      NFD_LOG_FACE_DEBUG("Transmit ring is full: DROP");
+      return;
+    }
+    if (sent < 0) {
+      err = std::strerror(errno);
+    }
+    else if (!m_isFlushPending) {
+      // let the kernel transmit all frames queued during this round of event processing at once
+      m_isFlushPending = true;
+      getGlobalIoService().post([this] {
+        m_isFlushPending = false;
+        m_ring->flush();
+      });
+    }
+  }
+  else
+#endif
+  {
+    sent = pcap_inject(*m_pcap, buffer.buf(), buffer.size());
+    if (sent < 0) {
+      err = m_pcap->getLastError();
+    }
+  }
+
   if (sent < 0)
-    handleError("Send operation failed: " + m_pcap.getLastError());
+    handleError("Send operation failed: " + err);
   else if (static_cast<size_t>(sent) < buffer.size())
     handleError("Failed to send the full frame: size=" + to_string(buffer.size()) +
                 " sent=" + to_string(sent));
@@ -163,28 +258,46 @@ EthernetTransport::handleRead(const boost::system::error_code& error)
   const uint8_t* pkt;
   size_t len;
   std::string err;
-  std::tie(pkt, len, err) = m_pcap.readNextPacket();
-
-  if (pkt == nullptr) {
-    NFD_LOG_FACE_WARN("Read error: " << err);
+#ifdef HAVE_AF_XDP
+  if (m_xdp) {
+    // process all frames in the receive ring
+    // stop if the transport is closed while processing a frame
+    while (m_socket.is_open()) {
+      std::tie(pkt, len, err) = m_xdp->readNextPacket();
+      if (pkt == nullptr) {
+        break;
+      }
+      handleFrame(pkt, len, {});
+    }
   }
-  else {
-    const ether_header* eh;
-    std::tie(eh, err) = ethernet::checkFrameHeader(pkt, len, m_srcAddress,
-                                                   m_destAddress.isMulticast() ? m_destAddress : m_srcAddress);
-    if (eh == nullptr) {
-      NFD_LOG_FACE_WARN(err);
+  else
+#endif
+#ifdef __linux__
+  if (m_ring) {
+    // process all frames in the blocks handed over by the kernel
+    // stop if the transport is closed while processing a frame
+    while (m_socket.is_open()) {
+      std::tie(pkt, len, err) = m_ring->readNextPacket();
+      if (pkt == nullptr) {
+        break;
+      }
+      handleFrame(pkt, len, m_ring->getLastRxTime());
+    }
+  }
+  else
+#endif
+  {
+    std::tie(pkt, len, err) = m_pcap->readNextPacket();
+    if (pkt == nullptr) {
+      NFD_LOG_FACE_WARN("Read error: " << err);
     }
     else {
-      ethernet::Address sender(eh->ether_shost);
-      pkt += ethernet::HDR_LEN;
-      len -= ethernet::HDR_LEN;
-      receivePayload(pkt, len, sender);
+      handleFrame(pkt, len, m_pcap->getLastRxTime());
     }
   }
 
 #ifdef _DEBUG
-  size_t nDropped = m_pcap.getNDropped();
+  size_t nDropped = getNDropped();
   if (nDropped - m_nDropped > 0)
     NFD_LOG_FACE_DEBUG("Detected " << nDropped - m_nDropped << " dropped frame(s)");
   m_nDropped = nDropped;
@@ -193,9 +306,61 @@ EthernetTransport::handleRead(const boost::system::error_code& error)
   asyncRead();
 }
 
+void
+EthernetTransport::handleFrame(const uint8_t* frame, size_t length,
+                               time::steady_clock::TimePoint rxTime)
+{
+  const ether_header* eh;
+  std::string err;
+  std::tie(eh, err) = ethernet::checkFrameHeader(frame, length, m_srcAddress,
+                                                 m_destAddress.isMulticast() ? m_destAddress : m_srcAddress);
+  if (eh == nullptr) {
+    NFD_LOG_FACE_WARN(err);
+    return;
+  }
+
+  ethernet::Address sender(eh->ether_shost);
+  receivePayload(frame + ethernet::HDR_LEN, length - ethernet::HDR_LEN, sender, rxTime);
+}
+
+size_t
+EthernetTransport::getNDropped() const
+{
+#ifdef __linux__
+  if (m_ring) {
+    return m_ring->getNDropped();
+  }
+#endif
+#ifdef HAVE_AF_XDP
+  if (m_xdp) {
+    return m_xdp->getNDropped();
+  }
+#endif
+  return m_pcap->getNDropped();
+}
+
+void
+EthernetTransport::setPacketFilter(const char* filter)
+{
+#ifdef HAVE_AF_XDP
+  if (m_xdp) {
+    // the XDP program only redirects NDN multicast frames, and handleFrame() checks the addresses
+    return;
+  }
+#endif
+#ifdef __linux__
+  if (m_ring) {
+    m_ring->setPacketFilter(filter);
+    return;
+  }
+#endif
+  m_pcap->setPacketFilter(filter);
+}
+
 void
 EthernetTransport::receivePayload(const uint8_t* payload, size_t length,
-                                  const ethernet::Address& sender)
+                                  const ethernet::Address& sender,
+                                  time::steady_clock::TimePoint rxTime)
 {
   NFD_LOG_FACE_TRACE("Received: " << length << " bytes from " << sender);
 
@@ -215,6 +380,7 @@ EthernetTransport::receivePayload(const uint8_t* payload, size_t length,
   if (m_destAddress.isMulticast()) {
     std::memcpy(&tp.remoteEndpoint, sender.data(), sender.size());
   }
+  tp.rxTime = rxTime;
   this->receive(std::move(tp));
 }
 
@@ -31,6 +31,13 @@
 #include "transport.hpp"
 #include <ndn-cxx/net/network-interface.hpp>
 
+#ifdef __linux__
+#include "packet-ring-helper.hpp"
+#endif
+#ifdef HAVE_AF_XDP
+#include "xdp-helper.hpp"
+#endif
+
 namespace nfd {
 namespace face {
 
@@ -50,19 +57,31 @@ public:
     }
   };
 
+  /**
+   * @brief Selects how frames are received from and sent to the network interface
+   */
+  enum class Backend {
+    PCAP,        ///< libpcap
+    PACKET_RING, ///< AF_PACKET socket with TPACKET_V3 memory-mapped rings (Linux only)
+    XDP,         ///< AF_XDP socket, receives multicast frames only (Linux only)
+  };
+
   /**
    * @brief Processes the payload of an incoming frame
    * @param payload Pointer to the first byte of data after the Ethernet header
    * @param length Payload length
    * @param sender Sender address
+   * @param rxTime Time at which the frame was received, the current time if unspecified
    */
   void
   receivePayload(const uint8_t* payload, size_t length,
-                 const ethernet::Address& sender);
+                 const ethernet::Address& sender,
+                 time::steady_clock::TimePoint rxTime = {});
 
 protected:
   EthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
-                    const ethernet::Address& remoteEndpoint);
+                    const ethernet::Address& remoteEndpoint,
+                    Backend backend);
 
   void
   doClose() final;
@@ -79,6 +98,13 @@ protected:
     m_hasRecentlyReceived = false;
   }
 
+  /**
+   * @brief Installs a BPF filter on the receiving socket
+   * @param filter Null-terminated string containing the BPF program source, see pcap-filter(7)
+   */
+  void
+  setPacketFilter(const char* filter);
+
 private:
   void
   handleNetifStateChange(ndn::net::InterfaceState netifState);
@@ -98,12 +124,28 @@ private:
   void
   handleRead(const boost::system::error_code& error);
 
+  /**
+   * @brief Processes an incoming frame, including the Ethernet header
+   */
+  void
+  handleFrame(const uint8_t* frame, size_t length, time::steady_clock::TimePoint rxTime);
+
+  size_t
+  getNDropped() const;
+
   void
   handleError(const std::string& errorMessage);
 
 protected:
   boost::asio::posix::stream_descriptor m_socket;
-  PcapHelper m_pcap;
+  unique_ptr<PcapHelper> m_pcap; ///< nullptr unless using Backend::PCAP
+#ifdef __linux__
+  unique_ptr<PacketRingHelper> m_ring; ///< nullptr unless using Backend::PACKET_RING
+  bool m_isFlushPending = false;
+#endif
+#ifdef HAVE_AF_XDP
+  unique_ptr<XdpHelper> m_xdp; ///< nullptr unless using Backend::XDP
+#endif
   ethernet::Address m_srcAddress;
   ethernet::Address m_destAddress;
   std::string m_interfaceName;
@@ -112,7 +154,7 @@ private:
   signal::ScopedConnection m_netifStateConn;
   bool m_hasRecentlyReceived;
 #ifdef _DEBUG
-  /// number of frames dropped by the kernel, as reported by libpcap
+  /// number of frames dropped by the kernel, as reported by the backend
   size_t m_nDropped;
 #endif
 };
@@ -29,6 +29,10 @@
 #include "daemon/global.hpp"
 #include "fw/face-table.hpp"
 
+#ifdef HAVE_IO_URING
+#include "io-uring.hpp"
+#endif
+
 namespace nfd {
 namespace face {
 
@@ -102,6 +106,7 @@ FaceSystem::processConfig(const ConfigSection& configSection, bool isDryRun, con
   context.isDryRun = isDryRun;
 
   // process general protocol factory config section
+  bool wantIoUring = false;
   auto generalSection = configSection.get_child_optional(SECTION_GENERAL);
   if (generalSection) {
     for (const auto& pair : *generalSection) {
@@ -109,12 +114,28 @@ FaceSystem::processConfig(const ConfigSection& configSection, bool isDryRun, con
       if (key == "enable_congestion_marking") {
         context.generalConfig.wantCongestionMarking = ConfigFile::parseYesNo(pair, "face_system.general");
       }
+      else if (key == "io_uring") {
+        wantIoUring = ConfigFile::parseYesNo(pair, "face_system.general");
+#ifndef HAVE_IO_URING
+        if (wantIoUring) {
+          NDN_THROW(ConfigFile::Error("face_system.general.io_uring is not supported on this platform"));
+        }
+#endif
+      }
       else {
         NDN_THROW(ConfigFile::Error("Unrecognized option face_system.general." + key));
       }
     }
   }
 
+#ifdef HAVE_IO_URING
+  // transports pick their backend when they are created, before the factories process their
+  // sections so that it applies to permanent faces created from the configuration
+  if (!isDryRun) {
+    setGlobalIoUringEnabled(wantIoUring);
+  }
+#endif
+
   // process in protocol factories
   for (const auto& pair : m_factories) {
     const std::string& sectionName = pair.first;
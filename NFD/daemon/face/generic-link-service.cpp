@@ -24,6 +24,7 @@
  */
 
 #include "generic-link-service.hpp"
+#include "daemon/global.hpp"
 
 #include <ndn-cxx/lp/tags.hpp>
 
@@ -40,19 +41,33 @@ constexpr size_t CONGESTION_MARK_SIZE = tlv::sizeOfVarNumber(lp::tlv::Congestion
 
 constexpr uint32_t DEFAULT_CONGESTION_THRESHOLD_DIVISOR = 2;
 
+/** \brief maximum overhead of an LpAggregate container: TLV-TYPE and TLV-LENGTH
+ */
+constexpr size_t MAX_AGGREGATE_OVERHEAD = tlv::sizeOfVarNumber(lp::tlv::LpAggregate) + 9;
+
 GenericLinkService::GenericLinkService(const GenericLinkService::Options& options)
   : m_options(options)
   , m_fragmenter(m_options.fragmenterOptions, this)
   , m_reassembler(m_options.reassemblerOptions, this)
   , m_reliability(m_options.reliabilityOptions, this)
   , m_lastSeqNo(-2)
+  , m_aggregateSize(0)
+  , m_aggregateClass(EgressScheduler::TrafficClass::DATA)
+  , m_egressScheduler(m_options.schedulerOptions, this)
   , m_nextMarkTime(time::steady_clock::TimePoint::max())
   , m_lastMarkTime(time::steady_clock::TimePoint::min())
   , m_nMarkedSinceInMarkingState(0)
+  , m_firstAboveThresholdTime(time::steady_clock::TimePoint::max())
 {
   m_reassembler.beforeTimeout.connect([this] (auto...) { ++this->nReassemblyTimeouts; });
+  m_reassembler.onBufferLimitExceeded.connect([this] (auto...) { ++this->nReassemblyBufferDrops; });
   m_reliability.onDroppedInterest.connect([this] (const auto& i) { this->notifyDroppedInterest(i); });
+  m_egressScheduler.afterDequeue.connect([this] (const Block& frame) {
+    this->sendPacket(Transport::Packet(Block(frame)));
+  });
+  m_egressScheduler.onQueueOverflow.connect([this] (auto...) { ++this->nEgressQueueDrops; });
   nReassembling.observe(&m_reassembler);
+  nEgressQueued.observe(&m_egressScheduler);
 }
 
 void
@@ -62,6 +77,7 @@ GenericLinkService::setOptions(const GenericLinkService::Options& options)
   m_fragmenter.setOptions(m_options.fragmenterOptions);
   m_reassembler.setOptions(m_options.reassemblerOptions);
   m_reliability.setOptions(m_options.reliabilityOptions);
+  m_egressScheduler.setOptions(m_options.schedulerOptions);
 }
 
 void
@@ -73,7 +89,7 @@ GenericLinkService::requestIdlePacket()
 }
 
 void
-GenericLinkService::sendLpPacket(lp::Packet&& pkt)
+GenericLinkService::sendLpPacket(lp::Packet&& pkt, EgressScheduler::TrafficClass tc)
 {
   const ssize_t mtu = this->getTransport()->getMtu();
 
@@ -91,7 +107,66 @@ GenericLinkService::sendLpPacket(lp::Packet&& pkt)
     NFD_LOG_FACE_WARN("attempted to send packet over MTU limit");
     return;
   }
-  this->sendPacket(std::move(tp));
+
+  if (m_options.allowAggregation && mtu != MTU_UNLIMITED) {
+    this->aggregateLpPacket(std::move(tp.packet), static_cast<size_t>(mtu), tc);
+    return;
+  }
+  m_egressScheduler.enqueue(std::move(tp.packet), tc);
+}
+
+void
+GenericLinkService::aggregateLpPacket(Block&& wire, size_t mtu, EgressScheduler::TrafficClass tc)
+{
+  if (MAX_AGGREGATE_OVERHEAD + m_aggregateSize + wire.size() > mtu) {
+    this->flushAggregate();
+
+    if (MAX_AGGREGATE_OVERHEAD + wire.size() > mtu) {
+      // packet cannot share a frame with any other packet
+      m_egressScheduler.enqueue(std::move(wire), tc);
+      return;
+    }
+  }
+
+  m_aggregateSize += wire.size();
+  m_aggregate.push_back(std::move(wire));
+  // the frame is scheduled with the priority of its most urgent LpPacket
+  m_aggregateClass = m_aggregate.size() == 1 ? tc : std::min(m_aggregateClass, tc);
+
+  if (m_aggregate.size() == 1) {
+    // while the egress scheduler is idle, holding the packet would only delay it, so it is sent
+    // after the current event loop iteration, together with any packets added in the meantime
+    auto delay = m_egressScheduler.size() == 0 ? 0_ns : m_options.aggregationDelay;
+    m_aggregationTimer = getScheduler().schedule(delay, [this] {
+      this->flushAggregate();
+    });
+  }
+}
+
+void
+GenericLinkService::flushAggregate()
+{
+  m_aggregationTimer.cancel();
+
+  if (m_aggregate.empty()) {
+    return;
+  }
+
+  if (m_aggregate.size() == 1) {
+    m_egressScheduler.enqueue(std::move(m_aggregate.front()), m_aggregateClass);
+  }
+  else {
+    Block aggregate(lp::tlv::LpAggregate);
+    for (const Block& wire : m_aggregate) {
+      aggregate.push_back(wire);
+    }
+    aggregate.encode();
+    ++this->nOutAggregates;
+    m_egressScheduler.enqueue(std::move(aggregate), m_aggregateClass);
+  }
+
+  m_aggregate.clear();
+  m_aggregateSize = 0;
 }
 
 void
@@ -101,7 +176,7 @@ GenericLinkService::doSendInterest(const Interest& interest)
 
   encodeLpFields(interest, lpPacket);
 
-  this->sendNetPacket(std::move(lpPacket), true);
+  this->sendNetPacket(std::move(lpPacket), EgressScheduler::TrafficClass::INTEREST);
 }
 
 void
@@ -111,7 +186,7 @@ GenericLinkService::doSendData(const Data& data)
 
   encodeLpFields(data, lpPacket);
 
-  this->sendNetPacket(std::move(lpPacket), false);
+  this->sendNetPacket(std::move(lpPacket), EgressScheduler::TrafficClass::DATA);
 }
 
 void
@@ -122,7 +197,7 @@ GenericLinkService::doSendNack(const lp::Nack& nack)
 
   encodeLpFields(nack, lpPacket);
 
-  this->sendNetPacket(std::move(lpPacket), false);
+  this->sendNetPacket(std::move(lpPacket), EgressScheduler::TrafficClass::CONTROL);
 }
 
 void
@@ -140,6 +215,11 @@ GenericLinkService::encodeLpFields(const ndn::PacketBase& netPkt, lp::Packet& lp
     lpPacket.add<lp::CongestionMarkField>(*congestionMarkTag);
   }
 
+  // CachePolicy is only meaningful on Data, and is never attached to Interests or Nacks
+  if (netPkt.getTag<NoCacheMarkTag>() != nullptr) {
+    lpPacket.add<lp::CachePolicyField>(lp::CachePolicy().setPolicy(lp::CachePolicyType::NO_CACHE));
+  }
+
   if (m_options.allowSelfLearning) {
     shared_ptr<lp::NonDiscoveryTag> nonDiscoveryTag = netPkt.getTag<lp::NonDiscoveryTag>();
     if (nonDiscoveryTag != nullptr) {
@@ -154,7 +234,7 @@ GenericLinkService::encodeLpFields(const ndn::PacketBase& netPkt, lp::Packet& lp
 }
 
 void
-GenericLinkService::sendNetPacket(lp::Packet&& pkt, bool isInterest)
+GenericLinkService::sendNetPacket(lp::Packet&& pkt, EgressScheduler::TrafficClass tc)
 {
   std::vector<lp::Packet> frags;
   ssize_t mtu = this->getTransport()->getMtu();
@@ -202,11 +282,11 @@ GenericLinkService::sendNetPacket(lp::Packet&& pkt, bool isInterest)
   }
 
   if (m_options.reliabilityOptions.isEnabled && frags.front().has<lp::FragmentField>()) {
-    m_reliability.handleOutgoing(frags, std::move(pkt), isInterest);
+    m_reliability.handleOutgoing(frags, std::move(pkt), tc == EgressScheduler::TrafficClass::INTEREST);
   }
 
   for (lp::Packet& frag : frags) {
-    this->sendLpPacket(std::move(frag));
+    this->sendLpPacket(std::move(frag), tc);
   }
 }
 
@@ -230,6 +310,8 @@ GenericLinkService::checkCongestionLevel(lp::Packet& pkt)
   if (sendQueueLength < 0) {
     return;
   }
+  // frames held back by the egress scheduler are queued as well
+  sendQueueLength += m_egressScheduler.getQueuedBytes();
 
   // To avoid overflowing the queue, set the congestion threshold to at least half of the send
   // queue capacity.
@@ -247,6 +329,16 @@ GenericLinkService::checkCongestionLevel(lp::Packet& pkt)
 
   if (static_cast<size_t>(sendQueueLength) > congestionThreshold) { // Send queue is congested
     const auto now = time::steady_clock::now();
+    if (m_options.wantStandingQueueMarking) {
+      if (m_firstAboveThresholdTime == time::steady_clock::TimePoint::max()) {
+        m_firstAboveThresholdTime = now;
+      }
+      if (now < m_firstAboveThresholdTime + m_options.baseCongestionMarkingInterval) {
+        // Send queue may still drain on its own; it is not yet a standing queue
+        return;
+      }
+    }
+
     if (now >= m_nextMarkTime || now >= m_lastMarkTime + m_options.baseCongestionMarkingInterval) {
       // Mark at most one initial packet per baseCongestionMarkingInterval
       if (m_nMarkedSinceInMarkingState == 0) {
@@ -267,22 +359,58 @@ GenericLinkService::checkCongestionLevel(lp::Packet& pkt)
       m_lastMarkTime = now;
     }
   }
-  else if (m_nextMarkTime != time::steady_clock::TimePoint::max()) {
-    // Congestion incident has ended, so reset
-    NFD_LOG_FACE_DEBUG("Send queue length dropped below congestion threshold");
-    m_nextMarkTime = time::steady_clock::TimePoint::max();
-    m_nMarkedSinceInMarkingState = 0;
+  else {
+    m_firstAboveThresholdTime = time::steady_clock::TimePoint::max();
+    if (m_nextMarkTime != time::steady_clock::TimePoint::max()) {
+      // Congestion incident has ended, so reset
+      NFD_LOG_FACE_DEBUG("Send queue length dropped below congestion threshold");
+      m_nextMarkTime = time::steady_clock::TimePoint::max();
+      m_nMarkedSinceInMarkingState = 0;
+    }
   }
 }
 
 void
 GenericLinkService::doReceivePacket(Transport::Packet&& packet)
+{
+  if (packet.packet.type() != lp::tlv::LpAggregate) {
+    this->receiveLpPacket(packet.packet, packet.remoteEndpoint, packet.rxTime);
+    return;
+  }
+
+  if (!m_options.allowAggregation) {
+    NFD_LOG_FACE_WARN("received LpAggregate, but aggregation disabled: DROP");
+    return;
+  }
+
+  try {
+    packet.packet.parse();
+  }
+  catch (const tlv::Error& e) {
+    ++this->nInLpInvalid;
+    NFD_LOG_FACE_WARN("LpAggregate parse error (" << e.what() << "): DROP");
+    return;
+  }
+
+  for (const Block& element : packet.packet.elements()) {
+    if (element.type() == lp::tlv::LpAggregate) {
+      ++this->nInLpInvalid;
+      NFD_LOG_FACE_WARN("nested LpAggregate: DROP");
+      continue;
+    }
+    this->receiveLpPacket(element, packet.remoteEndpoint, packet.rxTime);
+  }
+}
+
+void
+GenericLinkService::receiveLpPacket(const Block& packet, EndpointId remoteEndpoint,
+                                    time::steady_clock::TimePoint rxTime)
 {
   try {
-    lp::Packet pkt(packet.packet);
+    lp::Packet pkt(packet);
 
     if (m_options.reliabilityOptions.isEnabled) {
-      m_reliability.processIncomingPacket(pkt);
+      m_reliability.processIncomingPacket(pkt, rxTime);
     }
 
     if (!pkt.has<lp::FragmentField>()) {
@@ -299,10 +427,9 @@ GenericLinkService::doReceivePacket(Transport::Packet&& packet)
     bool isReassembled = false;
     Block netPkt;
     lp::Packet firstPkt;
-    std::tie(isReassembled, netPkt, firstPkt) = m_reassembler.receiveFragment(packet.remoteEndpoint,
-                                                                              pkt);
+    std::tie(isReassembled, netPkt, firstPkt) = m_reassembler.receiveFragment(remoteEndpoint, pkt);
     if (isReassembled) {
-      this->decodeNetPacket(netPkt, firstPkt);
+      this->decodeNetPacket(netPkt, firstPkt, rxTime);
     }
   }
   catch (const tlv::Error& e) {
@@ -312,20 +439,21 @@ GenericLinkService::doReceivePacket(Transport::Packet&& packet)
 }
 
 void
-GenericLinkService::decodeNetPacket(const Block& netPkt, const lp::Packet& firstPkt)
+GenericLinkService::decodeNetPacket(const Block& netPkt, const lp::Packet& firstPkt,
+                                    time::steady_clock::TimePoint rxTime)
 {
   try {
     switch (netPkt.type()) {
       case tlv::Interest:
         if (firstPkt.has<lp::NackField>()) {
-          this->decodeNack(netPkt, firstPkt);
+          this->decodeNack(netPkt, firstPkt, rxTime);
         }
         else {
-          this->decodeInterest(netPkt, firstPkt);
+          this->decodeInterest(netPkt, firstPkt, rxTime);
         }
         break;
       case tlv::Data:
-        this->decodeData(netPkt, firstPkt);
+        this->decodeData(netPkt, firstPkt, rxTime);
         break;
       default:
         ++this->nInNetInvalid;
@@ -340,7 +468,8 @@ GenericLinkService::decodeNetPacket(const Block& netPkt, const lp::Packet& first
 }
 
 void
-GenericLinkService::decodeInterest(const Block& netPkt, const lp::Packet& firstPkt)
+GenericLinkService::decodeInterest(const Block& netPkt, const lp::Packet& firstPkt,
+                                   time::steady_clock::TimePoint rxTime)
 {
   BOOST_ASSERT(netPkt.type() == tlv::Interest);
   BOOST_ASSERT(!firstPkt.has<lp::NackField>());
@@ -387,11 +516,13 @@ GenericLinkService::decodeInterest(const Block& netPkt, const lp::Packet& firstP
     return;
   }
 
+  interest->setTag(std::make_shared<RxTimestampTag>(rxTime));
   this->receiveInterest(*interest);
 }
 
 void
-GenericLinkService::decodeData(const Block& netPkt, const lp::Packet& firstPkt)
+GenericLinkService::decodeData(const Block& netPkt, const lp::Packet& firstPkt,
+                               time::steady_clock::TimePoint rxTime)
 {
   BOOST_ASSERT(netPkt.type() == tlv::Data);
 
@@ -440,11 +571,13 @@ GenericLinkService::decodeData(const Block& netPkt, const lp::Packet& firstPkt)
     }
   }
 
+  data->setTag(std::make_shared<RxTimestampTag>(rxTime));
   this->receiveData(*data);
 }
 
 void
-GenericLinkService::decodeNack(const Block& netPkt, const lp::Packet& firstPkt)
+GenericLinkService::decodeNack(const Block& netPkt, const lp::Packet& firstPkt,
+                               time::steady_clock::TimePoint rxTime)
 {
   BOOST_ASSERT(netPkt.type() == tlv::Interest);
   BOOST_ASSERT(firstPkt.has<lp::NackField>());
@@ -484,6 +617,7 @@ GenericLinkService::decodeNack(const Block& netPkt, const lp::Packet& firstPkt)
     return;
   }
 
+  nack.setTag(std::make_shared<RxTimestampTag>(rxTime));
   this->receiveNack(nack);
 }
 
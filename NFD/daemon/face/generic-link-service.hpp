@@ -27,6 +27,7 @@
 #define NFD_DAEMON_FACE_GENERIC_LINK_SERVICE_HPP
 
 #include "link-service.hpp"
+#include "egress-scheduler.hpp"
 #include "lp-fragmenter.hpp"
 #include "lp-reassembler.hpp"
 #include "lp-reliability.hpp"
@@ -63,6 +64,10 @@ public:
    */
   PacketCounter nReassemblyTimeouts;
 
+  /** \brief count of fragments dropped early because the reassembly buffer limit was reached
+   */
+  PacketCounter nReassemblyBufferDrops;
+
   /** \brief count of invalid reassembled network-layer packets dropped
    */
   PacketCounter nInNetInvalid;
@@ -84,6 +89,18 @@ public:
   /** \brief count of outgoing LpPackets that were marked with congestion marks
    */
   PacketCounter nCongestionMarked;
+
+  /** \brief count of outgoing link-layer frames that carried more than one LpPacket
+   */
+  PacketCounter nOutAggregates;
+
+  /** \brief count of outgoing link-layer frames currently held by the egress scheduler
+   */
+  SizeCounter<EgressScheduler> nEgressQueued;
+
+  /** \brief count of outgoing link-layer frames dropped because an egress queue was full
+   */
+  PacketCounter nEgressQueueDrops;
 };
 
 /** \brief GenericLinkService is a LinkService that implements the NDNLPv2 protocol
@@ -144,9 +161,39 @@ public:
      */
     size_t defaultCongestionThreshold = 65536;
 
+    /** \brief marks only a standing send queue, in the manner of CoDel
+     *
+     *  If false, a packet is marked as soon as the send queue exceeds the congestion threshold.
+     *  If true, packets are marked only after the send queue has stayed above the congestion
+     *  threshold for baseCongestionMarkingInterval, so that bursts that drain within one interval
+     *  are not marked. This is the CoDel sojourn time condition, applied to the send queue length,
+     *  because the sojourn time of bytes in a socket buffer cannot be observed.
+     */
+    bool wantStandingQueueMarking = false;
+
     /** \brief enables self-learning forwarding support
      */
     bool allowSelfLearning = true;
+
+    /** \brief enables aggregation of small LpPackets into one link-layer frame
+     *
+     *  If true, outgoing LpPackets are packed together into LpAggregate containers that fit
+     *  within the MTU, and incoming LpAggregate containers are accepted.
+     *  Both ends of the link must enable this option.
+     *  This has no effect on transports with unlimited MTU.
+     */
+    bool allowAggregation = false;
+
+    /** \brief maximum time an outgoing LpPacket is held while waiting to be aggregated
+     *
+     *  This applies only while earlier frames are queued in the egress scheduler. Otherwise,
+     *  the pending aggregate is sent at the end of the current event loop iteration.
+     */
+    time::nanoseconds aggregationDelay = 1_ms;
+
+    /** \brief options for egress pacing and prioritization
+     */
+    EgressScheduler::Options schedulerOptions;
   };
 
   /** \brief counters provided by GenericLinkService
@@ -177,9 +224,10 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE: // send path
 
   /** \brief send an LpPacket fragment
    *  \param pkt LpPacket to send
+   *  \param tc traffic class of the network-layer packet, used by the egress scheduler
    */
   void
-  sendLpPacket(lp::Packet&& pkt);
+  sendLpPacket(lp::Packet&& pkt, EgressScheduler::TrafficClass tc = EgressScheduler::TrafficClass::CONTROL);
 
   /** \brief send Interest
    */
@@ -206,10 +254,11 @@ private: // send path
 
   /** \brief send a complete network layer packet
    *  \param pkt LpPacket containing a complete network layer packet
-   *  \param isInterest whether the network layer packet is an Interest
+   *  \param tc traffic class of the network layer packet: INTEREST for an Interest,
+   *            DATA for a Data, or CONTROL for a Nack
    */
   void
-  sendNetPacket(lp::Packet&& pkt, bool isInterest);
+  sendNetPacket(lp::Packet&& pkt, EgressScheduler::TrafficClass tc);
 
   /** \brief assign a sequence number to an LpPacket
    */
@@ -228,21 +277,47 @@ private: // send path
   void
   checkCongestionLevel(lp::Packet& pkt);
 
+  /** \brief add an encoded LpPacket to the pending aggregate, or send it if it cannot be aggregated
+   *  \param wire encoded LpPacket
+   *  \param mtu MTU of the transport
+   *  \param tc traffic class of the LpPacket
+   */
+  void
+  aggregateLpPacket(Block&& wire, size_t mtu, EgressScheduler::TrafficClass tc);
+
+  /** \brief send the pending aggregate, if any
+   *
+   *  A single pending LpPacket is sent as is, without an LpAggregate container.
+   */
+  void
+  flushAggregate();
+
 private: // receive path
   /** \brief receive Packet from Transport
    */
   void
   doReceivePacket(Transport::Packet&& packet) OVERRIDE_WITH_TESTS_ELSE_FINAL;
 
+  /** \brief process an incoming LpPacket or bare network-layer packet
+   *  \param packet the packet, which must not be an LpAggregate
+   *  \param remoteEndpoint endpoint from which the packet was received
+   *  \param rxTime time at which the packet arrived at the transport
+   */
+  void
+  receiveLpPacket(const Block& packet, EndpointId remoteEndpoint,
+                  time::steady_clock::TimePoint rxTime);
+
   /** \brief decode incoming network-layer packet
    *  \param netPkt reassembled network-layer packet
    *  \param firstPkt LpPacket of first fragment
+   *  \param rxTime time at which the last fragment arrived, carried in RxTimestampTag
    *
    *  If decoding is successful, a receive signal is emitted;
    *  otherwise, a warning is logged.
    */
   void
-  decodeNetPacket(const Block& netPkt, const lp::Packet& firstPkt);
+  decodeNetPacket(const Block& netPkt, const lp::Packet& firstPkt,
+                  time::steady_clock::TimePoint rxTime);
 
   /** \brief decode incoming Interest
    *  \param netPkt reassembled network-layer packet; TLV-TYPE must be Interest
@@ -254,7 +329,8 @@ private: // receive path
    *  \throw tlv::Error parse error in an LpHeader field
    */
   void
-  decodeInterest(const Block& netPkt, const lp::Packet& firstPkt);
+  decodeInterest(const Block& netPkt, const lp::Packet& firstPkt,
+                 time::steady_clock::TimePoint rxTime);
 
   /** \brief decode incoming Interest
    *  \param netPkt reassembled network-layer packet; TLV-TYPE must be Data
@@ -266,7 +342,8 @@ private: // receive path
    *  \throw tlv::Error parse error in an LpHeader field
    */
   void
-  decodeData(const Block& netPkt, const lp::Packet& firstPkt);
+  decodeData(const Block& netPkt, const lp::Packet& firstPkt,
+             time::steady_clock::TimePoint rxTime);
 
   /** \brief decode incoming Interest
    *  \param netPkt reassembled network-layer packet; TLV-TYPE must be Interest
@@ -278,7 +355,8 @@ private: // receive path
    *  \throw tlv::Error parse error in an LpHeader field
    */
   void
-  decodeNack(const Block& netPkt, const lp::Packet& firstPkt);
+  decodeNack(const Block& netPkt, const lp::Packet& firstPkt,
+             time::steady_clock::TimePoint rxTime);
 
 PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   Options m_options;
@@ -286,6 +364,14 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   LpReassembler m_reassembler;
   LpReliability m_reliability;
   lp::Sequence m_lastSeqNo;
+  /// encoded LpPackets waiting to be sent in one LpAggregate
+  std::vector<Block> m_aggregate;
+  /// total size of LpPackets in m_aggregate
+  size_t m_aggregateSize;
+  /// highest-priority traffic class of LpPackets in m_aggregate
+  EgressScheduler::TrafficClass m_aggregateClass;
+  scheduler::ScopedEventId m_aggregationTimer;
+  EgressScheduler m_egressScheduler;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /// Time to mark next packet due to send queue congestion
@@ -294,6 +380,8 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   time::steady_clock::TimePoint m_lastMarkTime;
   /// number of marked packets in the current incident of congestion
   size_t m_nMarkedSinceInMarkingState;
+  /// Time the send queue went above the congestion threshold, used by standing queue marking
+  time::steady_clock::TimePoint m_firstAboveThresholdTime;
 
   friend class LpReliability;
 };
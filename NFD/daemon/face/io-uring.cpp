@@ -0,0 +1,487 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "io-uring.hpp"
+#include "core/logger.hpp"
+#include "daemon/global.hpp"
+
+#include <cerrno>
+#include <cstring> // for strerror()
+
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace nfd {
+namespace face {
+
+NFD_LOG_INIT(IoUring);
+
+constexpr size_t IoUring::SQ_ENTRIES;
+constexpr size_t IoUring::CQ_ENTRIES;
+constexpr size_t IoUring::MAX_CHAIN_LENGTH;
+constexpr size_t IoUring::N_RECV_BUFFERS;
+constexpr size_t IoUring::RECV_BUFFER_SIZE;
+
+/** \brief buffer group of the provided buffer ring
+ */
+static const uint16_t BUFFER_GROUP = 0;
+
+/** \brief user_data of operations whose completion is ignored
+ */
+static const uint64_t IGNORED_USER_DATA = 0;
+
+static std::string
+errnoToString(const std::string& what)
+{
+  return what + ": " + std::strerror(errno);
+}
+
+static int
+sysIoUringSetup(unsigned entries, io_uring_params& params)
+{
+  return ::syscall(__NR_io_uring_setup, entries, &params);
+}
+
+static int
+sysIoUringEnter(int fd, unsigned toSubmit)
+{
+  return ::syscall(__NR_io_uring_enter, fd, toSubmit, 0, 0, nullptr, 0);
+}
+
+static int
+sysIoUringRegister(int fd, unsigned opcode, const void* arg, unsigned nArgs)
+{
+  return ::syscall(__NR_io_uring_register, fd, opcode, arg, nArgs);
+}
+
+IoUring::IoUring(boost::asio::io_service& io)
+  : m_ringFd(-1)
+  , m_eventFd(io)
+  , m_ringMap(nullptr)
+  , m_ringMapSize(0)
+  , m_sqes(nullptr)
+  , m_sqesSize(0)
+  , m_bufRing(nullptr)
+  , m_bufRingSize(0)
+  , m_bufRingTail(0)
+  , m_hasMultishotReceive(true)
+  , m_isSubmitPending(false)
+  , m_lastOpId(IGNORED_USER_DATA)
+{
+  io_uring_params params{};
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = CQ_ENTRIES;
+  m_ringFd = sysIoUringSetup(SQ_ENTRIES, params);
+  if (m_ringFd < 0)
+    NDN_THROW(Error(errnoToString("io_uring_setup")));
+
+  try {
+    if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0 ||
+        (params.features & IORING_FEAT_NODROP) == 0)
+      NDN_THROW(Error("io_uring on this kernel lacks required features"));
+
+    m_ringMapSize = std::max(params.sq_off.array + params.sq_entries * sizeof(uint32_t),
+                             params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+    void* map = ::mmap(nullptr, m_ringMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       m_ringFd, IORING_OFF_SQ_RING);
+    if (map == MAP_FAILED) {
+      m_ringMapSize = 0;
+      NDN_THROW(Error(errnoToString("mmap(IORING_OFF_SQ_RING)")));
+    }
+    m_ringMap = static_cast<uint8_t*>(map);
+
+    m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    map = ::mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                 m_ringFd, IORING_OFF_SQES);
+    if (map == MAP_FAILED) {
+      m_sqesSize = 0;
+      NDN_THROW(Error(errnoToString("mmap(IORING_OFF_SQES)")));
+    }
+    m_sqes = static_cast<io_uring_sqe*>(map);
+
+    m_sqHead = reinterpret_cast<uint32_t*>(m_ringMap + params.sq_off.head);
+    m_sqTail = reinterpret_cast<uint32_t*>(m_ringMap + params.sq_off.tail);
+    m_sqArray = reinterpret_cast<uint32_t*>(m_ringMap + params.sq_off.array);
+    m_sqMask = *reinterpret_cast<uint32_t*>(m_ringMap + params.sq_off.ring_mask);
+    m_sqEntries = params.sq_entries;
+    m_sqLocalTail = *m_sqTail;
+
+    m_cqHead = reinterpret_cast<uint32_t*>(m_ringMap + params.cq_off.head);
+    m_cqTail = reinterpret_cast<uint32_t*>(m_ringMap + params.cq_off.tail);
+    m_cqes = reinterpret_cast<const io_uring_cqe*>(m_ringMap + params.cq_off.cqes);
+    m_cqMask = *reinterpret_cast<uint32_t*>(m_ringMap + params.cq_off.ring_mask);
+
+    int eventFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (eventFd < 0)
+      NDN_THROW(Error(errnoToString("eventfd")));
+    m_eventFd.assign(eventFd);
+    if (sysIoUringRegister(m_ringFd, IORING_REGISTER_EVENTFD, &eventFd, 1) < 0)
+      NDN_THROW(Error(errnoToString("io_uring_register(IORING_REGISTER_EVENTFD)")));
+
+    // provided buffer rings require Linux 5.19
+    m_bufRingSize = N_RECV_BUFFERS * sizeof(io_uring_buf);
+    map = ::mmap(nullptr, m_bufRingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED) {
+      m_bufRingSize = 0;
+      NDN_THROW(Error(errnoToString("mmap(buffer ring)")));
+    }
+    m_bufRing = static_cast<io_uring_buf_ring*>(map);
+
+    io_uring_buf_reg reg{};
+    reg.ring_addr = reinterpret_cast<uintptr_t>(m_bufRing);
+    reg.ring_entries = N_RECV_BUFFERS;
+    reg.bgid = BUFFER_GROUP;
+    if (sysIoUringRegister(m_ringFd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+      NDN_THROW(Error(errnoToString("io_uring_register(IORING_REGISTER_PBUF_RING)")));
+
+    m_recvBuffers.resize(N_RECV_BUFFERS * RECV_BUFFER_SIZE);
+    for (size_t bid = 0; bid < N_RECV_BUFFERS; ++bid) {
+      recycleRecvBuffer(bid);
+    }
+  }
+  catch (const Error&) {
+    close();
+    throw;
+  }
+
+  asyncWaitCompletions();
+}
+
+IoUring::~IoUring()
+{
+  close();
+}
+
+void
+IoUring::close()
+{
+  boost::system::error_code error;
+  m_eventFd.close(error);
+
+  // closing the ring cancels all in-flight operations
+  if (m_ringFd >= 0) {
+    ::close(m_ringFd);
+    m_ringFd = -1;
+  }
+  if (m_bufRing != nullptr) {
+    ::munmap(m_bufRing, m_bufRingSize);
+    m_bufRing = nullptr;
+  }
+  if (m_sqes != nullptr) {
+    ::munmap(m_sqes, m_sqesSize);
+    m_sqes = nullptr;
+  }
+  if (m_ringMap != nullptr) {
+    ::munmap(m_ringMap, m_ringMapSize);
+    m_ringMap = nullptr;
+  }
+}
+
+uint64_t
+IoUring::addOperation(const void* owner, int fd, CompletionCallback callback,
+                      const Block& packet, bool isReceive)
+{
+  uint64_t id = ++m_lastOpId;
+  m_ops.emplace(id, Operation{owner, fd, std::move(callback), packet, isReceive, false});
+  return id;
+}
+
+io_uring_sqe*
+IoUring::getSqe()
+{
+  if (m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE) == m_sqEntries) {
+    submit();
+  }
+  BOOST_ASSERT(m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE) < m_sqEntries);
+
+  uint32_t index = m_sqLocalTail & m_sqMask;
+  io_uring_sqe* sqe = &m_sqes[index];
+  std::memset(sqe, 0, sizeof(*sqe));
+  m_sqArray[index] = index;
+  ++m_sqLocalTail;
+
+  scheduleSubmit();
+  return sqe;
+}
+
+void
+IoUring::scheduleSubmit()
+{
+  if (m_isSubmitPending)
+    return;
+
+  // submit all operations queued during this round of event processing at once
+  m_isSubmitPending = true;
+  m_eventFd.get_io_service().post([this] {
+    m_isSubmitPending = false;
+    submit();
+  });
+}
+
+void
+IoUring::submit()
+{
+  __atomic_store_n(m_sqTail, m_sqLocalTail, __ATOMIC_RELEASE);
+
+  uint32_t toSubmit = m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+  while (toSubmit > 0) {
+    int ret = sysIoUringEnter(m_ringFd, toSubmit);
+    if (ret < 0) {
+      if (errno == EINTR)
+        continue;
+      if (errno == EBUSY || errno == EAGAIN) {
+        // too many completions are pending, retry after they have been processed
+        NFD_LOG_DEBUG("io_uring_enter: " << std::strerror(errno));
+        scheduleSubmit();
+        return;
+      }
+      NFD_LOG_ERROR(errnoToString("io_uring_enter"));
+      return;
+    }
+    toSubmit = m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+  }
+}
+
+void
+IoUring::send(const void* owner, int fd, const Block& packet, int msgFlags, CompletionCallback callback)
+{
+  uint64_t id = addOperation(owner, fd, std::move(callback), packet, false);
+
+  io_uring_sqe* sqe = getSqe();
+  sqe->opcode = IORING_OP_SEND;
+  sqe->fd = fd;
+  sqe->addr = reinterpret_cast<uintptr_t>(packet.wire());
+  sqe->len = packet.size();
+  sqe->msg_flags = msgFlags | MSG_NOSIGNAL;
+  sqe->user_data = id;
+}
+
+void
+IoUring::sendChain(const void* owner, int fd, const std::vector<Block>& packets, int msgFlags,
+                   const CompletionCallback& callback)
+{
+  BOOST_ASSERT(packets.size() <= MAX_CHAIN_LENGTH);
+
+  // all entries of a chain must be submitted together, otherwise the chain is broken
+  if (m_sqEntries - (m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE)) < packets.size()) {
+    submit();
+  }
+
+  for (size_t i = 0; i < packets.size(); ++i) {
+    send(owner, fd, packets[i], msgFlags, callback);
+    if (i + 1 < packets.size()) {
+      m_sqes[(m_sqLocalTail - 1) & m_sqMask].flags |= IOSQE_IO_LINK;
+    }
+  }
+}
+
+void
+IoUring::receive(const void* owner, int fd, CompletionCallback callback)
+{
+  uint64_t id = addOperation(owner, fd, std::move(callback), Block(), true);
+
+  int type = 0;
+  socklen_t len = sizeof(type);
+  ::getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &len);
+  m_ops.at(id).isStream = type == SOCK_STREAM;
+
+  prepareReceive(id, fd);
+}
+
+void
+IoUring::prepareReceive(uint64_t id, int fd)
+{
+  io_uring_sqe* sqe = getSqe();
+  sqe->opcode = IORING_OP_RECV;
+  sqe->fd = fd;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = BUFFER_GROUP;
+  sqe->ioprio = m_hasMultishotReceive ? IORING_RECV_MULTISHOT : 0;
+  sqe->user_data = id;
+}
+
+void
+IoUring::cancel(const void* owner)
+{
+  for (auto& pair : m_ops) {
+    Operation& op = pair.second;
+    if (op.owner != owner || !op.callback)
+      continue;
+
+    // the operation stays in m_ops, retaining its packet, until its final completion
+    op.callback = nullptr;
+
+    io_uring_sqe* sqe = getSqe();
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = pair.first;
+    sqe->user_data = IGNORED_USER_DATA;
+  }
+}
+
+void
+IoUring::recycleRecvBuffer(uint16_t bid)
+{
+  io_uring_buf& buf = m_bufRing->bufs[m_bufRingTail & (N_RECV_BUFFERS - 1)];
+  buf.addr = reinterpret_cast<uintptr_t>(m_recvBuffers.data() + bid * RECV_BUFFER_SIZE);
+  buf.len = RECV_BUFFER_SIZE;
+  buf.bid = bid;
+  ++m_bufRingTail;
+  __atomic_store_n(&m_bufRing->tail, m_bufRingTail, __ATOMIC_RELEASE);
+}
+
+void
+IoUring::asyncWaitCompletions()
+{
+  m_eventFd.async_read_some(boost::asio::null_buffers(), [this] (const auto& error, auto) {
+    if (error)
+      return;
+
+    uint64_t counter;
+    ssize_t ret = ::read(m_eventFd.native_handle(), &counter, sizeof(counter));
+    (void)ret;
+    this->handleCompletions();
+    this->asyncWaitCompletions();
+  });
+}
+
+void
+IoUring::handleCompletions()
+{
+  uint32_t head = *m_cqHead;
+  while (head != __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE)) {
+    const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+    uint64_t id = cqe.user_data;
+    int result = cqe.res;
+    uint32_t flags = cqe.flags;
+
+    // release the entry before invoking the callback, which may submit new operations
+    __atomic_store_n(m_cqHead, ++head, __ATOMIC_RELEASE);
+
+    if (id != IGNORED_USER_DATA) {
+      dispatchCompletion(id, result, flags);
+    }
+  }
+}
+
+void
+IoUring::dispatchCompletion(uint64_t id, int result, uint32_t flags)
+{
+  auto it = m_ops.find(id);
+  if (it == m_ops.end()) {
+    NFD_LOG_WARN("Completion of unknown operation " << id);
+    return;
+  }
+  // pointers to elements of an unordered_map are not invalidated by insertions
+  Operation* op = &it->second;
+  bool hasMore = (flags & IORING_CQE_F_MORE) != 0;
+
+  if (!op->isReceive) {
+    if (op->callback) {
+      auto callback = op->callback;
+      callback(result, nullptr);
+    }
+    m_ops.erase(id);
+    return;
+  }
+
+  if (result == -EINVAL && m_hasMultishotReceive && !hasMore) {
+    // multishot receive requires Linux 6.0
+    NFD_LOG_DEBUG("Multishot receive is not supported, falling back to single-shot receive");
+    m_hasMultishotReceive = false;
+    if (op->callback) {
+      prepareReceive(id, op->fd);
+    }
+    else {
+      m_ops.erase(id);
+    }
+    return;
+  }
+
+  bool hasBuffer = (flags & IORING_CQE_F_BUFFER) != 0;
+  uint16_t bid = flags >> IORING_CQE_BUFFER_SHIFT;
+  if (op->callback && result != -ENOBUFS && result != -ECANCELED) {
+    const uint8_t* data = hasBuffer ? m_recvBuffers.data() + bid * RECV_BUFFER_SIZE : nullptr;
+    auto callback = op->callback;
+    callback(result, data);
+  }
+  if (hasBuffer) {
+    recycleRecvBuffer(bid);
+  }
+
+  if (!hasMore) {
+    // single-shot receive, or multishot receive terminated because the buffer ring or the
+    // completion queue ran out of space; a result of zero is EOF only on stream sockets
+    if (op->callback && (result > 0 || result == -ENOBUFS || (result == 0 && !op->isStream))) {
+      prepareReceive(id, op->fd);
+    }
+    else {
+      m_ops.erase(id);
+    }
+  }
+}
+
+static thread_local bool g_wantIoUring = false;
+static thread_local bool g_isIoUringUnavailable = false;
+static thread_local unique_ptr<IoUring> g_ioUring;
+
+void
+setGlobalIoUringEnabled(bool wantIoUring)
+{
+  g_wantIoUring = wantIoUring;
+}
+
+IoUring*
+getGlobalIoUring()
+{
+  if (!g_wantIoUring)
+    return nullptr;
+
+  if (g_ioUring == nullptr && !g_isIoUringUnavailable) {
+    try {
+      g_ioUring = make_unique<IoUring>(getGlobalIoService());
+    }
+    catch (const IoUring::Error& e) {
+      NFD_LOG_WARN("io_uring is not available, falling back to Boost.Asio: " << e.what());
+      g_isIoUringUnavailable = true;
+    }
+  }
+  return g_ioUring.get();
+}
+
+#ifdef WITH_TESTS
+void
+resetGlobalIoUring()
+{
+  g_ioUring.reset();
+  g_isIoUringUnavailable = false;
+}
+#endif
+
+} // namespace face
+} // namespace nfd
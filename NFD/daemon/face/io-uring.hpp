@@ -0,0 +1,237 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_IO_URING_HPP
+#define NFD_DAEMON_FACE_IO_URING_HPP
+
+#include "core/common.hpp"
+
+#ifndef HAVE_IO_URING
+#error "Cannot include this file when io_uring is not available"
+#endif
+
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <linux/io_uring.h>
+
+#include <unordered_map>
+
+namespace nfd {
+namespace face {
+
+/** \brief an io_uring instance shared by socket-based transports
+ *
+ *  Submissions are accumulated in the submission queue and handed to the kernel with a single
+ *  io_uring_enter(2) call per round of event processing. Completions are signaled through an
+ *  eventfd watched by the io_service, and are dispatched to the transports in batches.
+ *
+ *  Receive operations are multishot: a single submission delivers every incoming datagram or
+ *  stream segment, using buffers from a ring registered with the kernel. On kernels that
+ *  support provided buffer rings but not multishot receive (Linux 5.19), the receive operation
+ *  is resubmitted after each completion.
+ *
+ *  \note Requires Linux 5.19 or later.
+ */
+class IoUring : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /** \brief receives the result of an operation
+   *  \param result number of octets transferred, or negated errno value on failure
+   *  \param data received octets, or nullptr for send operations and failures;
+   *              valid only until the callback returns
+   */
+  using CompletionCallback = std::function<void(int result, const uint8_t* data)>;
+
+  /** \brief create an io_uring instance that dispatches completions on \p io
+   *  \throw Error io_uring is not supported or not permitted
+   */
+  explicit
+  IoUring(boost::asio::io_service& io);
+
+  ~IoUring();
+
+  /** \brief send \p packet on socket \p fd
+   *
+   *  \p packet is retained until the operation completes.
+   *  \param owner identifies the operation for cancel()
+   *  \param msgFlags flags passed to send(2)
+   */
+  void
+  send(const void* owner, int fd, const Block& packet, int msgFlags, CompletionCallback callback);
+
+  /** \brief send \p packets on socket \p fd in order, as a chain of linked operations
+   *
+   *  Each send starts only after the previous one has completed in full; if a send fails,
+   *  the remaining ones complete with -ECANCELED. \p callback is invoked once per packet.
+   *  \pre packets.size() <= MAX_CHAIN_LENGTH
+   */
+  void
+  sendChain(const void* owner, int fd, const std::vector<Block>& packets, int msgFlags,
+            const CompletionCallback& callback);
+
+  /** \brief start receiving on socket \p fd
+   *
+   *  \p callback is invoked for each datagram or stream segment, until it fails
+   *  (result <= 0) or the operation is cancelled.
+   */
+  void
+  receive(const void* owner, int fd, CompletionCallback callback);
+
+  /** \brief cancel all operations of \p owner
+   *
+   *  No callback of \p owner is invoked after this function returns.
+   */
+  void
+  cancel(const void* owner);
+
+  /** \brief hand all queued submissions to the kernel
+   */
+  void
+  submit();
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** \brief returns the number of operations that have not reached their final completion
+   */
+  size_t
+  getOperationCount() const
+  {
+    return m_ops.size();
+  }
+
+public:
+  static constexpr size_t SQ_ENTRIES = 1024;
+  static constexpr size_t CQ_ENTRIES = 8192;
+  static constexpr size_t MAX_CHAIN_LENGTH = 64;
+  static constexpr size_t N_RECV_BUFFERS = 1024;
+  static constexpr size_t RECV_BUFFER_SIZE = ndn::MAX_NDN_PACKET_SIZE;
+
+private:
+  struct Operation
+  {
+    const void* owner;
+    int fd;
+    CompletionCallback callback; ///< empty if cancelled
+    Block packet;
+    bool isReceive;
+    bool isStream;
+  };
+
+  void
+  close();
+
+  uint64_t
+  addOperation(const void* owner, int fd, CompletionCallback callback, const Block& packet, bool isReceive);
+
+  /** \brief obtain a zeroed submission queue entry, submitting queued entries if necessary
+   */
+  io_uring_sqe*
+  getSqe();
+
+  void
+  scheduleSubmit();
+
+  void
+  prepareReceive(uint64_t id, int fd);
+
+  void
+  recycleRecvBuffer(uint16_t bid);
+
+  void
+  asyncWaitCompletions();
+
+  void
+  handleCompletions();
+
+  void
+  dispatchCompletion(uint64_t id, int result, uint32_t flags);
+
+private:
+  int m_ringFd;
+  boost::asio::posix::stream_descriptor m_eventFd;
+
+  uint8_t* m_ringMap;
+  size_t m_ringMapSize;
+  io_uring_sqe* m_sqes;
+  size_t m_sqesSize;
+
+  uint32_t* m_sqHead;
+  uint32_t* m_sqTail;
+  uint32_t* m_sqArray;
+  uint32_t m_sqMask;
+  uint32_t m_sqEntries;
+  uint32_t m_sqLocalTail; ///< tail including entries not yet visible to the kernel
+
+  uint32_t* m_cqHead;
+  uint32_t* m_cqTail;
+  const io_uring_cqe* m_cqes;
+  uint32_t m_cqMask;
+
+  io_uring_buf_ring* m_bufRing;
+  size_t m_bufRingSize;
+  std::vector<uint8_t> m_recvBuffers;
+  uint16_t m_bufRingTail;
+
+  bool m_hasMultishotReceive;
+  bool m_isSubmitPending;
+
+  std::unordered_map<uint64_t, Operation> m_ops; ///< user_data => in-flight operation
+  uint64_t m_lastOpId;
+};
+
+/** \brief enable or disable the io_uring backend for transports created afterwards
+ */
+void
+setGlobalIoUringEnabled(bool wantIoUring);
+
+/** \brief returns the io_uring instance of the current thread, creating it on first use
+ *  \return nullptr if the io_uring backend is disabled, or if io_uring is not available
+ *          on the running kernel, in which case transports use Boost.Asio
+ */
+IoUring*
+getGlobalIoUring();
+
+#ifdef WITH_TESTS
+/** \brief destroy the io_uring instance of the current thread
+ *
+ *  It will be recreated at the next invocation of getGlobalIoUring().
+ *  This must be called before resetGlobalIoService().
+ */
+void
+resetGlobalIoUring();
+#endif
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_IO_URING_HPP
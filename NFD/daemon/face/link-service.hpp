@@ -30,11 +30,40 @@
 #include "face-log.hpp"
 #include "transport.hpp"
 
+#include <ndn-cxx/tag.hpp>
+#include <ndn-cxx/lp/empty-value.hpp>
+
 namespace nfd {
 namespace face {
 
 class Face;
 
+/** \brief a packet tag that carries the time at which the packet arrived at the transport
+ *
+ *  GenericLinkService attaches this tag to every incoming Interest, Data, and Nack.
+ *  RTT measurements should be taken against this time rather than the current time,
+ *  so that they exclude queueing in the event loop and the forwarding pipelines.
+ */
+using RxTimestampTag = ndn::SimpleTag<time::steady_clock::TimePoint, 21>;
+
+/** \brief a packet tag that asks GenericLinkService to send a Data with CachePolicy=NoCache
+ *
+ *  This tag is attached only by the forwarder itself, e.g., by a CS admission policy.
+ *  A CachePolicy received from upstream is carried in lp::CachePolicyTag instead,
+ *  and is not forwarded.
+ */
+using NoCacheMarkTag = ndn::SimpleTag<lp::EmptyValue, 22>;
+
+/** \return the time carried in \p pkt's RxTimestampTag, or the current time if there is none
+ */
+template<typename Packet>
+time::steady_clock::TimePoint
+getRxTime(const Packet& pkt)
+{
+  auto tag = pkt.template getTag<RxTimestampTag>();
+  return tag == nullptr ? time::steady_clock::now() : tag->get();
+}
+
 /** \brief counters provided by LinkService
  *  \note The type name 'LinkServiceCounters' is implementation detail.
  *        Use 'LinkService::Counters' in public API.
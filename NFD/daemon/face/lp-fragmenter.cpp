@@ -89,20 +89,30 @@ LpFragmenter::fragmentPacket(const lp::Packet& packet, size_t mtu)
     return std::make_tuple(true, std::vector<lp::Packet>{packet});
   }
 
-  ndn::Buffer::const_iterator netPktBegin, netPktEnd;
-  std::tie(netPktBegin, netPktEnd) = packet.get<lp::FragmentField>();
-  size_t netPktSize = std::distance(netPktBegin, netPktEnd);
-
-  // compute size of other NDNLPv2 headers to be placed on the first fragment
-  size_t firstHeaderSize = 0;
+  // locate the network packet and other NDNLPv2 headers to be placed on the first fragment
   const Block& packetWire = packet.wireEncode();
+  size_t firstHeaderSize = 0;
+  ndn::ConstBufferPtr netPktBuffer;
+  ndn::Buffer::const_iterator netPktBegin, netPktEnd;
   if (packetWire.type() == lp::tlv::LpPacket) {
     for (const Block& element : packetWire.elements()) {
-      if (element.type() != lp::tlv::Fragment) {
+      if (element.type() == lp::tlv::Fragment) {
+        netPktBuffer = element.getBuffer();
+        netPktBegin = element.value_begin();
+        netPktEnd = element.value_end();
+      }
+      else {
         firstHeaderSize += element.size();
       }
     }
   }
+  else {
+    netPktBuffer = packetWire.getBuffer();
+    netPktBegin = packetWire.begin();
+    netPktEnd = packetWire.end();
+  }
+  BOOST_ASSERT(netPktBuffer != nullptr);
+  size_t netPktSize = std::distance(netPktBegin, netPktEnd);
 
   // compute payload size
   if (MAX_FRAG_OVERHEAD + firstHeaderSize + 1 > mtu) { // 1-octet fragment
@@ -121,16 +131,29 @@ LpFragmenter::fragmentPacket(const lp::Packet& packet, size_t mtu)
   }
 
   // populate fragments
-  std::vector<lp::Packet> frags(fragCount);
-  frags.front() = packet; // copy input packet to preserve other NDNLPv2 fields
+  // Each Fragment field references its slice of the network packet buffer instead of copying it,
+  // so that payload octets are copied only once, when the fragment is encoded for transmission.
+  std::vector<lp::Packet> frags;
+  frags.reserve(fragCount);
   size_t fragIndex = 0;
   auto fragBegin = netPktBegin,
        fragEnd = fragBegin + firstPayloadSize;
   while (fragBegin < netPktEnd) {
-    lp::Packet& frag = frags[fragIndex];
+    Block fragWire(lp::tlv::LpPacket);
+    if (fragIndex == 0 && packetWire.type() == lp::tlv::LpPacket) {
+      // preserve other NDNLPv2 fields on the first fragment
+      for (const Block& element : packetWire.elements()) {
+        if (element.type() != lp::tlv::Fragment) {
+          fragWire.push_back(element);
+        }
+      }
+    }
+    fragWire.push_back(Block(lp::tlv::Fragment, netPktBuffer, fragBegin, fragEnd));
+
+    frags.emplace_back(fragWire);
+    lp::Packet& frag = frags.back();
     frag.add<lp::FragIndexField>(fragIndex);
     frag.add<lp::FragCountField>(fragCount);
-    frag.set<lp::FragmentField>({fragBegin, fragEnd});
     BOOST_ASSERT(frag.wireEncode().size() <= mtu);
 
     ++fragIndex;
@@ -139,7 +162,7 @@ LpFragmenter::fragmentPacket(const lp::Packet& packet, size_t mtu)
   }
   BOOST_ASSERT(fragIndex == fragCount);
 
-  return std::make_tuple(true, frags);
+  return std::make_tuple(true, std::move(frags));
 }
 
 std::ostream&
@@ -27,7 +27,7 @@
 #include "link-service.hpp"
 #include "daemon/global.hpp"
 
-#include <numeric>
+#include <boost/functional/hash.hpp>
 
 namespace nfd {
 namespace face {
@@ -40,6 +40,22 @@ LpReassembler::LpReassembler(const LpReassembler::Options& options, const LinkSe
 {
 }
 
+constexpr size_t LpReassembler::NOT_RECEIVED;
+
+/** \brief maximum number of idle reassembly buffers kept for reuse
+ */
+static constexpr size_t MAX_POOLED_BUFFERS = 16;
+
+/** \brief whether a reassembly buffer is small enough to be handed out as the network-layer packet
+ *
+ *  A buffer with much unused capacity would stay pinned as long as the packet, e.g. in the CS.
+ */
+static bool
+isCompactBuffer(const ndn::Buffer& buffer)
+{
+  return buffer.capacity() - buffer.size() <= buffer.size() / 8;
+}
+
 std::tuple<bool, Block, lp::Packet>
 LpReassembler::receiveFragment(EndpointId remoteEndpoint, const lp::Packet& packet)
 {
@@ -67,11 +83,13 @@ LpReassembler::receiveFragment(EndpointId remoteEndpoint, const lp::Packet& pack
     return FALSE_RETURN;
   }
 
+  ndn::Buffer::const_iterator fragBegin, fragEnd;
+  std::tie(fragBegin, fragEnd) = packet.get<lp::FragmentField>();
+  size_t fragSize = std::distance(fragBegin, fragEnd);
+
   // check for fast path
   if (fragIndex == 0 && fragCount == 1) {
-    ndn::Buffer::const_iterator fragBegin, fragEnd;
-    std::tie(fragBegin, fragEnd) = packet.get<lp::FragmentField>();
-    Block netPkt(&*fragBegin, std::distance(fragBegin, fragEnd));
+    Block netPkt(&*fragBegin, fragSize);
     return std::make_tuple(true, netPkt, packet);
   }
 
@@ -83,34 +101,62 @@ LpReassembler::receiveFragment(EndpointId remoteEndpoint, const lp::Packet& pack
   lp::Sequence messageIdentifier = packet.get<lp::SequenceField>() - fragIndex;
   Key key = std::make_tuple(remoteEndpoint, messageIdentifier);
 
-  // add to PartialPacket
-  PartialPacket& pp = m_partialPackets[key];
-  if (pp.fragCount == 0) { // new PartialPacket
+  // buffer space is accounted by received payload, so that FragCount cannot inflate it
+  if (m_bufferedSize + fragSize > m_options.bufferLimit) {
+    NFD_LOG_FACE_WARN("reassembly error, buffer limit exceeded: DROP");
+    this->onBufferLimitExceeded(remoteEndpoint);
+    return FALSE_RETURN;
+  }
+
+  // find or create PartialPacket
+  auto it = m_partialPackets.find(key);
+  if (it == m_partialPackets.end()) {
+    // Every fragment of a packet fits in the link MTU, so FragCount times the size of
+    // this fragment is usually enough to hold the whole network-layer packet.
+    // FragCount comes from the peer, so the reservation is capped at the max packet size.
+    size_t capacity = std::min<size_t>(fragCount * fragSize, ndn::MAX_NDN_PACKET_SIZE);
+
+    it = m_partialPackets.emplace(key, PartialPacket()).first;
+    PartialPacket& pp = it->second;
+    pp.buffer = allocateBuffer(capacity);
+    pp.bufferedSize = 0;
+    pp.fragments.resize(fragCount);
     pp.fragCount = fragCount;
     pp.nReceivedFragments = 0;
-    pp.fragments.resize(fragCount);
+    pp.isInOrder = true;
   }
-  else {
-    if (fragCount != pp.fragCount) {
-      NFD_LOG_FACE_WARN("reassembly error, FragCount changed: DROP");
-      return FALSE_RETURN;
-    }
+  PartialPacket& pp = it->second;
+
+  if (fragCount != pp.fragCount) {
+    NFD_LOG_FACE_WARN("reassembly error, FragCount changed: DROP");
+    return FALSE_RETURN;
   }
 
-  if (pp.fragments[fragIndex].has<lp::SequenceField>()) {
+  FragmentSpan& span = pp.fragments[fragIndex];
+  if (span.offset != NOT_RECEIVED) {
     NFD_LOG_FACE_TRACE("fragment already received: DROP");
     return FALSE_RETURN;
   }
 
-  pp.fragments[fragIndex] = packet;
+  // append payload to reassembly buffer
+  span.offset = pp.buffer->size();
+  span.length = fragSize;
+  pp.buffer->insert(pp.buffer->end(), fragBegin, fragEnd);
+  pp.bufferedSize += fragSize;
+  m_bufferedSize += fragSize;
+
+  pp.isInOrder = pp.isInOrder && fragIndex == pp.nReceivedFragments;
+  if (fragIndex == 0) {
+    pp.firstFragment = packet;
+  }
   ++pp.nReceivedFragments;
 
   // check complete condition
   if (pp.nReceivedFragments == pp.fragCount) {
-    Block reassembled = doReassembly(key);
-    lp::Packet firstFrag(std::move(pp.fragments[0]));
-    m_partialPackets.erase(key);
-    return std::make_tuple(true, reassembled, firstFrag);
+    auto reassembled = doReassembly(pp);
+    lp::Packet firstFrag(std::move(pp.firstFragment));
+    erasePartialPacket(it);
+    return std::make_tuple(true, Block(reassembled), firstFrag);
   }
 
   // set drop timer
@@ -119,28 +165,21 @@ LpReassembler::receiveFragment(EndpointId remoteEndpoint, const lp::Packet& pack
   return FALSE_RETURN;
 }
 
-Block
-LpReassembler::doReassembly(const Key& key)
+ndn::ConstBufferPtr
+LpReassembler::doReassembly(PartialPacket& pp)
 {
-  PartialPacket& pp = m_partialPackets[key];
-
-  size_t payloadSize = std::accumulate(pp.fragments.begin(), pp.fragments.end(), 0U,
-    [&] (size_t sum, const lp::Packet& pkt) -> size_t {
-      ndn::Buffer::const_iterator fragBegin, fragEnd;
-      std::tie(fragBegin, fragEnd) = pkt.get<lp::FragmentField>();
-      return sum + std::distance(fragBegin, fragEnd);
-    });
-
-  ndn::Buffer fragBuffer(payloadSize);
-  auto it = fragBuffer.begin();
-
-  for (const lp::Packet& frag : pp.fragments) {
-    ndn::Buffer::const_iterator fragBegin, fragEnd;
-    std::tie(fragBegin, fragEnd) = frag.get<lp::FragmentField>();
-    it = std::copy(fragBegin, fragEnd, it);
+  if (pp.isInOrder && isCompactBuffer(*pp.buffer)) {
+    // the reassembly buffer already contains the network-layer packet
+    return std::move(pp.buffer);
   }
 
-  return Block(&*(fragBuffer.cbegin()), std::distance(fragBuffer.cbegin(), fragBuffer.cend()));
+  auto buffer = make_shared<ndn::Buffer>(pp.buffer->size());
+  auto out = buffer->begin();
+  for (const FragmentSpan& span : pp.fragments) {
+    auto in = pp.buffer->cbegin() + span.offset;
+    out = std::copy(in, in + span.length, out);
+  }
+  return buffer;
 }
 
 void
@@ -152,9 +191,56 @@ LpReassembler::timeoutPartialPacket(const Key& key)
   }
 
   this->beforeTimeout(std::get<0>(key), it->second.nReceivedFragments);
+  erasePartialPacket(it);
+}
+
+void
+LpReassembler::erasePartialPacket(PartialPacketTable::iterator it)
+{
+  PartialPacket& pp = it->second;
+  BOOST_ASSERT(m_bufferedSize >= pp.bufferedSize);
+  m_bufferedSize -= pp.bufferedSize;
+  if (pp.buffer != nullptr) {
+    releaseBuffer(std::move(pp.buffer));
+  }
   m_partialPackets.erase(it);
 }
 
+shared_ptr<ndn::Buffer>
+LpReassembler::allocateBuffer(size_t capacity)
+{
+  shared_ptr<ndn::Buffer> buffer;
+  if (m_bufferPool.empty()) {
+    buffer = make_shared<ndn::Buffer>();
+  }
+  else {
+    buffer = std::move(m_bufferPool.back());
+    m_bufferPool.pop_back();
+  }
+  buffer->reserve(capacity);
+  return buffer;
+}
+
+void
+LpReassembler::releaseBuffer(shared_ptr<ndn::Buffer> buffer)
+{
+  if (m_bufferPool.size() >= MAX_POOLED_BUFFERS || buffer.use_count() > 1 ||
+      buffer->capacity() > ndn::MAX_NDN_PACKET_SIZE) {
+    return;
+  }
+  buffer->clear();
+  m_bufferPool.push_back(std::move(buffer));
+}
+
+size_t
+LpReassembler::KeyHash::operator()(const Key& key) const noexcept
+{
+  size_t seed = 0;
+  boost::hash_combine(seed, std::get<0>(key));
+  boost::hash_combine(seed, std::get<1>(key));
+  return seed;
+}
+
 std::ostream&
 operator<<(std::ostream& os, const FaceLogHelper<LpReassembler>& flh)
 {
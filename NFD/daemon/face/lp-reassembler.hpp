@@ -31,6 +31,8 @@
 
 #include <ndn-cxx/lp/packet.hpp>
 
+#include <unordered_map>
+
 namespace nfd {
 namespace face {
 
@@ -55,6 +57,12 @@ public:
     /** \brief timeout before a partially reassembled packet is dropped
      */
     time::nanoseconds reassemblyTimeout = 500_ms;
+
+    /** \brief maximum total size of fragment payloads held by partial packets, in octets
+     *
+     *  A fragment is dropped if its payload does not fit within this limit.
+     */
+    size_t bufferLimit = 16 * 1024 * 1024;
   };
 
   explicit
@@ -89,6 +97,11 @@ public:
   size_t
   size() const;
 
+  /** \brief total size of fragment payloads held by partial packets, in octets
+   */
+  size_t
+  getBufferedSize() const;
+
   /** \brief signals before a partial packet is dropped due to timeout
    *
    *  If a partial packet is incomplete and no new fragment is received
@@ -98,14 +111,37 @@ public:
    */
   signal::Signal<LpReassembler, EndpointId, size_t> beforeTimeout;
 
+  /** \brief signals when a fragment is dropped because Options::bufferLimit is reached
+   *
+   *  This signal is emitted with the remote endpoint of the dropped fragment.
+   */
+  signal::Signal<LpReassembler, EndpointId> onBufferLimitExceeded;
+
 private:
-  /** \brief holds all fragments of packet until reassembled
+  static constexpr size_t NOT_RECEIVED = std::numeric_limits<size_t>::max();
+
+  /** \brief position of a fragment payload within the reassembly buffer
+   */
+  struct FragmentSpan
+  {
+    size_t offset = NOT_RECEIVED;
+    size_t length = 0;
+  };
+
+  /** \brief holds fragment payloads of a packet until reassembled
+   *
+   *  Payloads are appended to a single buffer in arrival order. When fragments arrive
+   *  in order, the buffer holds the network-layer packet once the last fragment is added.
    */
   struct PartialPacket
   {
-    std::vector<lp::Packet> fragments;
+    shared_ptr<ndn::Buffer> buffer; ///< fragment payloads in arrival order
+    size_t bufferedSize; ///< payload octets accounted against Options::bufferLimit
+    std::vector<FragmentSpan> fragments; ///< payload position, indexed by FragIndex
+    lp::Packet firstFragment;
     size_t fragCount; ///< total fragments
     size_t nReceivedFragments; ///< number of received fragments
+    bool isInOrder; ///< whether fragments have been received in FragIndex order
     scheduler::ScopedEventId dropTimer;
   };
 
@@ -116,16 +152,37 @@ private:
     lp::Sequence // message identifier (sequence of the first fragment)
   > Key;
 
-  Block
-  doReassembly(const Key& key);
+  struct KeyHash
+  {
+    size_t
+    operator()(const Key& key) const noexcept;
+  };
+
+  using PartialPacketTable = std::unordered_map<Key, PartialPacket, KeyHash>;
+
+  /** \return buffer containing the network-layer packet
+   */
+  ndn::ConstBufferPtr
+  doReassembly(PartialPacket& pp);
 
   void
   timeoutPartialPacket(const Key& key);
 
+  void
+  erasePartialPacket(PartialPacketTable::iterator it);
+
+  shared_ptr<ndn::Buffer>
+  allocateBuffer(size_t capacity);
+
+  void
+  releaseBuffer(shared_ptr<ndn::Buffer> buffer);
+
 private:
   Options m_options;
   const LinkService* m_linkService;
-  std::map<Key, PartialPacket> m_partialPackets;
+  PartialPacketTable m_partialPackets;
+  size_t m_bufferedSize = 0;
+  std::vector<shared_ptr<ndn::Buffer>> m_bufferPool;
 };
 
 std::ostream&
@@ -149,6 +206,12 @@ LpReassembler::size() const
   return m_partialPackets.size();
 }
 
+inline size_t
+LpReassembler::getBufferedSize() const
+{
+  return m_bufferedSize;
+}
+
 } // namespace face
 } // namespace nfd
 
@@ -34,9 +34,9 @@ namespace face {
 LpReliability::LpReliability(const LpReliability::Options& options, GenericLinkService* linkService)
   : m_options(options)
   , m_linkService(linkService)
-  , m_firstUnackedFrag(m_unackedFrags.begin())
   , m_lastTxSeqNo(-1) // set to "-1" to start TxSequence numbers at 0
   , m_isIdleAckTimerRunning(false)
+  , m_isRtoTimerRunning(false)
 {
   BOOST_ASSERT(m_linkService != nullptr);
   BOOST_ASSERT(m_options.idleAckTimerPeriod > 0_ns);
@@ -65,81 +65,68 @@ LpReliability::handleOutgoing(std::vector<lp::Packet>& frags, lp::Packet&& pkt,
 {
   BOOST_ASSERT(m_options.isEnabled);
 
-  auto unackedFragsIt = m_unackedFrags.begin();
   auto sendTime = time::steady_clock::now();
+  auto rtoExpiry = sendTime + m_rto.computeRto();
 
-  auto netPkt = make_shared<NetPkt>(std::move(pkt), isInterest);
-  netPkt->unackedFrags.reserve(frags.size());
+  NetPkt* netPkt = this->allocNetPkt(std::move(pkt), isInterest);
 
   for (lp::Packet& frag : frags) {
     // Assign TxSequence number
     lp::Sequence txSeq = assignTxSequence(frag);
 
     // Store LpPacket for future retransmissions
-    unackedFragsIt = m_unackedFrags.emplace_hint(unackedFragsIt,
-                                                 std::piecewise_construct,
-                                                 std::forward_as_tuple(txSeq),
-                                                 std::forward_as_tuple(frag));
-    unackedFragsIt->second.sendTime = sendTime;
-    unackedFragsIt->second.rtoTimer = getScheduler().schedule(m_rto.computeRto(),
-                                                              [=] { onLpPacketLost(txSeq); });
-    unackedFragsIt->second.netPkt = netPkt;
-
-    if (m_unackedFrags.size() == 1) {
-      m_firstUnackedFrag = m_unackedFrags.begin();
-    }
+    UnackedFrag& unackedFrag = m_unackedFrags.insert(txSeq, frag);
+    unackedFrag.sendTime = sendTime;
+    unackedFrag.rtoExpiry = rtoExpiry;
+    unackedFrag.netPkt = netPkt;
 
     // Add to associated NetPkt
-    netPkt->unackedFrags.push_back(unackedFragsIt);
+    netPkt->unackedFrags.push_back(txSeq);
   }
+
+  this->scheduleRtoTimer();
 }
 
 void
-LpReliability::processIncomingPacket(const lp::Packet& pkt)
+LpReliability::processIncomingPacket(const lp::Packet& pkt, time::steady_clock::TimePoint rxTime)
 {
   BOOST_ASSERT(m_options.isEnabled);
 
-  auto now = time::steady_clock::now();
-
   // Extract and parse Acks
-  for (lp::Sequence ackSeq : pkt.list<lp::AckField>()) {
-    auto fragIt = m_unackedFrags.find(ackSeq);
-    if (fragIt == m_unackedFrags.end()) {
-      // Ignore an Ack for an unknown TxSequence number
-      continue;
-    }
-    auto& frag = fragIt->second;
+  if (pkt.has<lp::AckField>() && !m_unackedFrags.empty()) {
+    lp::Sequence windowBegin = m_unackedFrags.getFirstTxSeq();
+    m_ackOffsets.clear();
+
+    for (lp::Sequence ackSeq : pkt.list<lp::AckField>()) {
+      UnackedFrag* frag = m_unackedFrags.find(ackSeq);
+      if (frag == nullptr) {
+        // Ignore an Ack for an unknown TxSequence number
+        continue;
+      }
 
-    // Cancel the RTO timer for the acknowledged fragment
-    frag.rtoTimer.cancel();
+      if (frag->retxCount == 0) {
+        // This sequence had no retransmissions, so use it to calculate the RTO
+        auto rtt = std::max(rxTime - frag->sendTime, time::steady_clock::duration::zero());
+        m_rto.addMeasurement(time::duration_cast<RttEstimator::Duration>(rtt));
+      }
 
-    if (frag.retxCount == 0) {
-      // This sequence had no retransmissions, so use it to calculate the RTO
-      m_rto.addMeasurement(time::duration_cast<RttEstimator::Duration>(now - frag.sendTime));
+      // Remove the fragment from the window of unacknowledged fragments and from its associated
+      // network packet. Potentially increment the start of the window.
+      m_ackOffsets.push_back(ackSeq - windowBegin);
+      this->onLpPacketAcknowledged(ackSeq);
     }
 
-    // Look for frags with TxSequence numbers < ackSeq (allowing for wraparound) and consider them
-    // lost if a configurable number of Acks containing greater TxSequence numbers have been
-    // received.
-    auto lostLpPackets = findLostLpPackets(fragIt);
-
-    // Remove the fragment from the map of unacknowledged fragments and from its associated network
-    // packet. Potentially increment the start of the window.
-    onLpPacketAcknowledged(fragIt);
-
-    // This set contains TxSequences that have been removed by onLpPacketLost below because they
-    // were part of a network packet that was removed due to a fragment exceeding retx, as well as
-    // any other TxSequences removed by onLpPacketLost. This prevents onLpPacketLost from being
-    // called later for an invalid iterator.
-    std::set<lp::Sequence> removedLpPackets;
+    // Look for frags with TxSequence numbers less than acknowledged ones (allowing for
+    // wraparound) and consider them lost if a configurable number of Acks containing greater
+    // TxSequence numbers have been received.
+    this->findLostLpPackets(windowBegin);
 
     // Resend or fail fragments considered lost. Potentially increment the start of the window.
-    for (lp::Sequence txSeq : lostLpPackets) {
-      if (removedLpPackets.find(txSeq) == removedLpPackets.end()) {
-        auto removedThisTxSeq = this->onLpPacketLost(txSeq);
-        for (auto removedTxSeq : removedThisTxSeq) {
-          removedLpPackets.insert(removedTxSeq);
-        }
+    for (lp::Sequence txSeq : m_lostLpPackets) {
+      // A lost fragment may have been removed by onLpPacketLost together with its network
+      // packet, after another fragment of the same network packet exceeded retx.
+      if (m_unackedFrags.count(txSeq) > 0) {
+        this->onLpPacketLost(txSeq);
       }
     }
   }
@@ -188,7 +175,7 @@ LpReliability::assignTxSequence(lp::Packet& frag)
 {
   lp::Sequence txSeq = ++m_lastTxSeqNo;
   frag.set<lp::TxSequenceField>(txSeq);
-  if (m_unackedFrags.size() > 0 && m_lastTxSeqNo == m_firstUnackedFrag->first) {
+  if (!m_unackedFrags.empty() && m_lastTxSeqNo == m_unackedFrags.getFirstTxSeq()) {
     NDN_THROW(std::length_error("TxSequence range exceeded"));
   }
   return m_lastTxSeqNo;
@@ -216,50 +203,85 @@ LpReliability::stopIdleAckTimer()
   m_isIdleAckTimerRunning = false;
 }
 
-std::vector<lp::Sequence>
-LpReliability::findLostLpPackets(LpReliability::UnackedFrags::iterator ackIt)
+void
+LpReliability::scheduleRtoTimer()
 {
-  std::vector<lp::Sequence> lostLpPackets;
+  if (m_unackedFrags.empty()) {
+    return;
+  }
 
-  for (auto it = m_firstUnackedFrag; ; ++it) {
-    if (it == m_unackedFrags.end()) {
-      it = m_unackedFrags.begin();
-    }
+  auto expiry = m_unackedFrags.at(m_unackedFrags.getFirstTxSeq()).rtoExpiry;
+  if (m_isRtoTimerRunning && m_rtoTimerExpiry <= expiry) {
+    return;
+  }
+
+  m_isRtoTimerRunning = true;
+  m_rtoTimerExpiry = expiry;
+  auto delay = std::max(expiry - time::steady_clock::now(), time::steady_clock::duration::zero());
+  m_rtoTimer = getScheduler().schedule(delay, [this] { onRtoTimeout(); });
+}
+
+void
+LpReliability::onRtoTimeout()
+{
+  auto now = time::steady_clock::now();
 
-    if (it->first == ackIt->first) {
+  // m_isRtoTimerRunning remains true until the loop ends, so that onLpPacketLost does not
+  // reschedule the timer for each retransmission
+  while (!m_unackedFrags.empty()) {
+    lp::Sequence txSeq = m_unackedFrags.getFirstTxSeq();
+    if (m_unackedFrags.at(txSeq).rtoExpiry > now) {
       break;
     }
+    this->onLpPacketLost(txSeq);
+  }
 
-    auto& unackedFrag = it->second;
-    unackedFrag.nGreaterSeqAcks++;
+  m_isRtoTimerRunning = false;
+  this->scheduleRtoTimer();
+}
 
-    if (unackedFrag.nGreaterSeqAcks >= m_options.seqNumLossThreshold) {
-      lostLpPackets.push_back(it->first);
-    }
+void
+LpReliability::findLostLpPackets(lp::Sequence windowBegin)
+{
+  m_lostLpPackets.clear();
+  if (m_ackOffsets.empty() || m_unackedFrags.empty()) {
+    return;
   }
 
-  return lostLpPackets;
+  std::sort(m_ackOffsets.begin(), m_ackOffsets.end());
+  auto greaterAckIt = m_ackOffsets.begin();
+
+  for (uint64_t offset = m_unackedFrags.getFirstTxSeq() - windowBegin;
+       offset < m_ackOffsets.back(); ++offset) {
+    lp::Sequence txSeq = windowBegin + offset;
+    UnackedFrag* frag = m_unackedFrags.find(txSeq);
+    if (frag == nullptr) {
+      continue;
+    }
+
+    while (*greaterAckIt < offset) {
+      ++greaterAckIt;
+    }
+    frag->nGreaterSeqAcks += std::distance(greaterAckIt, m_ackOffsets.end());
+
+    if (frag->nGreaterSeqAcks >= m_options.seqNumLossThreshold) {
+      m_lostLpPackets.push_back(txSeq);
+    }
+  }
 }
 
-std::vector<lp::Sequence>
+void
 LpReliability::onLpPacketLost(lp::Sequence txSeq)
 {
-  BOOST_ASSERT(m_unackedFrags.count(txSeq) > 0);
-  auto txSeqIt = m_unackedFrags.find(txSeq);
-
-  auto& txFrag = txSeqIt->second;
-  txFrag.rtoTimer.cancel();
-  auto netPkt = txFrag.netPkt;
-  std::vector<lp::Sequence> removedThisTxSeq;
+  UnackedFrag* txFrag = m_unackedFrags.find(txSeq);
+  BOOST_ASSERT(txFrag != nullptr);
+  NetPkt* netPkt = txFrag->netPkt;
 
   // Check if maximum number of retransmissions exceeded
-  if (txFrag.retxCount >= m_options.maxRetx) {
-    // Delete all LpPackets of NetPkt from m_unackedFrags (except this one)
-    for (size_t i = 0; i < netPkt->unackedFrags.size(); i++) {
-      if (netPkt->unackedFrags[i] != txSeqIt) {
-        removedThisTxSeq.push_back(netPkt->unackedFrags[i]->first);
-        deleteUnackedFrag(netPkt->unackedFrags[i]);
-      }
+  if (txFrag->retxCount >= m_options.maxRetx) {
+    // Delete all LpPackets of NetPkt from m_unackedFrags (including this one)
+    for (lp::Sequence fragTxSeq : netPkt->unackedFrags) {
+      m_unackedFrags.erase(fragTxSeq);
     }
 
     ++m_linkService->nRetxExhausted;
@@ -273,51 +295,45 @@ LpReliability::onLpPacketLost(lp::Sequence txSeq)
       onDroppedInterest(Interest(frag));
     }
 
-    removedThisTxSeq.push_back(txSeqIt->first);
-    deleteUnackedFrag(txSeqIt);
+    this->releaseNetPkt(netPkt);
   }
   else {
+    // Remove fragment from old TxSequence, because insertion may reallocate the window
+    lp::Packet pkt = std::move(txFrag->pkt);
+    size_t retxCount = txFrag->retxCount + 1;
+    m_unackedFrags.erase(txSeq);
+
     // Assign new TxSequence
-    lp::Sequence newTxSeq = assignTxSequence(txFrag.pkt);
+    lp::Sequence newTxSeq = assignTxSequence(pkt);
     netPkt->didRetx = true;
 
-    // Move fragment to new TxSequence mapping
-    auto newTxFragIt = m_unackedFrags.emplace_hint(
-      m_firstUnackedFrag != m_unackedFrags.end() && m_firstUnackedFrag->first > newTxSeq
-        ? m_firstUnackedFrag
-        : m_unackedFrags.end(),
-      std::piecewise_construct,
-      std::forward_as_tuple(newTxSeq),
-      std::forward_as_tuple(txFrag.pkt));
-    auto& newTxFrag = newTxFragIt->second;
-    newTxFrag.retxCount = txFrag.retxCount + 1;
+    // Move fragment to new TxSequence
+    UnackedFrag& newTxFrag = m_unackedFrags.insert(newTxSeq, pkt);
+    newTxFrag.sendTime = time::steady_clock::now();
+    newTxFrag.rtoExpiry = newTxFrag.sendTime + m_rto.computeRto();
+    newTxFrag.retxCount = retxCount;
     newTxFrag.netPkt = netPkt;
 
     // Update associated NetPkt
-    auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeqIt);
+    auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeq);
     BOOST_ASSERT(fragInNetPkt != netPkt->unackedFrags.end());
-    *fragInNetPkt = newTxFragIt;
-
-    removedThisTxSeq.push_back(txSeqIt->first);
-    deleteUnackedFrag(txSeqIt);
+    *fragInNetPkt = newTxSeq;
 
     // Retransmit fragment
-    m_linkService->sendLpPacket(lp::Packet(newTxFrag.pkt));
-
-    // Start RTO timer for this sequence
-    newTxFrag.rtoTimer = getScheduler().schedule(m_rto.computeRto(), [=] { onLpPacketLost(newTxSeq); });
+    m_linkService->sendLpPacket(std::move(pkt), netPkt->isInterest ? EgressScheduler::TrafficClass::INTEREST :
+                                                                     EgressScheduler::TrafficClass::DATA);
   }
 
-  return removedThisTxSeq;
+  this->scheduleRtoTimer();
 }
 
 void
-LpReliability::onLpPacketAcknowledged(UnackedFrags::iterator fragIt)
+LpReliability::onLpPacketAcknowledged(lp::Sequence txSeq)
 {
-  auto netPkt = fragIt->second.netPkt;
+  NetPkt* netPkt = m_unackedFrags.at(txSeq).netPkt;
 
   // Remove from NetPkt unacked fragment list
-  auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), fragIt);
+  auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeq);
   BOOST_ASSERT(fragInNetPkt != netPkt->unackedFrags.end());
   *fragInNetPkt = netPkt->unackedFrags.back();
   netPkt->unackedFrags.pop_back();
@@ -330,45 +346,137 @@ LpReliability::onLpPacketAcknowledged(UnackedFrags::iterator fragIt)
     else {
       ++m_linkService->nAcknowledged;
     }
+    this->releaseNetPkt(netPkt);
   }
 
-  deleteUnackedFrag(fragIt);
+  m_unackedFrags.erase(txSeq);
+}
+
+LpReliability::NetPkt*
+LpReliability::allocNetPkt(lp::Packet&& pkt, bool isInterest)
+{
+  NetPkt* netPkt = nullptr;
+  if (m_freeNetPkts.empty()) {
+    m_netPkts.push_back(make_unique<NetPkt>());
+    netPkt = m_netPkts.back().get();
+  }
+  else {
+    netPkt = m_freeNetPkts.back();
+    m_freeNetPkts.pop_back();
+  }
+
+  netPkt->pkt = std::move(pkt);
+  netPkt->isInterest = isInterest;
+  netPkt->didRetx = false;
+  return netPkt;
 }
 
 void
-LpReliability::deleteUnackedFrag(UnackedFrags::iterator fragIt)
+LpReliability::releaseNetPkt(NetPkt* netPkt)
 {
-  lp::Sequence firstUnackedTxSeq = m_firstUnackedFrag->first;
-  lp::Sequence currentTxSeq = fragIt->first;
-  auto nextFragIt = m_unackedFrags.erase(fragIt);
-
-  if (!m_unackedFrags.empty() && firstUnackedTxSeq == currentTxSeq) {
-    // If "first" fragment in send window (allowing for wraparound), increment window begin
-    if (nextFragIt == m_unackedFrags.end()) {
-      m_firstUnackedFrag = m_unackedFrags.begin();
-    }
-    else {
-      m_firstUnackedFrag = nextFragIt;
-    }
+  // unackedFrags keeps its capacity for the next network packet
+  netPkt->unackedFrags.clear();
+  netPkt->pkt = lp::Packet();
+  m_freeNetPkts.push_back(netPkt);
+}
+
+static constexpr size_t INITIAL_WINDOW_CAPACITY = 64;
+
+LpReliability::UnackedFrags::UnackedFrags()
+  : m_slots(INITIAL_WINDOW_CAPACITY)
+  , m_begin(0)
+  , m_end(0)
+  , m_size(0)
+{
+}
+
+LpReliability::UnackedFrag*
+LpReliability::UnackedFrags::find(lp::Sequence txSeq)
+{
+  return const_cast<UnackedFrag*>(const_cast<const UnackedFrags*>(this)->find(txSeq));
+}
+
+const LpReliability::UnackedFrag*
+LpReliability::UnackedFrags::find(lp::Sequence txSeq) const
+{
+  // unsigned subtraction also rejects TxSequences before m_begin
+  if (txSeq - m_begin >= m_end - m_begin) {
+    return nullptr;
   }
-  else if (m_unackedFrags.empty()) {
-    m_firstUnackedFrag = m_unackedFrags.end();
+
+  const UnackedFrag& slot = m_slots[txSeq & (m_slots.size() - 1)];
+  return slot.netPkt == nullptr ? nullptr : &slot;
+}
+
+LpReliability::UnackedFrag&
+LpReliability::UnackedFrags::at(lp::Sequence txSeq)
+{
+  UnackedFrag* frag = this->find(txSeq);
+  if (frag == nullptr) {
+    NDN_THROW(std::out_of_range("TxSequence " + to_string(txSeq) + " is not in the window"));
   }
+  return *frag;
 }
 
-LpReliability::UnackedFrag::UnackedFrag(lp::Packet pkt)
-  : pkt(std::move(pkt))
-  , sendTime(time::steady_clock::now())
-  , retxCount(0)
-  , nGreaterSeqAcks(0)
+LpReliability::UnackedFrag&
+LpReliability::UnackedFrags::insert(lp::Sequence txSeq, const lp::Packet& pkt)
 {
+  if (this->empty()) {
+    m_begin = m_end = txSeq;
+  }
+  BOOST_ASSERT(txSeq - m_begin >= m_end - m_begin);
+
+  uint64_t span = txSeq - m_begin + 1;
+  if (span > m_slots.size()) {
+    this->grow(span);
+  }
+
+  UnackedFrag& frag = this->getSlot(txSeq);
+  BOOST_ASSERT(frag.netPkt == nullptr);
+  frag.pkt = pkt;
+  frag.retxCount = 0;
+  frag.nGreaterSeqAcks = 0;
+
+  m_end = txSeq + 1;
+  ++m_size;
+  return frag;
 }
 
-LpReliability::NetPkt::NetPkt(lp::Packet&& pkt, bool isInterest)
-  : pkt(std::move(pkt))
-  , isInterest(isInterest)
-  , didRetx(false)
+void
+LpReliability::UnackedFrags::erase(lp::Sequence txSeq)
 {
+  UnackedFrag& frag = this->getSlot(txSeq);
+  BOOST_ASSERT(this->find(txSeq) == &frag);
+  frag.pkt = lp::Packet();
+  frag.netPkt = nullptr;
+  --m_size;
+
+  if (m_size == 0) {
+    m_begin = m_end;
+    return;
+  }
+
+  // If "first" fragment in send window (allowing for wraparound), increment window begin
+  if (txSeq == m_begin) {
+    do {
+      ++m_begin;
+    } while (this->getSlot(m_begin).netPkt == nullptr);
+  }
+}
+
+void
+LpReliability::UnackedFrags::grow(uint64_t minCapacity)
+{
+  size_t capacity = m_slots.size();
+  while (capacity < minCapacity) {
+    capacity *= 2;
+  }
+
+  std::vector<UnackedFrag> slots(capacity);
+  for (lp::Sequence txSeq = m_begin; txSeq != m_end; ++txSeq) {
+    slots[txSeq & (capacity - 1)] = std::move(this->getSlot(txSeq));
+  }
+  m_slots.swap(slots);
 }
 
 } // namespace face
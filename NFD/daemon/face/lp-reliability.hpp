@@ -92,9 +92,11 @@ public:
 
   /** \brief extract and parse all Acks and add Ack for contained Fragment (if any) to AckQueue
    *  \param pkt incoming LpPacket
+   *  \param rxTime time at which \p pkt arrived at the transport, used for RTT measurements
    */
   void
-  processIncomingPacket(const lp::Packet& pkt);
+  processIncomingPacket(const lp::Packet& pkt,
+                        time::steady_clock::TimePoint rxTime = time::steady_clock::now());
 
   /** \brief called by GenericLinkService to attach Acks onto an outgoing LpPacket
    *  \param pkt outgoing LpPacket to attach Acks to
@@ -106,7 +108,7 @@ public:
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   class UnackedFrag;
   class NetPkt;
-  using UnackedFrags = std::map<lp::Sequence, UnackedFrag>;
+  class UnackedFrags;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /** \brief assign TxSequence number to a fragment
@@ -131,70 +133,167 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   stopIdleAckTimer();
 
+  /** \brief ensure the RTO timer fires no later than the RTO expiry of the first fragment
+   *         in the window
+   *
+   *  There is a single RTO timer per link. It is rescheduled only if it would otherwise fire
+   *  too late; if it fires too early, onRtoTimeout() reschedules it.
+   */
+  void
+  scheduleRtoTimer();
+
+  /** \brief handle expiration of the RTO timer
+   *
+   *  Fragments are examined in TxSequence order, starting from the beginning of the window,
+   *  until a fragment whose RTO has not expired is found.
+   */
+  void
+  onRtoTimeout();
+
   /** \brief find and mark as lost fragments where a configurable number of Acks
    *         (\p m_options.seqNumLossThreshold) have been received for greater TxSequence numbers
-   *  \param ackIt iterator pointing to acknowledged fragment
-   *  \return vector containing TxSequences of fragments marked lost by this mechanism
+   *  \param windowBegin the beginning of the window before Acks in m_ackOffsets were processed
+   *  \post m_lostLpPackets contains TxSequences of fragments marked lost by this mechanism
+   *
+   *  All Acks of an incoming packet are counted in a single pass over the window.
    */
-  std::vector<lp::Sequence>
-  findLostLpPackets(UnackedFrags::iterator ackIt);
+  void
+  findLostLpPackets(lp::Sequence windowBegin);
 
   /** \brief resend (or give up on) a lost fragment
-   *  \return vector of the TxSequences of fragments removed due to a network packet being removed
    */
-  std::vector<lp::Sequence>
+  void
   onLpPacketLost(lp::Sequence txSeq);
 
-  /** \brief remove the fragment with the given sequence number from the map of unacknowledged
+  /** \brief remove the fragment with the given sequence number from the window of unacknowledged
    *         fragments, as well as its associated network packet (if any)
-   *  \param fragIt iterator to acknowledged fragment
+   *  \param txSeq TxSequence of acknowledged fragment, must be in the window
    *
-   *  If the given TxSequence marks the beginning of the send window, the window will be incremented.
    *  If the associated network packet has been fully transmitted, it will be removed.
    */
   void
-  onLpPacketAcknowledged(UnackedFrags::iterator fragIt);
+  onLpPacketAcknowledged(lp::Sequence txSeq);
+
+  /** \brief obtain a NetPkt record from the pool
+   */
+  NetPkt*
+  allocNetPkt(lp::Packet&& pkt, bool isInterest);
 
-  /** \brief delete a fragment from UnackedFrags and advance acknowledge window if necessary
-   *  \param fragIt iterator to an UnackedFrag, must be dereferencable
-   *  \post fragIt is not in m_unackedFrags
-   *  \post if was equal to m_firstUnackedFrag,
-   *        m_firstUnackedFrag is set to the UnackedFrag after fragIt with consideration of
-   *        TxSequence number wraparound, or set to m_unackedFrags.end() if m_unackedFrags is empty
+  /** \brief return a NetPkt record to the pool
    */
   void
-  deleteUnackedFrag(UnackedFrags::iterator fragIt);
+  releaseNetPkt(NetPkt* netPkt);
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /** \brief contains a sent fragment that has not been acknowledged and associated data
    */
   class UnackedFrag
   {
-  public:
-    explicit
-    UnackedFrag(lp::Packet pkt);
-
   public:
     lp::Packet pkt;
-    scheduler::ScopedEventId rtoTimer;
     time::steady_clock::TimePoint sendTime;
-    size_t retxCount;
-    size_t nGreaterSeqAcks; //!< number of Acks received for sequences greater than this fragment
-    shared_ptr<NetPkt> netPkt;
+    time::steady_clock::TimePoint rtoExpiry;
+    size_t retxCount = 0;
+    size_t nGreaterSeqAcks = 0; //!< number of Acks received for sequences greater than this fragment
+    NetPkt* netPkt = nullptr; //!< nullptr if this slot of the window is unused
   };
 
   /** \brief contains a network-layer packet with unacknowledged fragments
+   *
+   *  NetPkt records are pooled by LpReliability and reused across network packets.
    */
   class NetPkt
   {
   public:
-    NetPkt(lp::Packet&& pkt, bool isInterest);
+    std::vector<lp::Sequence> unackedFrags;
+    lp::Packet pkt;
+    bool isInterest = false;
+    bool didRetx = false;
+  };
 
+  /** \brief a window of unacknowledged fragments, indexed by TxSequence
+   *
+   *  The window is a circular buffer whose capacity is a power of two. The fragment with
+   *  TxSequence \p txSeq is stored in slot <tt>txSeq & (capacity - 1)</tt>, so that lookup,
+   *  insertion, and removal do not allocate. The buffer grows when a TxSequence does not fit
+   *  between the beginning of the window and its capacity. TxSequence wraparound is handled by
+   *  unsigned arithmetic relative to the beginning of the window.
+   */
+  class UnackedFrags
+  {
   public:
-    std::vector<UnackedFrags::iterator> unackedFrags;
-    lp::Packet pkt;
-    bool isInterest;
-    bool didRetx;
+    UnackedFrags();
+
+    bool
+    empty() const
+    {
+      return m_size == 0;
+    }
+
+    size_t
+    size() const
+    {
+      return m_size;
+    }
+
+    size_t
+    count(lp::Sequence txSeq) const
+    {
+      return this->find(txSeq) == nullptr ? 0 : 1;
+    }
+
+    /** \return the fragment with \p txSeq, or nullptr if it is not in the window
+     */
+    UnackedFrag*
+    find(lp::Sequence txSeq);
+
+    const UnackedFrag*
+    find(lp::Sequence txSeq) const;
+
+    /** \return the fragment with \p txSeq
+     *  \throw std::out_of_range \p txSeq is not in the window
+     */
+    UnackedFrag&
+    at(lp::Sequence txSeq);
+
+    /** \return TxSequence of the first unacknowledged fragment
+     *  \pre !empty()
+     */
+    lp::Sequence
+    getFirstTxSeq() const
+    {
+      BOOST_ASSERT(!this->empty());
+      return m_begin;
+    }
+
+    /** \brief insert a fragment at the end of the window
+     *  \param txSeq TxSequence of the fragment, must follow every TxSequence in the window
+     *  \return the inserted fragment, whose netPkt must be set by the caller
+     */
+    UnackedFrag&
+    insert(lp::Sequence txSeq, const lp::Packet& pkt);
+
+    /** \brief remove a fragment, and advance the beginning of the window if necessary
+     *  \pre count(txSeq) > 0
+     */
+    void
+    erase(lp::Sequence txSeq);
+
+  private:
+    UnackedFrag&
+    getSlot(lp::Sequence txSeq)
+    {
+      return m_slots[txSeq & (m_slots.size() - 1)];
+    }
+
+    void
+    grow(uint64_t minCapacity);
+
+  private:
+    std::vector<UnackedFrag> m_slots;
+    lp::Sequence m_begin; ///< TxSequence of the first unacknowledged fragment
+    lp::Sequence m_end; ///< one past the TxSequence of the last inserted fragment
+    size_t m_size;
   };
 
 public:
@@ -205,16 +304,17 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   Options m_options;
   GenericLinkService* m_linkService;
   UnackedFrags m_unackedFrags;
-  /** An iterator that points to the first unacknowledged fragment in the current window. The window
-   *  can wrap around so that the beginning of the window is at a TxSequence greater than other
-   *  fragments in the window. When the window is moved past the last item in the iterator, the
-   *  first fragment in the map will become the start of the window.
-   */
-  UnackedFrags::iterator m_firstUnackedFrag;
+  std::vector<unique_ptr<NetPkt>> m_netPkts; ///< every NetPkt record ever allocated
+  std::vector<NetPkt*> m_freeNetPkts;
+  std::vector<uint64_t> m_ackOffsets; ///< scratch space for Acks of an incoming packet
+  std::vector<lp::Sequence> m_lostLpPackets; ///< scratch space for lost fragments
   std::queue<lp::Sequence> m_ackQueue;
   lp::Sequence m_lastTxSeqNo;
   scheduler::ScopedEventId m_idleAckTimer;
   bool m_isIdleAckTimerRunning;
+  scheduler::ScopedEventId m_rtoTimer;
+  time::steady_clock::TimePoint m_rtoTimerExpiry;
+  bool m_isRtoTimerRunning;
   RttEstimator m_rto;
 };
 
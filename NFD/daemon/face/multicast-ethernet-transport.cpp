@@ -50,8 +50,9 @@ NFD_LOG_INIT(MulticastEthernetTransport);
 
 MulticastEthernetTransport::MulticastEthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
                                                        const ethernet::Address& mcastAddress,
-                                                       ndn::nfd::LinkType linkType)
-  : EthernetTransport(localEndpoint, mcastAddress)
+                                                       ndn::nfd::LinkType linkType,
+                                                       Backend backend)
+  : EthernetTransport(localEndpoint, mcastAddress, backend)
 #if defined(__linux__)
   , m_interfaceIndex(localEndpoint.getIndex())
 #endif
@@ -75,7 +76,7 @@ MulticastEthernetTransport::MulticastEthernetTransport(const ndn::net::NetworkIn
            ethernet::ETHERTYPE_NDN,
            m_destAddress.toString().data(),
            m_srcAddress.toString().data());
-  m_pcap.setPacketFilter(filter);
+  setPacketFilter(filter);
 
   BOOST_ASSERT(m_destAddress.isMulticast());
   if (!m_destAddress.isBroadcast())
@@ -92,7 +93,15 @@ MulticastEthernetTransport::joinMulticastGroup()
   mr.mr_alen = m_destAddress.size();
   std::memcpy(mr.mr_address, m_destAddress.data(), m_destAddress.size());
 
-  if (::setsockopt(m_socket.native_handle(), SOL_PACKET,
+  int packetFd = m_socket.native_handle();
+#ifdef HAVE_AF_XDP
+  if (m_xdp) {
+    // AF_XDP sockets do not support PACKET_ADD_MEMBERSHIP
+    packetFd = m_xdp->getControlFd();
+  }
+#endif
+
+  if (::setsockopt(packetFd, SOL_PACKET,
                    PACKET_ADD_MEMBERSHIP, &mr, sizeof(mr)) == 0)
     return; // success
 
@@ -74,11 +74,13 @@ MulticastUdpTransport::MulticastUdpTransport(const protocol::endpoint& multicast
 ssize_t
 MulticastUdpTransport::getSendQueueLength()
 {
-  ssize_t queueLength = getTxQueueLength(m_sendSocket.native_handle());
-  if (queueLength == QUEUE_ERROR) {
-    NFD_LOG_FACE_WARN("Failed to obtain send queue length from socket: " << std::strerror(errno));
-  }
-  return queueLength;
+  return m_txQueueLength.get([this] {
+    ssize_t queueLength = getTxQueueLength(m_sendSocket.native_handle());
+    if (queueLength == QUEUE_ERROR) {
+      NFD_LOG_FACE_WARN("Failed to obtain send queue length from socket: " << std::strerror(errno));
+    }
+    return queueLength;
+  });
 }
 
 void
@@ -0,0 +1,320 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "packet-ring-helper.hpp"
+#include "ethernet-protocol.hpp"
+#include "socket-utils.hpp"
+
+#include <pcap/pcap.h>
+
+#include <cerrno>
+#include <cstring> // for memcpy(), strerror()
+
+#include <linux/filter.h>
+#include <linux/if_packet.h>
+#include <net/ethernet.h>
+#include <net/if.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <boost/endian/conversion.hpp>
+
+#if !defined(PCAP_NETMASK_UNKNOWN)
+#define PCAP_NETMASK_UNKNOWN  0xffffffff
+#endif
+
+namespace nfd {
+namespace face {
+
+constexpr size_t PacketRingHelper::BLOCK_SIZE;
+constexpr size_t PacketRingHelper::N_RX_BLOCKS;
+constexpr size_t PacketRingHelper::N_TX_FRAMES;
+const time::milliseconds PacketRingHelper::BLOCK_TIMEOUT = 1_ms;
+
+/** \brief offset of frame data within a TPACKET_V3 transmit slot
+ */
+static const size_t TX_DATA_OFFSET = TPACKET_ALIGN(sizeof(tpacket3_hdr));
+
+static std::string
+errnoToString(const std::string& what)
+{
+  return what + ": " + std::strerror(errno);
+}
+
+PacketRingHelper::PacketRingHelper(const std::string& interfaceName, size_t mtu)
+  : m_fd(-1)
+  , m_ifIndex(0)
+  , m_mtu(mtu)
+  , m_ring(nullptr)
+  , m_ringSize(0)
+  , m_rxBlock(0)
+  , m_rxRemaining(0)
+  , m_rxFrame(nullptr)
+  , m_rxSec(0)
+  , m_rxNsec(0)
+  , m_txRing(nullptr)
+  , m_txFrameSize(0)
+  , m_nTxFrames(0)
+  , m_txFrame(0)
+  , m_nDropped(0)
+{
+  m_ifIndex = ::if_nametoindex(interfaceName.data());
+  if (m_ifIndex == 0)
+    NDN_THROW(Error(errnoToString("if_nametoindex")));
+
+  // protocol 0: do not receive anything until bound in activate()
+  m_fd = ::socket(AF_PACKET, SOCK_RAW, 0);
+  if (m_fd < 0)
+    NDN_THROW(Error(errnoToString("socket")));
+}
+
+PacketRingHelper::~PacketRingHelper()
+{
+  close();
+}
+
+void
+PacketRingHelper::activate()
+{
+  int version = TPACKET_V3;
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+    NDN_THROW(Error(errnoToString("setsockopt(PACKET_VERSION)")));
+
+  tpacket_req3 rxReq{};
+  rxReq.tp_block_size = BLOCK_SIZE;
+  rxReq.tp_block_nr = N_RX_BLOCKS;
+  rxReq.tp_frame_size = TPACKET_ALIGNMENT << 7;
+  rxReq.tp_frame_nr = (BLOCK_SIZE / rxReq.tp_frame_size) * N_RX_BLOCKS;
+  rxReq.tp_retire_blk_tov = BLOCK_TIMEOUT.count();
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_RX_RING, &rxReq, sizeof(rxReq)) < 0)
+    NDN_THROW(Error(errnoToString("setsockopt(PACKET_RX_RING)")));
+  size_t rxSize = BLOCK_SIZE * N_RX_BLOCKS;
+
+  // each transmit slot holds the TPACKET_V3 header and one frame of up to MTU octets
+  m_txFrameSize = TPACKET_ALIGNMENT;
+  while (m_txFrameSize < TX_DATA_OFFSET + ethernet::HDR_LEN + m_mtu) {
+    m_txFrameSize <<= 1;
+  }
+  size_t txSize = 0;
+  if (m_txFrameSize <= BLOCK_SIZE) {
+    tpacket_req3 txReq{};
+    txReq.tp_block_size = BLOCK_SIZE;
+    txReq.tp_frame_size = m_txFrameSize;
+    txReq.tp_block_nr = (N_TX_FRAMES * m_txFrameSize + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    txReq.tp_frame_nr = (BLOCK_SIZE / m_txFrameSize) * txReq.tp_block_nr;
+    // PACKET_TX_RING with TPACKET_V3 requires Linux 4.11; use send(2) if it is not supported
+    if (::setsockopt(m_fd, SOL_PACKET, PACKET_TX_RING, &txReq, sizeof(txReq)) == 0) {
+      txSize = BLOCK_SIZE * txReq.tp_block_nr;
+      m_nTxFrames = txReq.tp_frame_nr;
+    }
+  }
+
+  m_ringSize = rxSize + txSize;
+  void* ring = ::mmap(nullptr, m_ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED, m_fd, 0);
+  if (ring == MAP_FAILED) {
+    // MAP_LOCKED may fail due to RLIMIT_MEMLOCK
+    ring = ::mmap(nullptr, m_ringSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  }
+  if (ring == MAP_FAILED) {
+    m_ringSize = 0;
+    NDN_THROW(Error(errnoToString("mmap")));
+  }
+  m_ring = static_cast<uint8_t*>(ring);
+  if (txSize > 0) {
+    m_txRing = m_ring + rxSize;
+  }
+
+#ifdef PACKET_IGNORE_OUTGOING
+  // receive incoming frames only, like PCAP_D_IN; not supported before Linux 4.20,
+  // in which case outgoing frames are skipped in readNextPacket()
+  int one = 1;
+  ::setsockopt(m_fd, SOL_PACKET, PACKET_IGNORE_OUTGOING, &one, sizeof(one));
+#endif
+
+  sockaddr_ll sll{};
+  sll.sll_family = AF_PACKET;
+  sll.sll_protocol = boost::endian::native_to_big<uint16_t>(ETH_P_ALL);
+  sll.sll_ifindex = m_ifIndex;
+  if (::bind(m_fd, reinterpret_cast<sockaddr*>(&sll), sizeof(sll)) < 0)
+    NDN_THROW(Error(errnoToString("bind")));
+}
+
+void
+PacketRingHelper::close()
+{
+  if (m_ring != nullptr) {
+    ::munmap(m_ring, m_ringSize);
+    m_ring = nullptr;
+    m_txRing = nullptr;
+    m_ringSize = 0;
+  }
+  if (m_fd >= 0) {
+    ::close(m_fd);
+    m_fd = -1;
+  }
+}
+
+int
+PacketRingHelper::getFd() const
+{
+  // we need to duplicate the fd, otherwise both close() and the
+  // caller may attempt to close the same fd and one of them will fail
+  int fd = ::dup(m_fd);
+  if (fd < 0)
+    NDN_THROW(Error(errnoToString("dup")));
+  return fd;
+}
+
+size_t
+PacketRingHelper::getNDropped() const
+{
+  if (m_fd < 0)
+    return m_nDropped;
+
+  // the kernel resets the statistics on each read
+  tpacket_stats_v3 stats{};
+  socklen_t len = sizeof(stats);
+  if (::getsockopt(m_fd, SOL_PACKET, PACKET_STATISTICS, &stats, &len) < 0)
+    NDN_THROW(Error(errnoToString("getsockopt(PACKET_STATISTICS)")));
+
+  m_nDropped += stats.tp_drops;
+  return m_nDropped;
+}
+
+void
+PacketRingHelper::setPacketFilter(const char* filter) const
+{
+  pcap_t* pcap = pcap_open_dead(DLT_EN10MB, std::numeric_limits<uint16_t>::max());
+  if (pcap == nullptr)
+    NDN_THROW(Error("pcap_open_dead failed"));
+
+  bpf_program prog;
+  if (pcap_compile(pcap, &prog, filter, 1, PCAP_NETMASK_UNKNOWN) < 0) {
+    std::string err = pcap_geterr(pcap);
+    pcap_close(pcap);
+    NDN_THROW(Error("pcap_compile: " + err));
+  }
+  pcap_close(pcap);
+
+  // struct bpf_insn and struct sock_filter have the same layout
+  sock_fprog fprog{};
+  fprog.len = prog.bf_len;
+  fprog.filter = reinterpret_cast<sock_filter*>(prog.bf_insns);
+  int ret = ::setsockopt(m_fd, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog));
+  pcap_freecode(&prog);
+  if (ret < 0)
+    NDN_THROW(Error(errnoToString("setsockopt(SO_ATTACH_FILTER)")));
+}
+
+std::tuple<const uint8_t*, size_t, std::string>
+PacketRingHelper::readNextPacket()
+{
+  if (m_ring == nullptr)
+    return std::make_tuple(nullptr, 0, "");
+
+  while (true) {
+    auto block = reinterpret_cast<tpacket_block_desc*>(m_ring + m_rxBlock * BLOCK_SIZE);
+
+    if (m_rxFrame == nullptr) {
+      if ((__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0)
+        return std::make_tuple(nullptr, 0, "");
+
+      m_rxRemaining = block->hdr.bh1.num_pkts;
+      m_rxFrame = reinterpret_cast<uint8_t*>(block) + block->hdr.bh1.offset_to_first_pkt;
+    }
+
+    if (m_rxRemaining == 0) {
+      // all frames in this block have been consumed, return it to the kernel
+      __atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+      m_rxBlock = (m_rxBlock + 1) % N_RX_BLOCKS;
+      m_rxFrame = nullptr;
+      continue;
+    }
+
+    auto hdr = reinterpret_cast<tpacket3_hdr*>(m_rxFrame);
+    --m_rxRemaining;
+    m_rxFrame += hdr->tp_next_offset;
+
+    auto sll = reinterpret_cast<const sockaddr_ll*>(reinterpret_cast<uint8_t*>(hdr) +
+                                                    TPACKET_ALIGN(sizeof(tpacket3_hdr)));
+    if (sll->sll_pkttype == PACKET_OUTGOING) {
+      continue;
+    }
+
+    m_rxSec = hdr->tp_sec;
+    m_rxNsec = hdr->tp_nsec;
+    return std::make_tuple(reinterpret_cast<uint8_t*>(hdr) + hdr->tp_mac, hdr->tp_snaplen, "");
+  }
+}
+
+time::steady_clock::TimePoint
+PacketRingHelper::getLastRxTime() const
+{
+  return convertRxTimestamp(m_rxSec, m_rxNsec);
+}
+
+ssize_t
+PacketRingHelper::send(const uint8_t* frame, size_t size)
+{
+  if (m_txRing == nullptr) {
+    return ::send(m_fd, frame, size, MSG_DONTWAIT);
+  }
+
+  if (TX_DATA_OFFSET + size > m_txFrameSize) {
+    errno = EMSGSIZE;
+    return -1;
+  }
+
+  auto slot = m_txRing + m_txFrame * m_txFrameSize;
+  auto hdr = reinterpret_cast<tpacket3_hdr*>(slot);
+  if (__atomic_load_n(&hdr->tp_status, __ATOMIC_ACQUIRE) != TP_STATUS_AVAILABLE) {
+    // ring is full, wait for the kernel to transmit queued frames
+    flush();
+    if (__atomic_load_n(&hdr->tp_status, __ATOMIC_ACQUIRE) != TP_STATUS_AVAILABLE) {
+      errno = ENOBUFS;
+      return -1;
+    }
+  }
+
+  std::memcpy(slot + TX_DATA_OFFSET, frame, size);
+  hdr->tp_len = size;
+  hdr->tp_next_offset = 0;
+  __atomic_store_n(&hdr->tp_status, TP_STATUS_SEND_REQUEST, __ATOMIC_RELEASE);
+  m_txFrame = (m_txFrame + 1) % m_nTxFrames;
+  return size;
+}
+
+void
+PacketRingHelper::flush()
+{
+  if (m_txRing == nullptr || m_fd < 0) {
+    return;
+  }
+  ::send(m_fd, nullptr, 0, MSG_DONTWAIT);
+}
+
+} // namespace face
+} // namespace nfd
@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_PACKET_RING_HELPER_HPP
+#define NFD_DAEMON_FACE_PACKET_RING_HELPER_HPP
+
+#include "core/common.hpp"
+
+#ifndef __linux__
+#error "Cannot include this file on platforms other than Linux"
+#endif
+
+namespace nfd {
+namespace face {
+
+/**
+ * @brief Helper class for AF_PACKET sockets with TPACKET_V3 memory-mapped rings.
+ *
+ * Frames are received through a block-based PACKET_RX_RING shared with the kernel, so that
+ * a single readiness notification delivers a whole block of frames without any copy or
+ * system call per frame. If the kernel supports it, frames are sent through a PACKET_TX_RING;
+ * otherwise they are sent with send(2).
+ *
+ * The kernel hands a block to userspace when it is full or when the block timeout expires,
+ * therefore at low packet rates a frame may be delayed by up to BLOCK_TIMEOUT.
+ */
+class PacketRingHelper : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /**
+   * @brief Create an AF_PACKET socket bound to a network interface.
+   * @param interfaceName name of the network interface
+   * @param mtu MTU of the network interface, used to size the transmit ring
+   * @throw Error on any error
+   */
+  PacketRingHelper(const std::string& interfaceName, size_t mtu);
+
+  ~PacketRingHelper();
+
+  /**
+   * @brief Set up the memory-mapped rings and start receiving frames.
+   * @throw Error on any error
+   */
+  void
+  activate();
+
+  /**
+   * @brief Unmap the rings and close the socket.
+   */
+  void
+  close();
+
+  /**
+   * @brief Obtain a file descriptor that can be used in calls such as select(2) and poll(2).
+   * @pre activate() has been called.
+   * @return A selectable file descriptor. It is the caller's responsibility to close the fd.
+   * @throw Error on any error
+   */
+  int
+  getFd() const;
+
+  /**
+   * @brief Get the number of frames dropped by the kernel.
+   * @throw Error on any error
+   */
+  size_t
+  getNDropped() const;
+
+  /**
+   * @brief Install a BPF filter on the socket.
+   * @param filter Null-terminated string containing the BPF program source, see pcap-filter(7).
+   * @throw Error on any error
+   */
+  void
+  setPacketFilter(const char* filter) const;
+
+  /**
+   * @brief Read the next frame from the receive ring.
+   * @return If a frame is available, returns a tuple containing a pointer to the frame
+   *         (including the link-layer header) and the size of the frame; the third
+   *         element must be ignored. If no frame is available, returns a tuple containing
+   *         nullptr, 0, and an empty string.
+   * @warning The returned pointer must not be freed by the caller, and is valid only
+   *          until the next call to this function.
+   */
+  std::tuple<const uint8_t*, size_t, std::string>
+  readNextPacket();
+
+  /**
+   * @brief Get the time at which the kernel received the frame last returned by readNextPacket().
+   */
+  time::steady_clock::TimePoint
+  getLastRxTime() const;
+
+  /**
+   * @brief Queue a complete frame for transmission.
+   *
+   * If the transmit ring is available, the frame is only copied into the ring, and is sent
+   * on the next call to flush(); otherwise, the frame is sent immediately.
+   *
+   * @return number of octets queued or sent, or -1 on error with errno set;
+   *         errno is ENOBUFS if the transmit ring is full
+   */
+  ssize_t
+  send(const uint8_t* frame, size_t size);
+
+  /**
+   * @brief Ask the kernel to transmit all frames queued in the transmit ring.
+   */
+  void
+  flush();
+
+public:
+  static constexpr size_t BLOCK_SIZE = 1 << 18;
+  static constexpr size_t N_RX_BLOCKS = 8;
+  static constexpr size_t N_TX_FRAMES = 128;
+  static const time::milliseconds BLOCK_TIMEOUT;
+
+private:
+  int m_fd;
+  int m_ifIndex;
+  size_t m_mtu;
+  uint8_t* m_ring;
+  size_t m_ringSize;
+
+  size_t m_rxBlock; ///< index of the current receive block
+  size_t m_rxRemaining; ///< frames left to read in the current receive block
+  uint8_t* m_rxFrame; ///< next frame to read in the current receive block, nullptr if none
+  int64_t m_rxSec; ///< receive timestamp of the last frame, seconds
+  int64_t m_rxNsec; ///< receive timestamp of the last frame, nanoseconds within the second
+
+  uint8_t* m_txRing; ///< transmit ring, nullptr if not available
+  size_t m_txFrameSize;
+  size_t m_nTxFrames;
+  size_t m_txFrame; ///< index of the next transmit frame
+
+  mutable size_t m_nDropped;
+};
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_PACKET_RING_HELPER_HPP
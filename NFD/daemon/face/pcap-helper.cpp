@@ -24,6 +24,7 @@
  */
 
 #include "pcap-helper.hpp"
+#include "socket-utils.hpp"
 
 #include <pcap/pcap.h>
 #include <unistd.h>
@@ -37,6 +38,9 @@ namespace face {
 
 PcapHelper::PcapHelper(const std::string& interfaceName)
   : m_pcap(nullptr)
+  , m_rxSec(0)
+  , m_rxNsec(0)
+  , m_hasNanoPrecision(false)
 {
   char errbuf[PCAP_ERRBUF_SIZE] = {};
   m_pcap = pcap_create(interfaceName.data(), errbuf);
@@ -49,6 +53,11 @@ PcapHelper::PcapHelper(const std::string& interfaceName)
   // even if the kernel supports it, thus preventing bug #1511.
   if (pcap_set_immediate_mode(m_pcap, 1) < 0)
     NDN_THROW(Error("pcap_set_immediate_mode failed"));
+
+#ifdef PCAP_TSTAMP_PRECISION_NANO
+  // best effort, timestamps are reported in microseconds otherwise
+  m_hasNanoPrecision = pcap_set_tstamp_precision(m_pcap, PCAP_TSTAMP_PRECISION_NANO) == 0;
+#endif
 }
 
 PcapHelper::~PcapHelper()
@@ -121,7 +130,7 @@ PcapHelper::setPacketFilter(const char* filter) const
 }
 
 std::tuple<const uint8_t*, size_t, std::string>
-PcapHelper::readNextPacket() const
+PcapHelper::readNextPacket()
 {
   pcap_pkthdr* header;
   const uint8_t* packet;
@@ -131,8 +140,16 @@ PcapHelper::readNextPacket() const
     return std::make_tuple(nullptr, 0, getLastError());
   else if (ret == 0)
     return std::make_tuple(nullptr, 0, "timed out");
-  else
-    return std::make_tuple(packet, header->caplen, "");
+
+  m_rxSec = header->ts.tv_sec;
+  m_rxNsec = m_hasNanoPrecision ? header->ts.tv_usec : header->ts.tv_usec * 1000;
+  return std::make_tuple(packet, header->caplen, "");
+}
+
+time::steady_clock::TimePoint
+PcapHelper::getLastRxTime() const
+{
+  return convertRxTimestamp(m_rxSec, m_rxNsec);
 }
 
 } // namespace face
@@ -129,7 +129,13 @@ public:
    * @sa pcap_next_ex(3pcap)
    */
   std::tuple<const uint8_t*, size_t, std::string>
-  readNextPacket() const;
+  readNextPacket();
+
+  /**
+   * @brief Get the time at which the kernel received the packet last returned by readNextPacket().
+   */
+  time::steady_clock::TimePoint
+  getLastRxTime() const;
 
   operator pcap_t*() const
   {
@@ -138,6 +144,9 @@ public:
 
 private:
   pcap_t* m_pcap;
+  int64_t m_rxSec; ///< capture timestamp of the last packet, seconds
+  int64_t m_rxNsec; ///< capture timestamp of the last packet, nanoseconds within the second
+  bool m_hasNanoPrecision; ///< whether libpcap reports timestamps in nanoseconds
 };
 
 } // namespace face
@@ -36,6 +36,8 @@
 namespace nfd {
 namespace face {
 
+const time::nanoseconds TxQueueLengthCache::SAMPLING_INTERVAL = 1_ms;
+
 ssize_t
 getTxQueueLength(int fd)
 {
@@ -53,5 +55,19 @@ getTxQueueLength(int fd)
   return queueLength;
 }
 
+const time::nanoseconds MAX_RX_TIMESTAMP_AGE = 1_s;
+
+time::steady_clock::TimePoint
+convertRxTimestamp(int64_t sec, int64_t nsec)
+{
+  auto steadyNow = time::steady_clock::now();
+  auto age = time::duration_cast<time::nanoseconds>(time::system_clock::now().time_since_epoch()) -
+             time::seconds(sec) - time::nanoseconds(nsec);
+  if (age < time::nanoseconds::zero() || age > MAX_RX_TIMESTAMP_AGE) {
+    return steadyNow;
+  }
+  return steadyNow - age;
+}
+
 } // namespace face
 } // namespace nfd
@@ -27,6 +27,7 @@
 #define NFD_DAEMON_FACE_SOCKET_UTILS_HPP
 
 #include "core/common.hpp"
+#include "daemon/global.hpp"
 
 namespace nfd {
 namespace face {
@@ -42,6 +43,63 @@ namespace face {
 ssize_t
 getTxQueueLength(int fd);
 
+/** \brief convert a receive timestamp reported by the kernel to steady_clock
+ *  \param sec seconds since the Unix epoch
+ *  \param nsec nanoseconds within the second
+ *
+ *  Kernel timestamps (SO_TIMESTAMPNS, libpcap, and PACKET_RX_RING) are taken from the system
+ *  clock. The age of the timestamp is subtracted from the current steady_clock time. If the
+ *  timestamp lies in the future or is older than MAX_RX_TIMESTAMP_AGE, as it happens when the
+ *  system clock is stepped, the current steady_clock time is returned instead.
+ */
+time::steady_clock::TimePoint
+convertRxTimestamp(int64_t sec, int64_t nsec);
+
+/** \brief oldest receive timestamp accepted by convertRxTimestamp
+ */
+extern const time::nanoseconds MAX_RX_TIMESTAMP_AGE;
+
+/** \brief caches the send queue length of a system socket
+ *
+ *  Obtaining the send queue length requires a system call, which is too expensive to make for
+ *  every outgoing packet. This class samples the send queue length at most once per
+ *  SAMPLING_INTERVAL, and returns the previous sample in between.
+ */
+class TxQueueLengthCache : noncopyable
+{
+public:
+  /** \return the cached send queue length
+   *  \param sample a callable that obtains the send queue length from the socket;
+   *                it is invoked only if the cached value is older than SAMPLING_INTERVAL
+   */
+  template<typename Sample>
+  ssize_t
+  get(const Sample& sample)
+  {
+    auto now = getCoarseSteadyClockNow();
+    if (now >= m_expiry) {
+      m_value = sample();
+      m_expiry = now + SAMPLING_INTERVAL;
+    }
+    return m_value;
+  }
+
+  /** \brief discard the cached value, so that the next get() samples the socket
+   */
+  void
+  invalidate()
+  {
+    m_expiry = time::steady_clock::TimePoint::min();
+  }
+
+public:
+  static const time::nanoseconds SAMPLING_INTERVAL;
+
+private:
+  time::steady_clock::TimePoint m_expiry = time::steady_clock::TimePoint::min();
+  ssize_t m_value = 0;
+};
+
 } // namespace face
 } // namespace nfd
 
@@ -30,12 +30,20 @@
 #include "socket-utils.hpp"
 #include "daemon/global.hpp"
 
-#include <queue>
+#ifdef HAVE_IO_URING
+#include "io-uring.hpp"
+#endif
+
+#include <deque>
 
 namespace nfd {
 namespace face {
 
 /** \brief Implements Transport for stream-based protocols.
+ *
+ *  If the io_uring backend is enabled, the socket is serviced by the global IoUring instance
+ *  instead of Boost.Asio: a single multishot receive operation is kept outstanding, and all
+ *  packets queued while a send is in progress are submitted as one chain of linked sends.
  *
  *  \tparam Protocol a stream-based protocol in Boost.Asio
  */
@@ -79,6 +87,28 @@ protected:
   handleReceive(const boost::system::error_code& error,
                 size_t nBytesReceived);
 
+  /** \brief decode and deliver packets after \p nBytesReceived octets were appended to the
+   *         receive buffer
+   *  \return false if the transport has failed
+   */
+  bool
+  processReceiveBuffer(size_t nBytesReceived);
+
+#ifdef HAVE_IO_URING
+  void
+  handleUringSend(int result);
+
+  void
+  handleUringReceive(int result, const uint8_t* data);
+#endif
+
+  /** \brief cancel operations submitted to the io_uring backend, if any
+   *
+   *  No send or receive callback is invoked after this function returns.
+   */
+  void
+  cancelUringOperations();
+
   void
   processErrorCode(const boost::system::error_code& error);
 
@@ -96,14 +126,19 @@ protected:
 
 protected:
   typename protocol::socket m_socket;
+  TxQueueLengthCache m_txQueueLength;
 
   NFD_LOG_MEMBER_DECL();
 
 private:
   uint8_t m_receiveBuffer[ndn::MAX_NDN_PACKET_SIZE];
   size_t m_receiveBufferSize;
-  std::queue<Block> m_sendQueue;
+  std::deque<Block> m_sendQueue;
   size_t m_sendQueueBytes;
+#ifdef HAVE_IO_URING
+  IoUring* m_ioUring;
+  size_t m_nUringSendsInFlight; ///< number of packets at the front of m_sendQueue being sent
+#endif
 };
 
 
@@ -112,6 +147,10 @@ StreamTransport<T>::StreamTransport(typename StreamTransport::protocol::socket&&
   : m_socket(std::move(socket))
   , m_receiveBufferSize(0)
   , m_sendQueueBytes(0)
+#ifdef HAVE_IO_URING
+  , m_ioUring(getGlobalIoUring())
+  , m_nUringSendsInFlight(0)
+#endif
 {
   // No queue capacity is set because there is no theoretical limit to the size of m_sendQueue.
   // Therefore, protecting against send queue overflows is less critical than in other transport
@@ -124,10 +163,13 @@ template<class T>
 ssize_t
 StreamTransport<T>::getSendQueueLength()
 {
-  ssize_t queueLength = getTxQueueLength(m_socket.native_handle());
-  if (queueLength == QUEUE_ERROR) {
-    NFD_LOG_FACE_WARN("Failed to obtain send queue length from socket: " << std::strerror(errno));
-  }
+  ssize_t queueLength = m_txQueueLength.get([this] {
+    ssize_t queueLength = getTxQueueLength(m_socket.native_handle());
+    if (queueLength == QUEUE_ERROR) {
+      NFD_LOG_FACE_WARN("Failed to obtain send queue length from socket: " << std::strerror(errno));
+    }
+    return queueLength;
+  });
   return getSendQueueBytes() + std::max<ssize_t>(0, queueLength);
 }
 
@@ -145,6 +187,7 @@ StreamTransport<T>::doClose()
     m_socket.cancel(error);
     m_socket.shutdown(protocol::socket::shutdown_both, error);
   }
+  cancelUringOperations();
 
   // Ensure that the Transport stays alive at least until
   // all pending handlers are dispatched
@@ -188,7 +231,7 @@ StreamTransport<T>::doSend(Transport::Packet&& packet)
     return;
 
   bool wasQueueEmpty = m_sendQueue.empty();
-  m_sendQueue.push(packet.packet);
+  m_sendQueue.push_back(packet.packet);
   m_sendQueueBytes += packet.packet.size();
 
   if (wasQueueEmpty)
@@ -199,6 +242,19 @@ template<class T>
 void
 StreamTransport<T>::sendFromQueue()
 {
+#ifdef HAVE_IO_URING
+  if (m_ioUring != nullptr) {
+    // send everything queued since the previous chain was submitted, in order
+    BOOST_ASSERT(m_nUringSendsInFlight == 0);
+    size_t chainLength = std::min(m_sendQueue.size(), IoUring::MAX_CHAIN_LENGTH);
+    std::vector<Block> chain(m_sendQueue.begin(), m_sendQueue.begin() + chainLength);
+    m_nUringSendsInFlight = chain.size();
+    m_ioUring->sendChain(this, m_socket.native_handle(), chain, MSG_WAITALL,
+                         [this] (int result, const uint8_t*) { this->handleUringSend(result); });
+    return;
+  }
+#endif
+
   boost::asio::async_write(m_socket, boost::asio::buffer(m_sendQueue.front()),
                            [this] (auto&&... args) { this->handleSend(std::forward<decltype(args)>(args)...); });
 }
@@ -216,7 +272,7 @@ StreamTransport<T>::handleSend(const boost::system::error_code& error,
   BOOST_ASSERT(!m_sendQueue.empty());
   BOOST_ASSERT(m_sendQueue.front().size() == nBytesSent);
   m_sendQueueBytes -= nBytesSent;
-  m_sendQueue.pop();
+  m_sendQueue.pop_front();
 
   if (!m_sendQueue.empty())
     sendFromQueue();
@@ -228,6 +284,14 @@ StreamTransport<T>::startReceive()
 {
   BOOST_ASSERT(getState() == TransportState::UP);
 
+#ifdef HAVE_IO_URING
+  if (m_ioUring != nullptr) {
+    m_ioUring->receive(this, m_socket.native_handle(),
+                       [this] (int result, const uint8_t* data) { this->handleUringReceive(result, data); });
+    return;
+  }
+#endif
+
   m_socket.async_receive(boost::asio::buffer(m_receiveBuffer + m_receiveBufferSize,
                                              ndn::MAX_NDN_PACKET_SIZE - m_receiveBufferSize),
                          [this] (auto&&... args) { this->handleReceive(std::forward<decltype(args)>(args)...); });
@@ -243,9 +307,20 @@ StreamTransport<T>::handleReceive(const boost::system::error_code& error,
 
   NFD_LOG_FACE_TRACE("Received: " << nBytesReceived << " bytes");
 
+  if (processReceiveBuffer(nBytesReceived))
+    startReceive();
+}
+
+template<class T>
+bool
+StreamTransport<T>::processReceiveBuffer(size_t nBytesReceived)
+{
   m_receiveBufferSize += nBytesReceived;
   size_t offset = 0;
   bool isOk = true;
+  // all packets completed by this read arrived together, processing the earlier ones
+  // must not delay the receive time of the later ones
+  auto rxTime = time::steady_clock::now();
   while (m_receiveBufferSize - offset > 0) {
     Block element;
     std::tie(isOk, element) = Block::fromBuffer(m_receiveBuffer + offset, m_receiveBufferSize - offset);
@@ -255,14 +330,16 @@ StreamTransport<T>::handleReceive(const boost::system::error_code& error,
     offset += element.size();
     BOOST_ASSERT(offset <= m_receiveBufferSize);
 
-    this->receive(Transport::Packet(std::move(element)));
+    Transport::Packet tp(std::move(element));
+    tp.rxTime = rxTime;
+    this->receive(std::move(tp));
   }
 
   if (!isOk && m_receiveBufferSize == ndn::MAX_NDN_PACKET_SIZE && offset == 0) {
     NFD_LOG_FACE_ERROR("Failed to parse incoming packet or packet too large to process");
     this->setState(TransportState::FAILED);
     doClose();
-    return;
+    return false;
   }
 
   if (offset > 0) {
@@ -275,7 +352,72 @@ StreamTransport<T>::handleReceive(const boost::system::error_code& error,
     }
   }
 
-  startReceive();
+  return true;
+}
+
+#ifdef HAVE_IO_URING
+template<class T>
+void
+StreamTransport<T>::handleUringSend(int result)
+{
+  if (result < 0) {
+    // sends after a failed one in the same chain are cancelled by the kernel
+    if (result != -ECANCELED)
+      processErrorCode(boost::system::error_code(-result, boost::system::system_category()));
+    return;
+  }
+
+  BOOST_ASSERT(!m_sendQueue.empty());
+  BOOST_ASSERT(m_nUringSendsInFlight > 0);
+  if (static_cast<size_t>(result) != m_sendQueue.front().size()) {
+    // MSG_WAITALL makes the kernel retry short sends, so this happens only if the connection is lost
+    return processErrorCode(boost::asio::error::connection_reset);
+  }
+
+  NFD_LOG_FACE_TRACE("Successfully sent: " << result << " bytes");
+
+  m_sendQueueBytes -= result;
+  m_sendQueue.pop_front();
+
+  if (--m_nUringSendsInFlight == 0 && !m_sendQueue.empty())
+    sendFromQueue();
+}
+
+template<class T>
+void
+StreamTransport<T>::handleUringReceive(int result, const uint8_t* data)
+{
+  if (result == 0)
+    return processErrorCode(boost::asio::error::eof);
+  if (result < 0)
+    return processErrorCode(boost::system::error_code(-result, boost::system::system_category()));
+
+  NFD_LOG_FACE_TRACE("Received: " << result << " bytes");
+
+  // a received segment may be larger than the free space of the receive buffer
+  size_t nBytesRemaining = static_cast<size_t>(result);
+  while (nBytesRemaining > 0) {
+    size_t nBytesCopied = std::min(nBytesRemaining, ndn::MAX_NDN_PACKET_SIZE - m_receiveBufferSize);
+    std::copy_n(data, nBytesCopied, m_receiveBuffer + m_receiveBufferSize);
+    data += nBytesCopied;
+    nBytesRemaining -= nBytesCopied;
+
+    if (!processReceiveBuffer(nBytesCopied) || getState() != TransportState::UP)
+      return;
+  }
+}
+#endif
+
+template<class T>
+void
+StreamTransport<T>::cancelUringOperations()
+{
+#ifdef HAVE_IO_URING
+  if (m_ioUring != nullptr) {
+    m_ioUring->cancel(this);
+    m_nUringSendsInFlight = 0;
+  }
+#endif
 }
 
 template<class T>
@@ -320,9 +462,13 @@ template<class T>
 void
 StreamTransport<T>::resetSendQueue()
 {
-  std::queue<Block> emptyQueue;
+  std::deque<Block> emptyQueue;
   std::swap(emptyQueue, m_sendQueue);
   m_sendQueueBytes = 0;
+#ifdef HAVE_IO_URING
+  m_nUringSendsInFlight = 0;
+#endif
+  m_txQueueLength.invalidate();
 }
 
 template<class T>
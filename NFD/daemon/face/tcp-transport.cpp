@@ -60,23 +60,24 @@ TcpTransport::TcpTransport(protocol::socket&& socket,
 ssize_t
 TcpTransport::getSendQueueLength()
 {
-  int queueLength = getSendQueueBytes();
-
   // We want to obtain the amount of "not sent" bytes instead of the amount of "not sent" + "not
   // acked" bytes. On Linux, we use SIOCOUTQNSD for this reason. However, macOS does not provide an
   // efficient mechanism to obtain this value (SO_NWRITE includes both "not sent" and "not acked").
+  ssize_t nsd = m_txQueueLength.get([this] () -> ssize_t {
 #if defined(__linux__)
-  int nsd;
-  if (ioctl(m_socket.native_handle(), SIOCOUTQNSD, &nsd) < 0) {
-    NFD_LOG_FACE_WARN("Failed to obtain send queue length from socket: " << std::strerror(errno));
-  }
-  else if (nsd > 0) {
+    int nsd;
+    if (ioctl(m_socket.native_handle(), SIOCOUTQNSD, &nsd) < 0) {
+      NFD_LOG_FACE_WARN("Failed to obtain send queue length from socket: " << std::strerror(errno));
+      return 0;
+    }
     NFD_LOG_FACE_TRACE("SIOCOUTQNSD=" << nsd);
-    queueLength += nsd;
-  }
+    return nsd;
+#else
+    return 0;
 #endif
+  });
 
-  return queueLength;
+  return getSendQueueBytes() + std::max<ssize_t>(0, nsd);
 }
 
 bool
@@ -108,6 +109,7 @@ TcpTransport::handleError(const boost::system::error_code& error)
     // cancel all outstanding operations
     boost::system::error_code ec;
     m_socket.cancel(ec);
+    this->cancelUringOperations();
 
     // do this asynchronously because there could be some callbacks still pending
     getGlobalIoService().post([this] { reconnect(); });
@@ -125,6 +125,10 @@ Transport::receive(Packet&& packet)
   ++this->nInPackets;
   this->nInBytes += packet.packet.size();
 
+  if (packet.rxTime == time::steady_clock::TimePoint()) {
+    packet.rxTime = time::steady_clock::now();
+  }
+
   m_service->receivePacket(std::move(packet));
 }
 
@@ -139,6 +139,14 @@ public:
      *  and incoming packets from different remote endpoints have different EndpointIds.
      */
     EndpointId remoteEndpoint;
+
+    /** \brief time at which an incoming packet arrived
+     *
+     *  A transport that obtains a receive timestamp from the kernel sets this field before
+     *  calling Transport::receive; otherwise, Transport::receive sets it to the current time.
+     *  It is unused on outgoing packets.
+     */
+    time::steady_clock::TimePoint rxTime;
   };
 
   /** \brief counters provided by Transport
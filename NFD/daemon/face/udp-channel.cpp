@@ -37,11 +37,13 @@ namespace ip = boost::asio::ip;
 
 UdpChannel::UdpChannel(const udp::Endpoint& localEndpoint,
                        time::nanoseconds idleTimeout,
-                       bool wantCongestionMarking)
+                       bool wantCongestionMarking,
+                       bool wantSegmentationOffload)
   : m_localEndpoint(localEndpoint)
   , m_socket(getGlobalIoService())
   , m_idleFaceTimeout(idleTimeout)
   , m_wantCongestionMarking(wantCongestionMarking)
+  , m_wantSegmentationOffload(wantSegmentationOffload)
 {
   setUri(FaceUri(m_localEndpoint));
   NFD_LOG_CHAN_INFO("Creating channel");
@@ -163,6 +165,7 @@ UdpChannel::createFace(const udp::Endpoint& remoteEndpoint,
   options.allowFragmentation = true;
   options.allowReassembly = true;
   options.reliabilityOptions.isEnabled = params.wantLpReliability;
+  options.allowAggregation = params.wantLpAggregation;
 
   if (boost::logic::indeterminate(params.wantCongestionMarking)) {
     // Use default value for this channel if parameter is indeterminate
@@ -181,7 +184,8 @@ UdpChannel::createFace(const udp::Endpoint& remoteEndpoint,
 
   auto linkService = make_unique<GenericLinkService>(options);
   auto transport = make_unique<UnicastUdpTransport>(std::move(socket), params.persistency,
-                                                    m_idleFaceTimeout, params.mtu);
+                                                    m_idleFaceTimeout, params.mtu,
+                                                    m_wantSegmentationOffload);
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
 
   m_channelFaces[remoteEndpoint] = face;
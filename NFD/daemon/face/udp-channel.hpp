@@ -46,10 +46,13 @@ public:
    * To enable creation of faces upon incoming connections,
    * one needs to explicitly call UdpChannel::listen method.
    * The created socket is bound to \p localEndpoint.
+   * If \p wantSegmentationOffload is true, faces created by this channel use
+   * UDP GSO/GRO when the kernel supports it.
    */
   UdpChannel(const udp::Endpoint& localEndpoint,
              time::nanoseconds idleTimeout,
-             bool wantCongestionMarking);
+             bool wantCongestionMarking,
+             bool wantSegmentationOffload = false);
 
   bool
   isListening() const override
@@ -114,6 +117,7 @@ private:
   std::map<udp::Endpoint, shared_ptr<Face>> m_channelFaces;
   const time::nanoseconds m_idleFaceTimeout; ///< Timeout for automatic closure of idle on-demand faces
   bool m_wantCongestionMarking;
+  bool m_wantSegmentationOffload;
 };
 
 } // namespace face
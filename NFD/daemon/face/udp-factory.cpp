@@ -66,6 +66,7 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
   //   enable_v4 yes
   //   enable_v6 yes
   //   idle_timeout 600
+  //   gso no
   //   mcast yes
   //   mcast_group 224.0.23.170
   //   mcast_port 56363
@@ -88,6 +89,7 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
   bool enableV4 = false;
   bool enableV6 = false;
   uint32_t idleTimeout = 600;
+  bool wantSegmentationOffload = false;
   MulticastConfig mcastConfig;
 
   if (configSection) {
@@ -113,6 +115,14 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
       else if (key == "idle_timeout") {
         idleTimeout = ConfigFile::parseNumber<uint32_t>(pair, "face_system.udp");
       }
+      else if (key == "gso") {
+        wantSegmentationOffload = ConfigFile::parseYesNo(pair, "face_system.udp");
+#ifndef HAVE_UDP_GSO
+        if (wantSegmentationOffload) {
+          NDN_THROW(ConfigFile::Error("face_system.udp.gso is not supported on this platform"));
+        }
+#endif
+      }
       else if (key == "keep_alive_interval") {
         // ignored
       }
@@ -155,6 +165,9 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
         bool wantAdHoc = ConfigFile::parseYesNo(pair, "face_system.udp");
         mcastConfig.linkType = wantAdHoc ? ndn::nfd::LINK_TYPE_AD_HOC : ndn::nfd::LINK_TYPE_MULTI_ACCESS;
       }
+      else if (key == "mcast_aggregation") {
+        mcastConfig.wantAggregation = ConfigFile::parseYesNo(pair, "face_system.udp");
+      }
       else if (key == "whitelist") {
         mcastConfig.netifPredicate.parseWhitelist(value);
       }
@@ -177,6 +190,11 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
     return;
   }
 
+  if (m_wantSegmentationOffload != wantSegmentationOffload && !m_channels.empty()) {
+    NFD_LOG_WARN("Cannot change segmentation offload setting on existing channels");
+  }
+  m_wantSegmentationOffload = wantSegmentationOffload;
+
   if (enableV4) {
     udp::Endpoint endpoint(ip::udp::v4(), port);
     shared_ptr<UdpChannel> v4Channel = this->createChannel(endpoint, time::seconds(idleTimeout));
@@ -216,6 +234,9 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
     if (m_mcastConfig.linkType != mcastConfig.linkType && !m_mcastFaces.empty()) {
       NFD_LOG_WARN("Cannot change ad hoc setting on existing faces");
     }
+    if (m_mcastConfig.wantAggregation != mcastConfig.wantAggregation && !m_mcastFaces.empty()) {
+      NFD_LOG_WARN("Cannot change aggregation setting on existing faces");
+    }
     if (m_mcastConfig.group != mcastConfig.group) {
       NFD_LOG_INFO("changing IPv4 multicast group from " << m_mcastConfig.group <<
                    " to " << mcastConfig.group);
@@ -302,7 +323,8 @@ UdpFactory::createChannel(const udp::Endpoint& localEndpoint,
                     ", endpoint already allocated to a UDP multicast face"));
   }
 
-  auto channel = std::make_shared<UdpChannel>(localEndpoint, idleTimeout, m_wantCongestionMarking);
+  auto channel = std::make_shared<UdpChannel>(localEndpoint, idleTimeout, m_wantCongestionMarking,
+                                              m_wantSegmentationOffload);
   m_channels[localEndpoint] = channel;
   return channel;
 }
@@ -354,6 +376,7 @@ UdpFactory::createMulticastFace(const shared_ptr<const net::NetworkInterface>& n
 
   GenericLinkService::Options options;
   options.allowCongestionMarking = m_wantCongestionMarking;
+  options.allowAggregation = m_mcastConfig.wantAggregation;
   auto linkService = make_unique<GenericLinkService>(options);
   auto transport = make_unique<MulticastUdpTransport>(mcastEp, std::move(rxSock), std::move(txSock),
                                                       m_mcastConfig.linkType);
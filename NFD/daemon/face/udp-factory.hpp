@@ -123,6 +123,7 @@ private:
 
 private:
   bool m_wantCongestionMarking = false;
+  bool m_wantSegmentationOffload = false;
   std::map<udp::Endpoint, shared_ptr<UdpChannel>> m_channels;
 
   struct MulticastConfig
@@ -132,6 +133,7 @@ private:
     udp::Endpoint groupV6 = udp::getDefaultMulticastGroupV6();
     ndn::nfd::LinkType linkType = ndn::nfd::LINK_TYPE_MULTI_ACCESS;
     NetworkInterfacePredicate netifPredicate;
+    bool wantAggregation = false;
   };
   MulticastConfig m_mcastConfig;
   std::map<udp::Endpoint, shared_ptr<Face>> m_mcastFaces;
@@ -44,7 +44,8 @@ public:
                            const ethernet::Address& remoteEndpoint,
                            ndn::nfd::FacePersistency persistency,
                            time::nanoseconds idleTimeout,
-                           optional<ssize_t> overrideMtu = {});
+                           optional<ssize_t> overrideMtu = {},
+                           Backend backend = Backend::PCAP);
 
 protected:
   bool
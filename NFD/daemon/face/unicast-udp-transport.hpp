@@ -39,10 +39,15 @@ NFD_LOG_MEMBER_DECL_SPECIALIZED((DatagramTransport<boost::asio::ip::udp, Unicast
 class UnicastUdpTransport final : public DatagramTransport<boost::asio::ip::udp, Unicast>
 {
 public:
+  /**
+   * \param wantSegmentationOffload whether to send and receive runs of datagrams with
+   *                                UDP GSO/GRO, if supported by the kernel
+   */
   UnicastUdpTransport(protocol::socket&& socket,
                       ndn::nfd::FacePersistency persistency,
                       time::nanoseconds idleTimeout,
-                      optional<ssize_t> overrideMtu = {});
+                      optional<ssize_t> overrideMtu = {},
+                      bool wantSegmentationOffload = false);
 
 protected:
   bool
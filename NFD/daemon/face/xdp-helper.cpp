@@ -0,0 +1,518 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "xdp-helper.hpp"
+#include "ethernet-protocol.hpp"
+
+#include <cerrno>
+#include <cstring> // for memcpy(), strerror()
+
+#include <linux/bpf.h>
+#include <linux/ethtool.h>
+#include <linux/if_link.h>
+#include <linux/if_packet.h>
+#include <linux/sockios.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <boost/endian/conversion.hpp>
+
+#ifndef SOL_XDP
+#define SOL_XDP 283
+#endif
+
+namespace nfd {
+namespace face {
+
+constexpr size_t XdpHelper::N_RX_FRAMES;
+constexpr size_t XdpHelper::N_TX_FRAMES;
+
+static std::string
+errnoToString(const std::string& what)
+{
+  return what + ": " + std::strerror(errno);
+}
+
+static int
+sysBpf(int cmd, bpf_attr& attr)
+{
+  return ::syscall(__NR_bpf, cmd, &attr, sizeof(attr));
+}
+
+static bpf_insn
+makeInsn(uint8_t code, uint8_t dst, uint8_t src, int16_t off, int32_t imm)
+{
+  bpf_insn insn{};
+  insn.code = code;
+  insn.dst_reg = dst;
+  insn.src_reg = src;
+  insn.off = off;
+  insn.imm = imm;
+  return insn;
+}
+
+/** \brief build the XDP program that redirects NDN multicast frames to the XSKMAP \p mapFd
+ *
+ *  The program is equivalent to:
+ *  \code
+ *  if (data + ETH_HLEN > data_end || !(eth->h_dest[0] & 1) || eth->h_proto != htons(ETHERTYPE_NDN))
+ *    return XDP_PASS;
+ *  return bpf_redirect_map(&xsks, ctx->rx_queue_index, XDP_PASS);
+ *  \endcode
+ *  Frames with a VLAN tag do not match, and are passed to the kernel.
+ */
+static std::vector<bpf_insn>
+makeRedirectProgram(int mapFd)
+{
+  const int16_t passOffset = 16;
+  const int32_t ethertype = boost::endian::native_to_big(ethernet::ETHERTYPE_NDN);
+
+  std::vector<bpf_insn> prog{
+    /*  0 */ makeInsn(BPF_LDX | BPF_W | BPF_MEM, BPF_REG_2, BPF_REG_1, offsetof(xdp_md, data), 0),
+    /*  1 */ makeInsn(BPF_LDX | BPF_W | BPF_MEM, BPF_REG_3, BPF_REG_1, offsetof(xdp_md, data_end), 0),
+    /*  2 */ makeInsn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_4, BPF_REG_2, 0, 0),
+    /*  3 */ makeInsn(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_4, 0, 0, ethernet::HDR_LEN),
+    /*  4 */ makeInsn(BPF_JMP | BPF_JGT | BPF_X, BPF_REG_4, BPF_REG_3, passOffset - 5, 0),
+    /*  5 */ makeInsn(BPF_LDX | BPF_B | BPF_MEM, BPF_REG_4, BPF_REG_2, 0, 0),
+    /*  6 */ makeInsn(BPF_ALU64 | BPF_AND | BPF_K, BPF_REG_4, 0, 0, 1),
+    /*  7 */ makeInsn(BPF_JMP | BPF_JEQ | BPF_K, BPF_REG_4, 0, passOffset - 8, 0),
+    /*  8 */ makeInsn(BPF_LDX | BPF_H | BPF_MEM, BPF_REG_4, BPF_REG_2, 2 * ethernet::ADDR_LEN, 0),
+    /*  9 */ makeInsn(BPF_JMP | BPF_JNE | BPF_K, BPF_REG_4, 0, passOffset - 10, ethertype),
+    /* 10 */ makeInsn(BPF_LDX | BPF_W | BPF_MEM, BPF_REG_2, BPF_REG_1, offsetof(xdp_md, rx_queue_index), 0),
+    /* 11 */ makeInsn(BPF_LD | BPF_DW | BPF_IMM, BPF_REG_1, BPF_PSEUDO_MAP_FD, 0, mapFd),
+    /* 12 */ makeInsn(0, 0, 0, 0, 0),
+    /* 13 */ makeInsn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_3, 0, 0, XDP_PASS),
+    /* 14 */ makeInsn(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_redirect_map),
+    /* 15 */ makeInsn(BPF_JMP | BPF_EXIT, 0, 0, 0, 0),
+    /* 16 */ makeInsn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, XDP_PASS),
+    /* 17 */ makeInsn(BPF_JMP | BPF_EXIT, 0, 0, 0, 0),
+  };
+  return prog;
+}
+
+XdpHelper::XdpHelper(const std::string& interfaceName, size_t mtu)
+  : m_fd(-1)
+  , m_ctlFd(-1)
+  , m_mapFd(-1)
+  , m_progFd(-1)
+  , m_linkFd(-1)
+  , m_ifIndex(0)
+  , m_frameSize(0)
+  , m_isZeroCopy(false)
+  , m_umem(nullptr)
+  , m_umemSize(0)
+  , m_hasRxFrame(false)
+  , m_nDropped(0)
+{
+  // the kernel reserves XDP_PACKET_HEADROOM octets at the beginning of each UMEM frame,
+  // and the frame size must be a power of two between 2048 and the page size
+  size_t maxFrameLen = XDP_PACKET_HEADROOM + ethernet::HDR_LEN + mtu;
+  if (maxFrameLen <= 2048)
+    m_frameSize = 2048;
+  else if (maxFrameLen <= static_cast<size_t>(::sysconf(_SC_PAGESIZE)))
+    m_frameSize = ::sysconf(_SC_PAGESIZE);
+  else
+    NDN_THROW(Error("MTU " + to_string(mtu) + " is too large for AF_XDP"));
+
+  m_ifIndex = ::if_nametoindex(interfaceName.data());
+  if (m_ifIndex == 0)
+    NDN_THROW(Error(errnoToString("if_nametoindex")));
+
+  m_fd = ::socket(AF_XDP, SOCK_RAW, 0);
+  if (m_fd < 0)
+    NDN_THROW(Error(errnoToString("socket(AF_XDP)")));
+
+  // protocol 0: this socket never receives anything
+  m_ctlFd = ::socket(AF_PACKET, SOCK_RAW, 0);
+  if (m_ctlFd < 0) {
+    int err = errno;
+    close();
+    errno = err;
+    NDN_THROW(Error(errnoToString("socket(AF_PACKET)")));
+  }
+}
+
+XdpHelper::~XdpHelper()
+{
+  close();
+}
+
+uint32_t
+XdpHelper::getRxQueueCount(const std::string& interfaceName)
+{
+  if (interfaceName.size() >= IFNAMSIZ)
+    NDN_THROW(Error("Interface name " + interfaceName + " is too long"));
+
+  int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0)
+    NDN_THROW(Error(errnoToString("socket(AF_INET)")));
+
+  ethtool_channels channels{};
+  channels.cmd = ETHTOOL_GCHANNELS;
+  ifreq ifr{};
+  std::memcpy(ifr.ifr_name, interfaceName.data(), interfaceName.size());
+  ifr.ifr_data = reinterpret_cast<char*>(&channels);
+  int ret = ::ioctl(fd, SIOCETHTOOL, &ifr);
+  int err = errno;
+  ::close(fd);
+
+  if (ret < 0) {
+    if (err == EOPNOTSUPP)
+      return 1;
+    errno = err;
+    NDN_THROW(Error(errnoToString("ioctl(ETHTOOL_GCHANNELS)")));
+  }
+  uint32_t count = channels.rx_count + channels.combined_count;
+  return count > 0 ? count : 1;
+}
+
+void
+XdpHelper::activate()
+{
+  m_umemSize = (N_RX_FRAMES + N_TX_FRAMES) * m_frameSize;
+  void* umem = ::mmap(nullptr, m_umemSize, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+  if (umem == MAP_FAILED) {
+    m_umemSize = 0;
+    NDN_THROW(Error(errnoToString("mmap(UMEM)")));
+  }
+  m_umem = static_cast<uint8_t*>(umem);
+
+  xdp_umem_reg reg{};
+  reg.addr = reinterpret_cast<uintptr_t>(m_umem);
+  reg.len = m_umemSize;
+  reg.chunk_size = m_frameSize;
+  reg.headroom = 0;
+  if (::setsockopt(m_fd, SOL_XDP, XDP_UMEM_REG, &reg, sizeof(reg)) < 0)
+    NDN_THROW(Error(errnoToString("setsockopt(XDP_UMEM_REG)")));
+
+  auto setRingSize = [this] (int optname, uint32_t size, const char* what) {
+    if (::setsockopt(m_fd, SOL_XDP, optname, &size, sizeof(size)) < 0)
+      NDN_THROW(Error(errnoToString(std::string("setsockopt(") + what + ")")));
+  };
+  setRingSize(XDP_UMEM_FILL_RING, N_RX_FRAMES, "XDP_UMEM_FILL_RING");
+  setRingSize(XDP_UMEM_COMPLETION_RING, N_TX_FRAMES, "XDP_UMEM_COMPLETION_RING");
+  setRingSize(XDP_RX_RING, N_RX_FRAMES, "XDP_RX_RING");
+  setRingSize(XDP_TX_RING, N_TX_FRAMES, "XDP_TX_RING");
+
+  xdp_mmap_offsets offsets{};
+  socklen_t len = sizeof(offsets);
+  if (::getsockopt(m_fd, SOL_XDP, XDP_MMAP_OFFSETS, &offsets, &len) < 0)
+    NDN_THROW(Error(errnoToString("getsockopt(XDP_MMAP_OFFSETS)")));
+
+  mapRing(m_rx, offsets.rx, sizeof(xdp_desc), N_RX_FRAMES, XDP_PGOFF_RX_RING);
+  mapRing(m_tx, offsets.tx, sizeof(xdp_desc), N_TX_FRAMES, XDP_PGOFF_TX_RING);
+  mapRing(m_fill, offsets.fr, sizeof(uint64_t), N_RX_FRAMES, XDP_UMEM_PGOFF_FILL_RING);
+  mapRing(m_completion, offsets.cr, sizeof(uint64_t), N_TX_FRAMES, XDP_UMEM_PGOFF_COMPLETION_RING);
+
+  // the first N_RX_FRAMES frames of the UMEM are handed over to the kernel for reception,
+  // the remaining ones are used for transmission
+  auto fillDesc = static_cast<uint64_t*>(m_fill.desc);
+  for (size_t i = 0; i < N_RX_FRAMES; ++i) {
+    fillDesc[i] = i * m_frameSize;
+  }
+  __atomic_store_n(m_fill.producer, N_RX_FRAMES, __ATOMIC_RELEASE);
+
+  m_txFreeFrames.clear();
+  m_txFreeFrames.reserve(N_TX_FRAMES);
+  for (size_t i = N_RX_FRAMES + N_TX_FRAMES; i > N_RX_FRAMES; --i) {
+    m_txFreeFrames.push_back((i - 1) * m_frameSize);
+  }
+
+  bool isNativeMode = attachProgram();
+
+  sockaddr_xdp sxdp{};
+  sxdp.sxdp_family = AF_XDP;
+  sxdp.sxdp_ifindex = m_ifIndex;
+  sxdp.sxdp_queue_id = 0;
+  sxdp.sxdp_flags = XDP_ZEROCOPY | XDP_USE_NEED_WAKEUP;
+  m_isZeroCopy = isNativeMode &&
+                 ::bind(m_fd, reinterpret_cast<sockaddr*>(&sxdp), sizeof(sxdp)) == 0;
+  if (!m_isZeroCopy) {
+    // the driver does not support zero-copy, let the kernel copy frames into the UMEM
+    sxdp.sxdp_flags = XDP_COPY | XDP_USE_NEED_WAKEUP;
+    if (::bind(m_fd, reinterpret_cast<sockaddr*>(&sxdp), sizeof(sxdp)) < 0)
+      NDN_THROW(Error(errnoToString("bind")));
+  }
+
+  // start redirecting frames received on queue 0 into the socket
+  uint32_t key = 0;
+  uint32_t value = m_fd;
+  bpf_attr attr{};
+  attr.map_fd = m_mapFd;
+  attr.key = reinterpret_cast<uintptr_t>(&key);
+  attr.value = reinterpret_cast<uintptr_t>(&value);
+  attr.flags = BPF_ANY;
+  if (sysBpf(BPF_MAP_UPDATE_ELEM, attr) < 0)
+    NDN_THROW(Error(errnoToString("bpf(BPF_MAP_UPDATE_ELEM)")));
+}
+
+bool
+XdpHelper::attachProgram()
+{
+  bpf_attr attr{};
+  attr.map_type = BPF_MAP_TYPE_XSKMAP;
+  attr.key_size = sizeof(uint32_t);
+  attr.value_size = sizeof(uint32_t);
+  attr.max_entries = 1;
+  m_mapFd = sysBpf(BPF_MAP_CREATE, attr);
+  if (m_mapFd < 0)
+    NDN_THROW(Error(errnoToString("bpf(BPF_MAP_CREATE)")));
+
+  auto prog = makeRedirectProgram(m_mapFd);
+  static const char license[] = "GPL";
+  attr = {};
+  attr.prog_type = BPF_PROG_TYPE_XDP;
+  attr.insn_cnt = prog.size();
+  attr.insns = reinterpret_cast<uintptr_t>(prog.data());
+  attr.license = reinterpret_cast<uintptr_t>(license);
+  m_progFd = sysBpf(BPF_PROG_LOAD, attr);
+  if (m_progFd < 0)
+    NDN_THROW(Error(errnoToString("bpf(BPF_PROG_LOAD)")));
+
+  // the program is detached when the link is closed, even if NFD terminates abnormally
+  attr = {};
+  attr.link_create.prog_fd = m_progFd;
+  attr.link_create.target_ifindex = m_ifIndex;
+  attr.link_create.attach_type = BPF_XDP;
+  attr.link_create.flags = XDP_FLAGS_DRV_MODE;
+  m_linkFd = sysBpf(BPF_LINK_CREATE, attr);
+  if (m_linkFd >= 0)
+    return true;
+
+  // the driver does not support XDP, fall back to generic XDP
+  attr.link_create.flags = XDP_FLAGS_SKB_MODE;
+  m_linkFd = sysBpf(BPF_LINK_CREATE, attr);
+  if (m_linkFd < 0)
+    NDN_THROW(Error(errnoToString("bpf(BPF_LINK_CREATE)")));
+  return false;
+}
+
+void
+XdpHelper::mapRing(Ring& ring, const xdp_ring_offset& offsets, size_t descSize,
+                   uint32_t size, off_t pgoff)
+{
+  ring.mapSize = offsets.desc + size * descSize;
+  void* map = ::mmap(nullptr, ring.mapSize, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, m_fd, pgoff);
+  if (map == MAP_FAILED) {
+    ring.mapSize = 0;
+    NDN_THROW(Error(errnoToString("mmap(ring)")));
+  }
+
+  auto base = static_cast<uint8_t*>(map);
+  ring.map = map;
+  ring.producer = reinterpret_cast<uint32_t*>(base + offsets.producer);
+  ring.consumer = reinterpret_cast<uint32_t*>(base + offsets.consumer);
+  ring.flags = reinterpret_cast<uint32_t*>(base + offsets.flags);
+  ring.desc = base + offsets.desc;
+  ring.size = size;
+}
+
+void
+XdpHelper::unmapRing(Ring& ring)
+{
+  if (ring.map != nullptr) {
+    ::munmap(ring.map, ring.mapSize);
+  }
+  ring = {};
+}
+
+void
+XdpHelper::close()
+{
+  if (m_fd >= 0) {
+    // save the final statistics before the socket goes away
+    try {
+      getNDropped();
+    }
+    catch (const Error&) {
+    }
+  }
+
+  for (int* fd : {&m_linkFd, &m_progFd, &m_mapFd}) {
+    if (*fd >= 0) {
+      ::close(*fd);
+      *fd = -1;
+    }
+  }
+
+  unmapRing(m_rx);
+  unmapRing(m_tx);
+  unmapRing(m_fill);
+  unmapRing(m_completion);
+
+  if (m_fd >= 0) {
+    ::close(m_fd);
+    m_fd = -1;
+  }
+  if (m_ctlFd >= 0) {
+    ::close(m_ctlFd);
+    m_ctlFd = -1;
+  }
+  if (m_umem != nullptr) {
+    ::munmap(m_umem, m_umemSize);
+    m_umem = nullptr;
+    m_umemSize = 0;
+  }
+  m_hasRxFrame = false;
+  m_txFreeFrames.clear();
+}
+
+int
+XdpHelper::getFd() const
+{
+  // we need to duplicate the fd, otherwise both close() and the
+  // caller may attempt to close the same fd and one of them will fail
+  int fd = ::dup(m_fd);
+  if (fd < 0)
+    NDN_THROW(Error(errnoToString("dup")));
+  return fd;
+}
+
+size_t
+XdpHelper::getNDropped() const
+{
+  if (m_fd < 0)
+    return m_nDropped;
+
+  // older kernels do not report all fields
+  xdp_statistics stats{};
+  socklen_t len = sizeof(stats);
+  if (::getsockopt(m_fd, SOL_XDP, XDP_STATISTICS, &stats, &len) < 0)
+    NDN_THROW(Error(errnoToString("getsockopt(XDP_STATISTICS)")));
+
+  m_nDropped = stats.rx_dropped + stats.rx_ring_full;
+  return m_nDropped;
+}
+
+void
+XdpHelper::recycleRxFrame()
+{
+  uint32_t rxCons = *m_rx.consumer;
+  uint64_t addr = static_cast<const xdp_desc*>(m_rx.desc)[rxCons & (m_rx.size - 1)].addr;
+
+  // the fill ring can hold all receive frames, so there is always room
+  uint32_t fillProd = *m_fill.producer;
+  static_cast<uint64_t*>(m_fill.desc)[fillProd & (m_fill.size - 1)] = addr - addr % m_frameSize;
+  __atomic_store_n(m_fill.producer, fillProd + 1, __ATOMIC_RELEASE);
+  __atomic_store_n(m_rx.consumer, rxCons + 1, __ATOMIC_RELEASE);
+  m_hasRxFrame = false;
+}
+
+std::tuple<const uint8_t*, size_t, std::string>
+XdpHelper::readNextPacket()
+{
+  if (m_umem == nullptr || m_rx.map == nullptr)
+    return std::make_tuple(nullptr, 0, "");
+
+  if (m_hasRxFrame) {
+    recycleRxFrame();
+  }
+
+  uint32_t cons = *m_rx.consumer;
+  if (cons == __atomic_load_n(m_rx.producer, __ATOMIC_ACQUIRE)) {
+    if (__atomic_load_n(m_fill.flags, __ATOMIC_ACQUIRE) & XDP_RING_NEED_WAKEUP) {
+      // the driver ran out of receive frames, wake it up
+      ::recvfrom(m_fd, nullptr, 0, MSG_DONTWAIT, nullptr, nullptr);
+    }
+    return std::make_tuple(nullptr, 0, "");
+  }
+
+  const xdp_desc& desc = static_cast<const xdp_desc*>(m_rx.desc)[cons & (m_rx.size - 1)];
+  m_hasRxFrame = true;
+  return std::make_tuple(m_umem + desc.addr, desc.len, "");
+}
+
+void
+XdpHelper::reclaimTxFrames()
+{
+  uint32_t cons = *m_completion.consumer;
+  uint32_t prod = __atomic_load_n(m_completion.producer, __ATOMIC_ACQUIRE);
+  if (cons == prod)
+    return;
+
+  auto desc = static_cast<const uint64_t*>(m_completion.desc);
+  for (; cons != prod; ++cons) {
+    m_txFreeFrames.push_back(desc[cons & (m_completion.size - 1)]);
+  }
+  __atomic_store_n(m_completion.consumer, cons, __ATOMIC_RELEASE);
+}
+
+ssize_t
+XdpHelper::send(const uint8_t* frame, size_t size)
+{
+  if (m_umem == nullptr || m_tx.map == nullptr) {
+    errno = EBADF;
+    return -1;
+  }
+
+  if (size > m_frameSize) {
+    errno = EMSGSIZE;
+    return -1;
+  }
+
+  reclaimTxFrames();
+  if (m_txFreeFrames.empty()) {
+    // wait for the kernel to transmit queued frames
+    flush();
+    reclaimTxFrames();
+    if (m_txFreeFrames.empty()) {
+      errno = ENOBUFS;
+      return -1;
+    }
+  }
+
+  // every frame in the transmit ring comes from m_txFreeFrames, so there is always room
+  uint64_t addr = m_txFreeFrames.back();
+  m_txFreeFrames.pop_back();
+  std::memcpy(m_umem + addr, frame, size);
+
+  uint32_t prod = *m_tx.producer;
+  xdp_desc& desc = static_cast<xdp_desc*>(m_tx.desc)[prod & (m_tx.size - 1)];
+  desc.addr = addr;
+  desc.len = size;
+  desc.options = 0;
+  __atomic_store_n(m_tx.producer, prod + 1, __ATOMIC_RELEASE);
+  return size;
+}
+
+void
+XdpHelper::flush()
+{
+  if (m_tx.map == nullptr)
+    return;
+
+  if (__atomic_load_n(m_tx.flags, __ATOMIC_ACQUIRE) & XDP_RING_NEED_WAKEUP) {
+    ::sendto(m_fd, nullptr, 0, MSG_DONTWAIT, nullptr, 0);
+  }
+}
+
+} // namespace face
+} // namespace nfd
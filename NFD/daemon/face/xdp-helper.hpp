@@ -0,0 +1,232 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_XDP_HELPER_HPP
+#define NFD_DAEMON_FACE_XDP_HELPER_HPP
+
+#include "core/common.hpp"
+
+#ifndef HAVE_AF_XDP
+#error "Cannot include this file when AF_XDP is not available"
+#endif
+
+#include <linux/if_xdp.h>
+
+namespace nfd {
+namespace face {
+
+/**
+ * @brief Helper class for AF_XDP sockets.
+ *
+ * An XDP program attached to the network interface redirects NDN frames sent to a multicast
+ * or broadcast address into the AF_XDP socket, bypassing the kernel network stack; all other
+ * traffic, including NDN frames sent to a unicast address, is passed to the kernel as usual.
+ * Frames are exchanged with the kernel through a memory area (UMEM) shared with the driver.
+ * Zero-copy mode is used if the driver supports it, otherwise the kernel copies each frame
+ * into the UMEM (copy mode), which works with any driver including veth.
+ *
+ * Only frames received on queue 0 of the network interface are redirected. On multi-queue
+ * NICs, NDN frames must be steered to that queue, e.g., with `ethtool -N`; getRxQueueCount()
+ * can be used to detect such NICs before creating the socket.
+ */
+class XdpHelper : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /**
+   * @brief Create an AF_XDP socket for a network interface.
+   * @param interfaceName name of the network interface
+   * @param mtu MTU of the network interface, used to size the UMEM frames
+   * @throw Error on any error
+   */
+  XdpHelper(const std::string& interfaceName, size_t mtu);
+
+  ~XdpHelper();
+
+  /**
+   * @brief Get the number of receive queues of a network interface.
+   *
+   * The count is obtained with ETHTOOL_GCHANNELS. It is 1 if the driver does not report channels.
+   *
+   * @throw Error on any error
+   */
+  static uint32_t
+  getRxQueueCount(const std::string& interfaceName);
+
+  /**
+   * @brief Attach the XDP program to the network interface and start receiving frames.
+   * @throw Error on any error
+   */
+  void
+  activate();
+
+  /**
+   * @brief Detach the XDP program, release the UMEM, and close the socket.
+   */
+  void
+  close();
+
+  /**
+   * @brief Obtain a file descriptor that can be used in calls such as select(2) and poll(2).
+   * @pre activate() has been called.
+   * @return A selectable file descriptor. It is the caller's responsibility to close the fd.
+   * @throw Error on any error
+   */
+  int
+  getFd() const;
+
+  /**
+   * @brief Obtain an AF_PACKET socket bound to the same network interface.
+   *
+   * The socket does not receive any frame. It can be used for operations not supported by
+   * AF_XDP sockets, such as joining a link-layer multicast group with PACKET_ADD_MEMBERSHIP.
+   */
+  int
+  getControlFd() const
+  {
+    return m_ctlFd;
+  }
+
+  /**
+   * @brief Get the number of frames dropped by the kernel.
+   * @throw Error on any error
+   */
+  size_t
+  getNDropped() const;
+
+  /**
+   * @brief Return true if the socket operates in zero-copy mode.
+   */
+  bool
+  isZeroCopy() const
+  {
+    return m_isZeroCopy;
+  }
+
+  /**
+   * @brief Read the next frame from the receive ring.
+   * @return If a frame is available, returns a tuple containing a pointer to the frame
+   *         (including the link-layer header) and the size of the frame; the third
+   *         element must be ignored. If no frame is available, returns a tuple containing
+   *         nullptr, 0, and an empty string.
+   * @warning The returned pointer must not be freed by the caller, and is valid only
+   *          until the next call to this function.
+   */
+  std::tuple<const uint8_t*, size_t, std::string>
+  readNextPacket();
+
+  /**
+   * @brief Queue a complete frame for transmission.
+   *
+   * The frame is copied into the UMEM and is sent on the next call to flush().
+   *
+   * @return number of octets queued, or -1 on error with errno set;
+   *         errno is ENOBUFS if all transmit frames are in use
+   */
+  ssize_t
+  send(const uint8_t* frame, size_t size);
+
+  /**
+   * @brief Ask the kernel to transmit all queued frames, if needed.
+   */
+  void
+  flush();
+
+public:
+  static constexpr size_t N_RX_FRAMES = 2048;
+  static constexpr size_t N_TX_FRAMES = 2048;
+
+private:
+  void
+  recycleRxFrame();
+
+  void
+  reclaimTxFrames();
+
+  /**
+   * @brief Load the XDP program and attach it to the network interface.
+   * @return whether the program runs in the driver (native mode)
+   */
+  bool
+  attachProgram();
+
+private:
+  /**
+   * @brief Producer/consumer ring shared with the kernel
+   */
+  struct Ring
+  {
+    uint32_t* producer = nullptr;
+    uint32_t* consumer = nullptr;
+    uint32_t* flags = nullptr;
+    void* desc = nullptr;
+    uint32_t size = 0;
+    void* map = nullptr;
+    size_t mapSize = 0;
+  };
+
+  void
+  mapRing(Ring& ring, const xdp_ring_offset& offsets, size_t descSize,
+          uint32_t size, off_t pgoff);
+
+  void
+  unmapRing(Ring& ring);
+
+private:
+  int m_fd;
+  int m_ctlFd;
+  int m_mapFd;
+  int m_progFd;
+  int m_linkFd;
+  int m_ifIndex;
+  size_t m_frameSize;
+  bool m_isZeroCopy;
+
+  uint8_t* m_umem;
+  size_t m_umemSize;
+  Ring m_rx;
+  Ring m_tx;
+  Ring m_fill;
+  Ring m_completion;
+
+  bool m_hasRxFrame; ///< whether a frame returned by readNextPacket() is yet to be recycled
+  std::vector<uint64_t> m_txFreeFrames; ///< UMEM addresses of transmit frames not in use
+
+  mutable size_t m_nDropped;
+};
+
+} // namespace face
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_XDP_HELPER_HPP
@@ -50,6 +50,37 @@ wouldViolateScope(const Face& inFace, const Interest& interest, const Face& outF
   return false;
 }
 
+fib::NextHopMask
+getEligibleNextHopsMask(const Face& inFace, const Interest& interest, const fib::Entry& fibEntry)
+{
+  fib::NextHopMask mask = fibEntry.getAllNextHopsMask();
+
+  // do not forward back to the same face, unless it is ad hoc
+  mask &= ~(fibEntry.getNextHopsMaskByFace(inFace) & ~fibEntry.getAdHocNextHopsMask());
+
+  // same conditions as wouldViolateScope, applied to all non-local faces at once
+  if (scope_prefix::LOCALHOST.isPrefixOf(interest.getName()) ||
+      (scope_prefix::LOCALHOP.isPrefixOf(interest.getName()) &&
+       inFace.getScope() != ndn::nfd::FACE_SCOPE_LOCAL)) {
+    mask &= fibEntry.getLocalNextHopsMask();
+  }
+
+  return mask;
+}
+
+fib::NextHopMask
+getNextHopsWithUnexpiredOutRecordMask(const pit::Entry& pitEntry, const fib::Entry& fibEntry,
+                                      time::steady_clock::TimePoint now)
+{
+  fib::NextHopMask mask = 0;
+  for (const pit::OutRecord& outRecord : pitEntry.getOutRecords()) {
+    if (outRecord.getExpiry() > now) {
+      mask |= fibEntry.getNextHopsMaskByFace(outRecord.getFace());
+    }
+  }
+  return mask;
+}
+
 bool
 canForwardToLegacy(const pit::Entry& pitEntry, const Face& face)
 {
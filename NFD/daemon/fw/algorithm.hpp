@@ -27,6 +27,7 @@
 #define NFD_DAEMON_FW_PIT_ALGORITHM_HPP
 
 #include "core/scope-prefix.hpp"
+#include "table/fib-entry.hpp"
 #include "table/pit-entry.hpp"
 
 /** \file
@@ -42,6 +43,27 @@ namespace fw {
 bool
 wouldViolateScope(const Face& inFace, const Interest& interest, const Face& outFace);
 
+/** \brief compute the nexthops of \p fibEntry to which an Interest from \p inFace may be forwarded
+ *
+ *  A nexthop is eligible if it is not \p inFace (unless that face is ad hoc),
+ *  and forwarding to it would not violate scope.
+ *  This is equivalent to applying those checks to every nexthop, but uses the masks
+ *  precomputed by \p fibEntry instead of visiting each face.
+ *
+ *  \pre fibEntry.hasNextHopMasks()
+ *  \sa wouldViolateScope
+ */
+fib::NextHopMask
+getEligibleNextHopsMask(const Face& inFace, const Interest& interest, const fib::Entry& fibEntry);
+
+/** \brief compute the nexthops of \p fibEntry that have an out-record in \p pitEntry
+ *         expiring after \p now
+ *  \pre fibEntry.hasNextHopMasks()
+ */
+fib::NextHopMask
+getNextHopsWithUnexpiredOutRecordMask(const pit::Entry& pitEntry, const fib::Entry& fibEntry,
+                                      time::steady_clock::TimePoint now);
+
 /** \brief decide whether Interest can be forwarded to face
  *
  *  \return true if out-record of this face does not exist or has expired,
@@ -65,23 +65,19 @@ RttStats::computeSrtt(Rtt previousSrtt, Rtt currentRtt)
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
-FaceInfo::FaceInfo()
-  : m_isTimeoutScheduled(false)
+FaceInfo::FaceInfo(FaceId faceId)
+  : m_faceId(faceId)
+  , m_expiry(time::steady_clock::TimePoint::max())
+  , m_isTimeoutScheduled(false)
   , m_nSilentTimeouts(0)
 {
 }
 
-FaceInfo::~FaceInfo()
-{
-  cancelTimeoutEvent();
-  m_measurementExpirationId.cancel();
-}
-
 void
-FaceInfo::setTimeoutEvent(const scheduler::EventId& id, const Name& interestName)
+FaceInfo::setTimeout(time::steady_clock::TimePoint deadline, const Name& interestName)
 {
   if (!m_isTimeoutScheduled) {
-    m_timeoutEventId = id;
+    m_timeoutDeadline = deadline;
     m_isTimeoutScheduled = true;
     m_lastInterestName = interestName;
   }
@@ -91,17 +87,10 @@ FaceInfo::setTimeoutEvent(const scheduler::EventId& id, const Name& interestName
 }
 
 void
-FaceInfo::cancelTimeoutEvent()
-{
-  m_timeoutEventId.cancel();
-  m_isTimeoutScheduled = false;
-}
-
-void
-FaceInfo::cancelTimeoutEvent(const Name& prefix)
+FaceInfo::cancelTimeout(const Name& prefix)
 {
   if (isTimeoutScheduled() && doesNameMatchLastInterest(prefix)) {
-    cancelTimeoutEvent();
+    m_isTimeoutScheduled = false;
   }
 }
 
@@ -112,7 +101,8 @@ FaceInfo::doesNameMatchLastInterest(const Name& name)
 }
 
 void
-FaceInfo::recordRtt(const shared_ptr<pit::Entry>& pitEntry, const Face& inFace)
+FaceInfo::recordRtt(const shared_ptr<pit::Entry>& pitEntry, const Face& inFace,
+                    time::steady_clock::TimePoint rxTime)
 {
   // Calculate RTT
   auto outRecord = pitEntry->getOutRecord(inFace, 0);
@@ -122,7 +112,7 @@ FaceInfo::recordRtt(const shared_ptr<pit::Entry>& pitEntry, const Face& inFace)
     return;
   }
 
-  time::steady_clock::Duration steadyRtt = time::steady_clock::now() - outRecord->getLastRenewed();
+  auto steadyRtt = std::max(rxTime - outRecord->getLastRenewed(), time::steady_clock::Duration::zero());
   auto durationRtt = time::duration_cast<RttEstimator::Duration>(steadyRtt);
 
   m_rttStats.addRttMeasurement(durationRtt);
@@ -136,65 +126,120 @@ void
 FaceInfo::recordTimeout(const Name& interestName)
 {
   m_rttStats.recordTimeout();
-  cancelTimeoutEvent(interestName);
+  cancelTimeout(interestName);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
 NamespaceInfo::NamespaceInfo()
-  : m_isProbingDue(false)
+  : m_timeoutEventTime(time::steady_clock::TimePoint::max())
+  , m_isProbingDue(false)
   , m_hasFirstProbeBeenScheduled(false)
 {
 }
 
+FaceInfoTable::iterator
+NamespaceInfo::find(FaceId faceId)
+{
+  auto now = time::steady_clock::now();
+  return std::find_if(m_fit.begin(), m_fit.end(), [=] (const FaceInfo& info) {
+    return info.getFaceId() == faceId && info.getExpiry() > now;
+  });
+}
+
+FaceInfoTable::iterator
+NamespaceInfo::insert(FaceId faceId)
+{
+  // expired records are only erased here, so that find() does not invalidate pointers
+  auto now = time::steady_clock::now();
+  m_fit.erase(std::remove_if(m_fit.begin(), m_fit.end(),
+                             [=] (const FaceInfo& info) { return info.getExpiry() <= now; }),
+              m_fit.end());
+  BOOST_ASSERT(find(faceId) == end());
+
+  m_fit.emplace_back(faceId);
+  m_fit.back().setExpiry(now + AsfMeasurements::MEASUREMENTS_LIFETIME);
+  return std::prev(m_fit.end());
+}
+
 FaceInfo*
 NamespaceInfo::getFaceInfo(const fib::Entry&, FaceId faceId)
 {
-  auto it = m_fit.find(faceId);
-  if (it != m_fit.end()) {
-    return &it->second;
-  }
-  else {
-    return nullptr;
-  }
+  return get(faceId);
 }
 
 FaceInfo&
 NamespaceInfo::getOrCreateFaceInfo(const fib::Entry&, FaceId faceId)
 {
-  auto it = m_fit.find(faceId);
-  FaceInfo* info = nullptr;
-
-  if (it == m_fit.end()) {
-    const auto& pair = m_fit.emplace(faceId, FaceInfo());
-    info = &pair.first->second;
-
-    extendFaceInfoLifetime(*info, faceId);
+  auto it = find(faceId);
+  if (it == end()) {
+    it = insert(faceId);
   }
-  else {
-    info = &it->second;
-  }
-
-  return *info;
+  return *it;
 }
 
 void
 NamespaceInfo::expireFaceInfo(FaceId faceId)
 {
-  m_fit.erase(faceId);
+  m_fit.erase(std::remove_if(m_fit.begin(), m_fit.end(),
+                             [=] (const FaceInfo& info) { return info.getFaceId() == faceId; }),
+              m_fit.end());
+}
+
+void
+NamespaceInfo::extendFaceInfoLifetime(FaceInfo& info, FaceId)
+{
+  info.setExpiry(time::steady_clock::now() + AsfMeasurements::MEASUREMENTS_LIFETIME);
+}
+
+void
+NamespaceInfo::scheduleTimeout(FaceInfo& info, RttEstimator::Duration timeout,
+                               const Name& interestName, const TimeoutCallback& onTimeout)
+{
+  auto deadline = time::steady_clock::now() + timeout;
+  info.setTimeout(deadline, interestName);
+  m_onTimeout = onTimeout;
+
+  if (deadline < m_timeoutEventTime) {
+    m_timeoutEventTime = deadline;
+    m_timeoutEvent = getScheduler().schedule(timeout, [this] { onTimeoutEvent(); });
+  }
 }
 
 void
-NamespaceInfo::extendFaceInfoLifetime(FaceInfo& info, FaceId faceId)
+NamespaceInfo::onTimeoutEvent()
 {
-  // Cancel previous expiration
-  info.getMeasurementExpirationEventId().cancel();
+  auto now = time::steady_clock::now();
+  m_timeoutEventTime = time::steady_clock::TimePoint::max();
+
+  std::vector<std::pair<Name, FaceId>> expired;
+  for (FaceInfo& info : m_fit) {
+    if (!info.isTimeoutScheduled()) {
+      continue;
+    }
+    if (info.getExpiry() <= now) {
+      // measurements of this face expired before its timeout
+      info.m_isTimeoutScheduled = false;
+    }
+    else if (info.getTimeoutDeadline() <= now) {
+      info.m_isTimeoutScheduled = false;
+      expired.emplace_back(info.m_lastInterestName, info.getFaceId());
+    }
+    else {
+      m_timeoutEventTime = std::min(m_timeoutEventTime, info.getTimeoutDeadline());
+    }
+  }
+
+  if (m_timeoutEventTime != time::steady_clock::TimePoint::max()) {
+    m_timeoutEvent = getScheduler().schedule(m_timeoutEventTime - now, [this] { onTimeoutEvent(); });
+  }
 
-  // Refresh measurement
-  auto id = getScheduler().schedule(AsfMeasurements::MEASUREMENTS_LIFETIME,
-                                    [=] { expireFaceInfo(faceId); });
-  info.setMeasurementExpirationEventId(id);
+  // the callback may insert FaceInfo records, so it is invoked after the loop
+  TimeoutCallback onTimeout = m_onTimeout;
+  for (const auto& timeout : expired) {
+    onTimeout(timeout.first, timeout.second);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
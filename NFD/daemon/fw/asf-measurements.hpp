@@ -88,7 +88,11 @@ private:
 ////////////////////////////////////////////////////////////////////////////////
 
 /** \brief Strategy information for each face in a namespace
-*/
+ *
+ *  FaceInfo records have no scheduler events of their own: the RTO timeout is a deadline
+ *  served by the timeout event of the NamespaceInfo, and the measurement lifetime is an
+ *  expiry time that is checked on lookup.
+ */
 class FaceInfo
 {
 public:
@@ -102,36 +106,60 @@ public:
     }
   };
 
-  FaceInfo();
+  explicit
+  FaceInfo(FaceId faceId);
 
-  ~FaceInfo();
+  FaceId
+  getFaceId() const
+  {
+    return m_faceId;
+  }
 
+  /** \brief set the RTO timeout of an Interest forwarded to this face
+   *  \param deadline when the timeout expires
+   *  \param interestName name of the Interest
+   *  \throw Error a timeout is already set
+   */
   void
-  setTimeoutEvent(const scheduler::EventId& id, const Name& interestName);
+  setTimeout(time::steady_clock::TimePoint deadline, const Name& interestName);
 
+  /** \brief clear the timeout if it was set for an Interest whose name is a prefix of \p prefix
+   */
   void
-  setMeasurementExpirationEventId(const scheduler::EventId& id)
+  cancelTimeout(const Name& prefix);
+
+  bool
+  isTimeoutScheduled() const
   {
-    m_measurementExpirationId = id;
+    return m_isTimeoutScheduled;
   }
 
-  const scheduler::EventId&
-  getMeasurementExpirationEventId()
+  time::steady_clock::TimePoint
+  getTimeoutDeadline() const
   {
-    return m_measurementExpirationId;
+    return m_timeoutDeadline;
   }
 
-  void
-  cancelTimeoutEvent(const Name& prefix);
+  /** \return when the measurements of this face expire
+   */
+  time::steady_clock::TimePoint
+  getExpiry() const
+  {
+    return m_expiry;
+  }
 
-  bool
-  isTimeoutScheduled() const
+  void
+  setExpiry(time::steady_clock::TimePoint expiry)
   {
-    return m_isTimeoutScheduled;
+    m_expiry = expiry;
   }
 
+  /** \brief record the RTT of the Interest forwarded to \p inFace
+   *  \param rxTime time at which the Data arrived at the transport
+   */
   void
-  recordRtt(const shared_ptr<pit::Entry>& pitEntry, const Face& inFace);
+  recordRtt(const shared_ptr<pit::Entry>& pitEntry, const Face& inFace,
+            time::steady_clock::TimePoint rxTime);
 
   void
   recordTimeout(const Name& interestName);
@@ -179,26 +207,31 @@ public:
   }
 
 private:
-  void
-  cancelTimeoutEvent();
-
   bool
   doesNameMatchLastInterest(const Name& name);
 
 private:
+  FaceId m_faceId;
   RttStats m_rttStats;
   Name m_lastInterestName;
 
-  // Timeout associated with measurement
-  scheduler::EventId m_measurementExpirationId;
+  // Expiration of measurements
+  time::steady_clock::TimePoint m_expiry;
 
   // RTO associated with Interest
-  scheduler::EventId m_timeoutEventId;
+  time::steady_clock::TimePoint m_timeoutDeadline;
   bool m_isTimeoutScheduled;
   size_t m_nSilentTimeouts;
+
+  friend class NamespaceInfo;
 };
 
-typedef std::unordered_map<FaceId, FaceInfo> FaceInfoTable;
+/** \brief FaceInfo records of a namespace
+ *
+ *  A namespace typically has only a few faces, so a flat array searched linearly is faster
+ *  and more compact than a hash table.
+ */
+typedef std::vector<FaceInfo> FaceInfoTable;
 
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -208,6 +241,10 @@ typedef std::unordered_map<FaceId, FaceInfo> FaceInfoTable;
 class NamespaceInfo : public StrategyInfo
 {
 public:
+  /** \brief callback invoked when the RTO timeout of \p faceId expires
+   */
+  typedef std::function<void(const Name& interestName, FaceId faceId)> TimeoutCallback;
+
   NamespaceInfo();
 
   static constexpr int
@@ -216,6 +253,8 @@ public:
     return 1030;
   }
 
+  /** \warning Creating a FaceInfo invalidates pointers and references to other FaceInfo records.
+   */
   FaceInfo&
   getOrCreateFaceInfo(const fib::Entry& fibEntry, FaceId faceId);
 
@@ -231,19 +270,14 @@ public:
   FaceInfo*
   get(FaceId faceId)
   {
-    if (m_fit.find(faceId) != m_fit.end()) {
-      return &m_fit.at(faceId);
-    }
-    else {
-      return nullptr;
-    }
+    auto it = find(faceId);
+    return it == end() ? nullptr : &*it;
   }
 
+  /** \return the unexpired FaceInfo of \p faceId, or end()
+   */
   FaceInfoTable::iterator
-  find(FaceId faceId)
-  {
-    return m_fit.find(faceId);
-  }
+  find(FaceId faceId);
 
   FaceInfoTable::iterator
   end()
@@ -251,11 +285,22 @@ public:
     return m_fit.end();
   }
 
-  const FaceInfoTable::iterator
-  insert(FaceId faceId)
-  {
-    return m_fit.emplace(faceId, FaceInfo()).first;
-  }
+  /** \brief create a FaceInfo for \p faceId, which must not have an unexpired FaceInfo
+   *  \warning This invalidates pointers and references to other FaceInfo records.
+   */
+  FaceInfoTable::iterator
+  insert(FaceId faceId);
+
+  /** \brief set the RTO timeout of \p info to expire after \p timeout
+   *
+   *  All faces of the namespace share a single scheduler event, which is set for the
+   *  earliest timeout. When it fires, \p onTimeout is invoked for every expired timeout.
+   *
+   *  \throw FaceInfo::Error a timeout is already set on \p info
+   */
+  void
+  scheduleTimeout(FaceInfo& info, RttEstimator::Duration timeout, const Name& interestName,
+                  const TimeoutCallback& onTimeout);
 
   bool
   isProbingDue() const
@@ -281,9 +326,20 @@ public:
     m_hasFirstProbeBeenScheduled = hasBeenScheduled;
   }
 
+private:
+  /** \brief process expired timeouts and set the timeout event for the next one
+   */
+  void
+  onTimeoutEvent();
+
 private:
   FaceInfoTable m_fit;
 
+  scheduler::ScopedEventId m_timeoutEvent;
+  /// when m_timeoutEvent fires, or TimePoint::max() if it is not set
+  time::steady_clock::TimePoint m_timeoutEventTime;
+  TimeoutCallback m_onTimeout;
+
   bool m_isProbingDue;
   bool m_hasFirstProbeBeenScheduled;
 };
@@ -172,13 +172,13 @@ AsfStrategy::beforeSatisfyInterest(const shared_ptr<pit::Entry>& pitEntry,
   if (faceInfo == nullptr) {
     return;
   }
-  faceInfo->recordRtt(pitEntry, ingress.face);
+  faceInfo->recordRtt(pitEntry, ingress.face, face::getRxTime(data));
 
   // Extend lifetime for measurements associated with Face
   namespaceInfo->extendFaceInfoLifetime(*faceInfo, ingress.face.getId());
 
   if (faceInfo->isTimeoutScheduled()) {
-    faceInfo->cancelTimeoutEvent(data.getName());
+    faceInfo->cancelTimeout(data.getName());
   }
 }
 
@@ -227,9 +227,10 @@ AsfStrategy::forwardInterest(const Interest& interest,
     NFD_LOG_TRACE("Scheduling timeout for " << fibEntry.getPrefix() << " to: " << egress
                   << " in " << time::duration_cast<time::milliseconds>(timeout) << " ms");
 
-    auto id = getScheduler().schedule(timeout, bind(&AsfStrategy::onTimeout, this,
-                                                    interest.getName(), egress.face.getId()));
-    faceInfo.setTimeoutEvent(id, interest.getName());
+    namespaceInfo.scheduleTimeout(faceInfo, timeout, interest.getName(),
+                                  [this] (const Name& interestName, FaceId faceId) {
+                                    onTimeout(interestName, faceId);
+                                  });
   }
 }
 
@@ -336,7 +337,7 @@ AsfStrategy::onTimeout(const Name& interestName, const face::FaceId faceId)
     it = namespaceInfo->insert(faceId);
   }
 
-  FaceInfo& faceInfo = it->second;
+  FaceInfo& faceInfo = *it;
 
   faceInfo.setNSilentTimeouts(faceInfo.getNSilentTimeouts() + 1);
 
@@ -347,7 +348,7 @@ AsfStrategy::onTimeout(const Name& interestName, const face::FaceId faceId)
     namespaceInfo->extendFaceInfoLifetime(faceInfo, faceId);
 
     if (faceInfo.isTimeoutScheduled()) {
-      faceInfo.cancelTimeoutEvent(interestName);
+      faceInfo.cancelTimeout(interestName);
     }
   }
   else {
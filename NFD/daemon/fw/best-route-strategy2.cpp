@@ -52,6 +52,7 @@ BestRouteStrategy2::BestRouteStrategy2(Forwarder& forwarder, const Name& name)
       "BestRouteStrategy2 does not support version " + to_string(*parsed.version)));
   }
   this->setInstanceName(makeInstanceName(name, getStrategyName()));
+  this->setFlowCacheable(true);
 }
 
 const Name&
@@ -97,19 +98,55 @@ isNextHopEligible(const Face& inFace, const Interest& interest,
   return true;
 }
 
+/** \brief pick the eligible NextHop with lowest cost
+ *  \param wantUnused if true, NextHop must not have unexpired out-record
+ *  \param now time::steady_clock::now(), ignored if !wantUnused
+ */
+static fib::NextHopList::const_iterator
+findFirstEligibleNextHop(const Face& inFace, const Interest& interest,
+                         const fib::Entry& fibEntry,
+                         const shared_ptr<pit::Entry>& pitEntry,
+                         bool wantUnused = false,
+                         time::steady_clock::TimePoint now = time::steady_clock::TimePoint::min())
+{
+  const fib::NextHopList& nexthops = fibEntry.getNextHops();
+
+  if (!fibEntry.hasNextHopMasks()) {
+    return std::find_if(nexthops.begin(), nexthops.end(), [&] (const auto& nexthop) {
+      return isNextHopEligible(inFace, interest, nexthop, pitEntry, wantUnused, now);
+    });
+  }
+
+  fib::NextHopMask mask = getEligibleNextHopsMask(inFace, interest, fibEntry);
+  if (wantUnused) {
+    mask &= ~getNextHopsWithUnexpiredOutRecordMask(*pitEntry, fibEntry, now);
+  }
+  if (mask == 0) {
+    return nexthops.end();
+  }
+  // nexthops are sorted by cost, so the lowest set bit is the cheapest eligible nexthop
+  return nexthops.begin() + __builtin_ctzll(mask);
+}
+
 /** \brief pick an eligible NextHop with earliest out-record
  *  \note It is assumed that every nexthop has an out-record.
  */
 static fib::NextHopList::const_iterator
 findEligibleNextHopWithEarliestOutRecord(const Face& inFace, const Interest& interest,
-                                         const fib::NextHopList& nexthops,
+                                         const fib::Entry& fibEntry,
                                          const shared_ptr<pit::Entry>& pitEntry)
 {
+  const fib::NextHopList& nexthops = fibEntry.getNextHops();
+  bool hasMasks = fibEntry.hasNextHopMasks();
+  fib::NextHopMask mask = hasMasks ? getEligibleNextHopsMask(inFace, interest, fibEntry) : 0;
+
   auto found = nexthops.end();
   auto earliestRenewed = time::steady_clock::TimePoint::max();
 
   for (auto it = nexthops.begin(); it != nexthops.end(); ++it) {
-    if (!isNextHopEligible(inFace, interest, *it, pitEntry))
+    bool isEligible = hasMasks ? (mask >> (it - nexthops.begin())) & 1 :
+                                 isNextHopEligible(inFace, interest, *it, pitEntry);
+    if (!isEligible)
       continue;
 
     auto outRecord = pitEntry->getOutRecord(it->getFace(), 0);
@@ -139,9 +176,7 @@ BestRouteStrategy2::afterReceiveInterest(const FaceEndpoint& ingress, const Inte
 
   if (suppression == RetxSuppressionResult::NEW) {
     // forward to nexthop with lowest cost except downstream
-    it = std::find_if(nexthops.begin(), nexthops.end(), [&] (const auto& nexthop) {
-      return isNextHopEligible(ingress.face, interest, nexthop, pitEntry);
-    });
+    it = findFirstEligibleNextHop(ingress.face, interest, fibEntry, pitEntry);
 
     if (it == nexthops.end()) {
       NFD_LOG_DEBUG(interest << " from=" << ingress << " noNextHop");
@@ -161,9 +196,8 @@ BestRouteStrategy2::afterReceiveInterest(const FaceEndpoint& ingress, const Inte
   }
 
   // find an unused upstream with lowest cost except downstream
-  it = std::find_if(nexthops.begin(), nexthops.end(), [&] (const auto& nexthop) {
-    return isNextHopEligible(ingress.face, interest, nexthop, pitEntry, true, time::steady_clock::now());
-  });
+  it = findFirstEligibleNextHop(ingress.face, interest, fibEntry, pitEntry,
+                                true, time::steady_clock::now());
 
   if (it != nexthops.end()) {
     auto egress = FaceEndpoint(it->getFace(), 0);
@@ -173,7 +207,7 @@ BestRouteStrategy2::afterReceiveInterest(const FaceEndpoint& ingress, const Inte
   }
 
   // find an eligible upstream that is used earliest
-  it = findEligibleNextHopWithEarliestOutRecord(ingress.face, interest, nexthops, pitEntry);
+  it = findEligibleNextHopWithEarliestOutRecord(ingress.face, interest, fibEntry, pitEntry);
   if (it == nexthops.end()) {
     NFD_LOG_DEBUG(interest << " from=" << ingress << " retransmitNoNextHop");
   }
@@ -0,0 +1,223 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "consistent-hash-strategy.hpp"
+#include "algorithm.hpp"
+#include "core/city-hash.hpp"
+#include "core/logger.hpp"
+
+#include <cmath>
+
+namespace nfd {
+namespace fw {
+
+NFD_LOG_INIT(ConsistentHashStrategy);
+NFD_REGISTER_STRATEGY(ConsistentHashStrategy);
+
+const time::milliseconds ConsistentHashStrategy::RETX_SUPPRESSION_INITIAL(10);
+const time::milliseconds ConsistentHashStrategy::RETX_SUPPRESSION_MAX(250);
+
+ConsistentHashStrategy::ConsistentHashStrategy(Forwarder& forwarder, const Name& name)
+  : Strategy(forwarder)
+  , ProcessNackTraits(this)
+  , m_retxSuppression(RETX_SUPPRESSION_INITIAL,
+                      RetxSuppressionExponential::DEFAULT_MULTIPLIER,
+                      RETX_SUPPRESSION_MAX)
+{
+  ParsedInstanceName parsed = parseInstanceName(name);
+  if (!parsed.parameters.empty()) {
+    NDN_THROW(std::invalid_argument("ConsistentHashStrategy does not accept parameters"));
+  }
+  if (parsed.version && *parsed.version != getStrategyName()[-1].toVersion()) {
+    NDN_THROW(std::invalid_argument(
+      "ConsistentHashStrategy does not support version " + to_string(*parsed.version)));
+  }
+  this->setInstanceName(makeInstanceName(name, getStrategyName()));
+}
+
+const Name&
+ConsistentHashStrategy::getStrategyName()
+{
+  static Name strategyName("/localhost/nfd/strategy/consistent-hash/%FD%01");
+  return strategyName;
+}
+
+uint64_t
+ConsistentHashStrategy::computeKey(const Interest& interest)
+{
+  if (interest.hasHashCode()) {
+    std::string hashCode = interest.getHashCode();
+    return CityHash64(hashCode.data(), hashCode.size());
+  }
+
+  const Block& nameWire = interest.getName().wireEncode();
+  return CityHash64(reinterpret_cast<const char*>(nameWire.wire()), nameWire.size());
+}
+
+double
+ConsistentHashStrategy::computeScore(uint64_t key, FaceId faceId, uint64_t cost)
+{
+  uint64_t h = Hash128to64(uint128(key, faceId));
+  // the 53 most significant bits, mapped to the open interval (0, 1)
+  double u = (static_cast<double>(h >> 11) + 0.5) / static_cast<double>(uint64_t(1) << 53);
+  // a nexthop of cost zero is weighted as if it had cost one
+  double weight = 1.0 / static_cast<double>(std::max<uint64_t>(cost, 1));
+  return -weight / std::log(u);
+}
+
+/** \brief determines whether a NextHop is eligible
+ *  \param wantUnused if true, NextHop must not have unexpired out-record
+ *  \param now time::steady_clock::now(), ignored if !wantUnused
+ */
+static bool
+isNextHopEligible(const Face& inFace, const Interest& interest,
+                  const fib::NextHop& nexthop, const shared_ptr<pit::Entry>& pitEntry,
+                  bool wantUnused, time::steady_clock::TimePoint now)
+{
+  const Face& outFace = nexthop.getFace();
+
+  // do not forward back to the same face, unless it is ad hoc
+  if (outFace.getId() == inFace.getId() && outFace.getLinkType() != ndn::nfd::LINK_TYPE_AD_HOC)
+    return false;
+
+  // forwarding would violate scope
+  if (wouldViolateScope(inFace, interest, outFace))
+    return false;
+
+  if (wantUnused) {
+    // nexthop must not have unexpired out-record
+    auto outRecord = pitEntry->getOutRecord(outFace, 0);
+    if (outRecord != pitEntry->out_end() && outRecord->getExpiry() > now) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/** \brief pick the eligible NextHop with the highest score for \p key
+ *  \param wantUnused if true, NextHop must not have unexpired out-record
+ *  \param now time::steady_clock::now(), ignored if !wantUnused
+ */
+static fib::NextHopList::const_iterator
+findHighestScoringNextHop(uint64_t key, const Face& inFace, const Interest& interest,
+                          const fib::Entry& fibEntry, const shared_ptr<pit::Entry>& pitEntry,
+                          bool wantUnused = false,
+                          time::steady_clock::TimePoint now = time::steady_clock::TimePoint::min())
+{
+  const fib::NextHopList& nexthops = fibEntry.getNextHops();
+
+  bool hasMasks = fibEntry.hasNextHopMasks();
+  fib::NextHopMask mask = 0;
+  if (hasMasks) {
+    mask = getEligibleNextHopsMask(inFace, interest, fibEntry);
+    if (wantUnused) {
+      mask &= ~getNextHopsWithUnexpiredOutRecordMask(*pitEntry, fibEntry, now);
+    }
+  }
+
+  auto found = nexthops.end();
+  double highestScore = 0.0;
+  for (auto it = nexthops.begin(); it != nexthops.end(); ++it) {
+    bool isEligible = hasMasks ? (mask >> (it - nexthops.begin())) & 1 :
+                                 isNextHopEligible(inFace, interest, *it, pitEntry, wantUnused, now);
+    if (!isEligible)
+      continue;
+
+    double score = ConsistentHashStrategy::computeScore(key, it->getFace().getId(), it->getCost());
+    if (found == nexthops.end() || score > highestScore) {
+      found = it;
+      highestScore = score;
+    }
+  }
+
+  return found;
+}
+
+void
+ConsistentHashStrategy::afterReceiveInterest(const FaceEndpoint& ingress, const Interest& interest,
+                                             const shared_ptr<pit::Entry>& pitEntry)
+{
+  RetxSuppressionResult suppression = m_retxSuppression.decidePerPitEntry(*pitEntry);
+  if (suppression == RetxSuppressionResult::SUPPRESS) {
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " suppressed");
+    return;
+  }
+
+  const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
+  const fib::NextHopList& nexthops = fibEntry.getNextHops();
+  uint64_t key = computeKey(interest);
+
+  if (suppression == RetxSuppressionResult::NEW) {
+    auto it = findHighestScoringNextHop(key, ingress.face, interest, fibEntry, pitEntry);
+
+    if (it == nexthops.end()) {
+      NFD_LOG_DEBUG(interest << " from=" << ingress << " noNextHop");
+
+      lp::NackHeader nackHeader;
+      nackHeader.setReason(lp::NackReason::NO_ROUTE);
+      this->sendNack(pitEntry, ingress, nackHeader);
+
+      this->rejectPendingInterest(pitEntry);
+      return;
+    }
+
+    auto egress = FaceEndpoint(it->getFace(), 0);
+    this->sendInterest(pitEntry, egress, interest);
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " newPitEntry-to=" << egress);
+    return;
+  }
+
+  // fail over to the next unused upstream in rendezvous order
+  auto it = findHighestScoringNextHop(key, ingress.face, interest, fibEntry, pitEntry,
+                                      true, time::steady_clock::now());
+  if (it != nexthops.end()) {
+    auto egress = FaceEndpoint(it->getFace(), 0);
+    this->sendInterest(pitEntry, egress, interest);
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " retransmit-unused-to=" << egress);
+    return;
+  }
+
+  // all upstreams have been used, retry the one that owns the content key
+  it = findHighestScoringNextHop(key, ingress.face, interest, fibEntry, pitEntry);
+  if (it == nexthops.end()) {
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " retransmitNoNextHop");
+  }
+  else {
+    auto egress = FaceEndpoint(it->getFace(), 0);
+    this->sendInterest(pitEntry, egress, interest);
+    NFD_LOG_DEBUG(interest << " from=" << ingress << " retransmit-retry-to=" << egress);
+  }
+}
+
+void
+ConsistentHashStrategy::afterReceiveNack(const FaceEndpoint& ingress, const lp::Nack& nack,
+                                         const shared_ptr<pit::Entry>& pitEntry)
+{
+  this->processNack(ingress.face, nack, pitEntry);
+}
+
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_CONSISTENT_HASH_STRATEGY_HPP
+#define NFD_DAEMON_FW_CONSISTENT_HASH_STRATEGY_HPP
+
+#include "strategy.hpp"
+#include "process-nack-traits.hpp"
+#include "retx-suppression-exponential.hpp"
+
+namespace nfd {
+namespace fw {
+
+/** \brief a forwarding strategy that spreads Interests across FIB nexthops by content
+ *
+ *  This strategy maps each Interest to one nexthop with weighted rendezvous hashing
+ *  (highest random weight): every eligible nexthop is scored with a hash of the Interest's
+ *  content key and its FaceId, and the Interest is forwarded to the nexthop with the highest
+ *  score. The content key is the HashCode of the Interest if present, otherwise its Name.
+ *  Each nexthop receives a share of the content keys proportional to the inverse of its
+ *  cost, so that an upstream of cost 10 receives twice as many keys as an upstream of cost 20.
+ *
+ *  Because a content key always maps to the same upstream, the upstream caches partition the
+ *  content. When a nexthop is added or removed, only the keys that map to that nexthop are
+ *  remapped; the other keys keep their upstream.
+ *
+ *  If the consumer retransmits the Interest (and is not suppressed according to exponential
+ *  backoff algorithm), the strategy forwards it to the highest-scoring nexthop that has not
+ *  been used yet, or again to the highest-scoring nexthop if all have been used.
+ *
+ *  This strategy returns Nack to all downstreams with reason NoRoute if there is no usable
+ *  nexthop, and returns Nack to all downstreams if all upstreams have returned Nacks.
+ *
+ *  \note This strategy is not EndpointId-aware.
+ */
+class ConsistentHashStrategy : public Strategy
+                             , public ProcessNackTraits<ConsistentHashStrategy>
+{
+public:
+  explicit
+  ConsistentHashStrategy(Forwarder& forwarder, const Name& name = getStrategyName());
+
+  static const Name&
+  getStrategyName();
+
+  void
+  afterReceiveInterest(const FaceEndpoint& ingress, const Interest& interest,
+                       const shared_ptr<pit::Entry>& pitEntry) override;
+
+  void
+  afterReceiveNack(const FaceEndpoint& ingress, const lp::Nack& nack,
+                   const shared_ptr<pit::Entry>& pitEntry) override;
+
+  /** \brief compute the content key of an Interest
+   *  \return a hash of the HashCode of \p interest, or a hash of its Name if it has no HashCode
+   */
+  static uint64_t
+  computeKey(const Interest& interest);
+
+  /** \brief compute the rendezvous score of a nexthop for a content key
+   *
+   *  The score is -w / ln(u), where u is a uniform hash of \p key and \p faceId in (0, 1),
+   *  and w is the weight of the nexthop. A content key is mapped to the nexthop with the
+   *  highest score, which is each nexthop with a probability proportional to its weight.
+   */
+  static double
+  computeScore(uint64_t key, FaceId faceId, uint64_t cost);
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  static const time::milliseconds RETX_SUPPRESSION_INITIAL;
+  static const time::milliseconds RETX_SUPPRESSION_MAX;
+  RetxSuppressionExponential m_retxSuppression;
+
+  friend ProcessNackTraits<ConsistentHashStrategy>;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_CONSISTENT_HASH_STRATEGY_HPP
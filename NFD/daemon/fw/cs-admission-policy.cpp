@@ -0,0 +1,237 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-admission-policy.hpp"
+
+#include <ndn-cxx/lp/tags.hpp>
+#include <ndn-cxx/util/random.hpp>
+
+#include <boost/range/adaptor/map.hpp>
+#include <boost/range/algorithm/copy.hpp>
+
+#include <array>
+#include <random>
+
+namespace nfd {
+namespace fw {
+
+static const std::string CONFIG_SECTION = "cs_admission";
+static constexpr size_t SKETCH_DEPTH = 4;
+
+static void
+throwUnknownOption(const ConfigSection::value_type& option)
+{
+  NDN_THROW(ConfigFile::Error("Unrecognized option '" + option.first +
+                              "' in section '" + CONFIG_SECTION + "'"));
+}
+
+CsAdmissionPolicy::Registry&
+CsAdmissionPolicy::getRegistry()
+{
+  static Registry registry;
+  return registry;
+}
+
+unique_ptr<CsAdmissionPolicy>
+CsAdmissionPolicy::create(const std::string& policyName)
+{
+  Registry& registry = getRegistry();
+  auto i = registry.find(policyName);
+  return i == registry.end() ? nullptr : i->second();
+}
+
+std::set<std::string>
+CsAdmissionPolicy::getPolicyNames()
+{
+  std::set<std::string> policyNames;
+  boost::copy(getRegistry() | boost::adaptors::map_keys,
+              std::inserter(policyNames, policyNames.end()));
+  return policyNames;
+}
+
+void
+CsAdmissionPolicy::applyOptions(const ConfigSection& options)
+{
+  for (const auto& option : options) {
+    throwUnknownOption(option);
+  }
+}
+
+const std::string AdmitAllCsAdmissionPolicy::POLICY_NAME("admit-all");
+NFD_REGISTER_CS_ADMISSION_POLICY(AdmitAllCsAdmissionPolicy);
+
+bool
+AdmitAllCsAdmissionPolicy::shouldAdmit(const Face& inFace, const Data& data,
+                                       const pit::DataMatchResult& pitMatches)
+{
+  return true;
+}
+
+const std::string LeaveCopyDownCsAdmissionPolicy::POLICY_NAME("lcd");
+NFD_REGISTER_CS_ADMISSION_POLICY(LeaveCopyDownCsAdmissionPolicy);
+
+bool
+LeaveCopyDownCsAdmissionPolicy::shouldAdmit(const Face& inFace, const Data& data,
+                                            const pit::DataMatchResult& pitMatches)
+{
+  auto tag = data.getTag<lp::CachePolicyTag>();
+  return tag == nullptr || tag->get().getPolicy() != lp::CachePolicyType::NO_CACHE;
+}
+
+void
+LeaveCopyDownCsAdmissionPolicy::beforeForwardData(const Data& data)
+{
+  data.setTag(make_shared<face::NoCacheMarkTag>(lp::EmptyValue{}));
+}
+
+const std::string ProbabilisticCsAdmissionPolicy::POLICY_NAME("probability");
+NFD_REGISTER_CS_ADMISSION_POLICY(ProbabilisticCsAdmissionPolicy);
+
+const double ProbabilisticCsAdmissionPolicy::DEFAULT_PROBABILITY = 0.5;
+
+ProbabilisticCsAdmissionPolicy::ProbabilisticCsAdmissionPolicy()
+  : m_probability(DEFAULT_PROBABILITY)
+{
+}
+
+void
+ProbabilisticCsAdmissionPolicy::applyOptions(const ConfigSection& options)
+{
+  for (const auto& option : options) {
+    if (option.first != "probability") {
+      throwUnknownOption(option);
+    }
+    double probability = ConfigFile::parseNumber<double>(option, CONFIG_SECTION);
+    if (!(probability > 0.0 && probability <= 1.0)) {
+      NDN_THROW(ConfigFile::Error("Invalid value '" + option.second.get_value<std::string>() +
+                                  "' for option 'probability' in section '" +
+                                  CONFIG_SECTION + "'"));
+    }
+    m_probability = probability;
+  }
+}
+
+bool
+ProbabilisticCsAdmissionPolicy::shouldAdmit(const Face& inFace, const Data& data,
+                                            const pit::DataMatchResult& pitMatches)
+{
+  if (m_probability >= 1.0) {
+    return true;
+  }
+  std::bernoulli_distribution dist(m_probability);
+  return dist(ndn::random::getRandomNumberEngine());
+}
+
+const std::string PopularityCsAdmissionPolicy::POLICY_NAME("popularity");
+NFD_REGISTER_CS_ADMISSION_POLICY(PopularityCsAdmissionPolicy);
+
+const uint8_t PopularityCsAdmissionPolicy::DEFAULT_THRESHOLD = 2;
+const size_t PopularityCsAdmissionPolicy::SKETCH_WIDTH = 65536;
+const size_t PopularityCsAdmissionPolicy::SKETCH_AGING_PERIOD = SKETCH_WIDTH / 2;
+
+PopularityCsAdmissionPolicy::PopularityCsAdmissionPolicy()
+  : m_counters(SKETCH_DEPTH * SKETCH_WIDTH)
+  , m_nIncrements(0)
+  , m_threshold(DEFAULT_THRESHOLD)
+{
+}
+
+void
+PopularityCsAdmissionPolicy::applyOptions(const ConfigSection& options)
+{
+  for (const auto& option : options) {
+    if (option.first != "threshold") {
+      throwUnknownOption(option);
+    }
+    auto threshold = ConfigFile::parseNumber<unsigned>(option, CONFIG_SECTION);
+    if (threshold == 0 || threshold > std::numeric_limits<uint8_t>::max()) {
+      NDN_THROW(ConfigFile::Error("Invalid value '" + option.second.get_value<std::string>() +
+                                  "' for option 'threshold' in section '" +
+                                  CONFIG_SECTION + "'"));
+    }
+    m_threshold = static_cast<uint8_t>(threshold);
+  }
+}
+
+/** \brief computes the counter index of \p name in each row of the sketch
+ */
+static std::array<size_t, SKETCH_DEPTH>
+computeSketchIndexes(const Name& name, size_t width)
+{
+  // double hashing derives independent-enough row hashes from a single name hash
+  uint64_t h = std::hash<Name>()(name);
+  uint64_t h1 = h & 0xFFFFFFFF;
+  uint64_t h2 = (h >> 32) | 1;
+
+  std::array<size_t, SKETCH_DEPTH> indexes;
+  for (size_t row = 0; row < indexes.size(); ++row) {
+    indexes[row] = row * width + (h1 + row * h2) % width;
+  }
+  return indexes;
+}
+
+void
+PopularityCsAdmissionPolicy::afterReceiveInterest(const Interest& interest)
+{
+  for (size_t i : computeSketchIndexes(interest.getName(), SKETCH_WIDTH)) {
+    if (m_counters[i] < std::numeric_limits<uint8_t>::max()) {
+      ++m_counters[i];
+    }
+  }
+
+  if (++m_nIncrements >= SKETCH_AGING_PERIOD) {
+    for (uint8_t& counter : m_counters) {
+      counter >>= 1;
+    }
+    m_nIncrements = 0;
+  }
+}
+
+uint8_t
+PopularityCsAdmissionPolicy::estimate(const Name& name) const
+{
+  uint8_t count = std::numeric_limits<uint8_t>::max();
+  for (size_t i : computeSketchIndexes(name, SKETCH_WIDTH)) {
+    count = std::min(count, m_counters[i]);
+  }
+  return count;
+}
+
+bool
+PopularityCsAdmissionPolicy::shouldAdmit(const Face& inFace, const Data& data,
+                                         const pit::DataMatchResult& pitMatches)
+{
+  if (pitMatches.empty()) {
+    return this->estimate(data.getName()) >= m_threshold;
+  }
+
+  return std::any_of(pitMatches.begin(), pitMatches.end(),
+                     [this] (const shared_ptr<pit::Entry>& pitEntry) {
+                       return this->estimate(pitEntry->getName()) >= m_threshold;
+                     });
+}
+
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,242 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_CS_ADMISSION_POLICY_HPP
+#define NFD_DAEMON_FW_CS_ADMISSION_POLICY_HPP
+
+#include "core/config-file.hpp"
+#include "face/face.hpp"
+#include "table/pit.hpp"
+
+namespace nfd {
+namespace fw {
+
+/** \brief determines whether an incoming Data should be admitted into the ContentStore
+ *
+ *  The incoming Data pipeline consults this policy before inserting a Data into the
+ *  ContentStore. A Data that is not admitted skips the ContentStore, but it is still used to
+ *  satisfy pending Interests.
+ */
+class CsAdmissionPolicy : noncopyable
+{
+public:
+  virtual
+  ~CsAdmissionPolicy() = default;
+
+  /** \brief applies policy-specific options from the configuration file
+   *  \throw ConfigFile::Error an option is unknown or has an invalid value
+   *
+   *  The base class accepts no options.
+   */
+  virtual void
+  applyOptions(const ConfigSection& options);
+
+  /** \brief notifies the policy of an incoming Interest
+   */
+  virtual void
+  afterReceiveInterest(const Interest& interest)
+  {
+  }
+
+  /** \return whether \p data should be inserted into the ContentStore
+   *  \param pitMatches PIT entries satisfied by \p data
+   */
+  virtual bool
+  shouldAdmit(const Face& inFace, const Data& data, const pit::DataMatchResult& pitMatches) = 0;
+
+  /** \brief notifies the policy that \p data is about to be forwarded to downstreams
+   *
+   *  This is invoked after the admission decision, and allows the policy to tag \p data.
+   */
+  virtual void
+  beforeForwardData(const Data& data)
+  {
+  }
+
+public: // registry
+  template<typename P>
+  static void
+  registerPolicy(const std::string& policyName = P::POLICY_NAME)
+  {
+    Registry& registry = getRegistry();
+    BOOST_ASSERT(registry.count(policyName) == 0);
+    registry[policyName] = [] { return make_unique<P>(); };
+  }
+
+  /** \return a CsAdmissionPolicy identified by \p policyName,
+   *          or nullptr if \p policyName is unknown
+   */
+  static unique_ptr<CsAdmissionPolicy>
+  create(const std::string& policyName);
+
+  /** \return a list of available policy names
+   */
+  static std::set<std::string>
+  getPolicyNames();
+
+private:
+  typedef std::function<unique_ptr<CsAdmissionPolicy>()> CreateFunc;
+  typedef std::map<std::string, CreateFunc> Registry; // indexed by policy name
+
+  static Registry&
+  getRegistry();
+};
+
+/** \brief admits every Data
+ */
+class AdmitAllCsAdmissionPolicy : public CsAdmissionPolicy
+{
+public:
+  bool
+  shouldAdmit(const Face& inFace, const Data& data, const pit::DataMatchResult& pitMatches) final;
+
+public:
+  static const std::string POLICY_NAME;
+};
+
+/** \brief leave-copy-down: admits a Data only one hop downstream of where it was found
+ *
+ *  A Data is found either at the producer or in a ContentStore. Before forwarding a Data that
+ *  was received from an upstream, this policy marks it with face::NoCacheMarkTag, so that it is
+ *  sent with CachePolicy=NoCache and further downstream forwarders do not cache it. A Data
+ *  served from the ContentStore is forwarded without CachePolicy, so that the next downstream
+ *  forwarder caches it.
+ */
+class LeaveCopyDownCsAdmissionPolicy : public CsAdmissionPolicy
+{
+public:
+  bool
+  shouldAdmit(const Face& inFace, const Data& data, const pit::DataMatchResult& pitMatches) final;
+
+  void
+  beforeForwardData(const Data& data) final;
+
+public:
+  static const std::string POLICY_NAME;
+};
+
+/** \brief admits each Data with a fixed probability
+ *
+ *  Option:
+ *  \li probability: admission probability in (0,1]; default is 0.5
+ */
+class ProbabilisticCsAdmissionPolicy : public CsAdmissionPolicy
+{
+public:
+  ProbabilisticCsAdmissionPolicy();
+
+  void
+  applyOptions(const ConfigSection& options) final;
+
+  bool
+  shouldAdmit(const Face& inFace, const Data& data, const pit::DataMatchResult& pitMatches) final;
+
+  double
+  getProbability() const
+  {
+    return m_probability;
+  }
+
+public:
+  static const std::string POLICY_NAME;
+  static const double DEFAULT_PROBABILITY;
+
+private:
+  double m_probability;
+};
+
+/** \brief admits a Data only if it has been requested frequently
+ *
+ *  Interest names are counted in a count-min sketch, whose counters are halved periodically
+ *  so that the counts reflect recent popularity. A Data is admitted if the estimated count of
+ *  the name of any PIT entry it satisfies reaches a threshold. Since an Interest name can be a
+ *  prefix of the Data name, the Data name itself is only considered when no PIT entry matches.
+ *
+ *  Option:
+ *  \li threshold: minimum number of recent Interests; default is 2
+ */
+class PopularityCsAdmissionPolicy : public CsAdmissionPolicy
+{
+public:
+  PopularityCsAdmissionPolicy();
+
+  void
+  applyOptions(const ConfigSection& options) final;
+
+  void
+  afterReceiveInterest(const Interest& interest) final;
+
+  bool
+  shouldAdmit(const Face& inFace, const Data& data, const pit::DataMatchResult& pitMatches) final;
+
+  uint8_t
+  getThreshold() const
+  {
+    return m_threshold;
+  }
+
+  /** \return estimated number of recent Interests for \p name
+   */
+  uint8_t
+  estimate(const Name& name) const;
+
+public:
+  static const std::string POLICY_NAME;
+  static const uint8_t DEFAULT_THRESHOLD;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  static const size_t SKETCH_WIDTH;
+  /** \brief number of increments after which all counters are halved
+   */
+  static const size_t SKETCH_AGING_PERIOD;
+
+private:
+  std::vector<uint8_t> m_counters; ///< rows of SKETCH_WIDTH counters
+  size_t m_nIncrements;
+  uint8_t m_threshold;
+};
+
+/** \brief the default CsAdmissionPolicy
+ */
+typedef AdmitAllCsAdmissionPolicy DefaultCsAdmissionPolicy;
+
+} // namespace fw
+} // namespace nfd
+
+/** \brief registers a CS admission policy
+ *  \param P a subclass of nfd::fw::CsAdmissionPolicy;
+ *           P::POLICY_NAME must be a string that contains policy name
+ */
+#define NFD_REGISTER_CS_ADMISSION_POLICY(P)                     \
+static class NfdAuto ## P ## CsAdmissionPolicyRegistrationClass \
+{                                                               \
+public:                                                         \
+  NfdAuto ## P ## CsAdmissionPolicyRegistrationClass()          \
+  {                                                             \
+    ::nfd::fw::CsAdmissionPolicy::registerPolicy<P>();          \
+  }                                                             \
+} g_nfdAuto ## P ## CsAdmissionPolicyRegistrationVariable
+
+#endif // NFD_DAEMON_FW_CS_ADMISSION_POLICY_HPP
@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "flow-cache.hpp"
+
+namespace nfd {
+namespace fw {
+
+const size_t FlowCache::DEFAULT_LIMIT = 65536;
+
+FlowCache::FlowCache(const Fib& fib, const StrategyChoice& strategyChoice)
+  : m_fib(fib)
+  , m_strategyChoice(strategyChoice)
+  , m_fibEpoch(fib.getEpoch())
+  , m_strategyChoiceEpoch(strategyChoice.getEpoch())
+{
+}
+
+void
+FlowCache::setEnabled(bool isEnabled)
+{
+  m_isEnabled = isEnabled;
+  if (!m_isEnabled) {
+    this->clear();
+  }
+}
+
+void
+FlowCache::checkEpochs()
+{
+  if (m_fib.getEpoch() != m_fibEpoch || m_strategyChoice.getEpoch() != m_strategyChoiceEpoch) {
+    this->clear();
+    m_fibEpoch = m_fib.getEpoch();
+    m_strategyChoiceEpoch = m_strategyChoice.getEpoch();
+  }
+}
+
+const FlowCache::Upstreams*
+FlowCache::find(const Face& ingress, const fib::Entry& fibEntry, const Strategy& strategy)
+{
+  this->checkEpochs();
+
+  auto it = m_records.find(&fibEntry);
+  if (it == m_records.end()) {
+    return nullptr;
+  }
+
+  std::vector<Record>& records = it->second;
+  if (records.front().nextHopsVersion != fibEntry.getNextHopsVersion()) {
+    // all records of this FIB entry were made with the same nexthops
+    m_nRecords -= records.size();
+    m_records.erase(it);
+    return nullptr;
+  }
+
+  for (const Record& record : records) {
+    if (record.ingress == ingress.getId() && record.strategy == &strategy) {
+      return &record.upstreams;
+    }
+  }
+  return nullptr;
+}
+
+void
+FlowCache::insert(const Face& ingress, const fib::Entry& fibEntry, const Strategy& strategy,
+                  Upstreams upstreams)
+{
+  BOOST_ASSERT(!upstreams.empty());
+  this->checkEpochs();
+
+  if (m_nRecords >= m_limit) {
+    this->clear();
+  }
+
+  std::vector<Record>& records = m_records[&fibEntry];
+  if (!records.empty() && records.front().nextHopsVersion != fibEntry.getNextHopsVersion()) {
+    m_nRecords -= records.size();
+    records.clear();
+  }
+
+  auto it = std::find_if(records.begin(), records.end(), [&] (const Record& record) {
+    return record.ingress == ingress.getId() && record.strategy == &strategy;
+  });
+  if (it != records.end()) {
+    it->upstreams = std::move(upstreams);
+    return;
+  }
+
+  records.push_back({ingress.getId(), &strategy, fibEntry.getNextHopsVersion(), std::move(upstreams)});
+  ++m_nRecords;
+}
+
+void
+FlowCache::erase(const fib::Entry& fibEntry)
+{
+  auto it = m_records.find(&fibEntry);
+  if (it != m_records.end()) {
+    m_nRecords -= it->second.size();
+    m_records.erase(it);
+  }
+}
+
+void
+FlowCache::clear()
+{
+  m_records.clear();
+  m_nRecords = 0;
+}
+
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_FLOW_CACHE_HPP
+#define NFD_DAEMON_FW_FLOW_CACHE_HPP
+
+#include "table/fib.hpp"
+#include "table/strategy-choice.hpp"
+
+namespace nfd {
+namespace fw {
+
+class Strategy;
+
+/** \brief remembers the upstreams chosen by flow-cacheable strategies
+ *
+ *  A record is keyed by the incoming face, the FIB entry, and the effective strategy of an
+ *  Interest whose PIT entry had no out-record. It is valid until the nexthops of that FIB entry
+ *  change, a FIB entry is inserted or erased, or a strategy choice is changed.
+ *  Stale records are detected on lookup, so that table changes need not notify the cache.
+ *
+ *  \sa Strategy::setFlowCacheable
+ */
+class FlowCache : noncopyable
+{
+public:
+  /** \brief upstreams of a flow, in the order in which the strategy forwarded the Interest
+   */
+  using Upstreams = std::vector<std::pair<Face*, EndpointId>>;
+
+  FlowCache(const Fib& fib, const StrategyChoice& strategyChoice);
+
+  /** \brief whether the forwarder uses this cache; the default is false
+   */
+  bool
+  isEnabled() const
+  {
+    return m_isEnabled;
+  }
+
+  /** \brief enable or disable the cache
+   *
+   *  Disabling the cache erases all records.
+   */
+  void
+  setEnabled(bool isEnabled);
+
+  /** \brief default maximum number of records
+   */
+  static const size_t DEFAULT_LIMIT;
+
+  /** \brief maximum number of records; when this is exceeded, all records are erased
+   */
+  void
+  setLimit(size_t limit)
+  {
+    m_limit = limit;
+  }
+
+  size_t
+  size() const
+  {
+    return m_nRecords;
+  }
+
+  /** \return upstreams recorded for \p ingress, \p fibEntry, and \p strategy,
+   *          or nullptr if there is no valid record
+   *  \note The returned pointer is invalidated by any other member function call.
+   */
+  const Upstreams*
+  find(const Face& ingress, const fib::Entry& fibEntry, const Strategy& strategy);
+
+  /** \brief record \p upstreams for \p ingress, \p fibEntry, and \p strategy
+   *  \pre \p upstreams is not empty
+   */
+  void
+  insert(const Face& ingress, const fib::Entry& fibEntry, const Strategy& strategy,
+         Upstreams upstreams);
+
+  /** \brief erase all records of \p fibEntry
+   */
+  void
+  erase(const fib::Entry& fibEntry);
+
+  /** \brief erase all records
+   */
+  void
+  clear();
+
+private:
+  /** \brief erase all records if a FIB entry or strategy choice changed since they were made
+   */
+  void
+  checkEpochs();
+
+private:
+  struct Record
+  {
+    FaceId ingress;
+    const Strategy* strategy;
+    uint64_t nextHopsVersion;
+    Upstreams upstreams;
+  };
+
+  const Fib& m_fib;
+  const StrategyChoice& m_strategyChoice;
+  bool m_isEnabled = false;
+  size_t m_limit = DEFAULT_LIMIT;
+  uint64_t m_fibEpoch = 0;
+  uint64_t m_strategyChoiceEpoch = 0;
+
+  /// records indexed by FIB entry; each FIB entry usually has records of only a few faces
+  std::unordered_map<const fib::Entry*, std::vector<Record>> m_records;
+  size_t m_nRecords = 0;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_FLOW_CACHE_HPP
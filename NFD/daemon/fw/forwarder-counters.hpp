@@ -46,6 +46,7 @@ public:
 
   PacketCounter nCsHits;
   PacketCounter nCsMisses;
+  PacketCounter nCsAdmissionRejects;
 };
 
 } // namespace nfd
@@ -46,10 +46,13 @@ getDefaultStrategyName()
 
 Forwarder::Forwarder()
   : m_unsolicitedDataPolicy(make_unique<fw::DefaultUnsolicitedDataPolicy>())
+  , m_csAdmissionPolicy(make_unique<fw::DefaultCsAdmissionPolicy>())
   , m_fib(m_nameTree)
+  , m_fibViewPublisher(m_fib)
   , m_pit(m_nameTree)
   , m_measurements(m_nameTree)
   , m_strategyChoice(*this)
+  , m_flowCache(m_fib, m_strategyChoice)
 {
   m_faceTable.afterAdd.connect([this] (Face& face) {
     face.afterReceiveInterest.connect(
@@ -72,6 +75,8 @@ Forwarder::Forwarder()
 
   m_faceTable.beforeRemove.connect([this] (Face& face) {
     cleanupOnFaceRemoval(m_nameTree, m_fib, m_pit, face);
+    m_fibViewPublisher.schedulePublish();
+    m_flowCache.clear();
   });
 
   m_strategyChoice.setDefaultStrategy(getDefaultStrategyName());
@@ -129,11 +134,18 @@ Forwarder::onIncomingInterest(const FaceEndpoint& ingress, const Interest& inter
     return;
   }
 
+  // let CS admission policy learn which names are being requested
+  m_csAdmissionPolicy->afterReceiveInterest(interest);
+
   // is pending?
   if (!pitEntry->hasInRecords()) {
-    m_cs.find(interest,
-              bind(&Forwarder::onContentStoreHit, this, ingress, pitEntry, _1, _2),
-              bind(&Forwarder::onContentStoreMiss, this, ingress, pitEntry, _1));
+    const Data* match = m_cs.findMatch(interest);
+    if (match != nullptr) {
+      this->onContentStoreHit(ingress, pitEntry, interest, *match);
+    }
+    else {
+      this->onContentStoreMiss(ingress, pitEntry, interest);
+    }
   }
   else {
     this->onContentStoreMiss(ingress, pitEntry, interest);
@@ -195,11 +207,76 @@ Forwarder::onContentStoreMiss(const FaceEndpoint& ingress,
     return;
   }
 
+  if (m_flowCache.isEnabled() && this->forwardWithFlowCache(ingress, pitEntry, interest)) {
+    return;
+  }
+
   // dispatch to strategy: after incoming Interest
   this->dispatchToStrategy(*pitEntry,
     [&] (fw::Strategy& strategy) { strategy.afterReceiveInterest(ingress, interest, pitEntry); });
 }
 
+bool
+Forwarder::forwardWithFlowCache(const FaceEndpoint& ingress,
+                                const shared_ptr<pit::Entry>& pitEntry, const Interest& interest)
+{
+  // the upstreams of a flow-cacheable strategy depend only on the incoming face and FIB entry
+  // when the Interest has not been forwarded yet, is not scope-controlled, and is looked up by name
+  if (!pitEntry->getOutRecords().empty() ||
+      !interest.getForwardingHint().empty() ||
+      scope_prefix::LOCALHOST.isPrefixOf(interest.getName()) ||
+      scope_prefix::LOCALHOP.isPrefixOf(interest.getName())) {
+    return false;
+  }
+
+  fw::Strategy& strategy = m_strategyChoice.findEffectiveStrategy(*pitEntry);
+  if (!strategy.isFlowCacheable()) {
+    return false;
+  }
+
+  const fib::Entry& fibEntry = m_fib.findLongestPrefixMatch(*pitEntry);
+  const fw::FlowCache::Upstreams* upstreams = m_flowCache.find(ingress.face, fibEntry, strategy);
+  if (upstreams != nullptr) {
+    NFD_LOG_DEBUG("onContentStoreMiss interest=" << interest.getName() << " flow-cache-hit");
+    // onOutgoingInterest cannot change the FIB or strategy choice, so upstreams stays valid
+    for (const auto& upstream : *upstreams) {
+      this->onOutgoingInterest(pitEntry, FaceEndpoint(*upstream.first, upstream.second), interest);
+    }
+    return true;
+  }
+
+  // dispatch to strategy: after incoming Interest, then record its choice
+  this->dispatchToStrategy(*pitEntry,
+    [&] (fw::Strategy& strategy) { strategy.afterReceiveInterest(ingress, interest, pitEntry); });
+
+  fw::FlowCache::Upstreams chosen;
+  for (const pit::OutRecord& outRecord : pitEntry->getOutRecords()) {
+    chosen.emplace_back(&outRecord.getFace(), outRecord.getEndpointId());
+  }
+  if (!chosen.empty()) {
+    m_flowCache.insert(ingress.face, fibEntry, strategy, std::move(chosen));
+  }
+  return true;
+}
+
+bool
+Forwarder::shouldAdmitToCs(const Face& inFace, const Data& data,
+                           const pit::DataMatchResult& pitMatches)
+{
+  // Data with CachePolicy=NoCache is never admitted, regardless of the admission policy
+  auto cachePolicyTag = data.getTag<lp::CachePolicyTag>();
+  if (cachePolicyTag != nullptr &&
+      cachePolicyTag->get().getPolicy() == lp::CachePolicyType::NO_CACHE) {
+    return false;
+  }
+
+  bool isAdmitted = m_csAdmissionPolicy->shouldAdmit(inFace, data, pitMatches);
+  if (!isAdmitted) {
+    ++m_counters.nCsAdmissionRejects;
+  }
+  return isAdmitted;
+}
+
 void
 Forwarder::onContentStoreHit(const FaceEndpoint& ingress, const shared_ptr<pit::Entry>& pitEntry,
                              const Interest& interest, const Data& data)
@@ -208,6 +285,9 @@ Forwarder::onContentStoreHit(const FaceEndpoint& ingress, const shared_ptr<pit::
   ++m_counters.nCsHits;
 
   data.setTag(make_shared<lp::IncomingFaceIdTag>(face::FACEID_CONTENT_STORE));
+  // the CS admission policy may have marked the Data when it came from upstream;
+  // a CS hit makes this forwarder the upstream, so downstream may cache it
+  data.removeTag<face::NoCacheMarkTag>();
   // XXX should we lookup PIT for other Interests that also match csMatch?
 
   pitEntry->isSatisfied = true;
@@ -274,19 +354,21 @@ Forwarder::onIncomingData(const FaceEndpoint& ingress, const Data& data)
     return;
   }
 
+  // PIT match; the admission policy may consider the Interests that the Data satisfies
+  pit::DataMatchResult pitMatches = m_pit.findAllDataMatches(data);//according to names
+
  // CS insert the data, if the data 
- int result = m_cs.insert(data);
-
-  // PIT match(if the hashcode is new)
-pit::DataMatchResult pitMatches;
-  if(result == 1){
-        pitMatches = m_pit.findAllDataMatches(data);//according to names
-       // if (pitMatches.size() == 0) {
-         // goto Data unsolicited pipeline
-      //   this->onDataUnsolicited(ingress, data);
-       // return;
-   }
-   else return;     
+  // Data that are not admitted skip the CS; they are treated as new and satisfy PIT entries
+  int result = 1;
+  if (this->shouldAdmitToCs(ingress.face, data, pitMatches)) {
+    result = m_cs.insert(data);
+  }
+  m_csAdmissionPolicy->beforeForwardData(data);
+
+  // continue only if the hashcode is new
+  if (result != 1) {
+    return;
+  }
 
   // when only one PIT entry is matched, trigger strategy: after receive Data
   if (pitMatches.size() == 1) {
@@ -448,6 +530,11 @@ Forwarder::onIncomingNack(const FaceEndpoint& ingress, const lp::Nack& nack)
     this->setExpiryTimer(pitEntry, 0_ms);
   }
 
+  // the upstream may be unable to serve this prefix any more, so let the strategy decide again
+  if (m_flowCache.isEnabled()) {
+    m_flowCache.erase(m_fib.findLongestPrefixMatch(*pitEntry));
+  }
+
   // trigger strategy: after receive NACK
   this->dispatchToStrategy(*pitEntry,
     [&] (fw::Strategy& strategy) { strategy.afterReceiveNack(ingress, nack, pitEntry); });
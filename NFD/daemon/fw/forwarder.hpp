@@ -28,15 +28,20 @@
 
 #include "face-endpoint.hpp"
 #include "face-table.hpp"
+#include "flow-cache.hpp"
 #include "forwarder-counters.hpp"
 #include "unsolicited-data-policy.hpp"
+#include "cs-admission-policy.hpp"
 #include "table/fib.hpp"
+#include "table/fib-view.hpp"
 #include "table/pit.hpp"
 #include "table/cs.hpp"
+#include "table/cs-snapshot.hpp"
 #include "table/measurements.hpp"
 #include "table/strategy-choice.hpp"
 #include "table/dead-nonce-list.hpp"
 #include "table/network-region-table.hpp"
+#include "daemon/global.hpp"
 
 namespace nfd {
 
@@ -102,6 +107,19 @@ public: // faces and policies
     m_unsolicitedDataPolicy = std::move(policy);
   }
 
+  fw::CsAdmissionPolicy&
+  getCsAdmissionPolicy() const
+  {
+    return *m_csAdmissionPolicy;
+  }
+
+  void
+  setCsAdmissionPolicy(unique_ptr<fw::CsAdmissionPolicy> policy)
+  {
+    BOOST_ASSERT(policy != nullptr);
+    m_csAdmissionPolicy = std::move(policy);
+  }
+
 public: // forwarding entrypoints and tables
   /** \brief start incoming Interest processing
    *  \param ingress face on which Interest is received and endpoint of the sender
@@ -110,6 +128,7 @@ public: // forwarding entrypoints and tables
   void
   startProcessInterest(const FaceEndpoint& ingress, const Interest& interest)
   {
+    CoarseClockScope clockScope;
     this->onIncomingInterest(ingress, interest);
   }
 
@@ -120,6 +139,7 @@ public: // forwarding entrypoints and tables
   void
   startProcessData(const FaceEndpoint& ingress, const Data& data)
   {
+    CoarseClockScope clockScope;
     this->onIncomingData(ingress, data);
   }
 
@@ -130,6 +150,7 @@ public: // forwarding entrypoints and tables
   void
   startProcessNack(const FaceEndpoint& ingress, const lp::Nack& nack)
   {
+    CoarseClockScope clockScope;
     this->onIncomingNack(ingress, nack);
   }
 
@@ -145,6 +166,14 @@ public: // forwarding entrypoints and tables
     return m_fib;
   }
 
+  /** \brief publisher of FIB views for threads other than the forwarding thread
+   */
+  fib::ViewPublisher&
+  getFibViewPublisher()
+  {
+    return m_fibViewPublisher;
+  }
+
   Pit&
   getPit()
   {
@@ -157,6 +186,22 @@ public: // forwarding entrypoints and tables
     return m_cs;
   }
 
+  /** \return CS snapshot, or nullptr if CS persistence is disabled
+   */
+  cs::Snapshot*
+  getCsSnapshot() const
+  {
+    return m_csSnapshot.get();
+  }
+
+  /** \brief enable or disable (if \p snapshot is nullptr) CS persistence
+   */
+  void
+  setCsSnapshot(unique_ptr<cs::Snapshot> snapshot)
+  {
+    m_csSnapshot = std::move(snapshot);
+  }
+
   Measurements&
   getMeasurements()
   {
@@ -169,6 +214,15 @@ public: // forwarding entrypoints and tables
     return m_strategyChoice;
   }
 
+  /** \brief cache of upstreams chosen by flow-cacheable strategies, disabled by default
+   *  \sa fw::Strategy::setFlowCacheable
+   */
+  fw::FlowCache&
+  getFlowCache()
+  {
+    return m_flowCache;
+  }
+
   DeadNonceList&
   getDeadNonceList()
   {
@@ -257,6 +311,23 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   VIRTUAL_WITH_TESTS void
   insertDeadNonceList(pit::Entry& pitEntry, Face* upstream);
 
+  /** \brief decide whether an incoming Data should be inserted into the ContentStore
+   *  \param pitMatches PIT entries satisfied by \p data
+   */
+  bool
+  shouldAdmitToCs(const Face& inFace, const Data& data, const pit::DataMatchResult& pitMatches);
+
+  /** \brief forward a new Interest with the flow cache, if it is eligible
+   *
+   *  On a cache hit, the Interest is sent to the recorded upstreams. On a miss, the effective
+   *  strategy is triggered and its choice is recorded.
+   *
+   *  \retval false the Interest is not eligible and must be dispatched to the strategy
+   */
+  bool
+  forwardWithFlowCache(const FaceEndpoint& ingress,
+                       const shared_ptr<pit::Entry>& pitEntry, const Interest& interest);
+
   /** \brief call trigger (method) on the effective strategy of pitEntry
    */
 #ifdef WITH_TESTS
@@ -276,15 +347,19 @@ private:
 
   FaceTable m_faceTable;
   unique_ptr<fw::UnsolicitedDataPolicy> m_unsolicitedDataPolicy;
+  unique_ptr<fw::CsAdmissionPolicy> m_csAdmissionPolicy;
 
   NameTree           m_nameTree;
   Fib                m_fib;
+  fib::ViewPublisher m_fibViewPublisher;
   Pit                m_pit;
   Cs                 m_cs;
   Measurements       m_measurements;
   StrategyChoice     m_strategyChoice;
+  fw::FlowCache      m_flowCache;
   DeadNonceList      m_deadNonceList;
   NetworkRegionTable m_networkRegionTable;
+  unique_ptr<cs::Snapshot> m_csSnapshot;
 
   // allow Strategy (base class) to enter pipelines
   friend class fw::Strategy;
@@ -53,6 +53,7 @@ MulticastStrategy::MulticastStrategy(Forwarder& forwarder, const Name& name)
       "MulticastStrategy does not support version " + to_string(*parsed.version)));
   }
   this->setInstanceName(makeInstanceName(name, getStrategyName()));
+  this->setFlowCacheable(true);
 }
 
 const Name&
@@ -69,12 +70,16 @@ MulticastStrategy::afterReceiveInterest(const FaceEndpoint& ingress, const Inter
   const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
   const fib::NextHopList& nexthops = fibEntry.getNextHops();
 
+  bool hasMasks = fibEntry.hasNextHopMasks();
+  fib::NextHopMask eligibleMask = hasMasks ?
+                                  getEligibleNextHopsMask(ingress.face, interest, fibEntry) : 0;
+
   int nEligibleNextHops = 0;
 
   bool isSuppressed = false;
 
-  for (const auto& nexthop : nexthops) {
-    Face& outFace = nexthop.getFace();
+  for (size_t i = 0; i < nexthops.size(); ++i) {
+    Face& outFace = nexthops[i].getFace();
 
     RetxSuppressionResult suppressResult = m_retxSuppression.decidePerUpstream(*pitEntry, outFace);
 
@@ -84,8 +89,13 @@ MulticastStrategy::afterReceiveInterest(const FaceEndpoint& ingress, const Inter
       continue;
     }
 
-    if ((outFace.getId() == ingress.face.getId() && outFace.getLinkType() != ndn::nfd::LINK_TYPE_AD_HOC) ||
-        wouldViolateScope(ingress.face, interest, outFace)) {
+    if (hasMasks) {
+      if (((eligibleMask >> i) & 1) == 0) {
+        continue;
+      }
+    }
+    else if ((outFace.getId() == ingress.face.getId() && outFace.getLinkType() != ndn::nfd::LINK_TYPE_AD_HOC) ||
+             wouldViolateScope(ingress.face, interest, outFace)) {
       continue;
     }
 
@@ -114,6 +114,16 @@ public: // constructor, destructor, strategy name
     return m_name;
   }
 
+  /** \return whether the forwarder may replay this strategy's forwarding decision
+   *          for new PIT entries
+   *  \sa setFlowCacheable
+   */
+  bool
+  isFlowCacheable() const
+  {
+    return m_isFlowCacheable;
+  }
+
 public: // triggers
   /** \brief trigger after Interest is received
    *
@@ -371,6 +381,25 @@ protected: // instance name
     m_name = name;
   }
 
+  /** \brief declare whether the forwarder may replay this strategy's forwarding decision
+   *
+   *  A strategy may declare itself flow-cacheable if, for an Interest whose PIT entry has
+   *  no out-record, afterReceiveInterest does nothing other than immediately sending the
+   *  Interest unmodified to a set of upstreams, or rejecting it, and that set depends only on
+   *  the incoming face and the nexthops of the FIB entry found by lookupFib.
+   *  When the flow cache of the forwarder is enabled, the forwarder then remembers the upstreams
+   *  chosen for one Interest and sends later Interests from the same face under the same FIB
+   *  entry to them directly, without invoking afterReceiveInterest.
+   *  Interests with a forwarding hint or under a scope-controlled prefix are never replayed.
+   *
+   *  The default is false.
+   */
+  void
+  setFlowCacheable(bool isFlowCacheable)
+  {
+    m_isFlowCacheable = isFlowCacheable;
+  }
+
 private: // registry
   typedef std::function<unique_ptr<Strategy>(Forwarder& forwarder, const Name& strategyName)> CreateFunc;
   typedef std::map<Name, CreateFunc> Registry; // indexed by strategy name
@@ -387,6 +416,7 @@ protected: // accessors
 
 private: // instance fields
   Name m_name;
+  bool m_isFlowCacheable = false;
 
   /** \brief reference to the forwarder
    *
@@ -29,6 +29,8 @@ namespace nfd {
 
 static thread_local unique_ptr<boost::asio::io_service> g_ioService;
 static thread_local unique_ptr<Scheduler> g_scheduler;
+static thread_local bool g_hasCoarseNow = false;
+static thread_local time::steady_clock::TimePoint g_coarseNow;
 static boost::asio::io_service* g_mainIoService = nullptr;
 static boost::asio::io_service* g_ribIoService = nullptr;
 
@@ -50,6 +52,28 @@ getScheduler()
   return *g_scheduler;
 }
 
+time::steady_clock::TimePoint
+getCoarseSteadyClockNow()
+{
+  return g_hasCoarseNow ? g_coarseNow : time::steady_clock::now();
+}
+
+CoarseClockScope::CoarseClockScope()
+  : m_isOutermost(!g_hasCoarseNow)
+{
+  if (m_isOutermost) {
+    g_coarseNow = time::steady_clock::now();
+    g_hasCoarseNow = true;
+  }
+}
+
+CoarseClockScope::~CoarseClockScope()
+{
+  if (m_isOutermost) {
+    g_hasCoarseNow = false;
+  }
+}
+
 #ifdef WITH_TESTS
 void
 resetGlobalIoService()
@@ -61,6 +61,29 @@ runOnMainIoService(const std::function<void()>& f);
 void
 runOnRibIoService(const std::function<void()>& f);
 
+/** \brief Returns the current steady_clock time point, cached for the calling thread.
+ *
+ *  Within a CoarseClockScope, every call returns the time point captured when the outermost
+ *  scope was entered, so that processing one packet reads the clock only once.
+ *  Outside of any scope, this is equivalent to time::steady_clock::now().
+ */
+time::steady_clock::TimePoint
+getCoarseSteadyClockNow();
+
+/** \brief Caches the steady_clock reading of the calling thread while it is alive.
+ *  \sa getCoarseSteadyClockNow
+ */
+class CoarseClockScope : noncopyable
+{
+public:
+  CoarseClockScope();
+
+  ~CoarseClockScope();
+
+private:
+  bool m_isOutermost;
+};
+
 #ifdef WITH_TESTS
 /** \brief Destroy the global io_service instance.
  *
@@ -123,6 +123,8 @@ FaceManager::createFace(const ControlParameters& parameters,
                                parameters.getFlagBit(ndn::nfd::BIT_LOCAL_FIELDS_ENABLED);
   faceParams.wantLpReliability = parameters.hasFlagBit(ndn::nfd::BIT_LP_RELIABILITY_ENABLED) &&
                                  parameters.getFlagBit(ndn::nfd::BIT_LP_RELIABILITY_ENABLED);
+  faceParams.wantLpAggregation = parameters.hasFlagBit(ndn::nfd::BIT_LP_AGGREGATION_ENABLED) &&
+                                 parameters.getFlagBit(ndn::nfd::BIT_LP_AGGREGATION_ENABLED);
   if (parameters.hasFlagBit(ndn::nfd::BIT_CONGESTION_MARKING_ENABLED)) {
     faceParams.wantCongestionMarking = parameters.getFlagBit(ndn::nfd::BIT_CONGESTION_MARKING_ENABLED);
   }
@@ -175,9 +177,12 @@ makeUpdateFaceResponse(const Face& face)
     const auto& options = linkService->getOptions();
     params.setBaseCongestionMarkingInterval(options.baseCongestionMarkingInterval)
           .setDefaultCongestionThreshold(options.defaultCongestionThreshold)
+          .setRateLimit(options.schedulerOptions.rateLimit)
+          .setBurstSize(options.schedulerOptions.burstSize)
           .setFlagBit(ndn::nfd::BIT_LOCAL_FIELDS_ENABLED, options.allowLocalFields, false)
           .setFlagBit(ndn::nfd::BIT_LP_RELIABILITY_ENABLED, options.reliabilityOptions.isEnabled, false)
-          .setFlagBit(ndn::nfd::BIT_CONGESTION_MARKING_ENABLED, options.allowCongestionMarking, false);
+          .setFlagBit(ndn::nfd::BIT_CONGESTION_MARKING_ENABLED, options.allowCongestionMarking, false)
+          .setFlagBit(ndn::nfd::BIT_LP_AGGREGATION_ENABLED, options.allowAggregation, false);
   }
 
   return params;
@@ -187,7 +192,10 @@ static ControlParameters
 makeCreateFaceResponse(const Face& face)
 {
   ControlParameters params = makeUpdateFaceResponse(face);
-  params.setUri(face.getRemoteUri().toString())
+  // egress rate limits can only be set with faces/update
+  params.unsetRateLimit()
+        .unsetBurstSize()
+        .setUri(face.getRemoteUri().toString())
         .setLocalUri(face.getLocalUri().toString());
 
   copyMtu(face, params);
@@ -239,12 +247,21 @@ updateLinkServiceOptions(Face& face, const ControlParameters& parameters)
   if (parameters.hasFlagBit(ndn::nfd::BIT_CONGESTION_MARKING_ENABLED)) {
     options.allowCongestionMarking = parameters.getFlagBit(ndn::nfd::BIT_CONGESTION_MARKING_ENABLED);
   }
+  if (parameters.hasFlagBit(ndn::nfd::BIT_LP_AGGREGATION_ENABLED)) {
+    options.allowAggregation = parameters.getFlagBit(ndn::nfd::BIT_LP_AGGREGATION_ENABLED);
+  }
   if (parameters.hasBaseCongestionMarkingInterval()) {
     options.baseCongestionMarkingInterval = parameters.getBaseCongestionMarkingInterval();
   }
   if (parameters.hasDefaultCongestionThreshold()) {
     options.defaultCongestionThreshold = parameters.getDefaultCongestionThreshold();
   }
+  if (parameters.hasRateLimit()) {
+    options.schedulerOptions.rateLimit = parameters.getRateLimit();
+  }
+  if (parameters.hasBurstSize()) {
+    options.schedulerOptions.burstSize = parameters.getBurstSize();
+  }
 
   linkService->setOptions(options);
 }
@@ -295,6 +312,13 @@ FaceManager::updateFace(const Interest& interest,
     }
   }
 
+  // an empty token bucket would never admit a packet
+  if (parameters.hasBurstSize() && parameters.getBurstSize() == 0) {
+    NFD_LOG_TRACE("received request to set zero burst size");
+    areParamsValid = false;
+    response.setBurstSize(0);
+  }
+
   if (!areParamsValid) {
     done(ControlResponse(409, "Invalid properties specified").setBody(response.wireEncode()));
     return;
@@ -339,7 +363,8 @@ copyFaceProperties(const Face& face, T& to)
     const auto& options = linkService->getOptions();
     to.setFlagBit(ndn::nfd::BIT_LOCAL_FIELDS_ENABLED, options.allowLocalFields)
       .setFlagBit(ndn::nfd::BIT_LP_RELIABILITY_ENABLED, options.reliabilityOptions.isEnabled)
-      .setFlagBit(ndn::nfd::BIT_CONGESTION_MARKING_ENABLED, options.allowCongestionMarking);
+      .setFlagBit(ndn::nfd::BIT_CONGESTION_MARKING_ENABLED, options.allowCongestionMarking)
+      .setFlagBit(ndn::nfd::BIT_LP_AGGREGATION_ENABLED, options.allowAggregation);
   }
 }
 
@@ -28,6 +28,7 @@
 #include "core/logger.hpp"
 #include "fw/face-table.hpp"
 #include "table/fib.hpp"
+#include "table/fib-view.hpp"
 
 #include <ndn-cxx/lp/tags.hpp>
 #include <ndn-cxx/mgmt/nfd/fib-entry.hpp>
@@ -39,10 +40,12 @@ namespace nfd {
 NFD_LOG_INIT(FibManager);
 
 FibManager::FibManager(Fib& fib, const FaceTable& faceTable,
-                       Dispatcher& dispatcher, CommandAuthenticator& authenticator)
+                       Dispatcher& dispatcher, CommandAuthenticator& authenticator,
+                       fib::ViewPublisher* fibViewPublisher)
   : ManagerBase("fib", dispatcher, authenticator)
   , m_fib(fib)
   , m_faceTable(faceTable)
+  , m_fibViewPublisher(fibViewPublisher)
 {
   registerCommandHandler<ndn::nfd::FibAddNextHopCommand>("add-nexthop",
     bind(&FibManager::addNextHop, this, _2, _3, _4, _5));
@@ -78,6 +81,7 @@ FibManager::addNextHop(const Name& topPrefix, const Interest& interest,
 
   fib::Entry* entry = m_fib.insert(prefix).first;
   entry->addOrUpdateNextHop(*face, 0, cost);
+  schedulePublish();
 
   NFD_LOG_TRACE("fib/add-nexthop(" << prefix << ',' << faceId << ',' << cost << "): OK");
   return done(ControlResponse(200, "Success").setBody(parameters.wireEncode()));
@@ -107,6 +111,7 @@ FibManager::removeNextHop(const Name& topPrefix, const Interest& interest,
   }
 
   entry->removeNextHop(*face, 0);
+  schedulePublish();
   if (!entry->hasNextHops()) {
     m_fib.erase(*entry);
     NFD_LOG_TRACE("fib/remove-nexthop(" << prefix << ',' << faceId << "): OK entry-erased");
@@ -116,6 +121,51 @@ FibManager::removeNextHop(const Name& topPrefix, const Interest& interest,
   }
 }
 
+ControlResponse
+FibManager::applyFibUpdates(const std::list<rib::FibUpdate>& updates, uint64_t batchFaceId)
+{
+  // validate first, so that a rejected transaction leaves the FIB unchanged
+  bool hasBatchFace = m_faceTable.get(batchFaceId) != nullptr;
+  for (const auto& update : updates) {
+    if (update.action == rib::FibUpdate::ADD_NEXTHOP && update.name.size() > Fib::getMaxDepth()) {
+      NFD_LOG_DEBUG("fib/transaction(" << updates.size() << "): FAIL prefix-too-long " << update.name);
+      return ControlResponse(414, "FIB entry prefix cannot exceed " +
+                             ndn::to_string(Fib::getMaxDepth()) + " components");
+    }
+    if (update.faceId == batchFaceId && !hasBatchFace) {
+      NFD_LOG_DEBUG("fib/transaction(" << updates.size() << "): FAIL unknown-faceid " << batchFaceId);
+      return ControlResponse(410, "Face not found");
+    }
+  }
+
+  size_t nSkipped = 0;
+  for (const auto& update : updates) {
+    Face* face = m_faceTable.get(update.faceId);
+    if (face == nullptr) {
+      ++nSkipped;
+      continue;
+    }
+
+    if (update.action == rib::FibUpdate::ADD_NEXTHOP) {
+      m_fib.insert(update.name).first->addOrUpdateNextHop(*face, 0, update.cost);
+      continue;
+    }
+
+    fib::Entry* entry = m_fib.findExactMatch(update.name);
+    if (entry == nullptr) {
+      continue;
+    }
+    entry->removeNextHop(*face, 0);
+    if (!entry->hasNextHops()) {
+      m_fib.erase(*entry);
+    }
+  }
+
+  NFD_LOG_DEBUG("fib/transaction(" << updates.size() << "): OK skipped=" << nSkipped);
+  schedulePublish();
+  return ControlResponse(200, "Success");
+}
+
 void
 FibManager::listEntries(const Name& topPrefix, const Interest& interest,
                         ndn::mgmt::StatusDatasetContext& context)
@@ -135,6 +185,14 @@ FibManager::listEntries(const Name& topPrefix, const Interest& interest,
   context.end();
 }
 
+void
+FibManager::schedulePublish()
+{
+  if (m_fibViewPublisher != nullptr) {
+    m_fibViewPublisher->schedulePublish();
+  }
+}
+
 void
 FibManager::setFaceForSelfRegistration(const Interest& request, ControlParameters& parameters)
 {
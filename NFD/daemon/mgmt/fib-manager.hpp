@@ -27,11 +27,13 @@
 #define NFD_DAEMON_MGMT_FIB_MANAGER_HPP
 
 #include "manager-base.hpp"
+#include "rib/fib-update.hpp"
 
 namespace nfd {
 
 namespace fib {
 class Fib;
+class ViewPublisher;
 } // namespace fib
 
 class FaceTable;
@@ -43,8 +45,23 @@ class FaceTable;
 class FibManager : public ManagerBase
 {
 public:
+  /** \param fibViewPublisher if not nullptr, a FIB view is published after FIB changes
+   */
   FibManager(fib::Fib& fib, const FaceTable& faceTable,
-             Dispatcher& dispatcher, CommandAuthenticator& authenticator);
+             Dispatcher& dispatcher, CommandAuthenticator& authenticator,
+             fib::ViewPublisher* fibViewPublisher = nullptr);
+
+  /** \brief Apply FIB updates computed by the RIB service as a single transaction.
+   *
+   *  Updates are applied in order, without going through control commands. Updates for faces
+   *  that no longer exist are skipped, except that the whole transaction is rejected and the FIB
+   *  is left unchanged if the face \p batchFaceId does not exist and has updates, or if a
+   *  prefix exceeds the FIB depth limit.
+   *
+   *  \return response with code 200 if the transaction is applied, 410 or 414 if rejected
+   */
+  ControlResponse
+  applyFibUpdates(const std::list<rib::FibUpdate>& updates, uint64_t batchFaceId);
 
 private:
   void
@@ -62,12 +79,16 @@ private:
               ndn::mgmt::StatusDatasetContext& context);
 
 private:
+  void
+  schedulePublish();
+
   void
   setFaceForSelfRegistration(const Interest& request, ControlParameters& parameters);
 
 private:
   fib::Fib& m_fib;
   const FaceTable& m_faceTable;
+  fib::ViewPublisher* m_fibViewPublisher;
 };
 
 } // namespace nfd
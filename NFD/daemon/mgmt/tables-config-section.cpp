@@ -29,6 +29,9 @@
 namespace nfd {
 
 const size_t TablesConfigSection::DEFAULT_CS_MAX_PACKETS = 65536;
+const time::seconds TablesConfigSection::DEFAULT_CS_SNAPSHOT_INTERVAL = 300_s;
+const size_t TablesConfigSection::DEFAULT_CS_SHARED_MEMORY_SIZE = 64;
+const size_t TablesConfigSection::CS_SHARED_MEMORY_OCTETS_PER_SLOT = 1024;
 
 TablesConfigSection::TablesConfigSection(Forwarder& forwarder)
   : m_forwarder(forwarder)
@@ -53,6 +56,7 @@ TablesConfigSection::ensureConfigured()
   m_forwarder.getCs().setLimit(DEFAULT_CS_MAX_PACKETS);
   // Don't set default cs_policy because it's already created by CS itself.
   m_forwarder.setUnsolicitedDataPolicy(make_unique<fw::DefaultUnsolicitedDataPolicy>());
+  m_forwarder.setCsAdmissionPolicy(make_unique<fw::DefaultCsAdmissionPolicy>());
 
   m_isConfigured = true;
 }
@@ -76,6 +80,40 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun)
     }
   }
 
+  std::string csSnapshotPath;
+  OptionalConfigSection csSnapshotPathNode = section.get_child_optional("cs_snapshot_path");
+  if (csSnapshotPathNode) {
+    csSnapshotPath = csSnapshotPathNode->get_value<std::string>();
+  }
+
+  time::seconds csSnapshotInterval = DEFAULT_CS_SNAPSHOT_INTERVAL;
+  OptionalConfigSection csSnapshotIntervalNode = section.get_child_optional("cs_snapshot_interval");
+  if (csSnapshotIntervalNode) {
+    csSnapshotInterval = time::seconds(ConfigFile::parseNumber<uint32_t>(*csSnapshotIntervalNode,
+                                                                         "cs_snapshot_interval", "tables"));
+  }
+
+  std::string csSharedMemoryName;
+  OptionalConfigSection csSharedMemoryNameNode = section.get_child_optional("cs_shared_memory_name");
+  if (csSharedMemoryNameNode) {
+    csSharedMemoryName = csSharedMemoryNameNode->get_value<std::string>();
+    if (csSharedMemoryName.size() < 2 || csSharedMemoryName[0] != '/' ||
+        csSharedMemoryName.find('/', 1) != std::string::npos) {
+      NDN_THROW(ConfigFile::Error("Invalid cs_shared_memory_name '" + csSharedMemoryName +
+                                  "' in section 'tables'"));
+    }
+  }
+
+  size_t csSharedMemorySize = DEFAULT_CS_SHARED_MEMORY_SIZE;
+  OptionalConfigSection csSharedMemorySizeNode = section.get_child_optional("cs_shared_memory_size");
+  if (csSharedMemorySizeNode) {
+    csSharedMemorySize = ConfigFile::parseNumber<size_t>(*csSharedMemorySizeNode,
+                                                         "cs_shared_memory_size", "tables");
+    if (csSharedMemorySize == 0) {
+      NDN_THROW(ConfigFile::Error("cs_shared_memory_size in section 'tables' must be positive"));
+    }
+  }
+
   unique_ptr<fw::UnsolicitedDataPolicy> unsolicitedDataPolicy;
   OptionalConfigSection unsolicitedDataPolicyNode = section.get_child_optional("cs_unsolicited_policy");
   if (unsolicitedDataPolicyNode) {
@@ -89,6 +127,32 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun)
     unsolicitedDataPolicy = make_unique<fw::DefaultUnsolicitedDataPolicy>();
   }
 
+  unique_ptr<fw::CsAdmissionPolicy> csAdmissionPolicy;
+  OptionalConfigSection csAdmissionNode = section.get_child_optional("cs_admission");
+  if (csAdmissionNode) {
+    std::string policyName = csAdmissionNode->get_value<std::string>();
+    csAdmissionPolicy = fw::CsAdmissionPolicy::create(policyName);
+    if (csAdmissionPolicy == nullptr) {
+      NDN_THROW(ConfigFile::Error("Unknown cs_admission '" + policyName + "' in section 'tables'"));
+    }
+    csAdmissionPolicy->applyOptions(*csAdmissionNode);
+  }
+  else {
+    csAdmissionPolicy = make_unique<fw::DefaultCsAdmissionPolicy>();
+  }
+
+  bool wantNameTreeCompressed = false;
+  OptionalConfigSection nameTreeCompressedNode = section.get_child_optional("name_tree_compressed");
+  if (nameTreeCompressedNode) {
+    wantNameTreeCompressed = ConfigFile::parseYesNo(*nameTreeCompressedNode, "name_tree_compressed", "tables");
+  }
+
+  bool wantFlowCache = false;
+  OptionalConfigSection flowCacheNode = section.get_child_optional("flow_cache");
+  if (flowCacheNode) {
+    wantFlowCache = ConfigFile::parseYesNo(*flowCacheNode, "flow_cache", "tables");
+  }
+
   OptionalConfigSection strategyChoiceSection = section.get_child_optional("strategy_choice");
   if (strategyChoiceSection) {
     processStrategyChoiceSection(*strategyChoiceSection, isDryRun);
@@ -103,6 +167,9 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun)
     return;
   }
 
+  m_forwarder.getNameTree().setCompressed(wantNameTreeCompressed);
+  m_forwarder.getFlowCache().setEnabled(wantFlowCache);
+
   Cs& cs = m_forwarder.getCs();
   cs.setLimit(nCsMaxPackets);
   if (cs.size() == 0 && csPolicy != nullptr) {
@@ -110,6 +177,42 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun)
   }
 
   m_forwarder.setUnsolicitedDataPolicy(std::move(unsolicitedDataPolicy));
+  m_forwarder.setCsAdmissionPolicy(std::move(csAdmissionPolicy));
+
+  if (csSnapshotPath.empty()) {
+    m_forwarder.setCsSnapshot(nullptr);
+  }
+  else {
+    cs::Snapshot* snapshot = m_forwarder.getCsSnapshot();
+    if (snapshot == nullptr || snapshot->getPath() != csSnapshotPath) {
+      auto newSnapshot = make_unique<cs::Snapshot>(cs, csSnapshotPath);
+      if (cs.size() == 0) {
+        newSnapshot->startRestore();
+      }
+      snapshot = newSnapshot.get();
+      m_forwarder.setCsSnapshot(std::move(newSnapshot));
+    }
+    snapshot->setInterval(csSnapshotInterval);
+  }
+
+  size_t csSharedMemoryCapacity = csSharedMemorySize * 1024 * 1024;
+  ndn::SharedMemoryStorage* sharedStorage = cs.getSharedStorage();
+  if (csSharedMemoryName.empty()) {
+    cs.setSharedStorage(nullptr);
+  }
+  else if (sharedStorage == nullptr || sharedStorage->getName() != csSharedMemoryName ||
+           sharedStorage->getDataCapacity() != csSharedMemoryCapacity) {
+    // release the old segment first, in case it has the same name
+    cs.setSharedStorage(nullptr);
+    try {
+      cs.setSharedStorage(ndn::SharedMemoryStorage::create(csSharedMemoryName, csSharedMemoryCapacity,
+                            csSharedMemoryCapacity / CS_SHARED_MEMORY_OCTETS_PER_SLOT));
+    }
+    catch (const ndn::SharedMemoryStorage::Error&) {
+      NDN_THROW_NESTED(ConfigFile::Error("Cannot create cs_shared_memory_name '" +
+                                         csSharedMemoryName + "' in section 'tables'"));
+    }
+  }
 
   m_isConfigured = true;
 }
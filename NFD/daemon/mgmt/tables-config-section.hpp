@@ -40,6 +40,11 @@ namespace nfd {
  *    cs_max_packets 65536
  *    cs_policy lru
  *    cs_unsolicited_policy drop-all
+ *    cs_admission probability
+ *    {
+ *      probability 0.25
+ *    }
+ *    name_tree_compressed no
  *
  *    strategy_choice
  *    {
@@ -58,8 +63,8 @@ namespace nfd {
  *  \endcode
  *
  *  During a configuration reload,
- *  \li cs_max_packets, cs_policy, and cs_unsolicited_policy are applied;
- *      defaults are used if an option is omitted.
+ *  \li cs_max_packets, cs_policy, cs_unsolicited_policy, cs_admission, and name_tree_compressed
+ *      are applied; defaults are used if an option is omitted.
  *  \li strategy_choice entries are inserted, but old entries are not deleted.
  *  \li network_region is applied; it's kept unchanged if the section is omitted.
  *
@@ -93,6 +98,9 @@ private:
 
 private:
   static const size_t DEFAULT_CS_MAX_PACKETS;
+  static const time::seconds DEFAULT_CS_SNAPSHOT_INTERVAL;
+  static const size_t DEFAULT_CS_SHARED_MEMORY_SIZE; ///< in megabytes
+  static const size_t CS_SHARED_MEMORY_OCTETS_PER_SLOT;
 
   Forwarder& m_forwarder;
 
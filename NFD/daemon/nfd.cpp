@@ -39,6 +39,7 @@
 #include "mgmt/general-config-section.hpp"
 #include "mgmt/strategy-choice-manager.hpp"
 #include "mgmt/tables-config-section.hpp"
+#include "rib/fib-updater.hpp"
 
 namespace nfd {
 
@@ -67,7 +68,15 @@ Nfd::Nfd(const ConfigSection& config, ndn::KeyChain& keyChain)
 // It is necessary to explicitly define the destructor, because some member variables (e.g.,
 // unique_ptr<Forwarder>) are forward-declared, but implicitly declared destructor requires
 // complete types for all members when instantiated.
-Nfd::~Nfd() = default;
+Nfd::~Nfd()
+{
+  rib::FibUpdater::setFibTransaction(nullptr);
+
+  // write the final CS snapshot, so that a restart does not lose content cached since the last pass
+  if (m_forwarder != nullptr && m_forwarder->getCsSnapshot() != nullptr) {
+    m_forwarder->getCsSnapshot()->flush();
+  }
+}
 
 void
 Nfd::initialize()
@@ -139,7 +148,11 @@ Nfd::initializeManagement()
   m_forwarderStatusManager = make_unique<ForwarderStatusManager>(*m_forwarder, *m_dispatcher);
   m_faceManager = make_unique<FaceManager>(*m_faceSystem, *m_dispatcher, *m_authenticator);
   m_fibManager = make_unique<FibManager>(m_forwarder->getFib(), m_forwarder->getFaceTable(),
-                                         *m_dispatcher, *m_authenticator);
+                                         *m_dispatcher, *m_authenticator,
+                                         &m_forwarder->getFibViewPublisher());
+  // the RIB service applies FIB updates through the FIB manager directly, rather than
+  // sending control commands over the internal face
+  rib::FibUpdater::setFibTransaction(bind(&FibManager::applyFibUpdates, m_fibManager.get(), _1, _2));
   m_csManager = make_unique<CsManager>(m_forwarder->getCs(), m_forwarder->getCounters(),
                                        *m_dispatcher, *m_authenticator);
   m_strategyChoiceManager = make_unique<StrategyChoiceManager>(m_forwarder->getStrategyChoice(),
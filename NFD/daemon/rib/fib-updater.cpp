@@ -25,6 +25,7 @@
 
 #include "fib-updater.hpp"
 #include "core/logger.hpp"
+#include "daemon/global.hpp"
 
 #include <ndn-cxx/mgmt/nfd/control-parameters.hpp>
 
@@ -38,6 +39,8 @@ using ndn::nfd::ControlParameters;
 const unsigned int FibUpdater::MAX_NUM_TIMEOUTS = 10;
 const uint32_t FibUpdater::ERROR_FACE_NOT_FOUND = 410;
 
+FibUpdater::FibTransaction FibUpdater::s_fibTransaction;
+
 FibUpdater::FibUpdater(Rib& rib, ndn::nfd::Controller& controller)
   : m_rib(rib)
   , m_controller(controller)
@@ -50,6 +53,14 @@ FibUpdater::computeAndSendFibUpdates(const RibUpdateBatch& batch,
                                      const FibUpdateSuccessCallback& onSuccess,
                                      const FibUpdateFailureCallback& onFailure)
 {
+  if (s_fibTransaction != nullptr) {
+    FibUpdateList updates;
+    RibUpdateList inheritedRoutes = computeFibUpdates(batch, updates);
+    sendFibTransaction(std::move(updates), batch.getFaceId(), std::move(inheritedRoutes),
+                       onSuccess, onFailure);
+    return;
+  }
+
   m_batchFaceId = batch.getFaceId();
 
   // Erase previously calculated inherited routes
@@ -64,6 +75,57 @@ FibUpdater::computeAndSendFibUpdates(const RibUpdateBatch& batch,
   sendUpdatesForBatchFaceId(onSuccess, onFailure);
 }
 
+RibUpdateList
+FibUpdater::computeFibUpdates(const RibUpdateBatch& batch, FibUpdateList& updates)
+{
+  m_batchFaceId = batch.getFaceId();
+  m_inheritedRoutes.clear();
+  m_updatesForBatchFaceId.clear();
+  m_updatesForNonBatchFaceId.clear();
+
+  computeUpdates(batch);
+
+  // updates for the batch face go first, in the same order as sendUpdatesForBatchFaceId
+  updates.splice(updates.end(), m_updatesForBatchFaceId);
+  updates.splice(updates.end(), m_updatesForNonBatchFaceId);
+
+  RibUpdateList inheritedRoutes;
+  inheritedRoutes.swap(m_inheritedRoutes);
+  return inheritedRoutes;
+}
+
+void
+FibUpdater::sendFibTransaction(FibUpdateList updates, uint64_t batchFaceId,
+                               RibUpdateList inheritedRoutes,
+                               const FibUpdateSuccessCallback& onSuccess,
+                               const FibUpdateFailureCallback& onFailure)
+{
+  BOOST_ASSERT(s_fibTransaction != nullptr);
+
+  if (updates.empty()) {
+    onSuccess(std::move(inheritedRoutes));
+    return;
+  }
+
+  NFD_LOG_DEBUG("Applying " << updates.size() << " updates to FIB in one transaction");
+
+  runOnMainIoService([transaction = s_fibTransaction, updates = std::move(updates), batchFaceId,
+                      inheritedRoutes = std::move(inheritedRoutes), onSuccess, onFailure] {
+    ndn::nfd::ControlResponse response = transaction(updates, batchFaceId);
+
+    runOnRibIoService([response, inheritedRoutes, onSuccess, onFailure] {
+      if (response.getCode() == 200) {
+        onSuccess(inheritedRoutes);
+      }
+      else {
+        NFD_LOG_DEBUG("FIB transaction rejected (code: " << response.getCode() <<
+                      ", error: " << response.getText() << ")");
+        onFailure(response.getCode(), response.getText());
+      }
+    });
+  });
+}
+
 void
 FibUpdater::computeUpdates(const RibUpdateBatch& batch)
 {
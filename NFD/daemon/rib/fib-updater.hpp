@@ -53,8 +53,40 @@ public:
   typedef std::function<void(RibUpdateList inheritedRoutes)> FibUpdateSuccessCallback;
   typedef std::function<void(uint32_t code, const std::string& error)> FibUpdateFailureCallback;
 
+  /** \brief applies FibUpdates to NFD's FIB in one step
+   *
+   *  The function is invoked on the main thread. It should reject the whole transaction
+   *  if an update cannot be applied to the face with \p batchFaceId, and skip updates
+   *  for other faces that no longer exist.
+   *
+   *  \return response with code 200 if the transaction is applied, otherwise the error
+   *          that caused the transaction to be rejected
+   */
+  typedef std::function<ndn::nfd::ControlResponse(const FibUpdateList& updates,
+                                                  uint64_t batchFaceId)> FibTransaction;
+
   FibUpdater(Rib& rib, ndn::nfd::Controller& controller);
 
+  /** \brief sets the in-process FIB transaction function
+   *
+   *  When set, FibUpdates are passed to the main thread through its io_service and applied
+   *  in a single transaction, instead of being sent as one control command each.
+   *  Pass nullptr to revert to control commands.
+   *
+   *  \warning This must be called while the RIB thread is not running.
+   */
+  static void
+  setFibTransaction(const FibTransaction& transaction)
+  {
+    s_fibTransaction = transaction;
+  }
+
+  static bool
+  hasFibTransaction()
+  {
+    return s_fibTransaction != nullptr;
+  }
+
   /** \brief computes FibUpdates using the provided RibUpdateBatch and then sends the
    *         updates to NFD's FIB
    *
@@ -66,6 +98,24 @@ public:
                            const FibUpdateSuccessCallback& onSuccess,
                            const FibUpdateFailureCallback& onFailure);
 
+  /** \brief computes FibUpdates using the provided RibUpdateBatch without sending them
+   *
+   *  \param[out] updates computed FibUpdates are appended to this list
+   *  \return inherited routes to be applied to the RIB along with \p batch
+   */
+  RibUpdateList
+  computeFibUpdates(const RibUpdateBatch& batch, FibUpdateList& updates);
+
+  /** \brief applies \p updates to NFD's FIB with the in-process FIB transaction
+   *
+   *  \pre hasFibTransaction()
+   *  \param inheritedRoutes passed to onSuccess if the transaction is applied
+   */
+  void
+  sendFibTransaction(FibUpdateList updates, uint64_t batchFaceId, RibUpdateList inheritedRoutes,
+                     const FibUpdateSuccessCallback& onSuccess,
+                     const FibUpdateFailureCallback& onFailure);
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /** \brief determines the type of action that will be performed on the RIB and calls the
   *          corresponding computation method
@@ -267,6 +317,8 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 private:
   static const unsigned int MAX_NUM_TIMEOUTS;
   static const uint32_t ERROR_FACE_NOT_FOUND;
+
+  static FibTransaction s_fibTransaction;
 };
 
 } // namespace rib
@@ -394,6 +394,12 @@ Rib::sendBatchFromQueue()
 
   m_isUpdateInProgress = true;
 
+  if (FibUpdater::hasFibTransaction() &&
+      m_updateBatches.front().batch.begin()->getAction() == RibUpdate::REMOVE_FACE) {
+    sendRemoveFaceBatchesFromQueue();
+    return;
+  }
+
   UpdateQueueItem item = std::move(m_updateBatches.front());
   m_updateBatches.pop_front();
 
@@ -426,9 +432,40 @@ Rib::sendBatchFromQueue()
 }
 
 void
-Rib::onFibUpdateSuccess(const RibUpdateBatch& batch,
-                        const RibUpdateList& inheritedRoutes,
-                        const Rib::UpdateSuccessCallback& onSuccess)
+Rib::sendRemoveFaceBatchesFromQueue()
+{
+  BOOST_ASSERT(m_isUpdateInProgress);
+
+  FibUpdater::FibUpdateList fibUpdates;
+  size_t nBatches = 0;
+  do {
+    const UpdateQueueItem& item = m_updateBatches.front();
+    RibUpdateList inheritedRoutes = m_fibUpdater->computeFibUpdates(item.batch, fibUpdates);
+    applyUpdateBatch(item.batch, inheritedRoutes);
+    if (item.managerSuccessCallback != nullptr) {
+      item.managerSuccessCallback();
+    }
+
+    m_updateBatches.pop_front();
+    ++nBatches;
+  } while (!m_updateBatches.empty() &&
+           m_updateBatches.front().batch.begin()->getAction() == RibUpdate::REMOVE_FACE);
+
+  NFD_LOG_DEBUG("Coalesced " << nBatches << " REMOVE_FACE batches into " <<
+                fibUpdates.size() << " FIB updates");
+
+  // RIB is already updated, so the transaction only needs to advance the queue when done;
+  // it is not rejected because updates for nonexistent faces are skipped
+  m_fibUpdater->sendFibTransaction(std::move(fibUpdates), 0, {},
+                                   [this] (const RibUpdateList&) {
+                                     m_isUpdateInProgress = false;
+                                     sendBatchFromQueue();
+                                   },
+                                   bind(&Rib::onFibUpdateFailure, this, nullptr, _1, _2));
+}
+
+void
+Rib::applyUpdateBatch(const RibUpdateBatch& batch, const RibUpdateList& inheritedRoutes)
 {
   for (const RibUpdate& update : batch) {
     switch (update.getAction()) {
@@ -444,6 +481,14 @@ Rib::onFibUpdateSuccess(const RibUpdateBatch& batch,
 
   // Add and remove precalculated inherited routes to RibEntries
   modifyInheritedRoutes(inheritedRoutes);
+}
+
+void
+Rib::onFibUpdateSuccess(const RibUpdateBatch& batch,
+                        const RibUpdateList& inheritedRoutes,
+                        const Rib::UpdateSuccessCallback& onSuccess)
+{
+  applyUpdateBatch(batch, inheritedRoutes);
 
   m_isUpdateInProgress = false;
 
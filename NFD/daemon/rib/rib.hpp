@@ -175,6 +175,17 @@ private:
   void
   sendBatchFromQueue();
 
+  /** \brief Sends the consecutive REMOVE_FACE update batches at the front of the queue
+  *          as one in-process FIB transaction.
+  *
+  *   Removing the routes of a destroyed face cannot fail, so the RIB is updated as each
+  *   batch is computed, and a face with many routes results in a single FIB transaction.
+  *
+  *   \pre FibUpdater::hasFibTransaction()
+  */
+  void
+  sendRemoveFaceBatchesFromQueue();
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 #ifdef WITH_TESTS
   /** \brief In unit tests, mock FIB update result.
@@ -194,6 +205,11 @@ private:
   RibTable::iterator
   eraseEntry(RibTable::iterator it);
 
+  /** \brief applies the RIB updates in \p batch and the inherited routes computed for them
+   */
+  void
+  applyUpdateBatch(const RibUpdateBatch& batch, const RibUpdateList& inheritedRoutes);
+
   void
   updateRib(const RibUpdateBatch& batch);
 
@@ -60,7 +60,8 @@ void
 EntryImpl::unsetUnsolicited()
 {
   BOOST_ASSERT(!this->isQuery());
-  this->setData(this->getData(), false,"");
+  // keep the hash code: it is the key of this entry in the CS table
+  this->setData(this->getData(), false, this->getHash());
 }
 //
 bool
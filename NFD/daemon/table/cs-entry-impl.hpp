@@ -28,6 +28,8 @@
 
 #include "cs-entry.hpp"
 
+#include <boost/intrusive/list.hpp>
+
 namespace nfd {
 namespace cs {
 
@@ -74,6 +76,11 @@ private:
 private:
   std::string query_hashCode;
  // Name query_name;
+
+  using ExpiryHook = boost::intrusive::list_member_hook<>;
+  ExpiryHook m_expiryHook; ///< links the entry into an ExpiryIndex bucket
+  int64_t m_expiryTick = 0; ///< the ExpiryIndex tick at which the entry expires
+  friend class ExpiryIndex;
 };
 
 } // namespace cs
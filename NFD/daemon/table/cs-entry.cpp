@@ -24,6 +24,7 @@
  */
 
 #include "cs-entry.hpp"
+#include "daemon/global.hpp"
 
 namespace nfd {
 namespace cs {
@@ -43,14 +44,14 @@ bool
 Entry::isStale() const
 {
   BOOST_ASSERT(this->hasData());
-  return m_staleTime < time::steady_clock::now();
+  return this->isStale(getCoarseSteadyClockNow());
 }
 
 void
 Entry::updateStaleTime()
 {
   BOOST_ASSERT(this->hasData());
-  m_staleTime = time::steady_clock::now() + time::milliseconds(m_data->getFreshnessPeriod());
+  m_staleTime = getCoarseSteadyClockNow() + time::milliseconds(m_data->getFreshnessPeriod());
 }
 
 bool
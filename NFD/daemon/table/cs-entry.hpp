@@ -92,6 +92,16 @@ public: // exposed through ContentStore enumeration
   bool
   isStale() const;
 
+  /** \brief checks if the stored Data is stale at \p now
+   *  \pre hasData()
+   */
+  bool
+  isStale(const time::steady_clock::TimePoint& now) const
+  {
+    BOOST_ASSERT(this->hasData());
+    return m_staleTime < now;
+  }
+
   /** \brief determines whether Interest can be satisified by the stored Data
    *  \note ChildSelector is not considered
    *  \pre hasData()
@@ -125,6 +135,15 @@ public: // used by generic ContentStore implementation
   void
   updateStaleTime();
 
+  /** \brief sets stale time to an absolute time point
+   */
+  void
+  setStaleTime(const time::steady_clock::TimePoint& staleTime)
+  {
+    BOOST_ASSERT(this->hasData());
+    m_staleTime = staleTime;
+  }
+
   /** \brief clears the entry
    *  \post !hasData()
    */
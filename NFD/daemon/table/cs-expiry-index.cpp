@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-expiry-index.hpp"
+
+namespace nfd {
+namespace cs {
+
+const time::nanoseconds ExpiryIndex::DEFAULT_BUCKET_WIDTH = 100_ms;
+const size_t ExpiryIndex::DEFAULT_N_BUCKETS = 1024;
+
+ExpiryIndex::ExpiryIndex(time::nanoseconds bucketWidth, size_t nBuckets)
+  : m_bucketWidth(bucketWidth)
+  , m_buckets(nBuckets)
+{
+  BOOST_ASSERT(bucketWidth > time::nanoseconds::zero());
+  BOOST_ASSERT(nBuckets > 0);
+}
+
+ExpiryIndex::~ExpiryIndex()
+{
+  for (Bucket& bucket : m_buckets) {
+    bucket.clear();
+  }
+}
+
+void
+ExpiryIndex::insert(iterator i, const time::steady_clock::TimePoint& expiry)
+{
+  EntryImpl& entry = const_cast<EntryImpl&>(*i);
+
+  // an entry that expired before the last pop is placed at the next tick,
+  // because buckets before it are not visited again until the ring wraps around
+  int64_t tick = std::max(this->computeTick(expiry) + 1, m_nextTick);
+
+  if (entry.m_expiryHook.is_linked()) {
+    if (entry.m_expiryTick == tick) {
+      return;
+    }
+    this->getBucket(entry.m_expiryTick).erase(Bucket::s_iterator_to(entry));
+  }
+  else {
+    ++m_size;
+  }
+
+  entry.m_expiryTick = tick;
+  this->getBucket(tick).push_back(entry);
+}
+
+void
+ExpiryIndex::erase(iterator i)
+{
+  EntryImpl& entry = const_cast<EntryImpl&>(*i);
+  if (!entry.m_expiryHook.is_linked()) {
+    return;
+  }
+
+  this->getBucket(entry.m_expiryTick).erase(Bucket::s_iterator_to(entry));
+  --m_size;
+}
+
+std::vector<const EntryImpl*>
+ExpiryIndex::popExpired(const time::steady_clock::TimePoint& now, size_t limit)
+{
+  std::vector<const EntryImpl*> expired;
+  int64_t nowTick = this->computeTick(now);
+
+  // after a long idle period, visiting each bucket once is sufficient
+  int64_t tick = std::max(m_nextTick, nowTick - static_cast<int64_t>(m_buckets.size()) + 1);
+  for (; tick <= nowTick; ++tick) {
+    Bucket& bucket = this->getBucket(tick);
+    for (auto it = bucket.begin(); it != bucket.end();) {
+      if (it->m_expiryTick > nowTick) {
+        ++it;
+        continue;
+      }
+      if (expired.size() >= limit) {
+        m_nextTick = tick;
+        return expired;
+      }
+      expired.push_back(&*it);
+      it = bucket.erase(it);
+      --m_size;
+    }
+  }
+
+  m_nextTick = nowTick + 1;
+  return expired;
+}
+
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_EXPIRY_INDEX_HPP
+#define NFD_DAEMON_TABLE_CS_EXPIRY_INDEX_HPP
+
+#include "cs-internal.hpp"
+#include "cs-entry-impl.hpp"
+
+namespace nfd {
+namespace cs {
+
+/** \brief an index of CS entries by the time they become evictable
+ *
+ *  This is a hashed timing wheel: a ring of fixed-width time buckets, each holding an
+ *  intrusive list of entries, so that insertion and removal are O(1) and never allocate.
+ *  An entry belongs to the tick that ends the bucket containing its expiry time, and
+ *  is expired once the current time reaches that tick. Entries expiring more than one
+ *  revolution ahead share a bucket with nearer ones and are skipped until their tick comes.
+ */
+class ExpiryIndex : noncopyable
+{
+public:
+  explicit
+  ExpiryIndex(time::nanoseconds bucketWidth = DEFAULT_BUCKET_WIDTH,
+              size_t nBuckets = DEFAULT_N_BUCKETS);
+
+  ~ExpiryIndex();
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  /** \brief inserts an entry, or moves it if it's already indexed
+   *  \param expiry when the entry becomes evictable
+   */
+  void
+  insert(iterator i, const time::steady_clock::TimePoint& expiry);
+
+  /** \brief removes an entry from the index, if present
+   */
+  void
+  erase(iterator i);
+
+  /** \brief removes expired entries from the index
+   *  \param now current time
+   *  \param limit max number of entries to remove
+   *  \return up to \p limit expired entries, roughly in the order they expired
+   */
+  std::vector<const EntryImpl*>
+  popExpired(const time::steady_clock::TimePoint& now, size_t limit);
+
+public:
+  static const time::nanoseconds DEFAULT_BUCKET_WIDTH;
+  static const size_t DEFAULT_N_BUCKETS;
+
+private:
+  using Bucket = boost::intrusive::list<EntryImpl,
+                   boost::intrusive::member_hook<EntryImpl, EntryImpl::ExpiryHook,
+                                                 &EntryImpl::m_expiryHook>,
+                   boost::intrusive::constant_time_size<false>>;
+
+  /** \return the last tick not later than \p t
+   */
+  int64_t
+  computeTick(const time::steady_clock::TimePoint& t) const
+  {
+    return t.time_since_epoch() / m_bucketWidth;
+  }
+
+  Bucket&
+  getBucket(int64_t tick)
+  {
+    return m_buckets[static_cast<uint64_t>(tick) % m_buckets.size()];
+  }
+
+private:
+  time::nanoseconds m_bucketWidth;
+  std::vector<Bucket> m_buckets;
+  int64_t m_nextTick = 0; ///< no entry in buckets before this tick is expired
+  size_t m_size = 0;
+};
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_EXPIRY_INDEX_HPP
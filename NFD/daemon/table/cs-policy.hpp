@@ -117,8 +117,9 @@ public:
   void
   afterRefresh(iterator i);
 
-  /** \brief invoked by CS before an entry is erased due to management command
-   *  \warning CS must not invoke this method if an entry is erased due to eviction.
+  /** \brief invoked by CS before an entry is erased due to management command,
+   *         or because CS reclaims it as a stale entry
+   *  \warning CS must not invoke this method if an entry is erased due to policy eviction.
    */
   void
   beforeErase(iterator i);
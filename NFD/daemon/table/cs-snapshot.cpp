@@ -0,0 +1,309 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-snapshot.hpp"
+#include "cs.hpp"
+#include "core/logger.hpp"
+#include "daemon/global.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace nfd {
+namespace cs {
+
+NFD_LOG_INIT(CsSnapshot);
+
+const size_t Snapshot::BATCH_SIZE = 256;
+const time::nanoseconds Snapshot::BATCH_DELAY = 1_ms;
+
+static const char SNAPSHOT_MAGIC[] = "NFD-CS-SNAPSHOT-1";
+static const size_t SNAPSHOT_MAGIC_SIZE = sizeof(SNAPSHOT_MAGIC) - 1;
+
+enum : uint32_t {
+  SnapshotEntry       = 200,
+  SnapshotHashCode    = 201,
+  SnapshotStaleTime   = 202,
+  SnapshotUnsolicited = 203,
+};
+
+Snapshot::Snapshot(Cs& cs, const std::string& path)
+  : m_cs(cs)
+  , m_path(path)
+  , m_interval(time::nanoseconds::zero())
+{
+}
+
+Snapshot::~Snapshot()
+{
+  this->finishRestore();
+  if (m_file.is_open()) {
+    m_file.close();
+    std::remove((m_path + ".tmp").data());
+  }
+}
+
+void
+Snapshot::setInterval(time::nanoseconds interval)
+{
+  if (m_interval == interval) {
+    return;
+  }
+  m_interval = interval;
+  NFD_LOG_INFO("setInterval " << time::duration_cast<time::seconds>(interval));
+  this->scheduleNextPass();
+}
+
+void
+Snapshot::scheduleNextPass()
+{
+  if (m_interval <= time::nanoseconds::zero()) {
+    m_passEvent.cancel();
+    return;
+  }
+  m_passEvent = getScheduler().schedule(m_interval, [this] {
+    this->startWrite();
+    this->scheduleNextPass();
+  });
+}
+
+bool
+Snapshot::startRestore()
+{
+  this->finishRestore();
+
+  int fd = ::open(m_path.data(), O_RDONLY);
+  if (fd < 0) {
+    NFD_LOG_INFO("restore " << m_path << " not-found");
+    return false;
+  }
+
+  struct stat st;
+  if (::fstat(fd, &st) < 0 || static_cast<size_t>(st.st_size) < SNAPSHOT_MAGIC_SIZE) {
+    NFD_LOG_WARN("restore " << m_path << " truncated");
+    ::close(fd);
+    return false;
+  }
+
+  void* addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    NFD_LOG_WARN("restore " << m_path << " mmap: " << std::strerror(errno));
+    return false;
+  }
+  ::madvise(addr, st.st_size, MADV_SEQUENTIAL);
+
+  m_mapAddr = static_cast<const uint8_t*>(addr);
+  m_mapSize = static_cast<size_t>(st.st_size);
+  if (std::memcmp(m_mapAddr, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE) != 0) {
+    NFD_LOG_WARN("restore " << m_path << " bad-magic");
+    this->finishRestore();
+    return false;
+  }
+
+  NFD_LOG_INFO("restore " << m_path << " size=" << m_mapSize);
+  m_restoreOffset = SNAPSHOT_MAGIC_SIZE;
+  m_nRestored = 0;
+  m_restoreEvent = getScheduler().schedule(0_ns, [this] { this->restoreBatch(); });
+  return true;
+}
+
+void
+Snapshot::restoreBatch()
+{
+  auto steadyNow = time::steady_clock::now();
+  auto systemNow = time::system_clock::now();
+
+  for (size_t i = 0; i < BATCH_SIZE; ++i) {
+    if (m_restoreOffset >= m_mapSize) {
+      NFD_LOG_INFO("restore " << m_path << " complete nRestored=" << m_nRestored);
+      this->finishRestore();
+      return;
+    }
+
+    bool isOk = false;
+    Block entry;
+    std::tie(isOk, entry) = Block::fromBuffer(m_mapAddr + m_restoreOffset,
+                                              m_mapSize - m_restoreOffset);
+    if (!isOk || entry.type() != SnapshotEntry) {
+      NFD_LOG_WARN("restore " << m_path << " malformed-entry offset=" << m_restoreOffset);
+      this->finishRestore();
+      return;
+    }
+    m_restoreOffset += entry.size();
+
+    try {
+      entry.parse();
+      auto data = make_shared<Data>(entry.get(tlv::Data));
+      std::string hashCode = readString(entry.get(SnapshotHashCode));
+      auto staleTime = time::fromUnixTimestamp(
+                         time::milliseconds(readNonNegativeInteger(entry.get(SnapshotStaleTime))));
+      bool isUnsolicited = entry.find(SnapshotUnsolicited) != entry.elements_end();
+
+      if (m_cs.restore(*data, isUnsolicited, hashCode, steadyNow + (staleTime - systemNow)) > 0) {
+        ++m_nRestored;
+      }
+    }
+    catch (const tlv::Error& e) {
+      NFD_LOG_DEBUG("restore " << m_path << " skip-entry: " << e.what());
+    }
+  }
+
+  m_restoreEvent = getScheduler().schedule(BATCH_DELAY, [this] { this->restoreBatch(); });
+}
+
+void
+Snapshot::finishRestore()
+{
+  m_restoreEvent.cancel();
+  if (m_mapAddr != nullptr) {
+    ::munmap(const_cast<uint8_t*>(m_mapAddr), m_mapSize);
+    m_mapAddr = nullptr;
+    m_mapSize = 0;
+  }
+}
+
+void
+Snapshot::startWrite()
+{
+  if (m_file.is_open()) {
+    NFD_LOG_DEBUG("write " << m_path << " in-progress");
+    return;
+  }
+
+  if (this->beginPass()) {
+    m_writeEvent = getScheduler().schedule(0_ns, [this] { this->writeBatch(); });
+  }
+}
+
+void
+Snapshot::flush()
+{
+  if (this->isRestoring()) {
+    NFD_LOG_WARN("flush " << m_path << " restore-in-progress");
+    return;
+  }
+
+  if (m_file.is_open()) {
+    this->finishWrite(false);
+  }
+
+  if (!this->beginPass()) {
+    return;
+  }
+  while (m_file.is_open()) {
+    this->writeBatch();
+  }
+}
+
+bool
+Snapshot::beginPass()
+{
+  m_file.open(m_path + ".tmp", std::ios::binary | std::ios::trunc);
+  if (!m_file) {
+    NFD_LOG_WARN("write " << m_path << ".tmp cannot-open");
+    m_file.close();
+    return false;
+  }
+  m_file.write(SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE);
+
+  // capture a point-in-time view of CS contents; Data packets are shared, not copied
+  auto steadyNow = time::steady_clock::now();
+  auto systemNow = time::system_clock::now();
+  m_pending.clear();
+  m_pending.reserve(m_cs.size());
+  for (const Entry& entry : m_cs) {
+    m_pending.push_back({entry.getData().shared_from_this(), entry.getHash(),
+                         systemNow + (entry.getStaleTime() - steadyNow), entry.isUnsolicited()});
+  }
+  m_writeIndex = 0;
+
+  NFD_LOG_DEBUG("write " << m_path << " start nEntries=" << m_pending.size());
+  return true;
+}
+
+void
+Snapshot::writeBatch()
+{
+  size_t end = std::min(m_writeIndex + BATCH_SIZE, m_pending.size());
+  for (; m_writeIndex < end; ++m_writeIndex) {
+    const PendingEntry& pending = m_pending[m_writeIndex];
+    const Block& wire = pending.data->wireEncode();
+
+    ndn::EncodingBuffer encoder;
+    size_t totalLength = encoder.prependBlock(wire);
+    if (pending.isUnsolicited) {
+      totalLength += prependEmptyBlock(encoder, SnapshotUnsolicited);
+    }
+    totalLength += prependNonNegativeIntegerBlock(encoder, SnapshotStaleTime,
+                     std::max<int64_t>(0, time::toUnixTimestamp(pending.staleTime).count()));
+    totalLength += prependStringBlock(encoder, SnapshotHashCode, pending.hashCode);
+    encoder.prependVarNumber(totalLength);
+    encoder.prependVarNumber(SnapshotEntry);
+
+    m_file.write(reinterpret_cast<const char*>(encoder.buf()), encoder.size());
+  }
+
+  if (!m_file) {
+    NFD_LOG_WARN("write " << m_path << ".tmp failed");
+    this->finishWrite(false);
+  }
+  else if (m_writeIndex >= m_pending.size()) {
+    this->finishWrite(true);
+  }
+  else {
+    m_writeEvent = getScheduler().schedule(BATCH_DELAY, [this] { this->writeBatch(); });
+  }
+}
+
+void
+Snapshot::finishWrite(bool isSuccess)
+{
+  m_writeEvent.cancel();
+  m_file.close();
+  std::string tmpPath = m_path + ".tmp";
+
+  if (isSuccess && !m_file.fail() && std::rename(tmpPath.data(), m_path.data()) == 0) {
+    m_nWritten = m_pending.size();
+    NFD_LOG_INFO("write " << m_path << " complete nWritten=" << m_nWritten);
+  }
+  else {
+    NFD_LOG_WARN("write " << m_path << " aborted");
+    std::remove(tmpPath.data());
+  }
+
+  m_pending.clear();
+  m_pending.shrink_to_fit();
+}
+
+} // namespace cs
+} // namespace nfd
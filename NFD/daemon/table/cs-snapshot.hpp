@@ -0,0 +1,192 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_SNAPSHOT_HPP
+#define NFD_DAEMON_TABLE_CS_SNAPSHOT_HPP
+
+#include "core/common.hpp"
+
+#include <fstream>
+
+namespace nfd {
+namespace cs {
+
+class Cs;
+
+/** \brief persists ContentStore entries across restarts
+ *
+ *  A snapshot file begins with a fixed magic string, followed by a sequence of entries:
+ *  \code
+ *  SnapshotEntry = SNAPSHOT-ENTRY-TYPE TLV-LENGTH
+ *                    SnapshotHashCode
+ *                    SnapshotStaleTime   ; milliseconds since Unix epoch
+ *                    [SnapshotUnsolicited]
+ *                    Data
+ *  \endcode
+ *
+ *  Writing is incremental: every \p interval a new pass captures the CS contents, and each
+ *  scheduler step appends a bounded batch of entries to a temporary file, which atomically
+ *  replaces the snapshot file when the pass completes.
+ *
+ *  Restoring memory-maps the snapshot file and re-inserts its entries into the CS in bounded
+ *  batches, so that forwarding can start before the whole snapshot has been loaded.
+ */
+class Snapshot : noncopyable
+{
+public:
+  Snapshot(Cs& cs, const std::string& path);
+
+  ~Snapshot();
+
+  const std::string&
+  getPath() const
+  {
+    return m_path;
+  }
+
+  /** \brief sets the interval between two consecutive snapshot passes
+   *  \param interval time between passes; zero disables periodic snapshots
+   */
+  void
+  setInterval(time::nanoseconds interval);
+
+  time::nanoseconds
+  getInterval() const
+  {
+    return m_interval;
+  }
+
+  /** \brief starts restoring entries from the snapshot file
+   *  \return whether the snapshot file could be opened and has a valid header
+   *
+   *  Entries are inserted in batches from scheduler events after this function returns.
+   */
+  bool
+  startRestore();
+
+  /** \brief starts a snapshot pass, unless one is in progress
+   */
+  void
+  startWrite();
+
+  /** \brief writes a complete snapshot pass synchronously
+   *
+   *  A pass in progress is abandoned and restarted, so that the snapshot file reflects the
+   *  current CS contents. This should be invoked at shutdown, when the scheduler no longer runs.
+   *  Nothing is written while a restore is in progress, so that the snapshot file is not
+   *  replaced by a partially restored CS.
+   */
+  void
+  flush();
+
+  bool
+  isRestoring() const
+  {
+    return m_mapAddr != nullptr;
+  }
+
+  bool
+  isWriting() const
+  {
+    return m_file.is_open();
+  }
+
+  /** \return number of entries inserted into the CS from the snapshot file
+   */
+  size_t
+  getNRestored() const
+  {
+    return m_nRestored;
+  }
+
+  /** \return number of entries written by the last completed snapshot pass
+   */
+  size_t
+  getNWritten() const
+  {
+    return m_nWritten;
+  }
+
+private:
+  void
+  restoreBatch();
+
+  bool
+  beginPass();
+
+  void
+  finishRestore();
+
+  void
+  writeBatch();
+
+  void
+  finishWrite(bool isSuccess);
+
+  void
+  scheduleNextPass();
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** \brief max number of entries processed in one scheduler step
+   */
+  static const size_t BATCH_SIZE;
+
+  /** \brief delay between two consecutive batches
+   */
+  static const time::nanoseconds BATCH_DELAY;
+
+private:
+  struct PendingEntry
+  {
+    shared_ptr<const Data> data;
+    std::string hashCode;
+    time::system_clock::TimePoint staleTime;
+    bool isUnsolicited;
+  };
+
+  Cs& m_cs;
+  std::string m_path;
+  time::nanoseconds m_interval;
+  scheduler::ScopedEventId m_passEvent;
+
+  // restore state
+  const uint8_t* m_mapAddr = nullptr;
+  size_t m_mapSize = 0;
+  size_t m_restoreOffset = 0;
+  size_t m_nRestored = 0;
+  scheduler::ScopedEventId m_restoreEvent;
+
+  // write state
+  std::ofstream m_file;
+  std::vector<PendingEntry> m_pending;
+  size_t m_writeIndex = 0;
+  size_t m_nWritten = 0;
+  scheduler::ScopedEventId m_writeEvent;
+};
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_SNAPSHOT_HPP
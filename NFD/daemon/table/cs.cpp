@@ -26,6 +26,7 @@
 #include "cs.hpp"
 #include "core/algorithm.hpp"
 #include "core/logger.hpp"
+#include "daemon/global.hpp"
 
 #include <ndn-cxx/lp/tags.hpp>
 #include <ndn-cxx/util/concepts.hpp>
@@ -37,6 +38,10 @@ NDN_CXX_ASSERT_FORWARD_ITERATOR(Cs::const_iterator);
 
 NFD_LOG_INIT(ContentStore);
 
+const size_t Cs::STALE_EVICTION_BATCH = 16;
+const time::nanoseconds Cs::RECENT_REQUEST_PERIOD = 1_s;
+const size_t Cs::BATCH_PREFETCH_DISTANCE = 4;
+
 static unique_ptr<Policy>
 makeDefaultPolicy()
 {
@@ -80,7 +85,7 @@ Cs::insert(const Data& data, bool isUnsolicited,std::string hashCode)//1 for ins
  //   iter++;
  // }
   iterator iter = m_table.lower_bound(hashCode);
-  if(iter->getHashCode() == hashCode){
+  if(iter != m_table.end() && iter->getHashCode() == hashCode){
      m_policy->afterRefresh(iter);
  printf("------------------------------insert in CS:HIT a same hash-------------------------------") ;
      return -1;
@@ -93,6 +98,7 @@ Cs::insert(const Data& data, bool isUnsolicited,std::string hashCode)//1 for ins
 // emplace = add(a),std::set have not duplicated, so if repudicate, return 0 insert false
   EntryImpl& entry = const_cast<EntryImpl&>(*it);
   entry.updateStaleTime();
+  m_expiryIndex.insert(it, entry.getStaleTime());
   if (!isNewEntry) { // existing entry
     // XXX This doesn't forbid unsolicited Data from refreshing a solicited entry, although unsolicited Data is not inserted     
     if (entry.isUnsolicited() && !isUnsolicited) {
@@ -102,11 +108,64 @@ Cs::insert(const Data& data, bool isUnsolicited,std::string hashCode)//1 for ins
     return 0;// if old
   }
   else {
+    if (m_table.size() > m_policy->getLimit()) {
+      this->evictStaleEntries(it);
+    }
     m_policy->afterInsert(it);
     return 1;//if new
   }
 }
 
+void
+Cs::evictStaleEntries(iterator keep)
+{
+  auto now = getCoarseSteadyClockNow();
+  for (const EntryImpl* entry : m_expiryIndex.popExpired(now, STALE_EVICTION_BATCH)) {
+    iterator i = m_table.find(entry->getHashCode());
+    BOOST_ASSERT(i != m_table.end());
+    if (i == keep) {
+      m_expiryIndex.insert(i, i->getStaleTime());
+      continue;
+    }
+    NFD_LOG_DEBUG("evict-stale " << i->getName());
+    m_policy->beforeErase(i);
+    m_table.erase(i);
+  }
+}
+
+std::vector<int>
+Cs::insertBatch(const BatchInsertItem* items, size_t nItems)
+{
+  std::vector<int> results(nItems);
+  for (size_t i = 0; i < nItems; ++i) {
+    // bring the hash code and Data of a later item into cache while this one is being inserted
+    if (i + BATCH_PREFETCH_DISTANCE < nItems) {
+      const BatchInsertItem& ahead = items[i + BATCH_PREFETCH_DISTANCE];
+      NFD_PREFETCH(ahead.hashCode.data());
+      NFD_PREFETCH(ahead.data);
+    }
+    results[i] = this->insert(*items[i].data, items[i].isUnsolicited, items[i].hashCode);
+  }
+  return results;
+}
+
+int
+Cs::restore(const Data& data, bool isUnsolicited, const std::string& hashCode,
+            const time::steady_clock::TimePoint& staleTime)
+{
+  int result = this->insert(data, isUnsolicited, hashCode);
+  if (result <= 0) {
+    return result;
+  }
+
+  // the policy may have evicted the new entry already
+  iterator it = m_table.find(hashCode);
+  if (it != m_table.end()) {
+    const_cast<EntryImpl&>(*it).setStaleTime(staleTime);
+    m_expiryIndex.insert(it, staleTime);
+  }
+  return result;
+}
 
 void
 Cs::erase(const Name& prefix, size_t limit, const AfterEraseCallback& cb)
@@ -124,6 +183,7 @@ Cs::erase(const Name& prefix, size_t limit, const AfterEraseCallback& cb)
    }
   if(match != last){//have some problems
      m_policy->beforeErase(match);
+     m_expiryIndex.erase(match);
      match = m_table.erase(match);
      if (cb) {
          cb(1);
@@ -140,22 +200,97 @@ Cs::find(const Interest& interest,
   BOOST_ASSERT(static_cast<bool>(hitCallback));
   BOOST_ASSERT(static_cast<bool>(missCallback));
   printf("------------------------------CS::find-------------------------------") ;
-  if (!m_shouldServe || m_policy->getLimit() == 0) {
-    missCallback(interest);
+  iterator match = this->findImpl(interest);
+  if (match == m_table.end()) {
+    shared_ptr<const Data> sharedMatch = this->findShared(interest);
+    if (sharedMatch == nullptr) {
+      missCallback(interest);
+    }
+    else {
+      hitCallback(interest, *sharedMatch);
+    }
     return;
   }
-  iterator last = m_table.upper_bound(interest.getHashCode());
-  iterator match = m_table.lower_bound(interest.getHashCode());
-if(last != match)
+  hitCallback(interest, match->getData());
+}
+
+const Data*
+Cs::findMatch(const Interest& interest) const
+{
+  iterator match = this->findImpl(interest);
+  if (match != m_table.end()) {
+    return &match->getData();
+  }
+
+  m_sharedMatch = this->findShared(interest);
+  return m_sharedMatch.get();
+}
+
+std::vector<const Data*>
+Cs::findBatch(const Interest* const* interests, size_t nInterests) const
+{
+  std::vector<const Data*> matches(nInterests, nullptr);
+  m_sharedMatches.clear();
+  for (size_t i = 0; i < nInterests; ++i) {
+    // bring the hash code of a later Interest into cache while this one is being looked up
+    if (i + BATCH_PREFETCH_DISTANCE < nInterests) {
+      NFD_PREFETCH(interests[i + BATCH_PREFETCH_DISTANCE]->getHashCode().data());
+    }
+
+    iterator match = this->findImpl(*interests[i]);
+    if (match != m_table.end()) {
+      // the caller is going to forward the matched Data
+      matches[i] = &match->getData();
+      NFD_PREFETCH(matches[i]);
+      continue;
+    }
+
+    shared_ptr<const Data> sharedMatch = this->findShared(*interests[i]);
+    if (sharedMatch != nullptr) {
+      matches[i] = sharedMatch.get();
+      m_sharedMatches.push_back(std::move(sharedMatch));
+    }
+  }
+  return matches;
+}
+
+iterator
+Cs::findImpl(const Interest& interest) const
 {
+  if (!m_shouldServe || m_policy->getLimit() == 0) {
+    return m_table.end();
+  }
+
+  iterator match = m_table.find(interest.getHashCode());
+  if (match == m_table.end()) {
     NFD_LOG_DEBUG("  no-match");
-    missCallback(interest);
-    return;
- }
+    return match;
+  }
   NFD_LOG_DEBUG("  matching " << match->getHashCode());
   m_policy->beforeUse(match);
-  hitCallback(interest, match->getData());
+
+  // an entry that is still being requested is not evicted for being stale
+  auto keepUntil = getCoarseSteadyClockNow() + RECENT_REQUEST_PERIOD;
+  if (match->getStaleTime() < keepUntil) {
+    m_expiryIndex.insert(match, keepUntil);
+  }
+  return match;
 }
+
+shared_ptr<const Data>
+Cs::findShared(const Interest& interest) const
+{
+  if (m_sharedStorage == nullptr || !m_shouldServe) {
+    return nullptr;
+  }
+
+  shared_ptr<const Data> match = m_sharedStorage->find(interest.getHashCode());
+  if (match != nullptr) {
+    NFD_LOG_DEBUG("  matching-shared " << interest.getHashCode());
+  }
+  return match;
+}
+
 void
 Cs::dump()
 {
@@ -181,6 +316,7 @@ Cs::setPolicyImpl(unique_ptr<Policy> policy)
   NFD_LOG_DEBUG("set-policy " << policy->getName());
   m_policy = std::move(policy);
   m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (iterator it) {
+      m_expiryIndex.erase(it);
       m_table.erase(it);
     });
 
@@ -29,6 +29,9 @@
 #include "cs-policy.hpp"
 #include "cs-internal.hpp"
 #include "cs-entry-impl.hpp"
+#include "cs-expiry-index.hpp"
+
+#include <ndn-cxx/ims/shared-memory-storage.hpp>
 
 #include <boost/iterator/transform_iterator.hpp>
 
@@ -56,6 +59,14 @@ public:
 int
   insert(const Data& data, bool isUnsolicited = false,std::string hashCode = "");
 
+  /** \brief inserts a Data packet restored from a snapshot
+   *  \param staleTime absolute time when the Data becomes stale; it may be in the past
+   *  \return same as insert()
+   */
+  int
+  restore(const Data& data, bool isUnsolicited, const std::string& hashCode,
+          const time::steady_clock::TimePoint& staleTime);
+
   using AfterEraseCallback = std::function<void(size_t nErased)>;
   /** \brief asynchronously erases entries under \p prefix
    *  \param prefix name prefix of entries
@@ -80,6 +91,39 @@ int
        const HitCallback& hitCallback,
        const MissCallback& missCallback) const;
 
+  /** \brief finds the best matching Data packet synchronously
+   *  \return the matching Data, or nullptr if there's no match
+   *  \note Unlike find(), this lookup involves no callbacks. The returned pointer is valid
+   *        until the CS is modified or findMatch() is invoked again.
+   */
+  const Data*
+  findMatch(const Interest& interest) const;
+
+  /** \brief finds the best matching Data packets for a batch of Interests
+   *  \param interests array of \p nInterests Interests for lookup
+   *  \return for each Interest, the matching Data, or nullptr if there's no match
+   *  \note Unlike find(), this lookup involves no callbacks. Returned pointers are valid
+   *        until the CS is modified or findBatch() is invoked again.
+   */
+  std::vector<const Data*>
+  findBatch(const Interest* const* interests, size_t nInterests) const;
+
+  /** \brief a Data packet to be inserted with insertBatch()
+   */
+  struct BatchInsertItem
+  {
+    const Data* data;
+    std::string hashCode;
+    bool isUnsolicited;
+  };
+
+  /** \brief inserts a batch of Data packets
+   *  \param items array of \p nItems Data packets
+   *  \return for each Data packet, the return value of insert()
+   */
+  std::vector<int>
+  insertBatch(const BatchInsertItem* items, size_t nItems);
+
   /** \brief get number of stored packets
    */
   size_t
@@ -119,6 +163,26 @@ public: // configuration
   void
   setPolicy(unique_ptr<Policy> policy);
 
+  /** \brief get shared memory storage, or nullptr if it is disabled
+   */
+  ndn::SharedMemoryStorage*
+  getSharedStorage() const
+  {
+    return m_sharedStorage.get();
+  }
+
+  /** \brief enable or disable (if \p storage is nullptr) shared memory storage
+   *
+   *  Local producers may insert Data into the shared memory storage instead of sending them
+   *  over a face. A lookup that does not match any entry in the Table falls back to the
+   *  shared memory storage.
+   */
+  void
+  setSharedStorage(unique_ptr<ndn::SharedMemoryStorage> storage)
+  {
+    m_sharedStorage = std::move(storage);
+  }
+
   /** \brief get CS_ENABLE_ADMIT flag
    *  \sa https://redmine.named-data.net/projects/nfd/wiki/CsMgmt#Update-config
    */
@@ -178,17 +242,52 @@ public: // enumeration
   }
 
 private: // find
+  /** \brief looks up the Data matching \p interest, and notifies the policy of its use
+   *  \return iterator to the matching entry, or m_table.end() if there's no match
+   */
+  iterator
+  findImpl(const Interest& interest) const;
+
+  /** \brief looks up the Data matching \p interest in the shared memory storage
+   *  \return the matching Data, or nullptr if there's no match
+   */
+  shared_ptr<const Data>
+  findShared(const Interest& interest) const;
+
   void
   setPolicyImpl(unique_ptr<Policy> policy);
 
+  /** \brief evicts up to STALE_EVICTION_BATCH entries that are stale and not recently requested
+   *  \param keep an entry that must not be evicted
+   *
+   *  This is invoked when an insertion exceeds the capacity, before the replacement policy
+   *  is asked to evict entries. Evicting a batch creates headroom for subsequent insertions.
+   */
+  void
+  evictStaleEntries(iterator keep);
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   dump();
 
+  static const size_t STALE_EVICTION_BATCH;
+
+  /** \brief how long a requested entry is exempt from stale eviction
+   */
+  static const time::nanoseconds RECENT_REQUEST_PERIOD;
+
+  /** \brief how many elements ahead a batch operation prefetches
+   */
+  static const size_t BATCH_PREFETCH_DISTANCE;
+
 private:
   Table m_table;//Table = std::set<EntryImpl>;
+  mutable ExpiryIndex m_expiryIndex; ///< updated by find() when an entry is requested
   unique_ptr<Policy> m_policy;
   signal::ScopedConnection m_beforeEvictConnection;
+  unique_ptr<ndn::SharedMemoryStorage> m_sharedStorage;
+  mutable shared_ptr<const Data> m_sharedMatch; ///< keeps findMatch() result alive
+  mutable std::vector<shared_ptr<const Data>> m_sharedMatches; ///< keeps findBatch() results alive
 
   bool m_shouldAdmit = true; ///< if false, no Data will be admitted
   bool m_shouldServe = true; ///< if false, all lookups will miss
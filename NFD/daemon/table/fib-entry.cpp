@@ -57,7 +57,8 @@ Entry::addOrUpdateNextHop(Face& face, EndpointId endpointId, uint64_t cost)
     it = std::prev(m_nextHops.end());
   }
   it->setCost(cost);
-  this->sortNextHops();
+  this->sortNextHop(it);
+  this->afterNextHopsChange();
 }
 
 void
@@ -66,6 +67,7 @@ Entry::removeNextHop(const Face& face, EndpointId endpointId)
   auto it = this->findNextHop(face, endpointId);
   if (it != m_nextHops.end()) {
     m_nextHops.erase(it);
+    this->afterNextHopsChange();
   }
 }
 
@@ -77,13 +79,65 @@ Entry::removeNextHopByFace(const Face& face)
                              return &nexthop.getFace() == &face;
                            });
   m_nextHops.erase(it, m_nextHops.end());
+  this->afterNextHopsChange();
 }
 
 void
-Entry::sortNextHops()
+Entry::sortNextHop(NextHopList::iterator it)
 {
-  std::sort(m_nextHops.begin(), m_nextHops.end(),
-            [] (const NextHop& a, const NextHop& b) { return a.getCost() < b.getCost(); });
+  uint64_t cost = it->getCost();
+  auto costLess = [] (const NextHop& a, const NextHop& b) { return a.getCost() < b.getCost(); };
+
+  // a decreased cost moves the nexthop after the last entry with cost <= its own
+  auto pos = std::upper_bound(m_nextHops.begin(), it, *it, costLess);
+  if (pos != it) {
+    std::rotate(pos, it, std::next(it));
+    return;
+  }
+
+  // an increased cost moves the nexthop before the first following entry with cost >= its own
+  auto last = std::next(it);
+  while (last != m_nextHops.end() && last->getCost() < cost) {
+    ++last;
+  }
+  std::rotate(it, std::next(it), last);
+}
+
+void
+Entry::afterNextHopsChange()
+{
+  m_faces.clear();
+  m_faces.reserve(m_nextHops.size());
+  m_localMask = m_adHocMask = 0;
+  ++m_nextHopsVersion;
+
+  for (size_t i = 0; i < m_nextHops.size(); ++i) {
+    const Face& face = m_nextHops[i].getFace();
+    m_faces.push_back(&face);
+    if (i >= MAX_MASKED_NEXTHOPS) {
+      continue;
+    }
+    if (face.getScope() == ndn::nfd::FACE_SCOPE_LOCAL) {
+      m_localMask |= NextHopMask(1) << i;
+    }
+    if (face.getLinkType() == ndn::nfd::LINK_TYPE_AD_HOC) {
+      m_adHocMask |= NextHopMask(1) << i;
+    }
+  }
+}
+
+NextHopMask
+Entry::getNextHopsMaskByFace(const Face& face) const
+{
+  BOOST_ASSERT(hasNextHopMasks());
+
+  NextHopMask mask = 0;
+  for (size_t i = 0; i < m_faces.size(); ++i) {
+    if (m_faces[i] == &face) {
+      mask |= NextHopMask(1) << i;
+    }
+  }
+  return mask;
 }
 
 } // namespace fib
@@ -46,6 +46,16 @@ namespace fib {
  */
 using NextHopList = std::vector<NextHop>;
 
+/** \brief a bitmask over the nexthops of a FIB entry
+ *
+ *  Bit \c i refers to <tt>getNextHops()[i]</tt>, i.e. the mask follows the cost order.
+ */
+using NextHopMask = uint64_t;
+
+/** \brief maximum number of nexthops for which NextHopMask can be used
+ */
+const size_t MAX_MASKED_NEXTHOPS = std::numeric_limits<NextHopMask>::digits;
+
 /** \brief represents a FIB entry
  */
 class Entry : noncopyable
@@ -97,21 +107,92 @@ public:
   void
   removeNextHopByFace(const Face& face);
 
+public: // nexthop masks
+  /** \return whether this entry has few enough nexthops to be represented by NextHopMask
+   */
+  bool
+  hasNextHopMasks() const
+  {
+    return m_nextHops.size() <= MAX_MASKED_NEXTHOPS;
+  }
+
+  /** \return mask of all nexthops
+   *  \pre hasNextHopMasks()
+   */
+  NextHopMask
+  getAllNextHopsMask() const
+  {
+    BOOST_ASSERT(hasNextHopMasks());
+    return m_nextHops.size() == MAX_MASKED_NEXTHOPS ?
+           ~NextHopMask(0) : (NextHopMask(1) << m_nextHops.size()) - 1;
+  }
+
+  /** \return mask of nexthops on local-scope faces
+   *  \pre hasNextHopMasks()
+   */
+  NextHopMask
+  getLocalNextHopsMask() const
+  {
+    BOOST_ASSERT(hasNextHopMasks());
+    return m_localMask;
+  }
+
+  /** \return mask of nexthops on ad hoc faces
+   *  \pre hasNextHopMasks()
+   */
+  NextHopMask
+  getAdHocNextHopsMask() const
+  {
+    BOOST_ASSERT(hasNextHopMasks());
+    return m_adHocMask;
+  }
+
+  /** \return mask of nexthops on \p face, for any EndpointId
+   *  \pre hasNextHopMasks()
+   */
+  NextHopMask
+  getNextHopsMaskByFace(const Face& face) const;
+
+  /** \return a counter that is incremented whenever a nexthop is added, updated, or removed
+   */
+  uint64_t
+  getNextHopsVersion() const
+  {
+    return m_nextHopsVersion;
+  }
+
 private:
   /** \note This method is non-const because mutable iterators are needed by callers.
    */
   NextHopList::iterator
   findNextHop(const Face& face, EndpointId endpointId);
 
-  /** \brief sorts the nexthop list by cost
+  /** \brief moves the nexthop at \p it to its position in cost order
+   *
+   *  The rest of the list must already be sorted. Nexthops of equal cost keep their relative order.
+   */
+  void
+  sortNextHop(NextHopList::iterator it);
+
+  /** \brief rebuilds m_faces, m_localMask and m_adHocMask from m_nextHops,
+   *         and increments m_nextHopsVersion
    */
   void
-  sortNextHops();
+  afterNextHopsChange();
 
 private:
   Name m_prefix;
   NextHopList m_nextHops;
 
+  /** \brief faces of m_nextHops in the same order
+   *
+   *  Kept as a separate contiguous array so that finding a face does not touch the NextHop records.
+   */
+  std::vector<const Face*> m_faces;
+  NextHopMask m_localMask = 0;
+  NextHopMask m_adHocMask = 0;
+  uint64_t m_nextHopsVersion = 0;
+
   name_tree::Entry* m_nameTreeEntry = nullptr;
 
   friend class name_tree::Entry;
@@ -0,0 +1,200 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fib-view.hpp"
+#include "core/logger.hpp"
+#include "daemon/global.hpp"
+
+namespace nfd {
+namespace fib {
+
+NFD_LOG_INIT(FibView);
+
+constexpr size_t ViewPublisher::MAX_READERS;
+
+View::View(const Fib& fib, uint64_t version)
+  : m_version(version)
+{
+  m_entries.reserve(fib.size());
+  m_index.reserve(fib.size());
+
+  for (const fib::Entry& fibEntry : fib) {
+    m_entries.emplace_back();
+    Entry& entry = m_entries.back();
+    entry.m_prefix = fibEntry.getPrefix();
+    entry.m_prefix.wireEncode(); // readers must not trigger lazy encoding
+    entry.m_nextHops.reserve(fibEntry.getNextHops().size());
+    for (const fib::NextHop& nh : fibEntry.getNextHops()) {
+      entry.m_nextHops.push_back({nh.getFace().getId(), nh.getEndpointId(), nh.getCost()});
+    }
+
+    m_index.emplace(name_tree::computeHash(entry.m_prefix), m_entries.size() - 1);
+    m_maxDepth = std::max(m_maxDepth, entry.m_prefix.size());
+  }
+}
+
+const View::Entry*
+View::find(const Name& name, size_t prefixLen, name_tree::HashValue hash) const
+{
+  auto range = m_index.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    const Entry& entry = m_entries[it->second];
+    if (entry.m_prefix.size() == prefixLen && entry.m_prefix.isPrefixOf(name)) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+const View::Entry*
+View::findLongestPrefixMatch(const Name& name) const
+{
+  name_tree::HashSequence hashes = name_tree::computeHashes(name, m_maxDepth);
+  for (size_t i = hashes.size(); i > 0; --i) {
+    const Entry* entry = this->find(name, i - 1, hashes[i - 1]);
+    if (entry != nullptr) {
+      return entry;
+    }
+  }
+  return nullptr;
+}
+
+const View::Entry*
+View::findExactMatch(const Name& prefix) const
+{
+  if (prefix.size() > m_maxDepth) {
+    return nullptr;
+  }
+  return this->find(prefix, prefix.size(), name_tree::computeHash(prefix));
+}
+
+ViewPublisher::Reader::Reader(ViewPublisher& publisher)
+  : m_publisher(publisher)
+{
+  for (m_slot = 0; m_slot < MAX_READERS; ++m_slot) {
+    bool isUsed = false;
+    if (m_publisher.m_slots[m_slot].isUsed.compare_exchange_strong(isUsed, true)) {
+      return;
+    }
+  }
+  NDN_THROW(std::length_error("Too many FIB view readers"));
+}
+
+ViewPublisher::Reader::~Reader()
+{
+  BOOST_ASSERT(m_publisher.m_slots[m_slot].epoch == 0);
+  m_publisher.m_slots[m_slot].isUsed.store(false, std::memory_order_release);
+}
+
+const View&
+ViewPublisher::Reader::enter()
+{
+  Slot& slot = m_publisher.m_slots[m_slot];
+  BOOST_ASSERT(slot.epoch == 0);
+
+  // The announcement must be visible before the view pointer is loaded; both are sequentially
+  // consistent, so that a publisher either sees this announcement while reclaiming, or
+  // has already replaced the view that is loaded below.
+  slot.epoch.store(m_publisher.m_epoch.load());
+  return *m_publisher.m_current.load();
+}
+
+void
+ViewPublisher::Reader::leave()
+{
+  m_publisher.m_slots[m_slot].epoch.store(0, std::memory_order_release);
+}
+
+ViewPublisher::ViewPublisher(const Fib& fib)
+  : m_fib(fib)
+  , m_current(new View(fib, 0))
+{
+}
+
+ViewPublisher::~ViewPublisher()
+{
+  BOOST_ASSERT(std::none_of(m_slots.begin(), m_slots.end(),
+                            [] (const Slot& slot) { return slot.isUsed.load(); }));
+  delete m_current.load();
+}
+
+void
+ViewPublisher::setEnabled(bool wantEnabled)
+{
+  m_isEnabled = wantEnabled;
+  if (m_isEnabled) {
+    this->publish();
+  }
+  else {
+    m_publishEvent.cancel();
+    m_isPublishScheduled = false;
+  }
+}
+
+void
+ViewPublisher::schedulePublish()
+{
+  if (!m_isEnabled || m_isPublishScheduled) {
+    return;
+  }
+
+  m_isPublishScheduled = true;
+  m_publishEvent = getScheduler().schedule(0_ns, [this] { this->publish(); });
+}
+
+void
+ViewPublisher::publish()
+{
+  m_isPublishScheduled = false;
+  m_publishEvent.cancel();
+
+  unique_ptr<const View> old(m_current.exchange(new View(m_fib, ++m_version)));
+  // readers entering from now on announce at least retireEpoch and load the new view
+  uint64_t retireEpoch = m_epoch.fetch_add(1) + 1;
+  m_retired.emplace_back(retireEpoch, std::move(old));
+  NFD_LOG_TRACE("publish version=" << m_version << " entries=" << m_fib.size());
+
+  this->reclaim();
+}
+
+void
+ViewPublisher::reclaim()
+{
+  uint64_t minEpoch = std::numeric_limits<uint64_t>::max();
+  for (const Slot& slot : m_slots) {
+    uint64_t epoch = slot.epoch.load();
+    if (epoch != 0) {
+      minEpoch = std::min(minEpoch, epoch);
+    }
+  }
+
+  // a view retired in epoch E can only be used by readers that announced an epoch before E
+  while (!m_retired.empty() && m_retired.front().first <= minEpoch) {
+    m_retired.pop_front();
+  }
+}
+
+} // namespace fib
+} // namespace nfd
@@ -0,0 +1,244 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_FIB_VIEW_HPP
+#define NFD_DAEMON_TABLE_FIB_VIEW_HPP
+
+#include "fib.hpp"
+
+#include <atomic>
+#include <deque>
+#include <unordered_map>
+
+namespace nfd {
+namespace fib {
+
+/** \brief An immutable copy of the FIB that can be read from any thread
+ *
+ *  NextHop records refer to faces by FaceId, because Face objects belong to the main thread.
+ */
+class View : noncopyable
+{
+public:
+  struct NextHop
+  {
+    FaceId faceId;
+    EndpointId endpointId;
+    uint64_t cost;
+  };
+
+  class Entry
+  {
+  public:
+    const Name&
+    getPrefix() const
+    {
+      return m_prefix;
+    }
+
+    const std::vector<NextHop>&
+    getNextHops() const
+    {
+      return m_nextHops;
+    }
+
+  private:
+    Name m_prefix;
+    std::vector<NextHop> m_nextHops;
+
+    friend class View;
+  };
+
+  /** \brief Copy the contents of \p fib
+   *  \warning This must be called on the thread that owns \p fib.
+   */
+  View(const Fib& fib, uint64_t version);
+
+  /** \return number of times the FIB has been published before this view
+   */
+  uint64_t
+  getVersion() const
+  {
+    return m_version;
+  }
+
+  size_t
+  size() const
+  {
+    return m_entries.size();
+  }
+
+  /** \brief Performs a longest prefix match
+   *  \return the matched entry, or nullptr if no entry matches
+   */
+  const Entry*
+  findLongestPrefixMatch(const Name& name) const;
+
+  /** \brief Performs an exact match lookup
+   */
+  const Entry*
+  findExactMatch(const Name& prefix) const;
+
+private:
+  const Entry*
+  find(const Name& name, size_t prefixLen, name_tree::HashValue hash) const;
+
+private:
+  uint64_t m_version;
+  std::vector<Entry> m_entries;
+  /// indices into m_entries, keyed by the name tree hash of the prefix
+  std::unordered_multimap<name_tree::HashValue, size_t> m_index;
+  size_t m_maxDepth = 0;
+};
+
+/** \brief Publishes FIB views to reader threads with epoch-based reclamation
+ *
+ *  The main thread publishes a new View after changing the FIB; reader threads obtain the
+ *  current View without taking any lock. A reader announces the global epoch in its slot while
+ *  it reads, and a replaced View is deleted only after every reader that may still be using it
+ *  has left its read-side section.
+ *
+ *  Publishing copies the whole FIB, so it is disabled by default and changes are coalesced:
+ *  schedulePublish() publishes once at the end of the current event loop iteration.
+ */
+class ViewPublisher : noncopyable
+{
+public:
+  /** \brief Registration of a reader thread
+   *
+   *  Each thread that reads the FIB views owns a Reader; a Reader must not be used by
+   *  multiple threads concurrently.
+   */
+  class Reader : noncopyable
+  {
+  public:
+    /** \throw std::length_error MAX_READERS readers already exist
+     */
+    explicit
+    Reader(ViewPublisher& publisher);
+
+    ~Reader();
+
+    /** \brief Begin a read-side section
+     *  \return the current view, which remains valid until leave() is called
+     */
+    const View&
+    enter();
+
+    /** \brief End a read-side section
+     */
+    void
+    leave();
+
+  private:
+    ViewPublisher& m_publisher;
+    size_t m_slot;
+  };
+
+  explicit
+  ViewPublisher(const Fib& fib);
+
+  ~ViewPublisher();
+
+  bool
+  isEnabled() const
+  {
+    return m_isEnabled;
+  }
+
+  /** \brief Enable or disable publishing
+   *
+   *  Enabling publishes the current FIB immediately. While disabled, readers keep seeing
+   *  the last published view.
+   */
+  void
+  setEnabled(bool wantEnabled);
+
+  /** \brief Publish a view of the current FIB at the end of the current event loop iteration
+   *
+   *  This should be called after the FIB is changed. Changes made before the scheduled
+   *  publication are included in a single view. It has no effect if publishing is disabled.
+   */
+  void
+  schedulePublish();
+
+  /** \brief Publish a view of the current FIB immediately
+   */
+  void
+  publish();
+
+  /** \return number of replaced views that are waiting for readers to leave
+   */
+  size_t
+  getNRetiredViews() const
+  {
+    return m_retired.size();
+  }
+
+public:
+  static constexpr size_t MAX_READERS = 64;
+
+private:
+  /** \brief Delete retired views that no reader can be using
+   */
+  void
+  reclaim();
+
+private:
+  /// size of a reader slot in bytes
+  static constexpr size_t SLOT_SIZE = 128;
+
+  /** \brief per-reader state
+   *
+   *  Each slot is padded to two cache lines, so that the fields of adjacent slots never share
+   *  a cache line regardless of the alignment of the slot array, avoiding false sharing
+   *  between readers.
+   */
+  struct Slot
+  {
+    std::atomic<bool> isUsed{false};
+    /// epoch announced by the reader while in a read-side section, 0 when quiescent
+    std::atomic<uint64_t> epoch{0};
+    char padding[SLOT_SIZE - sizeof(std::atomic<uint64_t>) * 2];
+  };
+  static_assert(sizeof(Slot) == SLOT_SIZE, "Slot must be padded to SLOT_SIZE");
+
+  const Fib& m_fib;
+  std::atomic<const View*> m_current;
+  std::atomic<uint64_t> m_epoch{1};
+  std::array<Slot, MAX_READERS> m_slots;
+
+  /// replaced views, with the epoch in which they were replaced, in increasing epoch order
+  std::deque<std::pair<uint64_t, unique_ptr<const View>>> m_retired;
+  uint64_t m_version = 0;
+  bool m_isEnabled = false;
+  bool m_isPublishScheduled = false;
+  scheduler::ScopedEventId m_publishEvent;
+};
+
+} // namespace fib
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_FIB_VIEW_HPP
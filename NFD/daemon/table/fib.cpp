@@ -42,6 +42,12 @@ nteHasFibEntry(const name_tree::Entry& nte)
   return nte.getFibEntry() != nullptr;
 }
 
+static inline bool
+nteHasFibMarker(const name_tree::Entry& nte)
+{
+  return nte.getFibMarkerCount() > 0;
+}
+
 Fib::Fib(NameTree& nameTree)
   : m_nameTree(nameTree)
 {
@@ -61,19 +67,56 @@ Fib::findLongestPrefixMatchImpl(const K& key) const
 const Entry&
 Fib::findLongestPrefixMatch(const Name& prefix) const
 {
-  return this->findLongestPrefixMatchImpl(prefix);
+  if (m_nameTree.isCompressed()) {
+    // the binary search requires every prefix of a marked entry to be materialized
+    return this->findLongestPrefixMatchImpl(prefix);
+  }
+
+  // The binary search finds the longest prefix of 'prefix' that has a FIB entry attached to
+  // itself or to any descendant. No FIB entry can exist on the path between the longest
+  // matching FIB entry and that prefix, so the former is its nearest ancestor with a FIB entry.
+  name_tree::Entry* nte = m_nameTree.findLongestMarkedPrefix(prefix, m_maxDepth, &nteHasFibMarker);
+  if (nte != nullptr) {
+    nte = m_nameTree.findLongestPrefixMatch(*nte, &nteHasFibEntry);
+  }
+
+  if (nte != nullptr) {
+    return *nte->getFibEntry();
+  }
+  return *s_emptyEntry;
+}
+
+const Entry&
+Fib::findLongestPrefixMatchCached(name_tree::Entry& nte) const
+{
+  const Entry* entry = nte.getFibCache().get(m_epoch);
+  if (entry == nullptr) {
+    entry = &this->findLongestPrefixMatchImpl(nte);
+    nte.getFibCache().set(m_epoch, entry);
+  }
+  return *entry;
 }
 
 const Entry&
 Fib::findLongestPrefixMatch(const pit::Entry& pitEntry) const
 {
-  return this->findLongestPrefixMatchImpl(pitEntry);
+  name_tree::Entry* nte = m_nameTree.getEntry(pitEntry);
+  BOOST_ASSERT(nte != nullptr);
+
+  // a name tree entry is shared by PIT entries whose names differ in an implicit digest
+  // or in components beyond the depth limit, so only an exact name can use the cache
+  if (nte->getName().size() != pitEntry.getName().size()) {
+    return this->findLongestPrefixMatchImpl(pitEntry);
+  }
+  return this->findLongestPrefixMatchCached(*nte);
 }
 
 const Entry&
 Fib::findLongestPrefixMatch(const measurements::Entry& measurementsEntry) const
 {
-  return this->findLongestPrefixMatchImpl(measurementsEntry);
+  name_tree::Entry* nte = m_nameTree.getEntry(measurementsEntry);
+  BOOST_ASSERT(nte != nullptr);
+  return this->findLongestPrefixMatchCached(*nte);
 }
 
 Entry*
@@ -96,7 +139,10 @@ Fib::insert(const Name& prefix)
   }
 
   nte.setFibEntry(make_unique<Entry>(prefix));
+  m_epoch = name_tree::makeLookupEpoch();
   ++m_nItems;
+  ++m_nItemsByDepth[prefix.size()];
+  m_maxDepth = std::max(m_maxDepth, prefix.size());
   return {nte.getFibEntry(), true};
 }
 
@@ -105,7 +151,16 @@ Fib::erase(name_tree::Entry* nte, bool canDeleteNte)
 {
   BOOST_ASSERT(nte != nullptr);
 
+  size_t depth = nte->getName().size();
+  BOOST_ASSERT(m_nItemsByDepth[depth] > 0);
+  if (--m_nItemsByDepth[depth] == 0 && depth == m_maxDepth) {
+    while (m_maxDepth > 0 && m_nItemsByDepth[m_maxDepth] == 0) {
+      --m_maxDepth;
+    }
+  }
+
   nte->setFibEntry(nullptr);
+  m_epoch = name_tree::makeLookupEpoch();
   if (canDeleteNte) {
     m_nameTree.eraseIfEmpty(nte);
   }
@@ -33,6 +33,8 @@
 
 #include <boost/range/adaptor/transformed.hpp>
 
+#include <array>
+
 namespace nfd {
 
 namespace measurements {
@@ -58,8 +60,21 @@ public:
     return m_nItems;
   }
 
+  /** \return a value that changes whenever an entry is inserted or erased
+   *
+   *  A saved Entry pointer refers to the same entry as long as this value is unchanged.
+   */
+  uint64_t
+  getEpoch() const
+  {
+    return m_epoch;
+  }
+
 public: // lookup
   /** \brief Performs a longest prefix match
+   *
+   *  The lookup is a binary search on prefix length, bounded by the longest FIB entry prefix,
+   *  which probes the name tree hashtable O(log(getMaxDepth())) times.
    */
   const Entry&
   findLongestPrefixMatch(const Name& prefix) const;
@@ -67,6 +82,7 @@ public: // lookup
   /** \brief Performs a longest prefix match
    *
    *  This is equivalent to `findLongestPrefixMatch(pitEntry.getName())`
+   *  \note The result is cached on the name tree entry until the FIB is changed.
    */
   const Entry&
   findLongestPrefixMatch(const pit::Entry& pitEntry) const;
@@ -74,6 +90,7 @@ public: // lookup
   /** \brief Performs a longest prefix match
    *
    *  This is equivalent to `findLongestPrefixMatch(measurementsEntry.getName())`
+   *  \note The result is cached on the name tree entry until the FIB is changed.
    */
   const Entry&
   findLongestPrefixMatch(const measurements::Entry& measurementsEntry) const;
@@ -146,6 +163,11 @@ private:
   const Entry&
   findLongestPrefixMatchImpl(const K& key) const;
 
+  /** \brief Performs a longest prefix match of \p nte's name, using the lookup cache of \p nte
+   */
+  const Entry&
+  findLongestPrefixMatchCached(name_tree::Entry& nte) const;
+
   void
   erase(name_tree::Entry* nte, bool canDeleteNte = true);
 
@@ -160,6 +182,10 @@ private:
 private:
   NameTree& m_nameTree;
   size_t m_nItems = 0;
+  std::array<size_t, FIB_MAX_DEPTH + 1> m_nItemsByDepth{};
+  size_t m_maxDepth = 0; ///< number of components in the longest FIB entry prefix
+  /// epoch of name tree entries' FIB lookup caches, changed whenever an entry is inserted or erased
+  uint64_t m_epoch = name_tree::makeLookupEpoch();
 
   /** \brief The empty FIB entry.
    *
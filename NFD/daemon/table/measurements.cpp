@@ -86,6 +86,10 @@ Measurements::getParent(const Entry& child)
   name_tree::Entry* nteChild = m_nameTree.getEntry(child);
   name_tree::Entry* nte = nteChild->getParent();
   BOOST_ASSERT(nte != nullptr);
+  if (nte->getName().size() + 1 != child.getName().size()) {
+    // compressed name tree: the direct parent prefix is not materialized
+    return &this->get(child.getName().getPrefix(-1));
+  }
   return &this->get(*nte);
 }
 
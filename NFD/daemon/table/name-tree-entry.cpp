@@ -29,6 +29,13 @@
 namespace nfd {
 namespace name_tree {
 
+uint64_t
+makeLookupEpoch()
+{
+  static uint64_t lastEpoch = 0;
+  return ++lastEpoch;
+}
+
 Entry::Entry(const Name& name, Node* node)
   : m_name(name)
   , m_node(node)
@@ -42,7 +49,8 @@ Entry::setParent(Entry& entry)
 {
   BOOST_ASSERT(this->getParent() == nullptr);
   BOOST_ASSERT(!this->getName().empty());
-  BOOST_ASSERT(entry.getName() == this->getName().getPrefix(-1));
+  BOOST_ASSERT(entry.getName().size() < this->getName().size() &&
+               entry.getName().isPrefixOf(this->getName()));
 
   m_parent = &entry;
   m_parent->m_children.push_back(this);
@@ -74,14 +82,28 @@ Entry::setFibEntry(unique_ptr<fib::Entry> fibEntry)
 {
   BOOST_ASSERT(fibEntry == nullptr || fibEntry->m_nameTreeEntry == nullptr);
 
-  if (m_fibEntry != nullptr) {
+  bool hadFibEntry = m_fibEntry != nullptr;
+  if (hadFibEntry) {
     m_fibEntry->m_nameTreeEntry = nullptr;
   }
   m_fibEntry = std::move(fibEntry);
 
-  if (m_fibEntry != nullptr) {
+  bool hasFibEntry = m_fibEntry != nullptr;
+  if (hasFibEntry) {
     m_fibEntry->m_nameTreeEntry = this;
   }
+
+  if (hadFibEntry != hasFibEntry) {
+    for (Entry* entry = this; entry != nullptr; entry = entry->m_parent) {
+      if (hasFibEntry) {
+        ++entry->m_nFibMarkers;
+      }
+      else {
+        BOOST_ASSERT(entry->m_nFibMarkers > 0);
+        --entry->m_nFibMarkers;
+      }
+    }
+  }
 }
 
 void
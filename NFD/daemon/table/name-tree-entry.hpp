@@ -36,6 +36,44 @@ namespace name_tree {
 
 class Node;
 
+/** \return a new epoch for LookupCache, distinct from every epoch returned before
+ */
+uint64_t
+makeLookupEpoch();
+
+/** \brief Caches the result of a longest prefix match performed for a name tree entry
+ *
+ *  A table that uses this cache keeps a current epoch, obtained from makeLookupEpoch(), and
+ *  replaces it whenever a change may alter the result of any lookup or destroy a returned
+ *  object. A result is valid only if it was stored in the current epoch of the table, so
+ *  that every cached result of the table is invalidated in O(1).
+ *
+ *  \tparam T type of the lookup result
+ */
+template<typename T>
+class LookupCache
+{
+public:
+  /** \return the cached result, or nullptr if it was not stored in \p epoch
+   */
+  T*
+  get(uint64_t epoch) const
+  {
+    return m_epoch == epoch ? m_value : nullptr;
+  }
+
+  void
+  set(uint64_t epoch, T* value)
+  {
+    m_epoch = epoch;
+    m_value = value;
+  }
+
+private:
+  uint64_t m_epoch = 0;
+  T* m_value = nullptr;
+};
+
 /** \brief An entry in the name tree
  */
 class Entry : noncopyable
@@ -49,7 +87,8 @@ public:
     return m_name;
   }
 
-  /** \return entry of getName().getPrefix(-1)
+  /** \return entry of getName().getPrefix(-1), or in a compressed name tree,
+   *          entry of the longest proper prefix of getName() that has an entry
    *  \retval nullptr this entry is the root entry, i.e. getName() == Name()
    */
   Entry*
@@ -59,7 +98,8 @@ public:
   }
 
   /** \brief Set parent of this entry
-   *  \param entry entry of getName().getPrefix(-1)
+   *  \param entry entry of a proper prefix of getName(), which is getName().getPrefix(-1)
+   *               unless the name tree is compressed
    *  \pre getParent() == nullptr
    *  \post getParent() == &entry
    *  \post entry.getChildren() contains this
@@ -115,6 +155,18 @@ public: // attached table entries
   void
   setFibEntry(unique_ptr<fib::Entry> fibEntry);
 
+  /** \return number of FIB entries attached to this entry or any of its descendants
+   *
+   *  An entry with a non-zero count is a marker for the binary search on prefix length
+   *  performed by Fib. Since the count of an entry is never less than that of its children,
+   *  the marked prefixes of any name are exactly those not longer than the longest marked one.
+   */
+  size_t
+  getFibMarkerCount() const
+  {
+    return m_nFibMarkers;
+  }
+
   bool
   hasPitEntries() const
   {
@@ -151,6 +203,23 @@ public: // attached table entries
   void
   setStrategyChoiceEntry(unique_ptr<strategy_choice::Entry> strategyChoiceEntry);
 
+public: // lookup caches
+  /** \brief Cache of the longest prefix match of getName() in the FIB
+   */
+  LookupCache<const fib::Entry>&
+  getFibCache()
+  {
+    return m_fibCache;
+  }
+
+  /** \brief Cache of the effective strategy of getName()
+   */
+  LookupCache<fw::Strategy>&
+  getStrategyCache()
+  {
+    return m_strategyCache;
+  }
+
   /** \return name tree entry on which a table entry is attached,
    *          or nullptr if the table entry is detached
    *  \note This function is for NameTree internal use. Other components
@@ -170,11 +239,16 @@ private:
   std::vector<Entry*> m_children;
 
   unique_ptr<fib::Entry> m_fibEntry;
+  size_t m_nFibMarkers = 0;
   std::vector<shared_ptr<pit::Entry>> m_pitEntries;
   unique_ptr<measurements::Entry> m_measurementsEntry;
   unique_ptr<strategy_choice::Entry> m_strategyChoiceEntry;
 
+  LookupCache<const fib::Entry> m_fibCache;
+  LookupCache<fw::Strategy> m_strategyCache;
+
   friend Node* getNode(const Entry& entry);
+  friend class NameTree;
 };
 
 /** \brief a functor to get a table entry from a name tree entry
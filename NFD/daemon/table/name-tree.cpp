@@ -40,6 +40,51 @@ NameTree::NameTree(size_t nBuckets)
 {
 }
 
+void
+NameTree::setCompressed(bool wantCompressed)
+{
+  if (wantCompressed == m_isCompressed) {
+    return;
+  }
+  NFD_LOG_DEBUG("setCompressed " << wantCompressed << " size=" << this->size());
+
+  std::vector<Entry*> entries;
+  entries.reserve(this->size());
+  for (const Entry& nte : *this) {
+    entries.push_back(const_cast<Entry*>(&nte));
+  }
+  m_isCompressed = wantCompressed;
+
+  if (wantCompressed) {
+    for (Entry* nte : entries) {
+      if (nte->getParent() != nullptr && !nte->hasTableEntries() && nte->getChildren().size() == 1) {
+        this->splice(*nte);
+      }
+    }
+    return;
+  }
+
+  for (Entry* nte : entries) {
+    Entry* parent = nte->getParent();
+    if (parent != nullptr && parent->getName().size() + 1 != nte->getName().size()) {
+      nte->unsetParent();
+      nte->setParent(this->lookup(nte->getName(), nte->getName().size() - 1));
+    }
+  }
+
+  // materialized ancestors must count the FIB entries below them
+  for (const Entry& nte : *this) {
+    const_cast<Entry&>(nte).m_nFibMarkers = 0;
+  }
+  for (const Entry& nte : *this) {
+    if (nte.getFibEntry() != nullptr) {
+      for (Entry* entry = const_cast<Entry*>(&nte); entry != nullptr; entry = entry->m_parent) {
+        ++entry->m_nFibMarkers;
+      }
+    }
+  }
+}
+
 Entry&
 NameTree::lookup(const Name& name, size_t prefixLen)
 {
@@ -48,6 +93,10 @@ NameTree::lookup(const Name& name, size_t prefixLen)
   BOOST_ASSERT(prefixLen <= getMaxDepth());
 
   HashSequence hashes = computeHashes(name, prefixLen);
+  if (m_isCompressed) {
+    return this->lookupCompressed(name, prefixLen, hashes);
+  }
+
   const Node* node = nullptr;
   Entry* parent = nullptr;
 
@@ -63,6 +112,67 @@ NameTree::lookup(const Name& name, size_t prefixLen)
   return node->entry;
 }
 
+Entry&
+NameTree::lookupCompressed(const Name& name, size_t prefixLen, const HashSequence& hashes)
+{
+  const Node* node = m_ht.find(name, prefixLen, hashes);
+  if (node != nullptr) {
+    return node->entry;
+  }
+
+  // find the nearest ancestor that has an entry; the root entry is always materialized
+  Entry* parent = &m_ht.insert(name, 0, hashes).first->entry;
+  if (prefixLen == 0) {
+    return *parent;
+  }
+  for (size_t i = prefixLen - 1; i > 0; --i) {
+    node = m_ht.find(name, i, hashes);
+    if (node != nullptr) {
+      parent = &node->entry;
+      break;
+    }
+  }
+
+  Entry& entry = m_ht.insert(name, prefixLen, hashes).first->entry;
+
+  // children of an entry differ in the component following the parent name,
+  // so at most one child shares a prefix with the new entry
+  size_t parentLen = parent->getName().size();
+  auto it = std::find_if(parent->m_children.begin(), parent->m_children.end(),
+                         [&] (const Entry* child) { return child->getName()[parentLen] == name[parentLen]; });
+  if (it == parent->m_children.end()) {
+    entry.setParent(*parent);
+    return entry;
+  }
+
+  // the sibling cannot be a prefix of the new entry, otherwise it would have been found as parent
+  Entry* sibling = *it;
+  const Name& siblingName = sibling->getName();
+  size_t commonLen = parentLen + 1;
+  while (commonLen < prefixLen && siblingName[commonLen] == name[commonLen]) {
+    ++commonLen;
+  }
+  BOOST_ASSERT(commonLen < siblingName.size());
+
+  sibling->unsetParent();
+  if (commonLen == prefixLen) {
+    // new entry is an ancestor of the sibling
+    entry.setParent(*parent);
+    sibling->setParent(entry);
+    entry.m_nFibMarkers = sibling->m_nFibMarkers;
+    return entry;
+  }
+
+  // new entry and sibling diverge below the parent: materialize the branching point
+  Entry& branch = m_ht.insert(name, commonLen, hashes).first->entry;
+  BOOST_ASSERT(branch.getParent() == nullptr && !branch.hasChildren());
+  branch.setParent(*parent);
+  sibling->setParent(branch);
+  entry.setParent(branch);
+  branch.m_nFibMarkers = sibling->m_nFibMarkers;
+  return entry;
+}
+
 Entry&
 NameTree::lookup(const fib::Entry& fibEntry)
 {
@@ -125,9 +235,20 @@ NameTree::eraseIfEmpty(Entry* entry, bool canEraseAncestors)
   BOOST_ASSERT(entry != nullptr);
 
   size_t nErased = 0;
-  for (Entry* parent = nullptr; entry != nullptr && entry->isEmpty(); entry = parent) {
+  for (Entry* parent = nullptr; entry != nullptr; entry = parent) {
     parent = entry->getParent();
 
+    if (m_isCompressed && parent != nullptr && !entry->hasTableEntries() &&
+        entry->getChildren().size() == 1) {
+      this->splice(*entry);
+      ++nErased;
+      break;
+    }
+
+    if (!entry->isEmpty()) {
+      break;
+    }
+
     if (parent != nullptr) {
       entry->unsetParent();
     }
@@ -146,6 +267,21 @@ NameTree::eraseIfEmpty(Entry* entry, bool canEraseAncestors)
   return nErased;
 }
 
+void
+NameTree::splice(Entry& entry)
+{
+  BOOST_ASSERT(m_isCompressed);
+  BOOST_ASSERT(entry.getChildren().size() == 1);
+  Entry* parent = entry.getParent();
+  Entry* child = entry.getChildren().front();
+  BOOST_ASSERT(parent != nullptr);
+
+  child->unsetParent();
+  entry.unsetParent();
+  m_ht.erase(getNode(entry));
+  child->setParent(*parent);
+}
+
 Entry*
 NameTree::findExactMatch(const Name& name, size_t prefixLen) const
 {
@@ -200,6 +336,9 @@ NameTree::findLongestPrefixMatch(const pit::Entry& pitEntry, const EntrySelector
     for (size_t i = nte->getName().size() + 1; i <= depth; ++i) {
       const Entry* exact = this->findExactMatch(name, i);
       if (exact == nullptr) {
+        if (m_isCompressed) {
+          continue; // a longer prefix may still have an entry
+        }
         break;
       }
       nte = exact;
@@ -209,6 +348,37 @@ NameTree::findLongestPrefixMatch(const pit::Entry& pitEntry, const EntrySelector
   return this->findLongestPrefixMatch(*nte, entrySelector);
 }
 
+Entry*
+NameTree::findLongestMarkedPrefix(const Name& name, size_t maxPrefixLen,
+                                  const EntrySelector& isMarker) const
+{
+  size_t depth = std::min({name.size(), maxPrefixLen, getMaxDepth()});
+  HashSequence hashes = computeHashes(name, depth);
+
+  const Node* node = m_ht.find(name, 0, hashes);
+  if (node == nullptr || !isMarker(node->entry)) {
+    return nullptr;
+  }
+
+  // invariant: prefix of length 'low' is marked, no prefix longer than 'high' is marked
+  Entry* found = &node->entry;
+  size_t low = 0;
+  size_t high = depth;
+  while (low < high) {
+    size_t mid = low + (high - low + 1) / 2;
+    node = m_ht.find(name, mid, hashes);
+    if (node != nullptr && isMarker(node->entry)) {
+      found = &node->entry;
+      low = mid;
+    }
+    else {
+      high = mid - 1;
+    }
+  }
+
+  return found;
+}
+
 boost::iterator_range<NameTree::const_iterator>
 NameTree::findAllMatches(const Name& name, const EntrySelector& entrySelector) const
 {
@@ -233,6 +403,17 @@ NameTree::partialEnumerate(const Name& prefix,
                            const EntrySubTreeSelector& entrySubTreeSelector) const
 {
   Entry* entry = this->findExactMatch(prefix);
+  if (entry == nullptr && m_isCompressed) {
+    // the subtree under an unmaterialized prefix is rooted at a child of its nearest ancestor
+    Entry* ancestor = this->findLongestPrefixMatch(prefix);
+    if (ancestor != nullptr) {
+      auto it = std::find_if(ancestor->getChildren().begin(), ancestor->getChildren().end(),
+                             [&prefix] (const Entry* child) { return prefix.isPrefixOf(child->getName()); });
+      if (it != ancestor->getChildren().end()) {
+        entry = *it;
+      }
+    }
+  }
   return {Iterator(make_shared<PartialEnumerationImpl>(*this, entrySubTreeSelector), entry), end()};
 }
 
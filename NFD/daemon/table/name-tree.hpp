@@ -71,6 +71,28 @@ public: // information
     return m_ht.getNBuckets();
   }
 
+  /** \brief Whether the name tree is path-compressed
+   *
+   *  A compressed name tree is a radix tree: besides the root, only entries with attached table
+   *  entries and entries where two or more branches diverge are materialized. getParent() of an
+   *  entry returns its longest materialized proper prefix. This greatly reduces the number of
+   *  entries for large FIBs with long prefixes, at the expense of slower insertions.
+   */
+  bool
+  isCompressed() const
+  {
+    return m_isCompressed;
+  }
+
+  /** \brief Enable or disable path compression
+   *
+   *  Existing entries are converted: enabling compression deletes entries that have no table
+   *  entries and a single child, disabling it materializes all missing ancestors.
+   *  \warning Existing iterators are invalidated.
+   */
+  void
+  setCompressed(bool wantCompressed);
+
   /** \return name tree entry on which a table entry is attached,
    *          or nullptr if the table entry is detached
    */
@@ -85,7 +107,8 @@ public: // mutation
   /** \brief Find or insert an entry by name
    *
    *  This method seeks a name tree entry of name \c name.getPrefix(prefixLen).
-   *  If the entry does not exist, it is created along with all ancestors.
+   *  If the entry does not exist, it is created along with all ancestors; in a compressed name
+   *  tree, it is created along with the root entry and at most one branching ancestor.
    *  Existing iterators are unaffected during this operation.
    *
    *  \warning \p prefixLen must not exceed \c name.size().
@@ -137,6 +160,8 @@ public: // mutation
    *  \sa Entry::isEmpty()
    *  \post If the entry is empty, it's deleted. If \p canEraseAncestors is true,
    *        ancestors of the entry are also deleted if they become empty.
+   *        In a compressed name tree, a non-root entry without table entries that has a
+   *        single child is also deleted, and the child is attached to its parent.
    *  \note This function must be called after detaching a table entry from a name tree entry,
    *  \note Existing iterators, except those pointing to deleted entries, are unaffected.
    */
@@ -192,6 +217,21 @@ public: // matching
   findLongestPrefixMatch(const pit::Entry& pitEntry,
                          const EntrySelector& entrySelector = AnyEntry()) const;
 
+  /** \brief Longest prefix matching by binary search on prefix length
+   *
+   *  Unlike findLongestPrefixMatch, which probes every prefix of \p name starting from the
+   *  longest one, this method needs O(log(maxPrefixLen)) hashtable lookups.
+   *
+   *  \param maxPrefixLen only prefixes of \p name not longer than this are considered
+   *  \param isMarker a selector that, whenever it accepts an entry, also accepts all of
+   *                  its ancestors
+   *  \return entry with the longest name that is a prefix of \p name and passes \p isMarker,
+   *          or nullptr if the root entry does not exist or does not pass \p isMarker
+   */
+  Entry*
+  findLongestMarkedPrefix(const Name& name, size_t maxPrefixLen,
+                          const EntrySelector& isMarker) const;
+
   /** \brief All-prefixes match lookup
    *  \return a range where every entry has a name that is a prefix of \p name ,
    *          and matches \p entrySelector.
@@ -274,8 +314,19 @@ public: // enumeration
     return Iterator();
   }
 
+private:
+  Entry&
+  lookupCompressed(const Name& name, size_t prefixLen, const HashSequence& hashes);
+
+  /** \brief Delete \p entry and attach its only child to its parent
+   *  \pre the name tree is compressed
+   */
+  void
+  splice(Entry& entry);
+
 private:
   Hashtable m_ht;
+  bool m_isCompressed = false;
 
   friend class EnumerationImpl;
 };
@@ -64,6 +64,7 @@ StrategyChoice::setDefaultStrategy(const Name& strategyName)
   // which expects an existing root entry
   name_tree::Entry& nte = m_nameTree.lookup(Name());
   nte.setStrategyChoiceEntry(std::move(entry));
+  m_epoch = name_tree::makeLookupEpoch();
   ++m_nItems;
 }
 
@@ -111,6 +112,7 @@ StrategyChoice::insert(const Name& prefix, const Name& strategyName)
 
   this->changeStrategy(*entry, *oldStrategy, *strategy);
   entry->setStrategy(std::move(strategy));
+  m_epoch = name_tree::makeLookupEpoch();
   return InsertResult::OK;
 }
 
@@ -158,6 +160,7 @@ StrategyChoice::erase(const Name& prefix)
   this->changeStrategy(*entry, oldStrategy, parentStrategy);
 
   nte->setStrategyChoiceEntry(nullptr);
+  m_epoch = name_tree::makeLookupEpoch();
   m_nameTree.eraseIfEmpty(nte);
   --m_nItems;
 }
@@ -193,16 +196,36 @@ StrategyChoice::findEffectiveStrategy(const Name& prefix) const
   return this->findEffectiveStrategyImpl(prefix);
 }
 
+Strategy&
+StrategyChoice::findEffectiveStrategyCached(name_tree::Entry& nte) const
+{
+  Strategy* strategy = nte.getStrategyCache().get(m_epoch);
+  if (strategy == nullptr) {
+    strategy = &this->findEffectiveStrategyImpl(nte);
+    nte.getStrategyCache().set(m_epoch, strategy);
+  }
+  return *strategy;
+}
+
 Strategy&
 StrategyChoice::findEffectiveStrategy(const pit::Entry& pitEntry) const
 {
-  return this->findEffectiveStrategyImpl(pitEntry);
+  name_tree::Entry* nte = m_nameTree.getEntry(pitEntry);
+  BOOST_ASSERT(nte != nullptr);
+
+  // see Fib::findLongestPrefixMatch(const pit::Entry&)
+  if (nte->getName().size() != pitEntry.getName().size()) {
+    return this->findEffectiveStrategyImpl(pitEntry);
+  }
+  return this->findEffectiveStrategyCached(*nte);
 }
 
 Strategy&
 StrategyChoice::findEffectiveStrategy(const measurements::Entry& measurementsEntry) const
 {
-  return this->findEffectiveStrategyImpl(measurementsEntry);
+  name_tree::Entry* nte = m_nameTree.getEntry(measurementsEntry);
+  BOOST_ASSERT(nte != nullptr);
+  return this->findEffectiveStrategyCached(*nte);
 }
 
 static inline void
@@ -60,6 +60,16 @@ public:
     return m_nItems;
   }
 
+  /** \return a value that changes whenever a strategy is changed
+   *
+   *  A saved Strategy pointer refers to the same instance as long as this value is unchanged.
+   */
+  uint64_t
+  getEpoch() const
+  {
+    return m_epoch;
+  }
+
   /** \brief Set the default strategy
    *
    *  This must be called by forwarder constructor.
@@ -140,6 +150,7 @@ public: // effective strategy
   /** \brief Get effective strategy for \p pitEntry
    *
    *  This is equivalent to `findEffectiveStrategy(pitEntry.getName())`
+   *  \note The result is cached on the name tree entry until a strategy choice is changed.
    */
   fw::Strategy&
   findEffectiveStrategy(const pit::Entry& pitEntry) const;
@@ -147,6 +158,7 @@ public: // effective strategy
   /** \brief Get effective strategy for \p measurementsEntry
    *
    *  This is equivalent to `findEffectiveStrategy(measurementsEntry.getName())`
+   *  \note The result is cached on the name tree entry until a strategy choice is changed.
    */
   fw::Strategy&
   findEffectiveStrategy(const measurements::Entry& measurementsEntry) const;
@@ -187,6 +199,11 @@ private:
   fw::Strategy&
   findEffectiveStrategyImpl(const K& key) const;
 
+  /** \brief Get effective strategy for \p nte's name, using the lookup cache of \p nte
+   */
+  fw::Strategy&
+  findEffectiveStrategyCached(name_tree::Entry& nte) const;
+
   Range
   getRange() const;
 
@@ -194,6 +211,8 @@ private:
   Forwarder& m_forwarder;
   NameTree& m_nameTree;
   size_t m_nItems = 0;
+  /// epoch of name tree entries' strategy lookup caches, changed whenever a strategy is changed
+  uint64_t m_epoch = name_tree::makeLookupEpoch();
 };
 
 std::ostream&
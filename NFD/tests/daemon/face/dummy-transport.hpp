@@ -75,9 +75,11 @@ public:
   }
 
   void
-  receivePacket(Block block)
+  receivePacket(Block block, time::steady_clock::TimePoint rxTime = {})
   {
-    receive(Packet(std::move(block)));
+    Packet packet(std::move(block));
+    packet.rxTime = rxTime;
+    receive(std::move(packet));
   }
 
 protected:
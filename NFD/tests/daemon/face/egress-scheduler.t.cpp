@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/egress-scheduler.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+using namespace nfd::tests;
+using TrafficClass = EgressScheduler::TrafficClass;
+
+class EgressSchedulerFixture : public GlobalIoTimeFixture
+{
+protected:
+  EgressSchedulerFixture()
+  {
+    scheduler.afterDequeue.connect([this] (const Block& frame) { sent.push_back(frame.type()); });
+    scheduler.onQueueOverflow.connect([this] (TrafficClass tc) { dropped.push_back(tc); });
+  }
+
+  /** \brief make a frame of 1000 octets whose TLV-TYPE identifies it
+   */
+  static Block
+  makeFrame(uint32_t id)
+  {
+    std::vector<uint8_t> value(996);
+    Block frame = ndn::encoding::makeBinaryBlock(id, value.data(), value.size());
+    BOOST_ASSERT(frame.size() == 1000);
+    return frame;
+  }
+
+  void
+  setRate(uint64_t rateLimit, size_t burstSize)
+  {
+    EgressScheduler::Options options;
+    options.rateLimit = rateLimit;
+    options.burstSize = burstSize;
+    options.interestQuantum = 1100;
+    options.dataQuantum = 1100;
+    options.queueLimit = 10000;
+    scheduler.setOptions(options);
+  }
+
+protected:
+  EgressScheduler scheduler{{}};
+  std::vector<uint32_t> sent;
+  std::vector<TrafficClass> dropped;
+};
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_FIXTURE_TEST_SUITE(TestEgressScheduler, EgressSchedulerFixture)
+
+BOOST_AUTO_TEST_CASE(Unlimited)
+{
+  scheduler.enqueue(makeFrame(1), TrafficClass::DATA);
+  scheduler.enqueue(makeFrame(2), TrafficClass::INTEREST);
+  BOOST_CHECK_EQUAL(scheduler.size(), 0);
+  BOOST_CHECK(sent == std::vector<uint32_t>({1, 2}));
+}
+
+BOOST_AUTO_TEST_CASE(TokenBucket)
+{
+  setRate(10000, 1500); // 1000-octet frame every 100 ms
+
+  scheduler.enqueue(makeFrame(1), TrafficClass::DATA);
+  scheduler.enqueue(makeFrame(2), TrafficClass::DATA);
+  scheduler.enqueue(makeFrame(3), TrafficClass::DATA);
+  // burst allows two frames, leaving -500 tokens
+  BOOST_CHECK(sent == std::vector<uint32_t>({1, 2}));
+  BOOST_CHECK_EQUAL(scheduler.size(), 1);
+  BOOST_CHECK_EQUAL(scheduler.getQueuedBytes(), 1000);
+
+  advanceClocks(1_ms, 49_ms);
+  BOOST_CHECK_EQUAL(sent.size(), 2);
+  advanceClocks(1_ms, 2_ms);
+  BOOST_CHECK(sent == std::vector<uint32_t>({1, 2, 3}));
+  BOOST_CHECK_EQUAL(scheduler.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Priority)
+{
+  setRate(10000, 500);
+
+  scheduler.enqueue(makeFrame(1), TrafficClass::DATA);
+  scheduler.enqueue(makeFrame(2), TrafficClass::DATA);
+  scheduler.enqueue(makeFrame(3), TrafficClass::DATA);
+  scheduler.enqueue(makeFrame(4), TrafficClass::INTEREST);
+  scheduler.enqueue(makeFrame(5), TrafficClass::CONTROL);
+  BOOST_CHECK(sent == std::vector<uint32_t>({1}));
+
+  advanceClocks(10_ms, 1_s);
+  // control goes first, and the Interest does not wait behind all queued Data
+  BOOST_CHECK(sent == std::vector<uint32_t>({1, 5, 4, 2, 3}));
+}
+
+BOOST_AUTO_TEST_CASE(DeficitRoundRobin)
+{
+  setRate(10000, 500);
+
+  scheduler.enqueue(makeFrame(1), TrafficClass::DATA);
+  for (uint32_t id : {2, 3, 4}) {
+    scheduler.enqueue(makeFrame(id), TrafficClass::DATA);
+  }
+  for (uint32_t id : {11, 12, 13}) {
+    scheduler.enqueue(makeFrame(id), TrafficClass::INTEREST);
+  }
+
+  advanceClocks(10_ms, 1_s);
+  BOOST_CHECK(sent == std::vector<uint32_t>({1, 11, 2, 12, 3, 13, 4}));
+}
+
+BOOST_AUTO_TEST_CASE(QueueLimit)
+{
+  setRate(10000, 500);
+
+  for (uint32_t id = 1; id <= 12; ++id) {
+    scheduler.enqueue(makeFrame(id), TrafficClass::DATA);
+  }
+  scheduler.enqueue(makeFrame(20), TrafficClass::INTEREST);
+
+  // the first frame is sent at once, the Data queue holds 10 frames, and the last one is dropped
+  BOOST_CHECK_EQUAL(sent.size(), 1);
+  BOOST_CHECK_EQUAL(scheduler.size(), 11);
+  BOOST_CHECK(dropped == std::vector<TrafficClass>({TrafficClass::DATA}));
+}
+
+BOOST_AUTO_TEST_CASE(RemoveRateLimit)
+{
+  setRate(10000, 500);
+
+  scheduler.enqueue(makeFrame(1), TrafficClass::DATA);
+  scheduler.enqueue(makeFrame(2), TrafficClass::DATA);
+  scheduler.enqueue(makeFrame(3), TrafficClass::CONTROL);
+  BOOST_CHECK_EQUAL(scheduler.size(), 2);
+
+  setRate(0, 500);
+  BOOST_CHECK(sent == std::vector<uint32_t>({1, 3, 2}));
+  BOOST_CHECK_EQUAL(scheduler.size(), 0);
+
+  scheduler.enqueue(makeFrame(4), TrafficClass::DATA);
+  BOOST_CHECK(sent == std::vector<uint32_t>({1, 3, 2, 4}));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestEgressScheduler
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
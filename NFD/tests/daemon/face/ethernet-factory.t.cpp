@@ -24,6 +24,7 @@
  */
 
 #include "face/ethernet-factory.hpp"
+#include "face/generic-link-service.hpp"
 
 #include "ethernet-fixture.hpp"
 #include "face-system-fixture.hpp"
@@ -211,6 +212,32 @@ BOOST_AUTO_TEST_CASE(McastAdHoc)
   BOOST_CHECK_EQUAL(this->countEtherMcastFaces(ndn::nfd::LINK_TYPE_AD_HOC), netifs.size());
 }
 
+BOOST_AUTO_TEST_CASE(McastAggregation)
+{
+  SKIP_IF_ETHERNET_NETIF_COUNT_LT(1);
+
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      ether
+      {
+        listen no
+        mcast yes
+        mcast_aggregation yes
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, false);
+  auto faces = this->listEtherMcastFaces();
+  BOOST_CHECK_EQUAL(faces.size(), netifs.size());
+  for (const auto* face : faces) {
+    auto linkService = dynamic_cast<GenericLinkService*>(face->getLinkService());
+    BOOST_REQUIRE(linkService != nullptr);
+    BOOST_CHECK(linkService->getOptions().allowAggregation);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(ChangeMcastGroup)
 {
   SKIP_IF_ETHERNET_NETIF_COUNT_LT(1);
@@ -382,6 +409,22 @@ BOOST_AUTO_TEST_CASE(BadMcast)
   BOOST_CHECK_THROW(parseConfig(CONFIG, false), ConfigFile::Error);
 }
 
+BOOST_AUTO_TEST_CASE(BadMcastAggregation)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      ether
+      {
+        mcast_aggregation hello
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG, false), ConfigFile::Error);
+}
+
 BOOST_AUTO_TEST_CASE(BadMcastGroup)
 {
   // not an address
@@ -413,6 +456,54 @@ BOOST_AUTO_TEST_CASE(BadMcastGroup)
   BOOST_CHECK_THROW(parseConfig(CONFIG2, false), ConfigFile::Error);
 }
 
+BOOST_AUTO_TEST_CASE(BadPacketRing)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      ether
+      {
+        packet_ring hello
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(BadMcastXdp)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      ether
+      {
+        mcast_xdp hello
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(BadMcastXdpMultiQueue)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      ether
+      {
+        mcast_xdp_multiqueue hello
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG, false), ConfigFile::Error);
+}
+
 BOOST_AUTO_TEST_CASE(UnknownOption)
 {
   const std::string CONFIG = R"CONFIG(
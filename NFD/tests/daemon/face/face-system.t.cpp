@@ -114,6 +114,22 @@ BOOST_AUTO_TEST_CASE(OmittedSection)
   BOOST_CHECK(!f2->processConfigHistory.back().configSection);
 }
 
+BOOST_AUTO_TEST_CASE(BadIoUring)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      general
+      {
+        io_uring hello
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG, false), ConfigFile::Error);
+}
+
 BOOST_AUTO_TEST_CASE(UnknownSection)
 {
   const std::string CONFIG = R"CONFIG(
@@ -413,6 +413,151 @@ BOOST_AUTO_TEST_CASE(ReassemblyDisabledDropFragCount)
 
 BOOST_AUTO_TEST_SUITE_END() // Fragmentation
 
+BOOST_AUTO_TEST_SUITE(Aggregation)
+
+BOOST_AUTO_TEST_CASE(SendAggregate)
+{
+  // Initialize with Options that enable aggregation
+  GenericLinkService::Options options;
+  options.allowAggregation = true;
+  options.aggregationDelay = 2_ms;
+  initialize(options, 1500);
+
+  shared_ptr<Interest> interest1 = makeInterest("/aggregate/1");
+  shared_ptr<Interest> interest2 = makeInterest("/aggregate/2");
+  shared_ptr<Interest> interest3 = makeInterest("/aggregate/3");
+
+  face->sendInterest(*interest1);
+  face->sendInterest(*interest2);
+  face->sendInterest(*interest3);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 0);
+
+  advanceClocks(1_ms, 3);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(service->getCounters().nOutAggregates, 1);
+
+  Block aggregate = transport->sentPackets.back().packet;
+  BOOST_CHECK_EQUAL(aggregate.type(), lp::tlv::LpAggregate);
+  aggregate.parse();
+  BOOST_REQUIRE_EQUAL(aggregate.elements_size(), 3);
+  BOOST_CHECK_EQUAL(Interest(aggregate.elements()[0]), *interest1);
+  BOOST_CHECK_EQUAL(Interest(aggregate.elements()[2]), *interest3);
+}
+
+BOOST_AUTO_TEST_CASE(SendSingle)
+{
+  GenericLinkService::Options options;
+  options.allowAggregation = true;
+  initialize(options, 1500);
+
+  shared_ptr<Interest> interest1 = makeInterest("/aggregate/1");
+  face->sendInterest(*interest1);
+
+  advanceClocks(1_ms, 3);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(service->getCounters().nOutAggregates, 0);
+  lp::Packet interest1pkt;
+  BOOST_REQUIRE_NO_THROW(interest1pkt.wireDecode(transport->sentPackets.back().packet));
+  BOOST_CHECK(interest1pkt.has<lp::FragmentField>());
+}
+
+BOOST_AUTO_TEST_CASE(HoldWhileQueued)
+{
+  // the rate limit keeps frames queued in the egress scheduler after the first one
+  GenericLinkService::Options options;
+  options.allowAggregation = true;
+  options.aggregationDelay = 5_ms;
+  options.schedulerOptions.rateLimit = 1000;
+  options.schedulerOptions.burstSize = 1;
+  initialize(options, 1500);
+
+  // a packet on an idle link is sent without waiting for aggregationDelay
+  face->sendInterest(*makeInterest("/aggregate/1"));
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
+
+  face->sendInterest(*makeInterest("/aggregate/2"));
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
+
+  // the egress scheduler is busy, so packets are held for aggregationDelay
+  face->sendInterest(*makeInterest("/aggregate/3"));
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(service->getCounters().nOutAggregates, 0);
+  face->sendInterest(*makeInterest("/aggregate/4"));
+  advanceClocks(5_ms);
+  BOOST_CHECK_EQUAL(service->getCounters().nOutAggregates, 1);
+
+  advanceClocks(10_ms, 30);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 3);
+  BOOST_CHECK_EQUAL(transport->sentPackets[2].packet.type(), lp::tlv::LpAggregate);
+}
+
+BOOST_AUTO_TEST_CASE(SendOverMtu)
+{
+  shared_ptr<Interest> interest1 = makeInterest("/aggregate/1");
+  shared_ptr<Data> data1 = makeData("/aggregate/data");
+
+  // Data fits in MTU by itself, but not together with the Interest
+  GenericLinkService::Options options;
+  options.allowAggregation = true;
+  initialize(options, data1->wireEncode().size() + 20);
+
+  // Data does not fit in the pending aggregate, which is sent before it
+  face->sendInterest(*interest1);
+  face->sendData(*data1);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
+
+  // Data is sent when the aggregation timer expires
+  advanceClocks(1_ms, 3);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 2);
+  BOOST_CHECK_EQUAL(transport->sentPackets[0].packet.type(), tlv::Interest);
+  BOOST_CHECK_EQUAL(transport->sentPackets[1].packet.type(), tlv::Data);
+  BOOST_CHECK_EQUAL(service->getCounters().nOutAggregates, 0);
+}
+
+BOOST_AUTO_TEST_CASE(ReceiveAggregate)
+{
+  GenericLinkService::Options options;
+  options.allowAggregation = true;
+  initialize(options, 1500);
+
+  shared_ptr<Interest> interest1 = makeInterest("/aggregate/1");
+  shared_ptr<Data> data1 = makeData("/aggregate/data");
+
+  Block aggregate(lp::tlv::LpAggregate);
+  aggregate.push_back(interest1->wireEncode());
+  aggregate.push_back(lp::Packet(data1->wireEncode()).wireEncode());
+  aggregate.encode();
+
+  transport->receivePacket(aggregate);
+
+  BOOST_CHECK_EQUAL(service->getCounters().nInLpInvalid, 0);
+  BOOST_REQUIRE_EQUAL(receivedInterests.size(), 1);
+  BOOST_CHECK_EQUAL(receivedInterests.back(), *interest1);
+  BOOST_REQUIRE_EQUAL(receivedData.size(), 1);
+  BOOST_CHECK_EQUAL(receivedData.back(), *data1);
+}
+
+BOOST_AUTO_TEST_CASE(ReceiveAggregateDisabled)
+{
+  GenericLinkService::Options options;
+  options.allowAggregation = false;
+  initialize(options, 1500);
+
+  shared_ptr<Interest> interest1 = makeInterest("/aggregate/1");
+  Block aggregate(lp::tlv::LpAggregate);
+  aggregate.push_back(interest1->wireEncode());
+  aggregate.encode();
+
+  transport->receivePacket(aggregate);
+
+  BOOST_CHECK_EQUAL(service->getCounters().nInLpInvalid, 0); // not an error
+  BOOST_CHECK(receivedInterests.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Aggregation
+
 BOOST_AUTO_TEST_SUITE(Reliability)
 
 BOOST_AUTO_TEST_CASE(SendInterest)
@@ -776,6 +921,76 @@ BOOST_AUTO_TEST_CASE(CongestionCoDel)
   BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 7);
 }
 
+BOOST_AUTO_TEST_CASE(CongestionStandingQueue)
+{
+  GenericLinkService::Options options;
+  options.allowCongestionMarking = true;
+  options.baseCongestionMarkingInterval = 100_ms;
+  options.wantStandingQueueMarking = true;
+  initialize(options, MTU_UNLIMITED, 65536);
+  BOOST_CHECK_EQUAL(service->m_firstAboveThresholdTime, time::steady_clock::TimePoint::max());
+
+  shared_ptr<Interest> interest = makeInterest("/12345678");
+
+  // congestion threshold will be 32768 bytes, since min(65536, 65536 / 2) = 32768 bytes
+
+  // queue goes above threshold, but is not yet a standing queue
+  transport->setSendQueueLength(40000);
+  face->sendInterest(*interest);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  lp::Packet pkt1;
+  BOOST_REQUIRE_NO_THROW(pkt1.wireDecode(transport->sentPackets.back().packet));
+  BOOST_CHECK_EQUAL(pkt1.count<lp::CongestionMarkField>(), 0);
+  BOOST_CHECK_EQUAL(service->m_firstAboveThresholdTime, time::steady_clock::now());
+  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 0);
+
+  // burst drains within the interval, not marked
+  this->advanceClocks(50_ms);
+  transport->setSendQueueLength(1000);
+  face->sendInterest(*interest);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 2);
+  lp::Packet pkt2;
+  BOOST_REQUIRE_NO_THROW(pkt2.wireDecode(transport->sentPackets.back().packet));
+  BOOST_CHECK_EQUAL(pkt2.count<lp::CongestionMarkField>(), 0);
+  BOOST_CHECK_EQUAL(service->m_firstAboveThresholdTime, time::steady_clock::TimePoint::max());
+  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 0);
+
+  // queue goes above threshold again
+  transport->setSendQueueLength(40000);
+  face->sendInterest(*interest);
+  time::steady_clock::TimePoint firstAboveThresholdTime = time::steady_clock::now();
+  BOOST_CHECK_EQUAL(service->m_firstAboveThresholdTime, firstAboveThresholdTime);
+  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 0);
+
+  // still above threshold, but within the interval
+  this->advanceClocks(99_ms);
+  face->sendInterest(*interest);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 4);
+  lp::Packet pkt4;
+  BOOST_REQUIRE_NO_THROW(pkt4.wireDecode(transport->sentPackets.back().packet));
+  BOOST_CHECK_EQUAL(pkt4.count<lp::CongestionMarkField>(), 0);
+  BOOST_CHECK_EQUAL(service->m_firstAboveThresholdTime, firstAboveThresholdTime);
+  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 0);
+
+  // standing queue, marked
+  this->advanceClocks(1_ms);
+  face->sendInterest(*interest);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 5);
+  lp::Packet pkt5;
+  BOOST_REQUIRE_NO_THROW(pkt5.wireDecode(transport->sentPackets.back().packet));
+  BOOST_REQUIRE_EQUAL(pkt5.count<lp::CongestionMarkField>(), 1);
+  BOOST_CHECK_EQUAL(service->m_nextMarkTime, time::steady_clock::now() + 100_ms);
+  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 1);
+  BOOST_CHECK_EQUAL(service->getCounters().nCongestionMarked, 1);
+
+  // queue drains, congestion incident ends
+  transport->setSendQueueLength(0);
+  face->sendInterest(*interest);
+  BOOST_CHECK_EQUAL(service->m_firstAboveThresholdTime, time::steady_clock::TimePoint::max());
+  BOOST_CHECK_EQUAL(service->m_nextMarkTime, time::steady_clock::TimePoint::max());
+  BOOST_CHECK_EQUAL(service->m_nMarkedSinceInMarkingState, 0);
+}
+
 BOOST_AUTO_TEST_CASE(DefaultThreshold)
 {
   GenericLinkService::Options options;
@@ -924,6 +1139,32 @@ BOOST_AUTO_TEST_CASE(ReceiveCachePolicy)
   BOOST_CHECK_EQUAL(tag->get().getPolicy(), lp::CachePolicyType::NO_CACHE);
 }
 
+BOOST_AUTO_TEST_CASE(SendCachePolicy)
+{
+  shared_ptr<Data> data = makeData("/12345678");
+  data->setTag(make_shared<NoCacheMarkTag>(lp::EmptyValue{}));
+  face->sendData(*data);
+
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  lp::Packet sent(transport->sentPackets.back().packet);
+  BOOST_REQUIRE(sent.has<lp::CachePolicyField>());
+  BOOST_CHECK_EQUAL(sent.get<lp::CachePolicyField>().getPolicy(), lp::CachePolicyType::NO_CACHE);
+}
+
+BOOST_AUTO_TEST_CASE(SendCachePolicyNotForwarded)
+{
+  // a CachePolicy received from upstream is not sent downstream
+  shared_ptr<Data> data = makeData("/12345678");
+  lp::CachePolicy noCache;
+  noCache.setPolicy(lp::CachePolicyType::NO_CACHE);
+  data->setTag(make_shared<lp::CachePolicyTag>(noCache));
+  face->sendData(*data);
+
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  lp::Packet sent(transport->sentPackets.back().packet);
+  BOOST_CHECK(!sent.has<lp::CachePolicyField>());
+}
+
 BOOST_AUTO_TEST_CASE(ReceiveCachePolicyDropInterest)
 {
   // Initialize with Options that enables local fields
@@ -1351,6 +1592,57 @@ BOOST_AUTO_TEST_CASE(ReceivePrefixAnnouncementDropNack)
 
 BOOST_AUTO_TEST_SUITE_END() // LpFields
 
+BOOST_AUTO_TEST_SUITE(RxTimestamp)
+
+BOOST_AUTO_TEST_CASE(FromTransport)
+{
+  auto rxTime = time::steady_clock::now() - 10_ms;
+
+  shared_ptr<Interest> interest = makeInterest("/12345678");
+  transport->receivePacket(interest->wireEncode(), rxTime);
+
+  shared_ptr<Data> data = makeData("/12345678");
+  transport->receivePacket(data->wireEncode(), rxTime);
+
+  lp::Nack nack = makeNack("/localhost/test", 123, lp::NackReason::NO_ROUTE);
+  lp::Packet packet;
+  packet.set<lp::FragmentField>(std::make_pair(
+    nack.getInterest().wireEncode().begin(), nack.getInterest().wireEncode().end()));
+  packet.set<lp::NackField>(nack.getHeader());
+  transport->receivePacket(packet.wireEncode(), rxTime);
+
+  BOOST_REQUIRE_EQUAL(receivedInterests.size(), 1);
+  auto tag = receivedInterests.back().getTag<RxTimestampTag>();
+  BOOST_REQUIRE(tag != nullptr);
+  BOOST_CHECK(tag->get() == rxTime);
+
+  BOOST_REQUIRE_EQUAL(receivedData.size(), 1);
+  BOOST_CHECK(getRxTime(receivedData.back()) == rxTime);
+
+  BOOST_REQUIRE_EQUAL(receivedNacks.size(), 1);
+  BOOST_CHECK(getRxTime(receivedNacks.back()) == rxTime);
+}
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  auto rxTime = time::steady_clock::now();
+
+  // the transport does not provide a timestamp, so Transport::receive takes the current time
+  shared_ptr<Data> data = makeData("/12345678");
+  transport->receivePacket(data->wireEncode());
+  this->advanceClocks(5_ms);
+
+  BOOST_REQUIRE_EQUAL(receivedData.size(), 1);
+  auto tag = receivedData.back().getTag<RxTimestampTag>();
+  BOOST_REQUIRE(tag != nullptr);
+  BOOST_CHECK(tag->get() == rxTime);
+
+  // packets that did not come from a face are treated as just received
+  BOOST_CHECK(getRxTime(*data) == time::steady_clock::now());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // RxTimestamp
+
 BOOST_AUTO_TEST_SUITE(Malformed) // receive malformed packets
 
 BOOST_AUTO_TEST_CASE(WrongTlvType)
@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/io-uring.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/limited-io.hpp"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+using namespace nfd::tests;
+
+class IoUringFixture : public GlobalIoFixture
+{
+protected:
+  ~IoUringFixture()
+  {
+    ring.reset();
+    for (int fd : fds) {
+      ::close(fd);
+    }
+  }
+
+  /** \brief create the io_uring instance and a connected pair of sockets
+   *  \return false if io_uring is not available on the running kernel
+   */
+  bool
+  initialize(int sockType)
+  {
+    try {
+      ring = make_unique<IoUring>(g_io);
+    }
+    catch (const IoUring::Error& e) {
+      BOOST_TEST_MESSAGE("io_uring is not available, skipping test: " << e.what());
+      return false;
+    }
+
+    BOOST_REQUIRE_EQUAL(::socketpair(AF_UNIX, sockType | SOCK_NONBLOCK, 0, fds), 0);
+    return true;
+  }
+
+  void
+  receive(const void* owner)
+  {
+    ring->receive(owner, fds[1], [this] (int result, const uint8_t* data) {
+      BOOST_REQUIRE_GT(result, 0);
+      received.emplace_back(data, data + result);
+      limitedIo.afterOp();
+    });
+  }
+
+protected:
+  LimitedIo limitedIo;
+  unique_ptr<IoUring> ring;
+  int fds[2] = {-1, -1};
+  std::vector<std::vector<uint8_t>> received;
+};
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_FIXTURE_TEST_SUITE(TestIoUring, IoUringFixture)
+
+BOOST_AUTO_TEST_CASE(Datagram)
+{
+  if (!initialize(SOCK_DGRAM))
+    return;
+
+  this->receive(this);
+
+  std::vector<int> sendResults;
+  auto block1 = ndn::encoding::makeStringBlock(300, "hello");
+  auto block2 = ndn::encoding::makeStringBlock(301, "world");
+  for (const auto& block : {block1, block2}) {
+    ring->send(this, fds[0], block, 0, [&] (int result, const uint8_t* data) {
+      BOOST_CHECK(data == nullptr);
+      sendResults.push_back(result);
+      limitedIo.afterOp();
+    });
+  }
+
+  BOOST_CHECK_EQUAL(limitedIo.run(4, 1_s), LimitedIo::EXCEED_OPS);
+  BOOST_CHECK_EQUAL(sendResults.size(), 2);
+  BOOST_REQUIRE_EQUAL(received.size(), 2);
+  BOOST_CHECK_EQUAL_COLLECTIONS(received[0].begin(), received[0].end(), block1.begin(), block1.end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(received[1].begin(), received[1].end(), block2.begin(), block2.end());
+}
+
+BOOST_AUTO_TEST_CASE(StreamChain)
+{
+  if (!initialize(SOCK_STREAM))
+    return;
+
+  std::vector<Block> chain;
+  std::vector<uint8_t> expected;
+  for (int i = 0; i < 10; ++i) {
+    chain.push_back(ndn::encoding::makeNonNegativeIntegerBlock(300, i));
+    expected.insert(expected.end(), chain.back().begin(), chain.back().end());
+  }
+
+  std::vector<int> sendResults;
+  ring->sendChain(this, fds[0], chain, MSG_WAITALL, [&] (int result, const uint8_t*) {
+    sendResults.push_back(result);
+    limitedIo.afterOp();
+  });
+  BOOST_CHECK_EQUAL(limitedIo.run(chain.size(), 1_s), LimitedIo::EXCEED_OPS);
+  BOOST_REQUIRE_EQUAL(sendResults.size(), chain.size());
+  for (size_t i = 0; i < chain.size(); ++i) {
+    BOOST_CHECK_EQUAL(sendResults[i], chain[i].size());
+  }
+
+  // the stream may be received in any number of segments
+  this->receive(this);
+  std::vector<uint8_t> actual;
+  while (actual.size() < expected.size() &&
+         limitedIo.run(1, 1_s) == LimitedIo::EXCEED_OPS) {
+    actual.insert(actual.end(), received.back().begin(), received.back().end());
+  }
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(Cancel)
+{
+  if (!initialize(SOCK_DGRAM))
+    return;
+
+  int otherOwner = 0;
+  this->receive(this);
+  this->receive(&otherOwner);
+  limitedIo.defer(10_ms); // let the receive operations reach the kernel
+
+  ring->cancel(this);
+  ring->submit();
+  // wait until the cancelled operation has reached its final completion,
+  // otherwise it may still consume the datagram
+  for (int i = 0; i < 100 && ring->getOperationCount() > 1; ++i) {
+    limitedIo.defer(1_ms);
+  }
+  BOOST_REQUIRE_EQUAL(ring->getOperationCount(), 1);
+
+  auto block = ndn::encoding::makeStringBlock(300, "hello");
+  BOOST_REQUIRE_EQUAL(::send(fds[0], block.wire(), block.size(), 0), block.size());
+
+  // only the operation of the other owner receives the datagram
+  BOOST_CHECK_EQUAL(limitedIo.run(2, 100_ms), LimitedIo::EXCEED_TIME);
+  BOOST_CHECK_EQUAL(received.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestIoUring
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
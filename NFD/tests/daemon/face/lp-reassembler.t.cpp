@@ -264,8 +264,13 @@ BOOST_AUTO_TEST_CASE(OutOfOrder)
   std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(0, frag0);
   BOOST_REQUIRE(!isComplete);
 
-  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(0, frag1);
+  Block netPacket;
+  lp::Packet packet;
+  std::tie(isComplete, netPacket, packet) = reassembler.receiveFragment(0, frag1);
   BOOST_REQUIRE(isComplete);
+  BOOST_CHECK(packet.has<lp::NextHopFaceIdField>());
+  BOOST_CHECK_EQUAL_COLLECTIONS(data, data + sizeof(data), netPacket.begin(), netPacket.end());
+  BOOST_CHECK_EQUAL(reassembler.getBufferedSize(), 0);
 }
 
 BOOST_AUTO_TEST_CASE(Duplicate)
@@ -322,6 +327,112 @@ BOOST_AUTO_TEST_CASE(Timeout)
   BOOST_REQUIRE(!isComplete);
 }
 
+BOOST_AUTO_TEST_CASE(BufferLimit)
+{
+  ndn::Buffer data1Buffer(data, 5);
+  ndn::Buffer data2Buffer(data + 5, 5);
+
+  lp::Packet received1;
+  received1.add<lp::FragmentField>(std::make_pair(data1Buffer.begin(), data1Buffer.end()));
+  received1.add<lp::FragIndexField>(0);
+  received1.add<lp::FragCountField>(2);
+  received1.add<lp::SequenceField>(1000);
+
+  lp::Packet received2;
+  received2.add<lp::FragmentField>(std::make_pair(data2Buffer.begin(), data2Buffer.end()));
+  received2.add<lp::FragIndexField>(1);
+  received2.add<lp::FragCountField>(2);
+  received2.add<lp::SequenceField>(2001);
+
+  std::vector<EndpointId> dropHistory;
+  reassembler.onBufferLimitExceeded.connect([&] (EndpointId remoteEp) { dropHistory.push_back(remoteEp); });
+
+  LpReassembler::Options options;
+  options.bufferLimit = 8;
+  reassembler.setOptions(options);
+
+  bool isComplete = false;
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(0, received1);
+  BOOST_REQUIRE(!isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 1);
+  BOOST_CHECK_EQUAL(reassembler.getBufferedSize(), 5);
+  BOOST_CHECK(dropHistory.empty());
+
+  // fragment of another packet does not fit in the remaining buffer space
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(1, received2);
+  BOOST_REQUIRE(!isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 1);
+  BOOST_REQUIRE_EQUAL(dropHistory.size(), 1);
+  BOOST_CHECK_EQUAL(dropHistory.back(), 1);
+
+  // buffer space is released on timeout
+  advanceClocks(1_ms, 600);
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+  BOOST_CHECK_EQUAL(reassembler.getBufferedSize(), 0);
+
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(1, received2);
+  BOOST_REQUIRE(!isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 1);
+  BOOST_CHECK_EQUAL(dropHistory.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(LargeFragCount)
+{
+  ndn::Buffer data1Buffer(data, 5);
+
+  std::vector<EndpointId> dropHistory;
+  reassembler.onBufferLimitExceeded.connect([&] (EndpointId remoteEp) { dropHistory.push_back(remoteEp); });
+
+  LpReassembler::Options options;
+  options.bufferLimit = 100;
+  reassembler.setOptions(options);
+
+  // a large FragCount claimed by the peer does not consume buffer space in advance
+  for (lp::Sequence seq = 1000; seq < 1010; ++seq) {
+    lp::Packet received;
+    received.add<lp::FragmentField>(std::make_pair(data1Buffer.begin(), data1Buffer.end()));
+    received.add<lp::FragIndexField>(0);
+    received.add<lp::FragCountField>(options.nMaxFragments);
+    received.add<lp::SequenceField>(seq);
+
+    bool isComplete = false;
+    std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(0, received);
+    BOOST_REQUIRE(!isComplete);
+  }
+  BOOST_CHECK_EQUAL(reassembler.size(), 10);
+  BOOST_CHECK_EQUAL(reassembler.getBufferedSize(), 50);
+  BOOST_CHECK(dropHistory.empty());
+}
+
+BOOST_AUTO_TEST_CASE(CompactResult)
+{
+  // the first fragment is much larger than the last, so the reservation exceeds the packet size
+  ndn::Buffer data1Buffer(data, 9);
+  ndn::Buffer data2Buffer(data + 9, 1);
+
+  lp::Packet received1;
+  received1.add<lp::FragmentField>(std::make_pair(data1Buffer.begin(), data1Buffer.end()));
+  received1.add<lp::FragIndexField>(0);
+  received1.add<lp::FragCountField>(2);
+  received1.add<lp::SequenceField>(1000);
+
+  lp::Packet received2;
+  received2.add<lp::FragmentField>(std::make_pair(data2Buffer.begin(), data2Buffer.end()));
+  received2.add<lp::FragIndexField>(1);
+  received2.add<lp::FragCountField>(2);
+  received2.add<lp::SequenceField>(1001);
+
+  bool isComplete = false;
+  Block netPacket;
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment(0, received1);
+  BOOST_REQUIRE(!isComplete);
+  std::tie(isComplete, netPacket, std::ignore) = reassembler.receiveFragment(0, received2);
+  BOOST_REQUIRE(isComplete);
+  BOOST_CHECK_EQUAL_COLLECTIONS(data, data + sizeof(data), netPacket.begin(), netPacket.end());
+  BOOST_CHECK_LE(netPacket.getBuffer()->capacity(), sizeof(data) + sizeof(data) / 8);
+  BOOST_CHECK_EQUAL(reassembler.getBufferedSize(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(MissingSequence)
 {
   ndn::Buffer data1Buffer(data, 4);
@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/socket-utils.hpp"
+#include "face/transport.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+
+namespace nfd {
+namespace face {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_FIXTURE_TEST_SUITE(TestSocketUtils, GlobalIoTimeFixture)
+
+BOOST_AUTO_TEST_CASE(TxQueueLengthCacheSampling)
+{
+  TxQueueLengthCache cache;
+  int nSamples = 0;
+  ssize_t queueLength = 100;
+  auto sample = [&] {
+    ++nSamples;
+    return queueLength;
+  };
+
+  BOOST_CHECK_EQUAL(cache.get(sample), 100);
+  BOOST_CHECK_EQUAL(nSamples, 1);
+
+  // within the sampling interval, the cached value is returned
+  queueLength = 200;
+  BOOST_CHECK_EQUAL(cache.get(sample), 100);
+  BOOST_CHECK_EQUAL(nSamples, 1);
+
+  this->advanceClocks(TxQueueLengthCache::SAMPLING_INTERVAL);
+  BOOST_CHECK_EQUAL(cache.get(sample), 200);
+  BOOST_CHECK_EQUAL(nSamples, 2);
+
+  queueLength = QUEUE_ERROR;
+  cache.invalidate();
+  BOOST_CHECK_EQUAL(cache.get(sample), QUEUE_ERROR);
+  BOOST_CHECK_EQUAL(nSamples, 3);
+}
+
+BOOST_AUTO_TEST_CASE(ConvertRxTimestamp)
+{
+  auto toTimestamp = [] (time::system_clock::TimePoint tp) {
+    auto ns = time::duration_cast<time::nanoseconds>(tp.time_since_epoch()).count();
+    return std::make_pair<int64_t, int64_t>(ns / 1000000000, ns % 1000000000);
+  };
+  auto steadyNow = time::steady_clock::now();
+
+  auto ts = toTimestamp(time::system_clock::now() - 1500_us);
+  BOOST_CHECK(convertRxTimestamp(ts.first, ts.second) == steadyNow - 1500_us);
+
+  // timestamps in the future or too far in the past are replaced with the current time
+  ts = toTimestamp(time::system_clock::now() + 1_ms);
+  BOOST_CHECK(convertRxTimestamp(ts.first, ts.second) == steadyNow);
+  ts = toTimestamp(time::system_clock::now() - MAX_RX_TIMESTAMP_AGE - 1_ms);
+  BOOST_CHECK(convertRxTimestamp(ts.first, ts.second) == steadyNow);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSocketUtils
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace tests
+} // namespace face
+} // namespace nfd
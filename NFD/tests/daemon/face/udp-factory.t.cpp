@@ -24,6 +24,7 @@
  */
 
 #include "face/udp-factory.hpp"
+#include "face/generic-link-service.hpp"
 
 #include "face-system-fixture.hpp"
 #include "factory-test-common.hpp"
@@ -329,6 +330,36 @@ BOOST_FIXTURE_TEST_CASE(McastAdHoc, UdpFactoryMcastFixture)
   BOOST_CHECK_EQUAL(this->listUdp6McastFaces(ndn::nfd::LINK_TYPE_AD_HOC).size(), netifsV6.size());
 }
 
+BOOST_FIXTURE_TEST_CASE(McastAggregation, UdpFactoryMcastFixture)
+{
+#ifdef __linux__
+  // need superuser privileges to create multicast faces on Linux
+  SKIP_IF_NOT_SUPERUSER();
+#endif // __linux__
+  SKIP_IF_UDP_MCAST_NETIF_COUNT_LT(1);
+
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      udp
+      {
+        mcast_aggregation yes
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, false);
+  auto faces = this->listUdp4McastFaces();
+  auto facesV6 = this->listUdp6McastFaces();
+  faces.insert(faces.end(), facesV6.begin(), facesV6.end());
+  BOOST_CHECK_EQUAL(faces.size(), netifsV4.size() + netifsV6.size());
+  for (const auto* face : faces) {
+    auto linkService = dynamic_cast<GenericLinkService*>(face->getLinkService());
+    BOOST_REQUIRE(linkService != nullptr);
+    BOOST_CHECK(linkService->getOptions().allowAggregation);
+  }
+}
+
 BOOST_FIXTURE_TEST_CASE(ChangeMcastEndpointV4, UdpFactoryMcastFixture)
 {
 #ifdef __linux__
@@ -657,6 +688,22 @@ BOOST_AUTO_TEST_CASE(BadIdleTimeout)
   BOOST_CHECK_THROW(parseConfig(CONFIG2, false), ConfigFile::Error);
 }
 
+BOOST_AUTO_TEST_CASE(BadGso)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      udp
+      {
+        gso hello
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG, false), ConfigFile::Error);
+}
+
 BOOST_AUTO_TEST_CASE(BadMcast)
 {
   const std::string CONFIG = R"CONFIG(
@@ -673,6 +720,22 @@ BOOST_AUTO_TEST_CASE(BadMcast)
   BOOST_CHECK_THROW(parseConfig(CONFIG, false), ConfigFile::Error);
 }
 
+BOOST_AUTO_TEST_CASE(BadMcastAggregation)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      udp
+      {
+        mcast_aggregation hello
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG, false), ConfigFile::Error);
+}
+
 BOOST_AUTO_TEST_CASE(BadMcastGroupV4)
 {
   // not an address
@@ -175,6 +175,45 @@ BOOST_FIXTURE_TEST_CASE(RemoteClosePermanent, RemoteCloseFixture)
   BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
 }
 
+#ifdef HAVE_UDP_GSO
+BOOST_AUTO_TEST_CASE(SegmentationOffload)
+{
+  TRANSPORT_TEST_INIT(ndn::nfd::FACE_PERSISTENCY_PERSISTENT, true);
+
+  // three equal-size packets followed by a shorter one form a single run
+  std::vector<Block> packets;
+  for (const auto& value : {"aaaaaaaa", "bbbbbbbb", "cccccccc", "dddd"}) {
+    packets.push_back(ndn::encoding::makeStringBlock(300, value));
+    transport->send(Transport::Packet{Block{packets.back()}});
+  }
+  BOOST_CHECK_EQUAL(transport->getCounters().nOutPackets, 4);
+  // packets waiting to be passed to the kernel are included in the send queue length
+  BOOST_CHECK_GE(transport->getSendQueueLength(),
+                 static_cast<ssize_t>(3 * packets[0].size() + packets[3].size()));
+
+  // the receiver sees each segment as a separate datagram
+  for (const auto& pkt : packets) {
+    std::vector<uint8_t> readBuf(pkt.size());
+    remoteRead(readBuf);
+    BOOST_CHECK_EQUAL_COLLECTIONS(readBuf.begin(), readBuf.end(), pkt.begin(), pkt.end());
+  }
+
+  // datagrams possibly coalesced by GRO are delivered as separate packets
+  for (const auto& pkt : packets) {
+    ndn::Buffer buf(pkt.begin(), pkt.end());
+    remoteSocket.send(boost::asio::buffer(buf));
+  }
+  limitedIo.defer(1_s);
+
+  BOOST_CHECK_EQUAL(transport->getCounters().nInPackets, 4);
+  BOOST_REQUIRE_EQUAL(receivedPackets->size(), 4);
+  for (size_t i = 0; i < packets.size(); ++i) {
+    BOOST_CHECK_EQUAL((*receivedPackets)[i].packet, packets[i]);
+  }
+  BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
+}
+#endif // HAVE_UDP_GSO
+
 BOOST_AUTO_TEST_SUITE_END() // TestUnicastUdpTransport
 BOOST_AUTO_TEST_SUITE_END() // Face
 
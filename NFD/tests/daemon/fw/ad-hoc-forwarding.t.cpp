@@ -31,6 +31,7 @@
 // sorted alphabetically.
 #include "fw/asf-strategy.hpp"
 #include "fw/best-route-strategy2.hpp"
+#include "fw/consistent-hash-strategy.hpp"
 #include "fw/multicast-strategy.hpp"
 
 #include "tests/daemon/global-io-fixture.hpp"
@@ -88,6 +89,7 @@ BOOST_AUTO_TEST_SUITE(TestAdHocForwarding)
 using Strategies = boost::mpl::vector<
   AsfStrategy,
   BestRouteStrategy2,
+  ConsistentHashStrategy,
   MulticastStrategy
 >;
 
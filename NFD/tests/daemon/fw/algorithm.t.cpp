@@ -90,6 +90,64 @@ BOOST_AUTO_TEST_CASE(Localhop)
 
 BOOST_AUTO_TEST_SUITE_END() // WouldViolateScope
 
+BOOST_FIXTURE_TEST_CASE(EligibleNextHopsMask, ScopeControlFixture)
+{
+  auto adHocFace5 = make_shared<DummyFace>("dummy://5", "dummy://5", ndn::nfd::FACE_SCOPE_NON_LOCAL,
+                                           ndn::nfd::FACE_PERSISTENCY_PERSISTENT,
+                                           ndn::nfd::LINK_TYPE_AD_HOC);
+
+  fib::Entry fibEntry("/");
+  fibEntry.addOrUpdateNextHop(*nonLocalFace1, 0, 10);
+  fibEntry.addOrUpdateNextHop(*nonLocalFace2, 0, 20);
+  fibEntry.addOrUpdateNextHop(*localFace3, 0, 30);
+  fibEntry.addOrUpdateNextHop(*localFace4, 0, 40);
+  fibEntry.addOrUpdateNextHop(*adHocFace5, 0, 50);
+
+  std::vector<shared_ptr<Face>> faces{nonLocalFace1, nonLocalFace2, localFace3, localFace4, adHocFace5};
+  for (const Name& name : {Name("/ieWRzDsCu"), Name("/localhost/5n1LzIt3"), Name("/localhop/YcIKWCRYJ")}) {
+    auto interest = makeInterest(name);
+    for (const auto& inFace : faces) {
+      fib::NextHopMask expected = 0;
+      for (size_t i = 0; i < faces.size(); ++i) {
+        const Face& outFace = *faces[i];
+        bool isEligible = (&outFace != inFace.get() ||
+                           outFace.getLinkType() == ndn::nfd::LINK_TYPE_AD_HOC) &&
+                          !wouldViolateScope(*inFace, *interest, outFace);
+        expected |= fib::NextHopMask(isEligible) << i;
+      }
+      BOOST_TEST_INFO(name << " from " << inFace->getLocalUri());
+      BOOST_CHECK_EQUAL(getEligibleNextHopsMask(*inFace, *interest, fibEntry), expected);
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(UnexpiredOutRecordMask, GlobalIoTimeFixture)
+{
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  auto face3 = make_shared<DummyFace>();
+
+  fib::Entry fibEntry("/");
+  fibEntry.addOrUpdateNextHop(*face1, 0, 30);
+  fibEntry.addOrUpdateNextHop(*face2, 0, 20);
+  fibEntry.addOrUpdateNextHop(*face3, 0, 10);
+  // [face3, face2, face1]
+
+  auto interest = makeInterest("/lQ8BmDCq");
+  pit::Entry pitEntry(*interest);
+  BOOST_CHECK_EQUAL(getNextHopsWithUnexpiredOutRecordMask(pitEntry, fibEntry, time::steady_clock::now()), 0);
+
+  pitEntry.insertOrUpdateOutRecord(*face1, 0, *interest);
+  BOOST_CHECK_EQUAL(getNextHopsWithUnexpiredOutRecordMask(pitEntry, fibEntry, time::steady_clock::now()), 0b100);
+
+  this->advanceClocks(ndn::DEFAULT_INTEREST_LIFETIME / 2);
+  pitEntry.insertOrUpdateOutRecord(*face3, 0, *interest);
+  BOOST_CHECK_EQUAL(getNextHopsWithUnexpiredOutRecordMask(pitEntry, fibEntry, time::steady_clock::now()), 0b101);
+
+  this->advanceClocks(ndn::DEFAULT_INTEREST_LIFETIME / 2 + 1_ms);
+  BOOST_CHECK_EQUAL(getNextHopsWithUnexpiredOutRecordMask(pitEntry, fibEntry, time::steady_clock::now()), 0b001);
+}
+
 BOOST_AUTO_TEST_CASE(CanForwardToLegacy)
 {
   shared_ptr<Interest> interest = makeInterest("ndn:/WDsuBLIMG");
@@ -85,17 +85,19 @@ BOOST_AUTO_TEST_SUITE(TestFaceInfo)
 
 BOOST_FIXTURE_TEST_CASE(Basic, GlobalIoTimeFixture)
 {
-  FaceInfo info;
+  FaceInfo info(1);
+  BOOST_CHECK_EQUAL(info.getFaceId(), 1);
 
-  auto id = getScheduler().schedule(1_s, []{});
+  auto deadline = time::steady_clock::now() + 1_s;
   ndn::Name interestName("/ndn/interest");
 
   // Receive Interest and forward to next hop; should update RTO information
-  info.setTimeoutEvent(id, interestName);
+  info.setTimeout(deadline, interestName);
   BOOST_CHECK_EQUAL(info.isTimeoutScheduled(), true);
+  BOOST_CHECK(info.getTimeoutDeadline() == deadline);
 
   // If the strategy tries to schedule an RTO when one is already scheduled, throw an exception
-  BOOST_CHECK_THROW(info.setTimeoutEvent(id, interestName), FaceInfo::Error);
+  BOOST_CHECK_THROW(info.setTimeout(deadline, interestName), FaceInfo::Error);
 
   // Receive Data
   shared_ptr<Interest> interest = makeInterest(interestName);
@@ -107,14 +109,19 @@ BOOST_FIXTURE_TEST_CASE(Basic, GlobalIoTimeFixture)
   RttEstimator::Duration rtt(50);
   this->advanceClocks(5_ms, rtt);
 
-  info.recordRtt(pitEntry, *face);
-  info.cancelTimeoutEvent(interestName);
+  info.recordRtt(pitEntry, *face, time::steady_clock::now());
+  info.cancelTimeout(interestName);
 
   BOOST_CHECK_EQUAL(info.getRtt(), rtt);
   BOOST_CHECK_EQUAL(info.getSrtt(), rtt);
 
+  // RTT is measured up to the time at which the Data arrived at the transport
+  this->advanceClocks(5_ms, 20_ms);
+  info.recordRtt(pitEntry, *face, time::steady_clock::now() - 40_ms);
+  BOOST_CHECK_EQUAL(info.getRtt(), 30_ms);
+
   // Send out another Interest which times out
-  info.setTimeoutEvent(id, interestName);
+  info.setTimeout(deadline, interestName);
 
   info.recordTimeout(interestName);
   BOOST_CHECK_EQUAL(info.getRtt(), RttStats::RTT_TIMEOUT);
@@ -123,6 +130,95 @@ BOOST_FIXTURE_TEST_CASE(Basic, GlobalIoTimeFixture)
 
 BOOST_AUTO_TEST_SUITE_END() // TestFaceInfo
 
+BOOST_FIXTURE_TEST_SUITE(TestNamespaceInfo, GlobalIoTimeFixture)
+
+BOOST_AUTO_TEST_CASE(FaceInfoLifetime)
+{
+  NamespaceInfo ns;
+  fib::Entry fibEntry("/");
+
+  BOOST_CHECK(ns.getFaceInfo(fibEntry, 1) == nullptr);
+  FaceInfo& info1 = ns.getOrCreateFaceInfo(fibEntry, 1);
+  BOOST_CHECK_EQUAL(info1.getFaceId(), 1);
+  BOOST_CHECK_EQUAL(&ns.getOrCreateFaceInfo(fibEntry, 1), &info1);
+  ns.getOrCreateFaceInfo(fibEntry, 2);
+
+  this->advanceClocks(1_min, AsfMeasurements::MEASUREMENTS_LIFETIME - 1_min);
+  ns.extendFaceInfoLifetime(*ns.get(2), 2);
+  this->advanceClocks(1_min, 2_min);
+
+  // FaceInfo of face 1 has expired
+  BOOST_CHECK(ns.get(1) == nullptr);
+  BOOST_CHECK(ns.find(1) == ns.end());
+  BOOST_REQUIRE(ns.get(2) != nullptr);
+
+  FaceInfo& newInfo1 = *ns.insert(1);
+  BOOST_CHECK_EQUAL(newInfo1.getFaceId(), 1);
+  BOOST_CHECK(!newInfo1.hasSrttMeasurement());
+
+  ns.expireFaceInfo(2);
+  BOOST_CHECK(ns.get(2) == nullptr);
+  BOOST_CHECK(ns.get(1) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Timeouts)
+{
+  NamespaceInfo ns;
+  fib::Entry fibEntry("/");
+  ns.getOrCreateFaceInfo(fibEntry, 1);
+  ns.getOrCreateFaceInfo(fibEntry, 2);
+  ns.getOrCreateFaceInfo(fibEntry, 3);
+
+  std::vector<std::pair<Name, FaceId>> timeouts;
+  auto onTimeout = [&timeouts] (const Name& interestName, FaceId faceId) {
+    timeouts.emplace_back(interestName, faceId);
+  };
+
+  ns.scheduleTimeout(*ns.get(1), 300_ms, "/A/1", onTimeout);
+  ns.scheduleTimeout(*ns.get(2), 100_ms, "/A/2", onTimeout);
+  ns.scheduleTimeout(*ns.get(3), 200_ms, "/A/3", onTimeout);
+  BOOST_CHECK_THROW(ns.scheduleTimeout(*ns.get(3), 200_ms, "/A/3", onTimeout), FaceInfo::Error);
+
+  this->advanceClocks(10_ms, 150_ms);
+  BOOST_REQUIRE_EQUAL(timeouts.size(), 1);
+  BOOST_CHECK_EQUAL(timeouts[0].first, "/A/2");
+  BOOST_CHECK_EQUAL(timeouts[0].second, 2);
+  BOOST_CHECK(!ns.get(2)->isTimeoutScheduled());
+
+  // Data arrives from face 3
+  ns.get(3)->cancelTimeout("/A/3/data");
+  BOOST_CHECK(!ns.get(3)->isTimeoutScheduled());
+
+  // a timeout earlier than the pending one
+  ns.scheduleTimeout(*ns.get(2), 20_ms, "/A/4", onTimeout);
+
+  this->advanceClocks(10_ms, 100_ms);
+  BOOST_REQUIRE_EQUAL(timeouts.size(), 2);
+  BOOST_CHECK_EQUAL(timeouts[1].first, "/A/4");
+
+  this->advanceClocks(10_ms, 100_ms);
+  BOOST_REQUIRE_EQUAL(timeouts.size(), 3);
+  BOOST_CHECK_EQUAL(timeouts[2].first, "/A/1");
+  BOOST_CHECK_EQUAL(timeouts[2].second, 1);
+
+  this->advanceClocks(100_ms, 1_s);
+  BOOST_CHECK_EQUAL(timeouts.size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(TimeoutCancelledOnDestruction)
+{
+  int nTimeouts = 0;
+  {
+    NamespaceInfo ns;
+    ns.scheduleTimeout(ns.getOrCreateFaceInfo(fib::Entry("/"), 1), 100_ms, "/A",
+                       [&nTimeouts] (const Name&, FaceId) { ++nTimeouts; });
+  }
+  this->advanceClocks(100_ms, 1_s);
+  BOOST_CHECK_EQUAL(nTimeouts, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestNamespaceInfo
+
 BOOST_AUTO_TEST_SUITE_END() // TestAsfStrategy
 BOOST_AUTO_TEST_SUITE_END() // Fw
 
@@ -0,0 +1,244 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/consistent-hash-strategy.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+#include "strategy-tester.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using ConsistentHashStrategyTester = StrategyTester<ConsistentHashStrategy>;
+NFD_REGISTER_STRATEGY(ConsistentHashStrategyTester);
+
+BOOST_AUTO_TEST_SUITE(Fw)
+
+class ConsistentHashStrategyFixture : public GlobalIoTimeFixture
+{
+protected:
+  ConsistentHashStrategyFixture()
+    : strategy(forwarder)
+    , fib(forwarder.getFib())
+    , pit(forwarder.getPit())
+    , face1(make_shared<DummyFace>())
+    , face2(make_shared<DummyFace>())
+    , face3(make_shared<DummyFace>())
+    , face4(make_shared<DummyFace>())
+  {
+    forwarder.addFace(face1);
+    forwarder.addFace(face2);
+    forwarder.addFace(face3);
+    forwarder.addFace(face4);
+  }
+
+  /** \brief pick the nexthop with the highest score for \p key, as the strategy would
+   */
+  static FaceId
+  pickFace(uint64_t key, const std::vector<std::pair<FaceId, uint64_t>>& nexthops)
+  {
+    FaceId best = face::INVALID_FACEID;
+    double highestScore = 0.0;
+    for (const auto& nh : nexthops) {
+      double score = ConsistentHashStrategy::computeScore(key, nh.first, nh.second);
+      if (best == face::INVALID_FACEID || score > highestScore) {
+        best = nh.first;
+        highestScore = score;
+      }
+    }
+    return best;
+  }
+
+  /** \brief forward a new Interest with \p hashCode from face4
+   *  \return the upstream chosen by the strategy
+   */
+  FaceId
+  forwardNew(const std::string& hashCode)
+  {
+    shared_ptr<Interest> interest = makeInterest("/A", hashCode);
+    shared_ptr<pit::Entry> pitEntry = pit.insert(*interest).first;
+    pitEntry->insertOrUpdateInRecord(*face4, 0, *interest);
+
+    strategy.sendInterestHistory.clear();
+    strategy.afterReceiveInterest(FaceEndpoint(*face4, 0), *interest, pitEntry);
+    pit.erase(pitEntry.get());
+
+    BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 1);
+    return strategy.sendInterestHistory.back().outFaceId;
+  }
+
+protected:
+  Forwarder forwarder;
+  ConsistentHashStrategyTester strategy;
+  Fib& fib;
+  Pit& pit;
+  shared_ptr<DummyFace> face1;
+  shared_ptr<DummyFace> face2;
+  shared_ptr<DummyFace> face3;
+  shared_ptr<DummyFace> face4;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestConsistentHashStrategy, ConsistentHashStrategyFixture)
+
+BOOST_AUTO_TEST_CASE(ComputeKey)
+{
+  // the HashCode identifies the content, regardless of the Name
+  BOOST_CHECK_EQUAL(ConsistentHashStrategy::computeKey(*makeInterest("/A", "c0ffee")),
+                    ConsistentHashStrategy::computeKey(*makeInterest("/B", "c0ffee")));
+  BOOST_CHECK_NE(ConsistentHashStrategy::computeKey(*makeInterest("/A", "c0ffee")),
+                 ConsistentHashStrategy::computeKey(*makeInterest("/A", "decade")));
+
+  // without HashCode, the Name identifies the content
+  BOOST_CHECK_EQUAL(ConsistentHashStrategy::computeKey(*makeInterest("/A", "")),
+                    ConsistentHashStrategy::computeKey(*makeInterest("/A", "", 2732)));
+  BOOST_CHECK_NE(ConsistentHashStrategy::computeKey(*makeInterest("/A", "")),
+                 ConsistentHashStrategy::computeKey(*makeInterest("/B", "")));
+}
+
+BOOST_AUTO_TEST_CASE(WeightedShares)
+{
+  const int N_KEYS = 30000;
+  std::map<FaceId, int> nKeys;
+  for (uint64_t key = 0; key < N_KEYS; ++key) {
+    ++nKeys[pickFace(key, {{301, 10}, {302, 20}, {303, 20}})];
+  }
+
+  // shares are proportional to 1/cost, i.e. 1/2, 1/4, and 1/4
+  BOOST_CHECK_CLOSE(nKeys[301] * 1.0 / N_KEYS, 0.50, 5.0);
+  BOOST_CHECK_CLOSE(nKeys[302] * 1.0 / N_KEYS, 0.25, 5.0);
+  BOOST_CHECK_CLOSE(nKeys[303] * 1.0 / N_KEYS, 0.25, 5.0);
+
+  // a nexthop of cost zero is weighted like a nexthop of cost one
+  nKeys.clear();
+  for (uint64_t key = 0; key < N_KEYS; ++key) {
+    ++nKeys[pickFace(key, {{301, 0}, {302, 1}})];
+  }
+  BOOST_CHECK_CLOSE(nKeys[301] * 1.0 / N_KEYS, 0.50, 5.0);
+}
+
+BOOST_AUTO_TEST_CASE(MinimalRemapping)
+{
+  const uint64_t N_KEYS = 10000;
+  size_t nMovedToNew = 0;
+  for (uint64_t key = 0; key < N_KEYS; ++key) {
+    FaceId before = pickFace(key, {{301, 10}, {302, 10}, {303, 10}});
+
+    // removing a nexthop remaps only the keys that were mapped to it
+    FaceId afterRemoval = pickFace(key, {{301, 10}, {302, 10}});
+    if (before != 303) {
+      BOOST_CHECK_EQUAL(afterRemoval, before);
+    }
+
+    // adding a nexthop moves keys only to the new nexthop
+    FaceId afterAddition = pickFace(key, {{301, 10}, {302, 10}, {303, 10}, {304, 10}});
+    if (afterAddition != 304) {
+      BOOST_CHECK_EQUAL(afterAddition, before);
+    }
+    else {
+      ++nMovedToNew;
+    }
+  }
+  BOOST_CHECK_CLOSE(nMovedToNew * 1.0 / N_KEYS, 0.25, 10.0);
+}
+
+BOOST_AUTO_TEST_CASE(Affinity)
+{
+  fib::Entry& fibEntry = *fib.insert(Name()).first;
+  fibEntry.addOrUpdateNextHop(*face1, 0, 10);
+  fibEntry.addOrUpdateNextHop(*face2, 0, 10);
+  fibEntry.addOrUpdateNextHop(*face3, 0, 10);
+
+  std::set<FaceId> usedFaces;
+  for (int i = 0; i < 100; ++i) {
+    std::string hashCode = "hash" + to_string(i);
+    FaceId upstream = forwardNew(hashCode);
+    usedFaces.insert(upstream);
+
+    // the same content is always fetched from the same upstream
+    BOOST_CHECK_EQUAL(forwardNew(hashCode), upstream);
+  }
+
+  // content is spread across all upstreams
+  std::set<FaceId> expectedFaces{face1->getId(), face2->getId(), face3->getId()};
+  BOOST_CHECK_EQUAL_COLLECTIONS(usedFaces.begin(), usedFaces.end(),
+                                expectedFaces.begin(), expectedFaces.end());
+}
+
+BOOST_AUTO_TEST_CASE(Retransmission)
+{
+  fib::Entry& fibEntry = *fib.insert(Name()).first;
+  fibEntry.addOrUpdateNextHop(*face1, 0, 10);
+  fibEntry.addOrUpdateNextHop(*face2, 0, 10);
+
+  shared_ptr<Interest> interest = makeInterest("/A", "c0ffee");
+  shared_ptr<pit::Entry> pitEntry = pit.insert(*interest).first;
+  pitEntry->insertOrUpdateInRecord(*face4, 0, *interest);
+  strategy.afterReceiveInterest(FaceEndpoint(*face4, 0), *interest, pitEntry);
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 1);
+  FaceId primary = strategy.sendInterestHistory.back().outFaceId;
+
+  // retransmission within the suppression interval is suppressed
+  strategy.afterReceiveInterest(FaceEndpoint(*face4, 0), *interest, pitEntry);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 1);
+
+  // retransmission goes to the unused upstream
+  this->advanceClocks(ConsistentHashStrategy::RETX_SUPPRESSION_INITIAL);
+  pitEntry->insertOrUpdateInRecord(*face4, 0, *interest);
+  strategy.afterReceiveInterest(FaceEndpoint(*face4, 0), *interest, pitEntry);
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 2);
+  FaceId secondary = strategy.sendInterestHistory.back().outFaceId;
+  BOOST_CHECK_NE(secondary, primary);
+
+  // once both upstreams are used, retransmission goes to the primary upstream again
+  this->advanceClocks(ConsistentHashStrategy::RETX_SUPPRESSION_MAX);
+  pitEntry->insertOrUpdateInRecord(*face4, 0, *interest);
+  strategy.afterReceiveInterest(FaceEndpoint(*face4, 0), *interest, pitEntry);
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 3);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.back().outFaceId, primary);
+}
+
+BOOST_AUTO_TEST_CASE(RejectLoopback)
+{
+  fib::Entry& fibEntry = *fib.insert(Name()).first;
+  fibEntry.addOrUpdateNextHop(*face1, 0, 10);
+
+  shared_ptr<Interest> interest = makeInterest("/A", "c0ffee");
+  shared_ptr<pit::Entry> pitEntry = pit.insert(*interest).first;
+  pitEntry->insertOrUpdateInRecord(*face1, 0, *interest);
+
+  strategy.afterReceiveInterest(FaceEndpoint(*face1, 0), *interest, pitEntry);
+  BOOST_CHECK_EQUAL(strategy.rejectPendingInterestHistory.size(), 1);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 0);
+  BOOST_CHECK_EQUAL(strategy.sendNackHistory.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestConsistentHashStrategy
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
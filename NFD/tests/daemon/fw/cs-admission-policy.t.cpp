@@ -0,0 +1,228 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/cs-admission-policy.hpp"
+#include "fw/forwarder.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include <ndn-cxx/lp/tags.hpp>
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestCsAdmissionPolicy, GlobalIoTimeFixture)
+
+BOOST_AUTO_TEST_CASE(GetPolicyNames)
+{
+  std::set<std::string> policyNames = CsAdmissionPolicy::getPolicyNames();
+  BOOST_CHECK_EQUAL(policyNames.count("admit-all"), 1);
+  BOOST_CHECK_EQUAL(policyNames.count("lcd"), 1);
+  BOOST_CHECK_EQUAL(policyNames.count("probability"), 1);
+  BOOST_CHECK_EQUAL(policyNames.count("popularity"), 1);
+  BOOST_CHECK(CsAdmissionPolicy::create("no-such-policy") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Options)
+{
+  ConfigSection unknown;
+  unknown.put("no-such-option", "1");
+  BOOST_CHECK_THROW(AdmitAllCsAdmissionPolicy().applyOptions(unknown), ConfigFile::Error);
+  BOOST_CHECK_THROW(ProbabilisticCsAdmissionPolicy().applyOptions(unknown), ConfigFile::Error);
+
+  ProbabilisticCsAdmissionPolicy probability;
+  BOOST_CHECK_EQUAL(probability.getProbability(), ProbabilisticCsAdmissionPolicy::DEFAULT_PROBABILITY);
+  ConfigSection options;
+  options.put("probability", "0.25");
+  probability.applyOptions(options);
+  BOOST_CHECK_EQUAL(probability.getProbability(), 0.25);
+  options.put("probability", "0");
+  BOOST_CHECK_THROW(probability.applyOptions(options), ConfigFile::Error);
+  options.put("probability", "1.5");
+  BOOST_CHECK_THROW(probability.applyOptions(options), ConfigFile::Error);
+
+  PopularityCsAdmissionPolicy popularity;
+  BOOST_CHECK_EQUAL(popularity.getThreshold(), PopularityCsAdmissionPolicy::DEFAULT_THRESHOLD);
+  options.clear();
+  options.put("threshold", "3");
+  popularity.applyOptions(options);
+  BOOST_CHECK_EQUAL(popularity.getThreshold(), 3);
+  options.put("threshold", "256");
+  BOOST_CHECK_THROW(popularity.applyOptions(options), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(LeaveCopyDown)
+{
+  DummyFace face;
+  LeaveCopyDownCsAdmissionPolicy policy;
+
+  shared_ptr<Data> data = makeData("/A");
+  BOOST_CHECK_EQUAL(policy.shouldAdmit(face, *data, {}), true);
+
+  // downstream forwarders must not cache it again
+  policy.beforeForwardData(*data);
+  BOOST_CHECK(data->getTag<face::NoCacheMarkTag>() != nullptr);
+
+  // Data marked by the upstream forwarder is not cached
+  shared_ptr<Data> marked = makeData("/B");
+  lp::CachePolicy noCache;
+  noCache.setPolicy(lp::CachePolicyType::NO_CACHE);
+  marked->setTag(make_shared<lp::CachePolicyTag>(noCache));
+  BOOST_CHECK_EQUAL(policy.shouldAdmit(face, *marked, {}), false);
+}
+
+BOOST_AUTO_TEST_CASE(Probability)
+{
+  DummyFace face;
+  ProbabilisticCsAdmissionPolicy policy;
+  shared_ptr<Data> data = makeData("/A");
+
+  ConfigSection options;
+  options.put("probability", "1");
+  policy.applyOptions(options);
+  for (int i = 0; i < 100; ++i) {
+    BOOST_CHECK_EQUAL(policy.shouldAdmit(face, *data, {}), true);
+  }
+
+  options.put("probability", "0.5");
+  policy.applyOptions(options);
+  int nAdmitted = 0;
+  for (int i = 0; i < 1000; ++i) {
+    nAdmitted += policy.shouldAdmit(face, *data, {});
+  }
+  BOOST_CHECK_GT(nAdmitted, 350);
+  BOOST_CHECK_LT(nAdmitted, 650);
+}
+
+BOOST_AUTO_TEST_CASE(Popularity)
+{
+  DummyFace face;
+  PopularityCsAdmissionPolicy policy;
+  shared_ptr<Data> dataA = makeData("/A");
+  shared_ptr<Data> dataB = makeData("/B");
+
+  policy.afterReceiveInterest(*makeInterest("/A", "/A"));
+  BOOST_CHECK_EQUAL(policy.shouldAdmit(face, *dataA, {}), false);
+  policy.afterReceiveInterest(*makeInterest("/A", "/A"));
+  BOOST_CHECK_EQUAL(policy.shouldAdmit(face, *dataA, {}), true);
+  BOOST_CHECK_EQUAL(policy.shouldAdmit(face, *dataB, {}), false);
+
+  // counters are halved after an aging period
+  for (size_t i = 2; i < PopularityCsAdmissionPolicy::SKETCH_AGING_PERIOD; ++i) {
+    Name name = Name("/C").appendNumber(i);
+    policy.afterReceiveInterest(*makeInterest(name, name.toUri()));
+  }
+  BOOST_CHECK_EQUAL(policy.estimate("/A"), 1);
+  BOOST_CHECK_EQUAL(policy.shouldAdmit(face, *dataA, {}), false);
+}
+
+BOOST_AUTO_TEST_CASE(PopularityPitMatches)
+{
+  DummyFace face;
+  PopularityCsAdmissionPolicy policy;
+  shared_ptr<Data> data = makeData("/A/B/C");
+
+  // the Interest name is a prefix of the Data name
+  shared_ptr<Interest> interest = makeInterest("/A/B", "hash-ABC");
+  interest->setCanBePrefix(true);
+  policy.afterReceiveInterest(*interest);
+  policy.afterReceiveInterest(*interest);
+  BOOST_CHECK_EQUAL(policy.estimate("/A/B/C"), 0);
+
+  pit::DataMatchResult pitMatches{make_shared<pit::Entry>(*interest)};
+  BOOST_CHECK_EQUAL(policy.shouldAdmit(face, *data, pitMatches), true);
+
+  // an unpopular PIT entry does not make the Data popular
+  pit::DataMatchResult otherMatches{make_shared<pit::Entry>(*makeInterest("/A", "hash-A"))};
+  BOOST_CHECK_EQUAL(policy.shouldAdmit(face, *data, otherMatches), false);
+  otherMatches.push_back(pitMatches.front());
+  BOOST_CHECK_EQUAL(policy.shouldAdmit(face, *data, otherMatches), true);
+}
+
+BOOST_AUTO_TEST_CASE(RejectedDataIsForwarded)
+{
+  Forwarder forwarder;
+  forwarder.setCsAdmissionPolicy(make_unique<PopularityCsAdmissionPolicy>());
+
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+  forwarder.getFib().insert("/A").first->addOrUpdateNextHop(*face2, 0, 0);
+
+  face1->receiveInterest(*makeInterest("/A", "hash-A"));
+  this->advanceClocks(10_ms);
+  BOOST_REQUIRE_EQUAL(face2->sentInterests.size(), 1);
+
+  face2->receiveData(*makeData("/A"));
+  this->advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(face1->sentData.size(), 1);
+  BOOST_CHECK_EQUAL(forwarder.getCs().size(), 0);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nCsAdmissionRejects, 1);
+}
+
+BOOST_AUTO_TEST_CASE(CachePolicyMark)
+{
+  Forwarder forwarder;
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+  forwarder.getFib().insert("/A").first->addOrUpdateNextHop(*face2, 0, 0);
+
+  lp::CachePolicy noCache;
+  noCache.setPolicy(lp::CachePolicyType::NO_CACHE);
+  auto receiveData = [&] (const Name& name) {
+    face1->receiveInterest(*makeInterest(name, "hash" + name.toUri()));
+    this->advanceClocks(10_ms);
+    auto data = makeData(name);
+    data->setTag(make_shared<lp::CachePolicyTag>(noCache));
+    face2->receiveData(*data);
+    this->advanceClocks(10_ms);
+  };
+
+  // the default policy does not ask for CachePolicy, even if the producer has sent one
+  receiveData("/A/1");
+  BOOST_REQUIRE_EQUAL(face1->sentData.size(), 1);
+  BOOST_CHECK(face1->sentData.back().getTag<face::NoCacheMarkTag>() == nullptr);
+
+  forwarder.setCsAdmissionPolicy(make_unique<LeaveCopyDownCsAdmissionPolicy>());
+  receiveData("/A/2");
+  BOOST_REQUIRE_EQUAL(face1->sentData.size(), 2);
+  BOOST_CHECK(face1->sentData.back().getTag<face::NoCacheMarkTag>() != nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsAdmissionPolicy
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
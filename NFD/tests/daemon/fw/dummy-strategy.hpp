@@ -82,6 +82,8 @@ public:
   afterReceiveNack(const FaceEndpoint& ingress, const lp::Nack& nack,
                    const shared_ptr<pit::Entry>& pitEntry) override;
 
+  using fw::Strategy::setFlowCacheable;
+
 protected:
   /** \brief register an alias
    *  \tparam S subclass of DummyStrategy
@@ -0,0 +1,299 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/flow-cache.hpp"
+#include "fw/best-route-strategy2.hpp"
+#include "fw/forwarder.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+#include "choose-strategy.hpp"
+#include "dummy-strategy.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using namespace nfd::tests;
+
+class FlowCacheFixture : public GlobalIoTimeFixture
+{
+protected:
+  FlowCacheFixture()
+    : face1(make_shared<DummyFace>())
+    , face2(make_shared<DummyFace>())
+    , face3(make_shared<DummyFace>())
+    , strategy(choose<DummyStrategy>(forwarder, "/", DummyStrategy::getStrategyName()))
+    , flowCache(forwarder.getFlowCache())
+  {
+    forwarder.addFace(face1);
+    forwarder.addFace(face2);
+    forwarder.addFace(face3);
+    forwarder.getFib().insert("/A").first->addOrUpdateNextHop(*face2, 0, 10);
+
+    strategy.setFlowCacheable(true);
+    strategy.interestOutFace = face2;
+    flowCache.setEnabled(true);
+  }
+
+  void
+  receiveInterest(DummyFace& face, const Name& name)
+  {
+    face.receiveInterest(*makeInterest(name));
+    advanceClocks(1_ms);
+  }
+
+protected:
+  Forwarder forwarder;
+  shared_ptr<DummyFace> face1;
+  shared_ptr<DummyFace> face2;
+  shared_ptr<DummyFace> face3;
+  DummyStrategy& strategy;
+  FlowCache& flowCache;
+};
+
+class DispatchCountingForwarder : public Forwarder
+{
+protected:
+  void
+  dispatchToStrategy(pit::Entry& pitEntry, std::function<void(Strategy&)> trigger) override
+  {
+    ++dispatchToStrategy_count;
+    Forwarder::dispatchToStrategy(pitEntry, std::move(trigger));
+  }
+
+public:
+  int dispatchToStrategy_count = 0;
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestFlowCache, FlowCacheFixture)
+
+BOOST_AUTO_TEST_CASE(DisabledByDefault)
+{
+  Forwarder otherForwarder;
+  BOOST_CHECK(!otherForwarder.getFlowCache().isEnabled());
+}
+
+BOOST_AUTO_TEST_CASE(Hit)
+{
+  receiveInterest(*face1, "/A/1");
+  BOOST_CHECK_EQUAL(strategy.afterReceiveInterest_count, 1);
+  BOOST_CHECK_EQUAL(face2->sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(flowCache.size(), 1);
+
+  // same incoming face and FIB entry: strategy is bypassed
+  receiveInterest(*face1, "/A/2");
+  BOOST_CHECK_EQUAL(strategy.afterReceiveInterest_count, 1);
+  BOOST_REQUIRE_EQUAL(face2->sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(face2->sentInterests.back().getName(), "/A/2");
+
+  // different incoming face
+  receiveInterest(*face3, "/A/3");
+  BOOST_CHECK_EQUAL(strategy.afterReceiveInterest_count, 2);
+  BOOST_CHECK_EQUAL(face2->sentInterests.size(), 3);
+  BOOST_CHECK_EQUAL(flowCache.size(), 2);
+
+  // retransmission of a forwarded Interest is always processed by strategy
+  auto interest = makeInterest("/A/1");
+  face1->receiveInterest(*interest);
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(strategy.afterReceiveInterest_count, 3);
+}
+
+BOOST_AUTO_TEST_CASE(MissDispatch)
+{
+  DispatchCountingForwarder otherForwarder;
+  auto faceA = make_shared<DummyFace>();
+  auto faceB = make_shared<DummyFace>();
+  otherForwarder.addFace(faceA);
+  otherForwarder.addFace(faceB);
+  otherForwarder.getFib().insert("/A").first->addOrUpdateNextHop(*faceB, 0, 10);
+  auto& otherStrategy = choose<DummyStrategy>(otherForwarder, "/", DummyStrategy::getStrategyName());
+  otherStrategy.setFlowCacheable(true);
+  otherStrategy.interestOutFace = faceB;
+  otherForwarder.getFlowCache().setEnabled(true);
+
+  // a miss triggers the strategy through dispatchToStrategy
+  receiveInterest(*faceA, "/A/1");
+  BOOST_CHECK_EQUAL(otherForwarder.dispatchToStrategy_count, 1);
+  BOOST_CHECK_EQUAL(otherStrategy.afterReceiveInterest_count, 1);
+
+  // a hit does not involve the strategy
+  receiveInterest(*faceA, "/A/2");
+  BOOST_CHECK_EQUAL(otherForwarder.dispatchToStrategy_count, 1);
+  BOOST_CHECK_EQUAL(faceB->sentInterests.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(NotCacheable)
+{
+  strategy.setFlowCacheable(false);
+
+  receiveInterest(*face1, "/A/1");
+  receiveInterest(*face1, "/A/2");
+  BOOST_CHECK_EQUAL(strategy.afterReceiveInterest_count, 2);
+  BOOST_CHECK_EQUAL(face2->sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(flowCache.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ScopeControlled)
+{
+  auto localFace = make_shared<DummyFace>("dummy://", "dummy://", ndn::nfd::FACE_SCOPE_LOCAL);
+  forwarder.addFace(localFace);
+
+  receiveInterest(*localFace, "/localhop/A/1");
+  receiveInterest(*localFace, "/localhop/A/2");
+  BOOST_CHECK_EQUAL(strategy.afterReceiveInterest_count, 2);
+  BOOST_CHECK_EQUAL(flowCache.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Rejected)
+{
+  strategy.interestOutFace = nullptr;
+
+  receiveInterest(*face1, "/A/1");
+  receiveInterest(*face1, "/A/2");
+  BOOST_CHECK_EQUAL(strategy.afterReceiveInterest_count, 2);
+  BOOST_CHECK_EQUAL(flowCache.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(NextHopChange)
+{
+  receiveInterest(*face1, "/A/1");
+  BOOST_CHECK_EQUAL(flowCache.size(), 1);
+
+  forwarder.getFib().findExactMatch("/A")->addOrUpdateNextHop(*face3, 0, 5);
+  receiveInterest(*face1, "/A/2");
+  BOOST_CHECK_EQUAL(strategy.afterReceiveInterest_count, 2);
+
+  receiveInterest(*face1, "/A/3");
+  BOOST_CHECK_EQUAL(strategy.afterReceiveInterest_count, 2);
+}
+
+BOOST_AUTO_TEST_CASE(FibEntryChange)
+{
+  receiveInterest(*face1, "/A/1");
+  BOOST_CHECK_EQUAL(flowCache.size(), 1);
+
+  forwarder.getFib().insert("/B").first->addOrUpdateNextHop(*face3, 0, 10);
+  receiveInterest(*face1, "/A/2");
+  BOOST_CHECK_EQUAL(strategy.afterReceiveInterest_count, 2);
+  BOOST_CHECK_EQUAL(flowCache.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(StrategyChange)
+{
+  receiveInterest(*face1, "/A/1");
+  BOOST_CHECK_EQUAL(flowCache.size(), 1);
+
+  DummyStrategy& strategyB = choose<DummyStrategy>(forwarder, "/A/B", DummyStrategy::getStrategyName());
+  strategyB.setFlowCacheable(true);
+  strategyB.interestOutFace = face3;
+
+  receiveInterest(*face1, "/A/2");
+  BOOST_CHECK_EQUAL(strategy.afterReceiveInterest_count, 2);
+
+  // same FIB entry, different effective strategy
+  receiveInterest(*face1, "/A/B/1");
+  receiveInterest(*face1, "/A/B/2");
+  BOOST_CHECK_EQUAL(strategyB.afterReceiveInterest_count, 1);
+  BOOST_CHECK_EQUAL(face3->sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(flowCache.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(FaceRemoval)
+{
+  receiveInterest(*face3, "/A/1");
+  BOOST_CHECK_EQUAL(flowCache.size(), 1);
+
+  face3->close();
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(flowCache.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Nack)
+{
+  auto interest = makeInterest("/A/1");
+  interest->setNonce(7369);
+  face1->receiveInterest(*interest);
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(flowCache.size(), 1);
+
+  face2->receiveNack(makeNack(*interest, lp::NackReason::CONGESTION));
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(strategy.afterReceiveNack_count, 1);
+  BOOST_CHECK_EQUAL(flowCache.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Disable)
+{
+  receiveInterest(*face1, "/A/1");
+  BOOST_CHECK_EQUAL(flowCache.size(), 1);
+
+  flowCache.setEnabled(false);
+  BOOST_CHECK_EQUAL(flowCache.size(), 0);
+  receiveInterest(*face1, "/A/2");
+  BOOST_CHECK_EQUAL(strategy.afterReceiveInterest_count, 2);
+  BOOST_CHECK_EQUAL(flowCache.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Limit)
+{
+  flowCache.setLimit(1);
+  receiveInterest(*face1, "/A/1");
+  receiveInterest(*face3, "/A/2");
+  BOOST_CHECK_EQUAL(flowCache.size(), 1);
+
+  // record of face1 was dropped
+  receiveInterest(*face1, "/A/3");
+  BOOST_CHECK_EQUAL(strategy.afterReceiveInterest_count, 3);
+}
+
+BOOST_AUTO_TEST_CASE(BestRoute)
+{
+  choose<BestRouteStrategy2>(forwarder, "/A");
+  forwarder.getFib().findExactMatch("/A")->addOrUpdateNextHop(*face3, 0, 5);
+
+  receiveInterest(*face1, "/A/1");
+  receiveInterest(*face1, "/A/2");
+  BOOST_CHECK_EQUAL(flowCache.size(), 1);
+  BOOST_CHECK_EQUAL(face3->sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(face2->sentInterests.size(), 0);
+
+  // from face3, the lowest-cost eligible nexthop is face2
+  receiveInterest(*face3, "/A/3");
+  receiveInterest(*face3, "/A/4");
+  BOOST_CHECK_EQUAL(flowCache.size(), 2);
+  BOOST_CHECK_EQUAL(face2->sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(strategy.afterReceiveInterest_count, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestFlowCache
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
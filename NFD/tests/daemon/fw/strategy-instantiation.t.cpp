@@ -32,6 +32,7 @@
 #include "fw/asf-strategy.hpp"
 #include "fw/best-route-strategy.hpp"
 #include "fw/best-route-strategy2.hpp"
+#include "fw/consistent-hash-strategy.hpp"
 #include "fw/multicast-strategy.hpp"
 #include "fw/ncc-strategy.hpp"
 #include "fw/self-learning-strategy.hpp"
@@ -78,6 +79,7 @@ using Tests = boost::mpl::vector<
   Test<AsfStrategy, true, 3>,
   Test<BestRouteStrategy, false, 1>,
   Test<BestRouteStrategy2, false, 5>,
+  Test<ConsistentHashStrategy, false, 1>,
   Test<MulticastStrategy, false, 3>,
   Test<NccStrategy, false, 1>,
   Test<SelfLearningStrategy, false, 1>
@@ -29,6 +29,7 @@
 
 // Strategies implementing recommended Nack processing procedure, sorted alphabetically.
 #include "fw/best-route-strategy2.hpp"
+#include "fw/consistent-hash-strategy.hpp"
 #include "fw/multicast-strategy.hpp"
 
 #include "choose-strategy.hpp"
@@ -85,6 +86,7 @@ BOOST_AUTO_TEST_SUITE(TestStrategyNackReturn)
 
 using Strategies = boost::mpl::vector<
   BestRouteStrategy2,
+  ConsistentHashStrategy,
   MulticastStrategy
 >;
 
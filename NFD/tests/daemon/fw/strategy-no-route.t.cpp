@@ -32,6 +32,7 @@
 // sorted alphabetically.
 #include "fw/asf-strategy.hpp"
 #include "fw/best-route-strategy2.hpp"
+#include "fw/consistent-hash-strategy.hpp"
 #include "fw/multicast-strategy.hpp"
 
 #include "tests/test-common.hpp"
@@ -146,6 +147,10 @@ using Tests = boost::mpl::vector<
   Test<BestRouteStrategy2, NextHopIsDownstream<BestRouteStrategy2>>,
   Test<BestRouteStrategy2, NextHopViolatesScope<BestRouteStrategy2>>,
 
+  Test<ConsistentHashStrategy, EmptyNextHopList<ConsistentHashStrategy>>,
+  Test<ConsistentHashStrategy, NextHopIsDownstream<ConsistentHashStrategy>>,
+  Test<ConsistentHashStrategy, NextHopViolatesScope<ConsistentHashStrategy>>,
+
   Test<MulticastStrategy, EmptyNextHopList<MulticastStrategy>>,
   Test<MulticastStrategy, NextHopIsDownstream<MulticastStrategy>>,
   Test<MulticastStrategy, NextHopViolatesScope<MulticastStrategy>>
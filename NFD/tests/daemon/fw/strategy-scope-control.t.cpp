@@ -32,6 +32,7 @@
 #include "fw/asf-strategy.hpp"
 #include "fw/best-route-strategy.hpp"
 #include "fw/best-route-strategy2.hpp"
+#include "fw/consistent-hash-strategy.hpp"
 #include "fw/multicast-strategy.hpp"
 #include "fw/ncc-strategy.hpp"
 
@@ -108,6 +109,7 @@ using Tests = boost::mpl::vector<
   Test<AsfStrategy, true, false>,
   Test<BestRouteStrategy, false, false>,
   Test<BestRouteStrategy2, true, true>,
+  Test<ConsistentHashStrategy, true, true>,
   Test<MulticastStrategy, true, true>,
   Test<NccStrategy, false, false>
 >;
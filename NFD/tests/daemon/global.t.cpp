@@ -138,6 +138,27 @@ BOOST_FIXTURE_TEST_CASE(AdvanceClocks, RibIoTimeFixture)
   BOOST_CHECK_EQUAL(hasRibRun, true);
 }
 
+BOOST_FIXTURE_TEST_CASE(CoarseClock, GlobalIoTimeFixture)
+{
+  auto t0 = time::steady_clock::now();
+  BOOST_CHECK(getCoarseSteadyClockNow() == t0);
+
+  {
+    CoarseClockScope outer;
+    advanceClocks(10_ms);
+    BOOST_CHECK(getCoarseSteadyClockNow() == t0);
+
+    {
+      CoarseClockScope inner;
+      advanceClocks(10_ms);
+      BOOST_CHECK(getCoarseSteadyClockNow() == t0);
+    }
+    BOOST_CHECK(getCoarseSteadyClockNow() == t0);
+  }
+
+  BOOST_CHECK(getCoarseSteadyClockNow() == t0 + 20_ms);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestGlobal
 
 } // namespace tests
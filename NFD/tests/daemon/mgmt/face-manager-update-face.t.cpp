@@ -581,6 +581,57 @@ BOOST_AUTO_TEST_CASE(UpdateReliabilityEnableDisable)
   });
 }
 
+BOOST_AUTO_TEST_CASE(UpdateAggregationEnableDisable)
+{
+  createFace("udp4://127.0.0.1:26363");
+
+  ControlParameters enableParams;
+  enableParams.setFaceId(faceId);
+  enableParams.setFlagBit(ndn::nfd::BIT_LP_AGGREGATION_ENABLED, true);
+
+  ControlParameters disableParams;
+  disableParams.setFaceId(faceId);
+  disableParams.setFlagBit(ndn::nfd::BIT_LP_AGGREGATION_ENABLED, false);
+
+  updateFace(enableParams, false, [] (const ControlResponse& actual) {
+    ControlResponse expected(200, "OK");
+    BOOST_CHECK_EQUAL(actual.getCode(), expected.getCode());
+    BOOST_TEST_MESSAGE(actual.getText());
+
+    if (actual.getBody().hasWire()) {
+      ControlParameters actualParams(actual.getBody());
+
+      BOOST_CHECK(actualParams.hasFaceId());
+      BOOST_CHECK(actualParams.hasFacePersistency());
+      BOOST_REQUIRE(actualParams.hasFlags());
+      // Check if flags indicate aggregation enabled
+      BOOST_CHECK(actualParams.getFlagBit(ndn::nfd::BIT_LP_AGGREGATION_ENABLED));
+    }
+    else {
+      BOOST_ERROR("Enable: Response does not contain ControlParameters");
+    }
+  });
+
+  updateFace(disableParams, false, [] (const ControlResponse& actual) {
+    ControlResponse expected(200, "OK");
+    BOOST_CHECK_EQUAL(actual.getCode(), expected.getCode());
+    BOOST_TEST_MESSAGE(actual.getText());
+
+    if (actual.getBody().hasWire()) {
+      ControlParameters actualParams(actual.getBody());
+
+      BOOST_CHECK(actualParams.hasFaceId());
+      BOOST_CHECK(actualParams.hasFacePersistency());
+      BOOST_REQUIRE(actualParams.hasFlags());
+      // Check if flags indicate aggregation disabled
+      BOOST_CHECK(!actualParams.getFlagBit(ndn::nfd::BIT_LP_AGGREGATION_ENABLED));
+    }
+    else {
+      BOOST_ERROR("Disable: Response does not contain ControlParameters");
+    }
+  });
+}
+
 BOOST_AUTO_TEST_CASE(UpdateCongestionMarkingEnableDisable)
 {
   createFace("udp4://127.0.0.1:26363");
@@ -646,6 +697,52 @@ BOOST_AUTO_TEST_CASE(UpdateCongestionMarkingEnableDisable)
   });
 }
 
+BOOST_AUTO_TEST_CASE(UpdateRateLimit)
+{
+  createFace("udp4://127.0.0.1:26363");
+
+  ControlParameters params;
+  params.setFaceId(faceId);
+  params.setRateLimit(1250000);
+  params.setBurstSize(30000);
+
+  updateFace(params, false, [] (const ControlResponse& actual) {
+    BOOST_CHECK_EQUAL(actual.getCode(), 200);
+    BOOST_TEST_MESSAGE(actual.getText());
+
+    if (actual.getBody().hasWire()) {
+      ControlParameters actualParams(actual.getBody());
+
+      BOOST_REQUIRE(actualParams.hasRateLimit());
+      BOOST_CHECK_EQUAL(actualParams.getRateLimit(), 1250000);
+      BOOST_REQUIRE(actualParams.hasBurstSize());
+      BOOST_CHECK_EQUAL(actualParams.getBurstSize(), 30000);
+    }
+    else {
+      BOOST_ERROR("Response does not contain ControlParameters");
+    }
+  });
+
+  ControlParameters badParams;
+  badParams.setFaceId(faceId);
+  badParams.setBurstSize(0);
+
+  updateFace(badParams, false, [] (const ControlResponse& actual) {
+    BOOST_CHECK_EQUAL(actual.getCode(), 409);
+    BOOST_TEST_MESSAGE(actual.getText());
+
+    if (actual.getBody().hasWire()) {
+      ControlParameters actualParams(actual.getBody());
+
+      BOOST_REQUIRE(actualParams.hasBurstSize());
+      BOOST_CHECK_EQUAL(actualParams.getBurstSize(), 0);
+    }
+    else {
+      BOOST_ERROR("Response does not contain ControlParameters");
+    }
+  });
+}
+
 BOOST_AUTO_TEST_CASE(SelfUpdating)
 {
   createFace();
@@ -400,6 +400,52 @@ BOOST_AUTO_TEST_CASE(RecordNotExist)
 
 BOOST_AUTO_TEST_SUITE_END() // RemoveNextHop
 
+BOOST_AUTO_TEST_SUITE(Transaction)
+
+BOOST_AUTO_TEST_CASE(Apply)
+{
+  FaceId face1 = addFace();
+  FaceId face2 = addFace();
+  m_fib.insert("/B").first->addOrUpdateNextHop(*m_faceTable.get(face2), 0, 20);
+
+  std::list<rib::FibUpdate> updates{
+    rib::FibUpdate::createAddUpdate("/A", face1, 10),
+    rib::FibUpdate::createAddUpdate("/A", face2, 20),
+    rib::FibUpdate::createRemoveUpdate("/B", face2),
+    rib::FibUpdate::createAddUpdate("/C", 65535, 30), // nonexistent face is skipped
+  };
+  ControlResponse response = m_manager.applyFibUpdates(updates, face1);
+  BOOST_CHECK_EQUAL(response.getCode(), 200);
+  BOOST_CHECK_EQUAL(checkNextHop("/A", 2, face1, 10), CheckNextHopResult::OK);
+  BOOST_CHECK_EQUAL(checkNextHop("/A", 2, face2, 20), CheckNextHopResult::OK);
+  BOOST_CHECK_EQUAL(checkNextHop("/B"), CheckNextHopResult::NO_FIB_ENTRY);
+  BOOST_CHECK_EQUAL(checkNextHop("/C"), CheckNextHopResult::NO_FIB_ENTRY);
+  BOOST_CHECK(m_responses.empty()); // no control responses are generated
+}
+
+BOOST_AUTO_TEST_CASE(Reject)
+{
+  FaceId face1 = addFace();
+
+  std::list<rib::FibUpdate> updates{
+    rib::FibUpdate::createAddUpdate("/A", face1, 10),
+    rib::FibUpdate::createAddUpdate("/B", 65535, 20),
+  };
+  // batch face does not exist
+  BOOST_CHECK_EQUAL(m_manager.applyFibUpdates(updates, 65535).getCode(), 410);
+  BOOST_CHECK_EQUAL(checkNextHop("/A"), CheckNextHopResult::NO_FIB_ENTRY);
+
+  Name longName;
+  for (size_t i = 0; i <= Fib::getMaxDepth(); ++i) {
+    longName.append("A");
+  }
+  updates.push_back(rib::FibUpdate::createAddUpdate(longName, face1, 30));
+  BOOST_CHECK_EQUAL(m_manager.applyFibUpdates(updates, face1).getCode(), 414);
+  BOOST_CHECK_EQUAL(checkNextHop("/A"), CheckNextHopResult::NO_FIB_ENTRY);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Transaction
+
 BOOST_AUTO_TEST_SUITE(List)
 
 BOOST_AUTO_TEST_CASE(FibDataset)
@@ -25,6 +25,7 @@
 
 #include "mgmt/tables-config-section.hpp"
 #include "fw/forwarder.hpp"
+#include "fw/cs-admission-policy.hpp"
 #include "table/cs-policy-lru.hpp"
 #include "table/cs-policy-priority-fifo.hpp"
 
@@ -201,6 +202,202 @@ BOOST_AUTO_TEST_CASE(Unknown)
 
 BOOST_AUTO_TEST_SUITE_END() // CsPolicy
 
+BOOST_AUTO_TEST_SUITE(CsAdmission)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  forwarder.setCsAdmissionPolicy(make_unique<fw::LeaveCopyDownCsAdmissionPolicy>());
+
+  runConfig("tables\n{\n}\n", false);
+  NFD_CHECK_TYPEID_EQUAL(forwarder.getCsAdmissionPolicy(), fw::AdmitAllCsAdmissionPolicy);
+}
+
+BOOST_AUTO_TEST_CASE(Known)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_admission popularity
+      {
+        threshold 3
+      }
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  NFD_CHECK_TYPEID_EQUAL(forwarder.getCsAdmissionPolicy(), fw::AdmitAllCsAdmissionPolicy);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  auto policy = dynamic_cast<fw::PopularityCsAdmissionPolicy*>(&forwarder.getCsAdmissionPolicy());
+  BOOST_REQUIRE(policy != nullptr);
+  BOOST_CHECK_EQUAL(policy->getThreshold(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(Unknown)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_admission unknown
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidThreshold)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_admission popularity
+      {
+        threshold 0
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+  NFD_CHECK_TYPEID_EQUAL(forwarder.getCsAdmissionPolicy(), fw::AdmitAllCsAdmissionPolicy);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidProbability)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_admission probability
+      {
+        probability 1.5
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+  NFD_CHECK_TYPEID_EQUAL(forwarder.getCsAdmissionPolicy(), fw::AdmitAllCsAdmissionPolicy);
+}
+
+BOOST_AUTO_TEST_CASE(UnknownOption)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_admission lcd
+      {
+        threshold 2
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // CsAdmission
+
+BOOST_AUTO_TEST_SUITE(CsSnapshot)
+
+BOOST_AUTO_TEST_CASE(Valid)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_snapshot_path )CONFIG" UNIT_TEST_CONFIG_PATH R"CONFIG(/tables-config-cs-A.snapshot
+      cs_snapshot_interval 60
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK(forwarder.getCsSnapshot() == nullptr);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  cs::Snapshot* snapshot = forwarder.getCsSnapshot();
+  BOOST_REQUIRE(snapshot != nullptr);
+  BOOST_CHECK_EQUAL(snapshot->getPath(), UNIT_TEST_CONFIG_PATH "/tables-config-cs-A.snapshot");
+  BOOST_CHECK_EQUAL(snapshot->getInterval(), 60_s);
+
+  // omitting cs_snapshot_path disables CS persistence
+  BOOST_REQUIRE_NO_THROW(runConfig("tables\n{\n}\n", false));
+  BOOST_CHECK(forwarder.getCsSnapshot() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(DefaultInterval)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_snapshot_path )CONFIG" UNIT_TEST_CONFIG_PATH R"CONFIG(/tables-config-cs-A.snapshot
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_REQUIRE(forwarder.getCsSnapshot() != nullptr);
+  BOOST_CHECK_EQUAL(forwarder.getCsSnapshot()->getInterval(), 300_s);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidInterval)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_snapshot_path )CONFIG" UNIT_TEST_CONFIG_PATH R"CONFIG(/tables-config-cs-A.snapshot
+      cs_snapshot_interval invalid
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+  BOOST_CHECK(forwarder.getCsSnapshot() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Reload)
+{
+  const std::string CONFIG1 = R"CONFIG(
+    tables
+    {
+      cs_snapshot_path )CONFIG" UNIT_TEST_CONFIG_PATH R"CONFIG(/tables-config-cs-A.snapshot
+      cs_snapshot_interval 60
+    }
+  )CONFIG";
+
+  const std::string CONFIG2 = R"CONFIG(
+    tables
+    {
+      cs_snapshot_path )CONFIG" UNIT_TEST_CONFIG_PATH R"CONFIG(/tables-config-cs-A.snapshot
+      cs_snapshot_interval 120
+    }
+  )CONFIG";
+
+  const std::string CONFIG3 = R"CONFIG(
+    tables
+    {
+      cs_snapshot_path )CONFIG" UNIT_TEST_CONFIG_PATH R"CONFIG(/tables-config-cs-B.snapshot
+      cs_snapshot_interval 120
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG1, false));
+  cs::Snapshot* snapshot1 = forwarder.getCsSnapshot();
+  BOOST_REQUIRE(snapshot1 != nullptr);
+
+  // same path: the snapshot is kept and only its interval changes
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG2, false));
+  BOOST_CHECK(forwarder.getCsSnapshot() == snapshot1);
+  BOOST_CHECK_EQUAL(snapshot1->getInterval(), 120_s);
+
+  // different path: the snapshot is replaced
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG3, false));
+  cs::Snapshot* snapshot3 = forwarder.getCsSnapshot();
+  BOOST_REQUIRE(snapshot3 != nullptr);
+  BOOST_CHECK_EQUAL(snapshot3->getPath(), UNIT_TEST_CONFIG_PATH "/tables-config-cs-B.snapshot");
+  BOOST_CHECK_EQUAL(snapshot3->getInterval(), 120_s);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // CsSnapshot
+
 class CsUnsolicitedPolicyFixture : public TablesConfigSectionFixture
 {
 protected:
@@ -274,6 +471,122 @@ BOOST_AUTO_TEST_CASE(Unknown)
 
 BOOST_AUTO_TEST_SUITE_END() // CsUnsolicitedPolicy
 
+BOOST_AUTO_TEST_SUITE(NameTreeCompressed)
+
+BOOST_AUTO_TEST_CASE(Valid)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      name_tree_compressed yes
+    }
+  )CONFIG";
+
+  NameTree& nameTree = forwarder.getNameTree();
+  BOOST_REQUIRE(!nameTree.isCompressed());
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK(!nameTree.isCompressed());
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK(nameTree.isCompressed());
+
+  // omitting the option reverts to the default
+  BOOST_REQUIRE_NO_THROW(runConfig("tables\n{\n}\n", false));
+  BOOST_CHECK(!nameTree.isCompressed());
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValue)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      name_tree_compressed maybe
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidStrategyChoice)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      name_tree_compressed yes
+      strategy_choice
+      {
+        / /localhost/nfd/strategy/test-doesnotexist
+      }
+    }
+  )CONFIG";
+
+  // the setting is not applied if another part of the section is rejected
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+  BOOST_CHECK(!forwarder.getNameTree().isCompressed());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // NameTreeCompressed
+
+BOOST_AUTO_TEST_SUITE(FlowCache)
+
+BOOST_AUTO_TEST_CASE(Valid)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      flow_cache yes
+    }
+  )CONFIG";
+
+  fw::FlowCache& flowCache = forwarder.getFlowCache();
+  BOOST_REQUIRE(!flowCache.isEnabled());
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK(!flowCache.isEnabled());
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK(flowCache.isEnabled());
+
+  // omitting the option reverts to the default
+  BOOST_REQUIRE_NO_THROW(runConfig("tables\n{\n}\n", false));
+  BOOST_CHECK(!flowCache.isEnabled());
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValue)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      flow_cache maybe
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidStrategyChoice)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      flow_cache yes
+      strategy_choice
+      {
+        / /localhost/nfd/strategy/test-doesnotexist
+      }
+    }
+  )CONFIG";
+
+  // the setting is not applied if another part of the section is rejected
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+  BOOST_CHECK(!forwarder.getFlowCache().isEnabled());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // FlowCache
+
 BOOST_AUTO_TEST_SUITE(StrategyChoice)
 
 BOOST_AUTO_TEST_CASE(Unversioned)
@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rib/rib.hpp"
+#include "daemon/global.hpp"
+
+#include "tests/test-common.hpp"
+#include "fib-updates-common.hpp"
+
+namespace nfd {
+namespace rib {
+namespace tests {
+
+class FibTransactionFixture : public FibUpdatesFixture
+{
+public:
+  FibTransactionFixture()
+  {
+    // main and RIB threads share the io_service in this test
+    setMainIoService(&g_io);
+    setRibIoService(&g_io);
+  }
+
+  ~FibTransactionFixture()
+  {
+    FibUpdater::setFibTransaction(nullptr);
+    setMainIoService(nullptr);
+    setRibIoService(nullptr);
+  }
+
+  void
+  enableFibTransaction(uint32_t code)
+  {
+    FibUpdater::setFibTransaction([this, code] (const FibUpdater::FibUpdateList& updates,
+                                                uint64_t batchFaceId) {
+      transactions.push_back(updates);
+      batchFaceIds.push_back(batchFaceId);
+      return ndn::nfd::ControlResponse(code, "");
+    });
+  }
+
+public:
+  std::vector<FibUpdater::FibUpdateList> transactions;
+  std::vector<uint64_t> batchFaceIds;
+};
+
+BOOST_AUTO_TEST_SUITE(TestFibUpdates)
+BOOST_FIXTURE_TEST_SUITE(Transaction, FibTransactionFixture)
+
+BOOST_AUTO_TEST_CASE(Register)
+{
+  Route route = createRoute(5, 0, 10, 0);
+  RibUpdate update;
+  update.setAction(RibUpdate::REGISTER)
+        .setName("/z")
+        .setRoute(route);
+
+  enableFibTransaction(410);
+  int nSuccess = 0;
+  int nFailure = 0;
+  rib.beginApplyUpdate(update, [&] { ++nSuccess; }, [&] (uint32_t code, const std::string&) {
+    BOOST_CHECK_EQUAL(code, 410);
+    ++nFailure;
+  });
+  BOOST_CHECK_EQUAL(transactions.size(), 0); // transaction is posted to the main thread
+  g_io.poll();
+  g_io.reset();
+  BOOST_CHECK_EQUAL(nSuccess, 0);
+  BOOST_CHECK_EQUAL(nFailure, 1);
+  BOOST_CHECK(rib.find("/z") == rib.end());
+
+  enableFibTransaction(200);
+  rib.beginApplyUpdate(update, [&] { ++nSuccess; }, [&] (uint32_t, const std::string&) { ++nFailure; });
+  g_io.poll();
+  BOOST_CHECK_EQUAL(nSuccess, 1);
+  BOOST_CHECK_EQUAL(nFailure, 1);
+  BOOST_CHECK(rib.find("/z") != rib.end());
+
+  BOOST_REQUIRE_EQUAL(transactions.size(), 2);
+  BOOST_REQUIRE_EQUAL(transactions.back().size(), 1);
+  BOOST_CHECK(transactions.back().front() == FibUpdate::createAddUpdate("/z", 5, 10));
+  BOOST_CHECK_EQUAL(batchFaceIds.back(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(CoalesceRemoveFace)
+{
+  insertRoute("/", 3, 0, 5, ndn::nfd::ROUTE_FLAG_CHILD_INHERIT);
+  insertRoute("/a", 1, 0, 10, ndn::nfd::ROUTE_FLAG_CHILD_INHERIT);
+  insertRoute("/a/b", 1, 0, 20, 0);
+  insertRoute("/a/c", 2, 0, 30, 0);
+  insertRoute("/x", 1, 0, 10, ndn::nfd::ROUTE_FLAG_CAPTURE);
+  insertRoute("/x/y", 2, 0, 15, 0);
+
+  enableFibTransaction(200);
+  rib.beginRemoveFace(1);
+
+  // RIB is updated right away, all FIB updates are sent in one transaction
+  BOOST_CHECK(rib.find("/a") == rib.end());
+  BOOST_CHECK(rib.find("/a/b") == rib.end());
+  BOOST_CHECK(rib.find("/x") == rib.end());
+  BOOST_CHECK(rib.m_updateBatches.empty());
+  g_io.poll();
+
+  BOOST_REQUIRE_EQUAL(transactions.size(), 1);
+  BOOST_CHECK_EQUAL(batchFaceIds.front(), 0);
+  const auto& updates = transactions.front();
+  BOOST_CHECK(std::none_of(updates.begin(), updates.end(),
+                           [] (const FibUpdate& update) { return update.faceId == 1; }));
+  // capture flag on /x was turned off, so /x/y inherits face 3 from /
+  BOOST_CHECK(std::find(updates.begin(), updates.end(),
+                        FibUpdate::createAddUpdate("/x/y", 3, 5)) != updates.end());
+  BOOST_CHECK(rib.find("/x/y")->second->hasInheritedRoute(createRoute(3, 0, 5, 0)));
+
+  // the queue advances after the transaction completes
+  Route route = createRoute(4, 0, 10, 0);
+  RibUpdate update;
+  update.setAction(RibUpdate::REGISTER)
+        .setName("/z")
+        .setRoute(route);
+  rib.beginApplyUpdate(update, nullptr, nullptr);
+  g_io.reset();
+  g_io.poll();
+  BOOST_CHECK_EQUAL(transactions.size(), 2);
+  BOOST_CHECK(rib.find("/z") != rib.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Transaction
+BOOST_AUTO_TEST_SUITE_END() // TestFibUpdates
+
+} // namespace tests
+} // namespace rib
+} // namespace nfd
@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-expiry-index.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+using namespace nfd::tests;
+
+class ExpiryIndexFixture
+{
+protected:
+  iterator
+  insertEntry(const std::string& hashCode)
+  {
+    return table.emplace(makeData(hashCode), false, hashCode).first;
+  }
+
+  static std::set<std::string>
+  toHashCodes(const std::vector<const EntryImpl*>& entries)
+  {
+    std::set<std::string> hashCodes;
+    for (const EntryImpl* entry : entries) {
+      hashCodes.insert(entry->getHashCode());
+    }
+    return hashCodes;
+  }
+
+protected:
+  time::steady_clock::TimePoint t0 = time::steady_clock::TimePoint() + 1000_s;
+  Table table;
+  ExpiryIndex index{100_ms, 8};
+};
+
+BOOST_AUTO_TEST_SUITE(Table)
+BOOST_FIXTURE_TEST_SUITE(TestCsExpiryIndex, ExpiryIndexFixture)
+
+BOOST_AUTO_TEST_CASE(InsertPop)
+{
+  iterator a = insertEntry("/A");
+  iterator b = insertEntry("/B");
+  iterator c = insertEntry("/C");
+  index.insert(a, t0 + 50_ms);
+  index.insert(b, t0 + 250_ms);
+  index.insert(c, t0 + 250_ms);
+  BOOST_CHECK_EQUAL(index.size(), 3);
+
+  // an entry expires at the end of its bucket
+  BOOST_CHECK(index.popExpired(t0 + 99_ms, 10).empty());
+  BOOST_CHECK(toHashCodes(index.popExpired(t0 + 100_ms, 10)) == std::set<std::string>{"/A"});
+  BOOST_CHECK_EQUAL(index.size(), 2);
+
+  // limit is honored, and the remaining entry is returned next time
+  auto expired = index.popExpired(t0 + 300_ms, 1);
+  BOOST_CHECK_EQUAL(expired.size(), 1);
+  BOOST_CHECK_EQUAL(index.popExpired(t0 + 300_ms, 10).size(), 1);
+  BOOST_CHECK_EQUAL(index.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(MoveErase)
+{
+  iterator a = insertEntry("/A");
+  iterator b = insertEntry("/B");
+  index.insert(a, t0 + 50_ms);
+  index.insert(b, t0 + 50_ms);
+
+  // re-inserting moves the entry
+  index.insert(a, t0 + 450_ms);
+  BOOST_CHECK_EQUAL(index.size(), 2);
+  BOOST_CHECK(toHashCodes(index.popExpired(t0 + 200_ms, 10)) == std::set<std::string>{"/B"});
+
+  index.erase(a);
+  index.erase(a);
+  BOOST_CHECK_EQUAL(index.size(), 0);
+  BOOST_CHECK(index.popExpired(t0 + 1_s, 10).empty());
+}
+
+BOOST_AUTO_TEST_CASE(Wraparound)
+{
+  // 8 buckets of 100ms cover 800ms; /B is more than one revolution ahead of /A
+  iterator a = insertEntry("/A");
+  iterator b = insertEntry("/B");
+  index.insert(a, t0 + 50_ms);
+  index.insert(b, t0 + 850_ms);
+
+  BOOST_CHECK(toHashCodes(index.popExpired(t0 + 100_ms, 10)) == std::set<std::string>{"/A"});
+  BOOST_CHECK(index.popExpired(t0 + 800_ms, 10).empty());
+  BOOST_CHECK(toHashCodes(index.popExpired(t0 + 900_ms, 10)) == std::set<std::string>{"/B"});
+
+  // after a long idle period, every bucket is visited
+  index.insert(a, t0 + 1_s);
+  index.insert(b, t0 + 1450_ms);
+  BOOST_CHECK_EQUAL(index.popExpired(t0 + 60_s, 10).size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(InsertExpired)
+{
+  iterator a = insertEntry("/A");
+  BOOST_CHECK(index.popExpired(t0 + 500_ms, 10).empty());
+
+  // an entry that is already expired is returned by the next pop after the current bucket
+  index.insert(a, t0);
+  BOOST_CHECK(index.popExpired(t0 + 550_ms, 10).empty());
+  BOOST_CHECK_EQUAL(index.popExpired(t0 + 600_ms, 10).size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsExpiryIndex
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,225 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-snapshot.hpp"
+#include "table/cs.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+using namespace nfd::tests;
+
+class CsSnapshotFixture : public GlobalIoTimeFixture
+{
+protected:
+  CsSnapshotFixture()
+    : path(UNIT_TEST_CONFIG_PATH "/cs-snapshot-test/cs.snapshot")
+  {
+    boost::filesystem::create_directories(UNIT_TEST_CONFIG_PATH "/cs-snapshot-test");
+    boost::filesystem::remove(path);
+  }
+
+  ~CsSnapshotFixture() override
+  {
+    boost::filesystem::remove(path);
+  }
+
+  void
+  insert(Cs& cs, const Name& name, time::milliseconds freshnessPeriod, bool isUnsolicited = false)
+  {
+    shared_ptr<Data> data = makeData(name);
+    data->setFreshnessPeriod(freshnessPeriod);
+    cs.insert(*data, isUnsolicited, name.toUri());
+  }
+
+  static const Entry*
+  findEntry(const Cs& cs, const std::string& hashCode)
+  {
+    for (const Entry& entry : cs) {
+      if (entry.getHash() == hashCode) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+protected:
+  const std::string path;
+};
+
+BOOST_AUTO_TEST_SUITE(Table)
+BOOST_FIXTURE_TEST_SUITE(TestCsSnapshot, CsSnapshotFixture)
+
+BOOST_AUTO_TEST_CASE(WriteAndRestore)
+{
+  Cs cs1(100);
+  insert(cs1, "/A", 10_s);
+  insert(cs1, "/B", 0_ms);
+  insert(cs1, "/C", 10_s, true);
+
+  {
+    Snapshot snapshot1(cs1, path);
+    snapshot1.startWrite();
+    BOOST_CHECK(snapshot1.isWriting());
+    advanceClocks(1_ms, 5);
+    BOOST_CHECK(!snapshot1.isWriting());
+    BOOST_CHECK_EQUAL(snapshot1.getNWritten(), 3);
+  }
+  BOOST_REQUIRE(boost::filesystem::exists(path));
+  BOOST_CHECK(!boost::filesystem::exists(path + ".tmp"));
+
+  advanceClocks(1_s);
+
+  Cs cs2(100);
+  Snapshot snapshot2(cs2, path);
+  BOOST_REQUIRE(snapshot2.startRestore());
+  BOOST_CHECK(snapshot2.isRestoring());
+  BOOST_CHECK_EQUAL(cs2.size(), 0);
+  advanceClocks(1_ms, 5);
+  BOOST_CHECK(!snapshot2.isRestoring());
+  BOOST_CHECK_EQUAL(snapshot2.getNRestored(), 3);
+  BOOST_REQUIRE_EQUAL(cs2.size(), 3);
+
+  const Entry* a = findEntry(cs2, "/A");
+  BOOST_REQUIRE(a != nullptr);
+  BOOST_CHECK_EQUAL(a->getName(), "/A");
+  BOOST_CHECK(!a->isStale());
+  BOOST_CHECK(!a->isUnsolicited());
+  advanceClocks(1_s, 9);
+  BOOST_CHECK(a->isStale());
+
+  const Entry* b = findEntry(cs2, "/B");
+  BOOST_REQUIRE(b != nullptr);
+  BOOST_CHECK(b->isStale());
+
+  const Entry* c = findEntry(cs2, "/C");
+  BOOST_REQUIRE(c != nullptr);
+  BOOST_CHECK(c->isUnsolicited());
+}
+
+BOOST_AUTO_TEST_CASE(RestoreInBatches)
+{
+  const size_t nEntries = Snapshot::BATCH_SIZE * 2 + 1;
+  Cs cs1(nEntries);
+  for (size_t i = 0; i < nEntries; ++i) {
+    insert(cs1, Name("/N").appendNumber(i), 10_s);
+  }
+  Snapshot snapshot1(cs1, path);
+  snapshot1.startWrite();
+  advanceClocks(1_ms, 10);
+  BOOST_REQUIRE_EQUAL(snapshot1.getNWritten(), nEntries);
+
+  Cs cs2(nEntries);
+  Snapshot snapshot2(cs2, path);
+  BOOST_REQUIRE(snapshot2.startRestore());
+  advanceClocks(1_ns);
+  BOOST_CHECK_EQUAL(cs2.size(), Snapshot::BATCH_SIZE);
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(cs2.size(), nEntries);
+}
+
+BOOST_AUTO_TEST_CASE(PeriodicWrite)
+{
+  Cs cs(100);
+  insert(cs, "/A", 10_s);
+
+  Snapshot snapshot(cs, path);
+  snapshot.setInterval(60_s);
+  advanceClocks(1_s, 59);
+  BOOST_CHECK(!boost::filesystem::exists(path));
+  advanceClocks(1_s, 2);
+  BOOST_CHECK(boost::filesystem::exists(path));
+  BOOST_CHECK_EQUAL(snapshot.getNWritten(), 1);
+
+  insert(cs, "/B", 10_s);
+  advanceClocks(1_s, 60);
+  BOOST_CHECK_EQUAL(snapshot.getNWritten(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Flush)
+{
+  const size_t nEntries = Snapshot::BATCH_SIZE * 2 + 1;
+  Cs cs1(nEntries + 1);
+  for (size_t i = 0; i < nEntries; ++i) {
+    insert(cs1, Name("/N").appendNumber(i), 10_s);
+  }
+
+  Snapshot snapshot1(cs1, path);
+  snapshot1.startWrite();
+  advanceClocks(1_ns);
+  BOOST_CHECK(snapshot1.isWriting());
+
+  // the pass in progress is restarted, and includes entries inserted after it started
+  insert(cs1, "/A", 10_s);
+  snapshot1.flush();
+  BOOST_CHECK(!snapshot1.isWriting());
+  BOOST_CHECK_EQUAL(snapshot1.getNWritten(), nEntries + 1);
+  BOOST_CHECK(!boost::filesystem::exists(path + ".tmp"));
+
+  Cs cs2(nEntries + 1);
+  Snapshot snapshot2(cs2, path);
+  BOOST_REQUIRE(snapshot2.startRestore());
+
+  // flushing during restore does not overwrite the snapshot file
+  snapshot2.flush();
+  BOOST_CHECK_EQUAL(snapshot2.getNWritten(), 0);
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(cs2.size(), nEntries + 1);
+}
+
+BOOST_AUTO_TEST_CASE(RestoreMissing)
+{
+  Cs cs(100);
+  Snapshot snapshot(cs, path);
+  BOOST_CHECK(!snapshot.startRestore());
+  BOOST_CHECK(!snapshot.isRestoring());
+}
+
+BOOST_AUTO_TEST_CASE(RestoreCorrupted)
+{
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "NOT-A-CS-SNAPSHOT";
+  }
+
+  Cs cs(100);
+  Snapshot snapshot(cs, path);
+  BOOST_CHECK(!snapshot.startRestore());
+  BOOST_CHECK_EQUAL(cs.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsSnapshot
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
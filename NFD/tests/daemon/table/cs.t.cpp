@@ -29,6 +29,7 @@
 #include "tests/daemon/global-io-fixture.hpp"
 
 #include <cstring>
+#include <unistd.h>
 
 #include <ndn-cxx/exclude.hpp>
 #include <ndn-cxx/lp/tags.hpp>
@@ -471,6 +472,159 @@ BOOST_FIXTURE_TEST_CASE(CachePolicyNoCache, FindFixture)
   CHECK_CS_FIND(0);
 }
 
+BOOST_FIXTURE_TEST_CASE(FindMatch, GlobalIoTimeFixture)
+{
+  Cs cs;
+  shared_ptr<Data> dataA = makeData("/A");
+  shared_ptr<Data> dataB = makeData("/B");
+  cs.insert(*dataA, false, "hash-A");
+  cs.insert(*dataB, false, "hash-B");
+
+  BOOST_CHECK(cs.findMatch(*makeInterest("/B", "hash-B")) == dataB.get());
+  BOOST_CHECK(cs.findMatch(*makeInterest("/C", "hash-C")) == nullptr);
+  BOOST_CHECK(cs.findMatch(*makeInterest("/A", "hash-A")) == dataA.get());
+
+  cs.enableServe(false);
+  BOOST_CHECK(cs.findMatch(*makeInterest("/A", "hash-A")) == nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE(Batch, GlobalIoTimeFixture)
+{
+  Cs cs;
+  shared_ptr<Data> dataA = makeData("/A");
+  shared_ptr<Data> dataB = makeData("/B");
+  std::vector<Cs::BatchInsertItem> items = {
+    {dataA.get(), "hash-A", false},
+    {dataB.get(), "hash-B", false},
+    {dataA.get(), "hash-A", false},
+  };
+  std::vector<int> results = cs.insertBatch(items.data(), items.size());
+  BOOST_REQUIRE_EQUAL(results.size(), items.size());
+  BOOST_CHECK_EQUAL(results[0], 1);
+  BOOST_CHECK_EQUAL(results[1], 1);
+  BOOST_CHECK_EQUAL(results[2], -1);
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+
+  std::vector<shared_ptr<Interest>> interests = {
+    makeInterest("/B", "hash-B"),
+    makeInterest("/C", "hash-C"),
+    makeInterest("/A", "hash-A"),
+  };
+  std::vector<const Interest*> batch;
+  for (const auto& interest : interests) {
+    batch.push_back(interest.get());
+  }
+  std::vector<const Data*> matches = cs.findBatch(batch.data(), batch.size());
+  BOOST_REQUIRE_EQUAL(matches.size(), batch.size());
+  BOOST_CHECK(matches[0] == dataB.get());
+  BOOST_CHECK(matches[1] == nullptr);
+  BOOST_CHECK(matches[2] == dataA.get());
+
+  cs.enableServe(false);
+  matches = cs.findBatch(batch.data(), batch.size());
+  BOOST_CHECK(std::all_of(matches.begin(), matches.end(), [] (const Data* d) { return d == nullptr; }));
+}
+
+BOOST_FIXTURE_TEST_CASE(SharedStorage, GlobalIoTimeFixture)
+{
+  std::string segmentName = "/nfd-test-cs-" + to_string(::getpid());
+  Cs cs;
+  cs.setSharedStorage(ndn::SharedMemoryStorage::create(segmentName, 4096, 16));
+  BOOST_REQUIRE(cs.getSharedStorage() != nullptr);
+
+  // a local producer publishes into the segment without going through a face
+  auto producer = ndn::SharedMemoryStorage::open(segmentName);
+  shared_ptr<Data> dataA = makeData("/A");
+  BOOST_CHECK(producer->insert(*dataA, "hash-A"));
+  shared_ptr<Data> dataB = makeData("/B");
+  cs.insert(*dataB, false, "hash-B");
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+
+  bool isHit = false;
+  cs.find(*makeInterest("/A", "hash-A"),
+          [&] (const Interest&, const Data& data) {
+            isHit = true;
+            BOOST_CHECK_EQUAL(data.getName(), "/A");
+          },
+          [] (const Interest&) {});
+  BOOST_CHECK(isHit);
+
+  const Data* match = cs.findMatch(*makeInterest("/A", "hash-A"));
+  BOOST_REQUIRE(match != nullptr);
+  BOOST_CHECK_EQUAL(match->getName(), "/A");
+  BOOST_CHECK(cs.findMatch(*makeInterest("/B", "hash-B")) == dataB.get());
+  BOOST_CHECK(cs.findMatch(*makeInterest("/C", "hash-C")) == nullptr);
+
+  std::vector<shared_ptr<Interest>> interests = {
+    makeInterest("/A", "hash-A"),
+    makeInterest("/B", "hash-B"),
+    makeInterest("/C", "hash-C"),
+  };
+  std::vector<const Interest*> batch;
+  for (const auto& interest : interests) {
+    batch.push_back(interest.get());
+  }
+  std::vector<const Data*> matches = cs.findBatch(batch.data(), batch.size());
+  BOOST_REQUIRE(matches[0] != nullptr);
+  BOOST_CHECK_EQUAL(matches[0]->getName(), "/A");
+  BOOST_CHECK(matches[1] == dataB.get());
+  BOOST_CHECK(matches[2] == nullptr);
+
+  cs.setSharedStorage(nullptr);
+  BOOST_CHECK(cs.findMatch(*makeInterest("/A", "hash-A")) == nullptr);
+  matches = cs.findBatch(batch.data(), batch.size());
+  BOOST_CHECK(matches[0] == nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE(EvictStale, GlobalIoTimeFixture)
+{
+  Cs cs(4);
+  auto insertWithFreshness = [&cs] (const std::string& name, time::milliseconds freshnessPeriod) {
+    shared_ptr<Data> data = makeData(name);
+    data->setFreshnessPeriod(freshnessPeriod);
+    cs.insert(*data, false, name);
+  };
+  auto has = [&cs] (const std::string& hashCode) {
+    return std::any_of(cs.begin(), cs.end(),
+                       [&] (const Entry& entry) { return entry.getHash() == hashCode; });
+  };
+
+  insertWithFreshness("/F1", 10_s);
+  insertWithFreshness("/S1", 1_s);
+  insertWithFreshness("/S2", 1_s);
+  insertWithFreshness("/F2", 10_s);
+  advanceClocks(500_ms, 4);
+
+  // /S1 is requested while stale, and thus is not evicted for RECENT_REQUEST_PERIOD
+  bool isHit = false;
+  cs.find(*makeInterest("/S1", "/S1"),
+          [&] (const Interest&, const Data&) { isHit = true; },
+          [] (const Interest&) {});
+  BOOST_CHECK(isHit);
+
+  // LRU would evict /F1, but stale entry /S2 goes first
+  insertWithFreshness("/F3", 10_s);
+  BOOST_CHECK_EQUAL(cs.size(), 4);
+  BOOST_CHECK(has("/F1"));
+  BOOST_CHECK(has("/S1"));
+  BOOST_CHECK(!has("/S2"));
+  BOOST_CHECK(has("/F2"));
+  BOOST_CHECK(has("/F3"));
+
+  advanceClocks(500_ms);
+  insertWithFreshness("/F4", 10_s);
+  BOOST_CHECK_EQUAL(cs.size(), 4);
+  BOOST_CHECK(has("/S1"));
+  BOOST_CHECK(!has("/F1"));
+
+  // /S1 has not been requested again since
+  advanceClocks(500_ms, 2);
+  insertWithFreshness("/F5", 10_s);
+  BOOST_CHECK_EQUAL(cs.size(), 4);
+  BOOST_CHECK(!has("/S1"));
+  BOOST_CHECK(has("/F2"));
+}
+
 BOOST_AUTO_TEST_CASE(Enumeration)
 {
   Cs cs;
@@ -0,0 +1,237 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/fib-view.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include <thread>
+
+namespace nfd {
+namespace fib {
+namespace tests {
+
+using namespace nfd::tests;
+
+class FibViewFixture : public GlobalIoTimeFixture
+{
+protected:
+  FibViewFixture()
+    : fib(nameTree)
+    , publisher(fib)
+  {
+  }
+
+protected:
+  NameTree nameTree;
+  Fib fib;
+  ViewPublisher publisher;
+};
+
+BOOST_AUTO_TEST_SUITE(Table)
+BOOST_FIXTURE_TEST_SUITE(TestFibView, FibViewFixture)
+
+BOOST_AUTO_TEST_CASE(Lookup)
+{
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  face1->setId(301);
+  face2->setId(302);
+  fib.insert("/").first->addOrUpdateNextHop(*face1, 0, 10);
+  fib.insert("/A/B").first->addOrUpdateNextHop(*face2, 0, 20);
+  fib.insert("/A/B").first->addOrUpdateNextHop(*face1, 0, 30);
+
+  ViewPublisher::Reader reader(publisher);
+  BOOST_CHECK_EQUAL(reader.enter().size(), 0); // initial view is taken at construction
+  reader.leave();
+
+  publisher.publish();
+  const View& view = reader.enter();
+  BOOST_CHECK_EQUAL(view.getVersion(), 1);
+  BOOST_CHECK_EQUAL(view.size(), 2);
+
+  const View::Entry* entry = view.findLongestPrefixMatch("/A/B/C");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_CHECK_EQUAL(entry->getPrefix(), "/A/B");
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 2);
+  BOOST_CHECK_EQUAL(entry->getNextHops()[0].faceId, 302);
+  BOOST_CHECK_EQUAL(entry->getNextHops()[0].cost, 20);
+  BOOST_CHECK_EQUAL(entry->getNextHops()[1].faceId, 301);
+
+  entry = view.findLongestPrefixMatch("/A/C");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_CHECK_EQUAL(entry->getPrefix(), "/");
+
+  BOOST_CHECK(view.findExactMatch("/A") == nullptr);
+  BOOST_CHECK(view.findExactMatch("/A/B") != nullptr);
+  BOOST_CHECK(view.findExactMatch("/A/B/C") == nullptr);
+  reader.leave();
+}
+
+BOOST_AUTO_TEST_CASE(Reclaim)
+{
+  auto face = make_shared<DummyFace>();
+  fib.insert("/A").first->addOrUpdateNextHop(*face, 0, 10);
+
+  ViewPublisher::Reader reader(publisher);
+  const View& view0 = reader.enter();
+
+  publisher.publish();
+  // reader is still using the initial view
+  BOOST_CHECK_EQUAL(publisher.getNRetiredViews(), 1);
+  BOOST_CHECK_EQUAL(view0.getVersion(), 0);
+  BOOST_CHECK_EQUAL(view0.size(), 0);
+  reader.leave();
+
+  const View& view1 = reader.enter();
+  BOOST_CHECK_EQUAL(view1.getVersion(), 1);
+  BOOST_CHECK_EQUAL(view1.size(), 1);
+  publisher.publish();
+  // initial view is reclaimed, version 1 is still in use
+  BOOST_CHECK_EQUAL(publisher.getNRetiredViews(), 1);
+  reader.leave();
+
+  publisher.publish();
+  BOOST_CHECK_EQUAL(publisher.getNRetiredViews(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SchedulePublish)
+{
+  auto face = make_shared<DummyFace>();
+  ViewPublisher::Reader reader(publisher);
+
+  // disabled publisher ignores changes
+  fib.insert("/A").first->addOrUpdateNextHop(*face, 0, 10);
+  publisher.schedulePublish();
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(reader.enter().getVersion(), 0);
+  reader.leave();
+
+  publisher.setEnabled(true);
+  BOOST_CHECK_EQUAL(reader.enter().getVersion(), 1);
+  reader.leave();
+
+  // changes before the scheduled publication are coalesced into one view
+  fib.insert("/B").first->addOrUpdateNextHop(*face, 0, 10);
+  publisher.schedulePublish();
+  fib.insert("/C").first->addOrUpdateNextHop(*face, 0, 10);
+  publisher.schedulePublish();
+  BOOST_CHECK_EQUAL(reader.enter().getVersion(), 1);
+  reader.leave();
+
+  advanceClocks(1_ms);
+  const View& view = reader.enter();
+  BOOST_CHECK_EQUAL(view.getVersion(), 2);
+  BOOST_CHECK_EQUAL(view.size(), 3);
+  reader.leave();
+}
+
+BOOST_AUTO_TEST_CASE(TooManyReaders)
+{
+  std::vector<unique_ptr<ViewPublisher::Reader>> readers;
+  for (size_t i = 0; i < ViewPublisher::MAX_READERS; ++i) {
+    readers.push_back(make_unique<ViewPublisher::Reader>(publisher));
+  }
+  BOOST_CHECK_THROW(ViewPublisher::Reader{publisher}, std::length_error);
+
+  readers.pop_back();
+  BOOST_CHECK_NO_THROW(ViewPublisher::Reader{publisher});
+}
+
+BOOST_AUTO_TEST_CASE(MultiReaderStress)
+{
+  const size_t N_ENTRIES = 200;
+  const size_t N_READERS = 4;
+  const uint64_t N_ROUNDS = 500;
+
+  auto face = make_shared<DummyFace>();
+  std::vector<Entry*> entries;
+  for (size_t i = 0; i < N_ENTRIES; ++i) {
+    entries.push_back(fib.insert(Name("/P").appendNumber(i)).first);
+    entries.back()->addOrUpdateNextHop(*face, 0, 0);
+  }
+  publisher.publish();
+
+  // Each round sets every nexthop cost to the round number, so a consistent view has
+  // the same cost on all entries. Assertions are counted because Boost.Test is not thread-safe.
+  std::atomic<bool> shouldStop{false};
+  std::atomic<size_t> nErrors{0};
+  std::atomic<size_t> nReads{0};
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < N_READERS; ++t) {
+    threads.emplace_back([&] {
+      ViewPublisher::Reader reader(publisher);
+      uint64_t lastVersion = 0;
+      Name name("/P");
+      while (!shouldStop) {
+        const View& view = reader.enter();
+        if (view.getVersion() < lastVersion || view.size() != N_ENTRIES) {
+          ++nErrors;
+        }
+        lastVersion = view.getVersion();
+
+        uint64_t cost = view.getVersion() - 1;
+        for (size_t i = 0; i < N_ENTRIES; ++i) {
+          const View::Entry* entry = view.findLongestPrefixMatch(Name(name).appendNumber(i).append("x"));
+          if (entry == nullptr || entry->getNextHops().size() != 1 ||
+              entry->getNextHops().front().cost != cost) {
+            ++nErrors;
+          }
+        }
+        reader.leave();
+        ++nReads;
+      }
+    });
+  }
+
+  for (uint64_t round = 1; round <= N_ROUNDS; ++round) {
+    for (Entry* entry : entries) {
+      entry->addOrUpdateNextHop(*face, 0, round);
+    }
+    publisher.publish();
+  }
+
+  // let readers observe the last view before stopping
+  while (nReads < N_READERS * 2) {
+    std::this_thread::yield();
+  }
+  shouldStop = true;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  publisher.publish();
+  BOOST_CHECK_EQUAL(publisher.getNRetiredViews(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestFibView
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace tests
+} // namespace fib
+} // namespace nfd
@@ -188,6 +188,98 @@ BOOST_AUTO_TEST_CASE(FibEntry)
   BOOST_CHECK_EQUAL(entry.getNextHops().size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(FibEntryCostOrder)
+{
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  auto face3 = make_shared<DummyFace>();
+  auto face4 = make_shared<DummyFace>();
+
+  Entry entry("/A");
+  auto getFaces = [&entry] {
+    std::vector<Face*> faces;
+    for (const auto& nexthop : entry.getNextHops()) {
+      faces.push_back(&nexthop.getFace());
+    }
+    return faces;
+  };
+
+  entry.addOrUpdateNextHop(*face1, 0, 20);
+  entry.addOrUpdateNextHop(*face2, 0, 20);
+  entry.addOrUpdateNextHop(*face3, 0, 10);
+  entry.addOrUpdateNextHop(*face4, 0, 30);
+  // [face3:10, face1:20, face2:20, face4:30]
+  std::vector<Face*> expected{face3.get(), face1.get(), face2.get(), face4.get()};
+  BOOST_CHECK(getFaces() == expected);
+
+  // decreased cost goes after existing nexthops with equal cost
+  entry.addOrUpdateNextHop(*face4, 0, 20);
+  expected = {face3.get(), face1.get(), face2.get(), face4.get()};
+  BOOST_CHECK(getFaces() == expected);
+
+  entry.addOrUpdateNextHop(*face2, 0, 5);
+  expected = {face2.get(), face3.get(), face1.get(), face4.get()};
+  BOOST_CHECK(getFaces() == expected);
+
+  // increased cost goes before following nexthops with equal cost
+  entry.addOrUpdateNextHop(*face3, 0, 20);
+  expected = {face2.get(), face3.get(), face1.get(), face4.get()};
+  BOOST_CHECK(getFaces() == expected);
+
+  entry.addOrUpdateNextHop(*face2, 0, 40);
+  expected = {face3.get(), face1.get(), face4.get(), face2.get()};
+  BOOST_CHECK(getFaces() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(FibEntryMasks)
+{
+  auto face1 = make_shared<DummyFace>("dummy://1", "dummy://1", ndn::nfd::FACE_SCOPE_LOCAL);
+  auto face2 = make_shared<DummyFace>("dummy://2", "dummy://2", ndn::nfd::FACE_SCOPE_NON_LOCAL,
+                                      ndn::nfd::FACE_PERSISTENCY_PERSISTENT, ndn::nfd::LINK_TYPE_AD_HOC);
+  auto face3 = make_shared<DummyFace>();
+
+  Entry entry("/A");
+  BOOST_CHECK(entry.hasNextHopMasks());
+  BOOST_CHECK_EQUAL(entry.getAllNextHopsMask(), 0);
+
+  entry.addOrUpdateNextHop(*face1, 0, 30);
+  entry.addOrUpdateNextHop(*face2, 0, 20);
+  entry.addOrUpdateNextHop(*face3, 0, 10);
+  entry.addOrUpdateNextHop(*face3, 1, 40);
+  // [face3:10, face2:20, face1:30, face3:40]
+  BOOST_CHECK_EQUAL(entry.getAllNextHopsMask(), 0b1111);
+  BOOST_CHECK_EQUAL(entry.getLocalNextHopsMask(), 0b0100);
+  BOOST_CHECK_EQUAL(entry.getAdHocNextHopsMask(), 0b0010);
+  BOOST_CHECK_EQUAL(entry.getNextHopsMaskByFace(*face1), 0b0100);
+  BOOST_CHECK_EQUAL(entry.getNextHopsMaskByFace(*face3), 0b1001);
+
+  entry.addOrUpdateNextHop(*face1, 0, 5);
+  // [face1:5, face3:10, face2:20, face3:40]
+  BOOST_CHECK_EQUAL(entry.getLocalNextHopsMask(), 0b0001);
+  BOOST_CHECK_EQUAL(entry.getAdHocNextHopsMask(), 0b0100);
+  BOOST_CHECK_EQUAL(entry.getNextHopsMaskByFace(*face3), 0b1010);
+
+  entry.removeNextHopByFace(*face3);
+  // [face1:5, face2:20]
+  BOOST_CHECK_EQUAL(entry.getAllNextHopsMask(), 0b11);
+  BOOST_CHECK_EQUAL(entry.getAdHocNextHopsMask(), 0b10);
+  BOOST_CHECK_EQUAL(entry.getNextHopsMaskByFace(*face3), 0);
+
+  entry.removeNextHop(*face1, 0);
+  // [face2:20]
+  BOOST_CHECK_EQUAL(entry.getLocalNextHopsMask(), 0);
+  BOOST_CHECK_EQUAL(entry.getAdHocNextHopsMask(), 0b1);
+
+  for (EndpointId i = 0; i < MAX_MASKED_NEXTHOPS - 1; ++i) {
+    entry.addOrUpdateNextHop(*face3, i, 100);
+  }
+  BOOST_CHECK(entry.hasNextHopMasks());
+  BOOST_CHECK_EQUAL(entry.getAllNextHopsMask(), ~NextHopMask(0));
+
+  entry.addOrUpdateNextHop(*face3, MAX_MASKED_NEXTHOPS, 100);
+  BOOST_CHECK(!entry.hasNextHopMasks());
+}
+
 BOOST_AUTO_TEST_CASE(Insert_LongestPrefixMatch)
 {
   NameTree nameTree;
@@ -237,6 +329,72 @@ BOOST_AUTO_TEST_CASE(Insert_LongestPrefixMatch)
   BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/E").getPrefix(), "/");
 }
 
+BOOST_AUTO_TEST_CASE(LongestPrefixMatchMarkers)
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+
+  fib.insert("/A");
+  fib.insert("/A/B/C/D");
+  fib.insert("/A/B/E");
+  // PIT entries create name tree entries without FIB markers
+  Pit pit(nameTree);
+  pit.insert(*makeInterest("/A/B/C/F/G/H"));
+
+  BOOST_CHECK_EQUAL(nameTree.findExactMatch("/")->getFibMarkerCount(), 3);
+  BOOST_CHECK_EQUAL(nameTree.findExactMatch("/A/B")->getFibMarkerCount(), 2);
+  BOOST_CHECK_EQUAL(nameTree.findExactMatch("/A/B/C/F")->getFibMarkerCount(), 0);
+
+  // the longest marked prefix is /A/B/C, whose nearest ancestor with a FIB entry is /A
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C/F/G/H").getPrefix(), "/A");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C/D/E/F/G/H/I/J").getPrefix(), "/A/B/C/D");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/E").getPrefix(), "/A/B/E");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B").getPrefix(), "/A");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/X/Y").getPrefix(), "/"); // the empty entry
+
+  fib.erase("/A/B/C/D");
+  BOOST_CHECK_EQUAL(nameTree.findExactMatch("/")->getFibMarkerCount(), 2);
+  BOOST_CHECK_EQUAL(nameTree.findExactMatch("/A/B/C")->getFibMarkerCount(), 0);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C/D/E").getPrefix(), "/A");
+
+  fib.erase("/A");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C/F/G/H").getPrefix(), "/"); // the empty entry
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/E/F").getPrefix(), "/A/B/E");
+
+  fib.erase("/A/B/E");
+  BOOST_CHECK_EQUAL(nameTree.findExactMatch("/")->getFibMarkerCount(), 0);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/E/F").getPrefix(), "/"); // the empty entry
+}
+
+BOOST_AUTO_TEST_CASE(LongestPrefixMatchCompressed)
+{
+  NameTree nameTree;
+  nameTree.setCompressed(true);
+  Fib fib(nameTree);
+
+  fib.insert("/A");
+  fib.insert("/A/B/C/D");
+  fib.insert("/A/B/E");
+  BOOST_CHECK(nameTree.findExactMatch("/A/B/C") == nullptr);
+  BOOST_CHECK_EQUAL(nameTree.findExactMatch("/A/B")->getFibMarkerCount(), 2);
+
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C/F/G/H").getPrefix(), "/A");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C/D/E").getPrefix(), "/A/B/C/D");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/E").getPrefix(), "/A/B/E");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/X/Y").getPrefix(), "/"); // the empty entry
+
+  fib.erase("/A/B/E");
+  BOOST_CHECK(nameTree.findExactMatch("/A/B") == nullptr);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/E/F").getPrefix(), "/A");
+
+  // converting to an uncompressed name tree restores FIB markers on materialized ancestors
+  nameTree.setCompressed(false);
+  BOOST_CHECK_EQUAL(nameTree.findExactMatch("/A/B/C")->getFibMarkerCount(), 1);
+  BOOST_CHECK_EQUAL(nameTree.findExactMatch("/")->getFibMarkerCount(), 2);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C/D/E").getPrefix(), "/A/B/C/D");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/A/B/C/F").getPrefix(), "/A");
+}
+
 BOOST_AUTO_TEST_CASE(LongestPrefixMatchWithPitEntry)
 {
   NameTree nameTree;
@@ -282,6 +440,34 @@ BOOST_AUTO_TEST_CASE(LongestPrefixMatchWithMeasurementsEntry)
   BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(mABCD).getPrefix(), "/A/B/C");
 }
 
+BOOST_AUTO_TEST_CASE(LongestPrefixMatchCache)
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+  Pit pit(nameTree);
+  Measurements measurements(nameTree);
+
+  fib.insert("/A");
+  shared_ptr<pit::Entry> pitABC = pit.insert(*makeInterest("/A/B/C")).first;
+  measurements::Entry& mABC = measurements.get("/A/B/C");
+
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitABC).getPrefix(), "/A");
+
+  // cached results must not survive insertion of a longer match
+  fib.insert("/A/B");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitABC).getPrefix(), "/A/B");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(mABC).getPrefix(), "/A/B");
+  BOOST_CHECK_EQUAL(&fib.findLongestPrefixMatch(*pitABC), fib.findExactMatch("/A/B"));
+
+  // nor erasure of the cached entry
+  fib.erase("/A/B");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitABC).getPrefix(), "/A");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(mABC).getPrefix(), "/A");
+
+  fib.erase("/A");
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(*pitABC).getPrefix(), "/"); // the empty entry
+}
+
 void
 validateFindExactMatch(Fib& fib, const Name& target)
 {
@@ -690,6 +690,80 @@ BOOST_FIXTURE_TEST_CASE(IteratorFindAllMatches, EnumerationFixture)
     .end();
 }
 
+BOOST_AUTO_TEST_SUITE(Compressed)
+
+BOOST_AUTO_TEST_CASE(LookupErase)
+{
+  NameTree nt;
+  nt.setCompressed(true);
+  BOOST_CHECK(nt.isCompressed());
+
+  Entry& abcd = nt.lookup("/a/b/c/d");
+  BOOST_CHECK_EQUAL(nt.size(), 2);
+  Entry* root = nt.findExactMatch("/");
+  BOOST_REQUIRE(root != nullptr);
+  BOOST_CHECK_EQUAL(abcd.getParent(), root);
+
+  // diverging names materialize the branching point
+  Entry& abxy = nt.lookup("/a/b/x/y");
+  BOOST_CHECK_EQUAL(nt.size(), 4);
+  Entry* ab = nt.findExactMatch("/a/b");
+  BOOST_REQUIRE(ab != nullptr);
+  BOOST_CHECK_EQUAL(ab->getParent(), root);
+  BOOST_CHECK_EQUAL(abcd.getParent(), ab);
+  BOOST_CHECK_EQUAL(abxy.getParent(), ab);
+  BOOST_CHECK_EQUAL(root->getChildren().size(), 1);
+
+  // a prefix of an existing entry is inserted above it
+  Entry& a = nt.lookup("/a");
+  BOOST_CHECK_EQUAL(nt.size(), 5);
+  BOOST_CHECK_EQUAL(a.getParent(), root);
+  BOOST_CHECK_EQUAL(ab->getParent(), &a);
+
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(Name("/a/b/c/z")), ab);
+  BOOST_CHECK_EQUAL(&nt.lookup("/a/b/c/d"), &abcd);
+
+  auto&& enumerable = nt.partialEnumerate("/a/b/c");
+  BOOST_CHECK_EQUAL(std::distance(enumerable.begin(), enumerable.end()), 1);
+  BOOST_CHECK_EQUAL(enumerable.begin()->getName(), "/a/b/c/d");
+
+  // /a/b is left with a single child and is spliced out
+  BOOST_CHECK_EQUAL(nt.eraseIfEmpty(&abxy), 2);
+  BOOST_CHECK_EQUAL(nt.size(), 3);
+  BOOST_CHECK(nt.findExactMatch("/a/b") == nullptr);
+  BOOST_CHECK_EQUAL(abcd.getParent(), &a);
+
+  BOOST_CHECK_EQUAL(nt.eraseIfEmpty(&abcd), 3);
+  BOOST_CHECK_EQUAL(nt.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Convert)
+{
+  NameTree nt;
+  Entry& abc = nt.lookup("/a/b/c");
+  Entry& abd = nt.lookup("/a/b/d");
+  BOOST_CHECK_EQUAL(nt.size(), 5);
+
+  nt.setCompressed(true);
+  BOOST_CHECK_EQUAL(nt.size(), 4);
+  BOOST_CHECK(nt.findExactMatch("/a") == nullptr);
+  Entry* ab = nt.findExactMatch("/a/b");
+  BOOST_REQUIRE(ab != nullptr);
+  BOOST_CHECK_EQUAL(ab->getParent(), nt.findExactMatch("/"));
+  BOOST_CHECK_EQUAL(abc.getParent(), ab);
+  BOOST_CHECK_EQUAL(abd.getParent(), ab);
+
+  nt.setCompressed(false);
+  BOOST_CHECK(!nt.isCompressed());
+  BOOST_CHECK_EQUAL(nt.size(), 5);
+  Entry* a = nt.findExactMatch("/a");
+  BOOST_REQUIRE(a != nullptr);
+  BOOST_CHECK_EQUAL(a->getParent(), nt.findExactMatch("/"));
+  BOOST_CHECK_EQUAL(ab->getParent(), a);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Compressed
+
 BOOST_AUTO_TEST_CASE(HashTableResizeShrink)
 {
   size_t nBuckets = 16;
@@ -257,6 +257,33 @@ BOOST_AUTO_TEST_CASE(FindEffectiveStrategyWithMeasurementsEntry)
   BOOST_CHECK_EQUAL(this->findInstanceName(mABCD), strategyNameQ);
 }
 
+BOOST_AUTO_TEST_CASE(FindEffectiveStrategyCache)
+{
+  BOOST_CHECK(sc.insert("/", strategyNameP));
+
+  Pit& pit = forwarder.getPit();
+  shared_ptr<pit::Entry> pitABC = pit.insert(*makeInterest("/A/B/C")).first;
+  measurements::Entry& mABC = forwarder.getMeasurements().get("/A/B/C");
+
+  BOOST_CHECK_EQUAL(this->findInstanceName(*pitABC), strategyNameP);
+  BOOST_CHECK_EQUAL(&sc.findEffectiveStrategy(*pitABC), &sc.findEffectiveStrategy("/"));
+
+  // cached results must not survive a new strategy choice
+  BOOST_CHECK(sc.insert("/A", strategyNameQ));
+  BOOST_CHECK_EQUAL(this->findInstanceName(*pitABC), strategyNameQ);
+  BOOST_CHECK_EQUAL(this->findInstanceName(mABC), strategyNameQ);
+
+  // nor replacement of the cached strategy instance
+  BOOST_CHECK(sc.insert("/A", strategyNameP));
+  BOOST_CHECK_EQUAL(this->findInstanceName(*pitABC), strategyNameP);
+  BOOST_CHECK_EQUAL(&sc.findEffectiveStrategy(*pitABC), &sc.findEffectiveStrategy("/A"));
+
+  // nor erasure of the strategy choice
+  sc.erase("/A");
+  BOOST_CHECK_EQUAL(&sc.findEffectiveStrategy(*pitABC), &sc.findEffectiveStrategy("/"));
+  BOOST_CHECK_EQUAL(&sc.findEffectiveStrategy(mABC), &sc.findEffectiveStrategy("/"));
+}
+
 BOOST_AUTO_TEST_CASE(Erase)
 {
   NameTree& nameTree = forwarder.getNameTree();
@@ -244,5 +244,45 @@ BOOST_FIXTURE_TEST_CASE(Rightmost, CsBenchmarkFixture)
   std::cout << "find(rightmost) " << (N_INTERESTS * N_CHILDREN * REPEAT) << ": " << d << std::endl;
 }
 
+// insertBatch, then findBatch hit, compared with per-packet insert and find
+BOOST_FIXTURE_TEST_CASE(BatchInsertFindHit, CsBenchmarkFixture)
+{
+  constexpr size_t N_WORKLOAD = CS_CAPACITY * 2;
+  constexpr size_t BATCH_SIZE = 32;
+  constexpr size_t REPEAT = 4;
+
+  std::vector<shared_ptr<Interest>> interestWorkload = makeInterestWorkload(N_WORKLOAD);
+  std::vector<shared_ptr<Data>> dataWorkload = makeDataWorkload(N_WORKLOAD);
+  std::vector<const Interest*> interests(N_WORKLOAD);
+  std::vector<Cs::BatchInsertItem> items(N_WORKLOAD);
+  for (size_t i = 0; i < N_WORKLOAD; ++i) {
+    interestWorkload[i]->setHashCode(to_string(i));
+    interests[i] = interestWorkload[i].get();
+    items[i] = {dataWorkload[i].get(), to_string(i), false};
+  }
+
+  time::microseconds d1 = timedRun([&] {
+    for (size_t j = 0; j < REPEAT; ++j) {
+      for (size_t i = 0; i < N_WORKLOAD; ++i) {
+        cs.insert(*items[i].data, false, items[i].hashCode);
+        find(*interests[i]);
+      }
+    }
+  });
+  std::cout << "insert-find(hit) " << (N_WORKLOAD * REPEAT) << ": " << d1 << std::endl;
+
+  Cs cs2;
+  cs2.setLimit(CS_CAPACITY);
+  time::microseconds d2 = timedRun([&] {
+    for (size_t j = 0; j < REPEAT; ++j) {
+      for (size_t i = 0; i < N_WORKLOAD; i += BATCH_SIZE) {
+        cs2.insertBatch(&items[i], BATCH_SIZE);
+        cs2.findBatch(&interests[i], BATCH_SIZE);
+      }
+    }
+  });
+  std::cout << "insertBatch-findBatch(hit) " << (N_WORKLOAD * REPEAT) << ": " << d2 << std::endl;
+}
+
 } // namespace tests
 } // namespace nfd
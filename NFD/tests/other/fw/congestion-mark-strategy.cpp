@@ -69,6 +69,8 @@ CongestionMarkStrategy::CongestionMarkStrategy(Forwarder& forwarder, const Name&
       "CongestionMarkStrategy does not support version " + to_string(*parsed.version)));
   }
   this->setInstanceName(makeInstanceName(name, getStrategyName()));
+  // congestion marks are applied in afterReceiveInterest
+  this->setFlowCacheable(false);
 }
 
 const Name&
@@ -153,5 +153,51 @@ BOOST_FIXTURE_TEST_CASE(SimpleExchanges, PitFibBenchmarkFixture)
   std::cout << time::duration_cast<time::microseconds>(t2 - t1) << std::endl;
 }
 
+// This test case compares the binary search on prefix length used by Fib::findLongestPrefixMatch
+// with a scan that probes every prefix of the Interest name, starting from the longest one.
+BOOST_FIXTURE_TEST_CASE(LongestPrefixMatch, PitFibBenchmarkFixture)
+{
+  // total amount of FIB entries
+  const size_t nFibEntries = 1000000;
+  // number of lookups performed with each method
+  const size_t nLookups = 1000000;
+  // length of Interest Name, with FIB prefixes of 2 components
+  const size_t interestNameLength = 10;
+
+  std::vector<Name> names;
+  names.reserve(nLookups);
+  for (size_t i = 0; i < nFibEntries; ++i) {
+    m_fib.insert(Name("/fib").append(to_string(i)));
+  }
+  for (size_t i = 0; i < nLookups; ++i) {
+    Name name("/fib");
+    name.append(to_string(i * 7919 % nFibEntries));
+    while (name.size() < interestNameLength) {
+      name.append("dup");
+    }
+    names.push_back(std::move(name));
+  }
+
+  auto t1 = time::steady_clock::now();
+  size_t nScanMatches = 0;
+  for (const Name& name : names) {
+    auto nte = m_nameTree.findLongestPrefixMatch(name, [] (const name_tree::Entry& nte) {
+      return nte.getFibEntry() != nullptr;
+    });
+    nScanMatches += nte != nullptr;
+  }
+  auto t2 = time::steady_clock::now();
+  size_t nBinarySearchMatches = 0;
+  for (const Name& name : names) {
+    nBinarySearchMatches += !m_fib.findLongestPrefixMatch(name).getPrefix().empty();
+  }
+  auto t3 = time::steady_clock::now();
+
+  BOOST_CHECK_EQUAL(nScanMatches, nLookups);
+  BOOST_CHECK_EQUAL(nBinarySearchMatches, nLookups);
+  std::cout << "scan " << time::duration_cast<time::microseconds>(t2 - t1)
+            << ", binary search " << time::duration_cast<time::microseconds>(t3 - t2) << std::endl;
+}
+
 } // namespace tests
 } // namespace nfd
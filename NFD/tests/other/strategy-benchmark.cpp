@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2017,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "fw/asf-strategy.hpp"
+#include "fw/best-route-strategy2.hpp"
+#include "fw/forwarder.hpp"
+#include "daemon/global.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include <iostream>
+
+#ifdef HAVE_VALGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+namespace nfd {
+namespace tests {
+
+class StrategyBenchmarkFixture
+{
+protected:
+  StrategyBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+  }
+
+  void
+  generatePackets(size_t nNamespaces, size_t nRounds)
+  {
+    for (size_t round = 0; round < nRounds; ++round) {
+      for (size_t i = 0; i < nNamespaces; ++i) {
+        Name name("/ns");
+        name.append(to_string(i)).append(to_string(round));
+        interests.push_back(make_shared<Interest>(name));
+        data.push_back(makeData(name));
+      }
+    }
+  }
+
+  /** \brief forward every Interest with \p strategyName, one round of all namespaces at a time
+   *
+   *  The FIB has a route for each namespace to two producer faces. Every Interest is
+   *  answered from the lowest-cost producer before the next round starts.
+   *
+   *  \return elapsed time
+   */
+  time::nanoseconds
+  run(const Name& strategyName, size_t nNamespaces, size_t nRounds)
+  {
+    Forwarder forwarder;
+    auto consumer = make_shared<DummyFace>();
+    auto producer1 = make_shared<DummyFace>();
+    auto producer2 = make_shared<DummyFace>();
+    forwarder.addFace(consumer);
+    forwarder.addFace(producer1);
+    forwarder.addFace(producer2);
+
+    forwarder.getStrategyChoice().insert("/", strategyName);
+    for (size_t i = 0; i < nNamespaces; ++i) {
+      fib::Entry* entry = forwarder.getFib().insert(Name("/ns").append(to_string(i))).first;
+      entry->addOrUpdateNextHop(*producer1, 0, 10);
+      entry->addOrUpdateNextHop(*producer2, 0, 20);
+    }
+
+#ifdef HAVE_VALGRIND
+    CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+    auto t1 = time::steady_clock::now();
+
+    for (size_t round = 0; round < nRounds; ++round) {
+      size_t first = round * nNamespaces;
+      for (size_t i = first; i < first + nNamespaces; ++i) {
+        consumer->receiveInterest(*interests[i]);
+      }
+      for (size_t i = first; i < first + nNamespaces; ++i) {
+        producer1->receiveData(*data[i]);
+      }
+      consumer->sentData.clear();
+      producer1->sentInterests.clear();
+      producer2->sentInterests.clear();
+      getGlobalIoService().poll();
+    }
+
+    auto t2 = time::steady_clock::now();
+
+#ifdef HAVE_VALGRIND
+    CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+    return t2 - t1;
+  }
+
+protected:
+  std::vector<shared_ptr<Interest>> interests;
+  std::vector<shared_ptr<Data>> data;
+};
+
+// This test case compares the forwarding overhead of AsfStrategy, which keeps RTT measurements
+// and timeouts for every face in every namespace, with BestRouteStrategy2, which keeps none.
+BOOST_FIXTURE_TEST_CASE(AsfVersusBestRoute, StrategyBenchmarkFixture)
+{
+  // number of namespaces with active traffic, each with its own FIB entry
+  const size_t nNamespaces = 10000;
+  // number of Interest-Data exchanges in each namespace
+  const size_t nRounds = 20;
+
+  generatePackets(nNamespaces, nRounds);
+
+  auto bestRoute = run(fw::BestRouteStrategy2::getStrategyName(), nNamespaces, nRounds);
+  auto asf = run(fw::asf::AsfStrategy::getStrategyName(), nNamespaces, nRounds);
+
+  std::cout << "best-route " << time::duration_cast<time::microseconds>(bestRoute)
+            << ", asf " << time::duration_cast<time::microseconds>(asf)
+            << ", ratio " << static_cast<double>(asf.count()) / bestRoute.count() << std::endl;
+}
+
+} // namespace tests
+} // namespace nfd
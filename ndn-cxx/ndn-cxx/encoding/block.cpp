@@ -146,6 +146,18 @@ Block::Block(uint32_t type, ConstBufferPtr value)
   m_size = tlv::sizeOfVarNumber(m_type) + tlv::sizeOfVarNumber(value_size()) + value_size();
 }
 
+Block::Block(uint32_t type, ConstBufferPtr buffer,
+             Buffer::const_iterator valueBegin, Buffer::const_iterator valueEnd)
+  : m_buffer(std::move(buffer))
+  , m_begin(m_buffer->end())
+  , m_end(m_buffer->end())
+  , m_valueBegin(valueBegin)
+  , m_valueEnd(valueEnd)
+  , m_type(type)
+{
+  m_size = tlv::sizeOfVarNumber(m_type) + tlv::sizeOfVarNumber(value_size()) + value_size();
+}
+
 Block::Block(uint32_t type, const Block& value)
   : m_buffer(value.m_buffer)
   , m_begin(m_buffer->end())
@@ -146,6 +146,17 @@ public: // construction, assignment
    */
   Block(uint32_t type, ConstBufferPtr value);
 
+  /** @brief Create a Block with the specified TLV-TYPE and a TLV-VALUE that is a range of @p buffer
+   *  @param type TLV-TYPE
+   *  @param buffer a Buffer containing the TLV-VALUE at [@p valueBegin,@p valueEnd), must not be nullptr
+   *  @param valueBegin begin position of TLV-VALUE within @p buffer
+   *  @param valueEnd end position of TLV-VALUE within @p buffer
+   *  @note The TLV-VALUE is referenced rather than copied. The Block has no wire encoding
+   *        until it is encoded, either directly or as part of an enclosing Block.
+   */
+  Block(uint32_t type, ConstBufferPtr buffer,
+        Buffer::const_iterator valueBegin, Buffer::const_iterator valueEnd);
+
   /** @brief Create a Block with the specified TLV-TYPE and TLV-VALUE
    *  @param type TLV-TYPE
    *  @param value a Block to be nested as TLV-VALUE, must be valid
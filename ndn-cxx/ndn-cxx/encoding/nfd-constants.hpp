@@ -70,6 +70,7 @@ enum FaceFlagBit {
   BIT_LOCAL_FIELDS_ENABLED = 0, ///< whether local fields are enabled on a face
   BIT_LP_RELIABILITY_ENABLED = 1, ///< whether the link reliability feature is enabled on a face
   BIT_CONGESTION_MARKING_ENABLED = 2, ///< whether congestion detection and marking is enabled on a face
+  BIT_LP_AGGREGATION_ENABLED = 3, ///< whether aggregation of small LpPackets is enabled on a face
 };
 
 /** \ingroup management
@@ -70,6 +70,8 @@ enum {
   BaseCongestionMarkingInterval = 135,
   DefaultCongestionThreshold    = 136,
   Mtu                           = 137,
+  RateLimit                     = 138,
+  BurstSize                     = 139,
   FaceQueryFilter               = 150,
   FaceEventNotification         = 192,
   FaceEventKind                 = 193,
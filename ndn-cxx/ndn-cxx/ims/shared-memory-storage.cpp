@@ -0,0 +1,325 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/ims/shared-memory-storage.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ndn {
+
+constexpr size_t SharedMemoryStorage::MAX_HASH_CODE_LENGTH;
+constexpr size_t SharedMemoryStorage::BUCKET_SIZE;
+
+static const char SEGMENT_MAGIC[8] = {'N', 'D', 'N', 'S', 'H', 'M', 'S', '1'};
+static const uint32_t SEGMENT_VERSION = 1;
+static const size_t SEGMENT_ALIGNMENT = 64;
+static const int LOCK_MAX_SPINS = 1 << 20;
+
+static_assert(sizeof(SEGMENT_MAGIC) == sizeof(SharedMemoryStorage::Header::magic),
+              "Header::magic must hold SEGMENT_MAGIC");
+static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,
+              "SharedMemoryStorage requires address-free atomics");
+
+static size_t
+alignUp(size_t n)
+{
+  return (n + SEGMENT_ALIGNMENT - 1) / SEGMENT_ALIGNMENT * SEGMENT_ALIGNMENT;
+}
+
+size_t
+SharedMemoryStorage::computeSegmentSize(size_t nSlots, size_t dataCapacity)
+{
+  return alignUp(sizeof(Header)) + alignUp(nSlots * sizeof(Slot)) + dataCapacity;
+}
+
+unique_ptr<SharedMemoryStorage>
+SharedMemoryStorage::create(const std::string& name, size_t dataCapacity, size_t nSlots)
+{
+  if (dataCapacity == 0) {
+    NDN_THROW(Error("Data area of shared memory segment " + name + " must not be empty"));
+  }
+  nSlots = std::max<size_t>(1, (nSlots + BUCKET_SIZE - 1) / BUCKET_SIZE) * BUCKET_SIZE;
+  size_t size = computeSegmentSize(nSlots, dataCapacity);
+
+  ::shm_unlink(name.data());
+  int fd = ::shm_open(name.data(), O_RDWR | O_CREAT | O_EXCL, 0660);
+  if (fd < 0) {
+    NDN_THROW_ERRNO(Error("Cannot create shared memory segment " + name));
+  }
+  if (::ftruncate(fd, static_cast<off_t>(size)) < 0) {
+    int err = errno;
+    ::close(fd);
+    ::shm_unlink(name.data());
+    errno = err;
+    NDN_THROW_ERRNO(Error("Cannot resize shared memory segment " + name));
+  }
+  void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  int err = errno;
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    ::shm_unlink(name.data());
+    errno = err;
+    NDN_THROW_ERRNO(Error("Cannot map shared memory segment " + name));
+  }
+
+  auto storage = unique_ptr<SharedMemoryStorage>(
+    new SharedMemoryStorage(name, static_cast<uint8_t*>(addr), size, nSlots, dataCapacity, true));
+
+  // the segment is zero-filled by ftruncate; construct the atomics in place
+  Header* header = new (addr) Header;
+  header->version = SEGMENT_VERSION;
+  header->nSlots = static_cast<uint32_t>(nSlots);
+  header->dataCapacity = dataCapacity;
+  header->writerLock.store(0, std::memory_order_relaxed);
+  header->reservePos.store(0, std::memory_order_relaxed);
+  for (size_t i = 0; i < nSlots; ++i) {
+    new (&storage->m_slots[i]) Slot;
+    storage->m_slots[i].seq.store(0, std::memory_order_relaxed);
+  }
+  // a segment is not opened by applications until its magic appears
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(header->magic, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC));
+
+  return storage;
+}
+
+unique_ptr<SharedMemoryStorage>
+SharedMemoryStorage::open(const std::string& name)
+{
+  int fd = ::shm_open(name.data(), O_RDWR, 0);
+  if (fd < 0) {
+    NDN_THROW_ERRNO(Error("Cannot open shared memory segment " + name));
+  }
+  struct stat st;
+  if (::fstat(fd, &st) < 0 || static_cast<size_t>(st.st_size) < alignUp(sizeof(Header))) {
+    ::close(fd);
+    NDN_THROW(Error("Shared memory segment " + name + " is truncated"));
+  }
+  size_t size = static_cast<size_t>(st.st_size);
+  void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  int err = errno;
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    errno = err;
+    NDN_THROW_ERRNO(Error("Cannot map shared memory segment " + name));
+  }
+
+  // read the geometry once; later changes to the header by other processes are ignored
+  const Header* header = static_cast<const Header*>(addr);
+  size_t nSlots = header->nSlots;
+  uint64_t dataCapacity = header->dataCapacity;
+  if (std::memcmp(header->magic, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC)) != 0 ||
+      header->version != SEGMENT_VERSION ||
+      nSlots == 0 || nSlots % BUCKET_SIZE != 0 ||
+      dataCapacity == 0 || dataCapacity > size ||
+      computeSegmentSize(nSlots, dataCapacity) != size) {
+    ::munmap(addr, size);
+    NDN_THROW(Error("Shared memory segment " + name + " has an incompatible format"));
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  return unique_ptr<SharedMemoryStorage>(
+    new SharedMemoryStorage(name, static_cast<uint8_t*>(addr), size, nSlots, dataCapacity, false));
+}
+
+SharedMemoryStorage::SharedMemoryStorage(const std::string& name, uint8_t* addr, size_t size,
+                                         size_t nSlots, uint64_t dataCapacity, bool isOwner)
+  : m_name(name)
+  , m_addr(addr)
+  , m_size(size)
+  , m_isOwner(isOwner)
+  , m_nSlots(nSlots)
+  , m_dataCapacity(dataCapacity)
+  , m_header(reinterpret_cast<Header*>(addr))
+  , m_slots(reinterpret_cast<Slot*>(addr + alignUp(sizeof(Header))))
+  , m_dataArea(addr + alignUp(sizeof(Header)) + alignUp(nSlots * sizeof(Slot)))
+{
+}
+
+SharedMemoryStorage::~SharedMemoryStorage()
+{
+  ::munmap(m_addr, m_size);
+  if (m_isOwner) {
+    ::shm_unlink(m_name.data());
+  }
+}
+
+size_t
+SharedMemoryStorage::getDataCapacity() const
+{
+  return m_dataCapacity;
+}
+
+size_t
+SharedMemoryStorage::getNSlots() const
+{
+  return m_nSlots;
+}
+
+size_t
+SharedMemoryStorage::computeBucket(const std::string& hashCode, size_t nBuckets)
+{
+  // FNV-1a
+  uint64_t h = 14695981039346656037ULL;
+  for (char c : hashCode) {
+    h ^= static_cast<uint8_t>(c);
+    h *= 1099511628211ULL;
+  }
+  return static_cast<size_t>(h % nBuckets);
+}
+
+bool
+SharedMemoryStorage::lock()
+{
+  for (int i = 0; i < LOCK_MAX_SPINS; ++i) {
+    uint32_t expected = 0;
+    if (m_header->writerLock.compare_exchange_weak(expected, 1, std::memory_order_acquire,
+                                                   std::memory_order_relaxed)) {
+      return true;
+    }
+    if (i % 64 == 63) {
+      std::this_thread::yield();
+    }
+  }
+  return false;
+}
+
+void
+SharedMemoryStorage::unlock()
+{
+  m_header->writerLock.store(0, std::memory_order_release);
+}
+
+bool
+SharedMemoryStorage::insert(const Data& data, const std::string& hashCode)
+{
+  if (hashCode.empty() || hashCode.size() > MAX_HASH_CODE_LENGTH) {
+    return false;
+  }
+  const Block& wire = data.wireEncode();
+  uint64_t capacity = m_dataCapacity;
+  if (wire.size() > capacity || wire.size() > std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+
+  if (!this->lock()) {
+    return false;
+  }
+
+  // reserve a contiguous region in the data area, skipping the tail if it is too short
+  uint64_t pos = m_header->reservePos.load(std::memory_order_relaxed);
+  uint64_t offset = pos % capacity;
+  if (offset + wire.size() > capacity) {
+    pos += capacity - offset;
+    offset = 0;
+  }
+
+  size_t nBuckets = m_nSlots / BUCKET_SIZE;
+  Slot* bucket = m_slots + computeBucket(hashCode, nBuckets) * BUCKET_SIZE;
+  Slot* slot = nullptr;
+  for (size_t i = 0; i < BUCKET_SIZE; ++i) {
+    Slot& candidate = bucket[i];
+    if (candidate.dataLength > 0 && candidate.hashLength == hashCode.size() &&
+        std::memcmp(candidate.hash, hashCode.data(), hashCode.size()) == 0) {
+      slot = &candidate;
+      break;
+    }
+    if (slot == nullptr || (slot->dataLength > 0 &&
+                            (candidate.dataLength == 0 || candidate.dataPos < slot->dataPos))) {
+      slot = &candidate;
+    }
+  }
+
+  uint32_t seq = slot->seq.load(std::memory_order_relaxed);
+  slot->seq.store(seq + 1, std::memory_order_relaxed);
+  // readers must observe the reservation, which invalidates overwritten Data,
+  // before any octet in the reserved region changes
+  m_header->reservePos.store(pos + wire.size(), std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  std::memcpy(m_dataArea + offset, wire.wire(), wire.size());
+  slot->hashLength = static_cast<uint32_t>(hashCode.size());
+  std::memcpy(slot->hash, hashCode.data(), hashCode.size());
+  slot->dataPos = pos;
+  slot->dataLength = static_cast<uint32_t>(wire.size());
+  slot->seq.store(seq + 2, std::memory_order_release);
+
+  this->unlock();
+  return true;
+}
+
+shared_ptr<Data>
+SharedMemoryStorage::find(const std::string& hashCode) const
+{
+  if (hashCode.empty() || hashCode.size() > MAX_HASH_CODE_LENGTH) {
+    return nullptr;
+  }
+  uint64_t capacity = m_dataCapacity;
+
+  size_t nBuckets = m_nSlots / BUCKET_SIZE;
+  const Slot* bucket = m_slots + computeBucket(hashCode, nBuckets) * BUCKET_SIZE;
+  for (size_t i = 0; i < BUCKET_SIZE; ++i) {
+    const Slot& slot = bucket[i];
+    uint32_t seq = slot.seq.load(std::memory_order_acquire);
+    if (seq % 2 != 0) {
+      continue;
+    }
+    uint32_t hashLength = slot.hashLength;
+    uint32_t dataLength = slot.dataLength;
+    uint64_t dataPos = slot.dataPos;
+    if (dataLength == 0 || hashLength != hashCode.size() ||
+        std::memcmp(slot.hash, hashCode.data(), hashLength) != 0) {
+      continue;
+    }
+    // a slot written by a misbehaving client must not make the copy leave the data area
+    uint64_t offset = dataPos % capacity;
+    if (dataLength > MAX_NDN_PACKET_SIZE || offset + dataLength > capacity) {
+      continue;
+    }
+
+    auto buffer = make_shared<Buffer>(m_dataArea + offset, dataLength);
+
+    // the copy is valid if neither the slot nor the copied region has been overwritten
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (slot.seq.load(std::memory_order_relaxed) != seq ||
+        m_header->reservePos.load(std::memory_order_relaxed) > dataPos + capacity) {
+      return nullptr;
+    }
+
+    try {
+      return make_shared<Data>(Block(buffer));
+    }
+    catch (const tlv::Error&) {
+      return nullptr;
+    }
+  }
+  return nullptr;
+}
+
+} // namespace ndn
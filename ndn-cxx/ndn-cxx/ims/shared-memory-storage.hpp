@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_IMS_SHARED_MEMORY_STORAGE_HPP
+#define NDN_IMS_SHARED_MEMORY_STORAGE_HPP
+
+#include "ndn-cxx/data.hpp"
+
+#include <atomic>
+
+namespace ndn {
+
+/** @brief Represents a Data storage in a POSIX shared memory segment
+ *
+ *  The segment is created by the forwarder, and mapped by applications on the same host.
+ *  A producer inserts its Data into the segment once, and the forwarder can answer Interests
+ *  from the segment directly, without receiving the Data over a face and caching another copy.
+ *
+ *  Data packets are indexed by hash code, which has the same meaning as
+ *  Interest::getHashCode().  Wire encodings are appended to a circular data area, so that
+ *  newer Data eventually overwrite older Data.  The index is a set-associative table: each
+ *  hash code maps to a bucket of a few slots, and the slot with the oldest Data is replaced
+ *  when the bucket is full.
+ *
+ *  Concurrent inserts from several processes are serialized by a spinlock stored in the
+ *  segment.  Lookups never take the lock: each slot carries a sequence number that is odd
+ *  while the slot is being updated, and a lookup that observes a change in the sequence
+ *  number, or finds its Data overwritten in the circular area, reports a miss.
+ *
+ *  Any process that maps the segment can modify it.  The size of the index and of the data
+ *  area are therefore taken from the segment only once, when it is created or opened, and
+ *  a slot that refers to a region outside the data area is ignored.
+ */
+class SharedMemoryStorage : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /** @brief Creates a new shared memory segment
+   *  @param name name of the segment, as accepted by shm_open(3), e.g. "/nfd-cs"
+   *  @param dataCapacity size of the circular data area in octets
+   *  @param nSlots number of index slots, rounded up to a multiple of the bucket size
+   *  @throw Error the segment cannot be created
+   *
+   *  An existing segment with the same name is replaced.
+   *  The segment is unlinked when the returned object is destroyed.
+   */
+  static unique_ptr<SharedMemoryStorage>
+  create(const std::string& name, size_t dataCapacity, size_t nSlots);
+
+  /** @brief Maps an existing shared memory segment
+   *  @throw Error the segment does not exist, or has an incompatible format
+   */
+  static unique_ptr<SharedMemoryStorage>
+  open(const std::string& name);
+
+  ~SharedMemoryStorage();
+
+  /** @brief Inserts a Data packet
+   *  @param data the Data packet
+   *  @param hashCode hash code of @p data, at most MAX_HASH_CODE_LENGTH octets
+   *  @return whether the Data has been inserted; a Data packet is refused if its hash code
+   *          is too long, if it does not fit in the data area, or if the lock cannot be
+   *          acquired because another process holds it for too long
+   */
+  bool
+  insert(const Data& data, const std::string& hashCode);
+
+  /** @brief Finds a Data packet by hash code
+   *  @return a copy of the Data packet, or nullptr if it is not found
+   */
+  shared_ptr<Data>
+  find(const std::string& hashCode) const;
+
+  const std::string&
+  getName() const
+  {
+    return m_name;
+  }
+
+  size_t
+  getDataCapacity() const;
+
+  size_t
+  getNSlots() const;
+
+public:
+  static constexpr size_t MAX_HASH_CODE_LENGTH = 64;
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  static constexpr size_t BUCKET_SIZE = 4;
+
+  struct Header
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t nSlots;
+    uint64_t dataCapacity;
+    std::atomic<uint32_t> writerLock;
+    std::atomic<uint64_t> reservePos; ///< end of the last reservation in the data area
+  };
+
+  struct Slot
+  {
+    std::atomic<uint32_t> seq; ///< odd while the slot is being updated
+    uint32_t hashLength;
+    uint32_t dataLength; ///< zero if the slot is empty
+    uint64_t dataPos; ///< logical position in the data area; physical offset is modulo capacity
+    uint8_t hash[MAX_HASH_CODE_LENGTH];
+  };
+
+private:
+  SharedMemoryStorage(const std::string& name, uint8_t* addr, size_t size, size_t nSlots,
+                      uint64_t dataCapacity, bool isOwner);
+
+  static size_t
+  computeBucket(const std::string& hashCode, size_t nBuckets);
+
+  static size_t
+  computeSegmentSize(size_t nSlots, size_t dataCapacity);
+
+  bool
+  lock();
+
+  void
+  unlock();
+
+private:
+  std::string m_name;
+  uint8_t* m_addr;
+  size_t m_size;
+  bool m_isOwner;
+  /// geometry of the segment, never read again from the header because clients can modify it
+  size_t m_nSlots;
+  uint64_t m_dataCapacity;
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  Header* m_header;
+  Slot* m_slots;
+  uint8_t* m_dataArea;
+};
+
+} // namespace ndn
+
+#endif // NDN_IMS_SHARED_MEMORY_STORAGE_HPP
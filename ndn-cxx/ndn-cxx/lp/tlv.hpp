@@ -46,6 +46,12 @@ enum {
   TxSequence = 840,
   NonDiscovery = 844,
   PrefixAnnouncement = 848,
+
+  /**
+   * \brief container of several LpPackets sent in one link-layer frame
+   * \note This is a local extension to NDNLPv2; both ends of a link must enable aggregation.
+   */
+  LpAggregate = 960,
 };
 
 enum {
@@ -51,6 +51,12 @@ ControlParameters::wireEncode(EncodingImpl<TAG>& encoder) const
 {
   size_t totalLength = 0;
 
+  if (this->hasBurstSize()) {
+    totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::BurstSize, m_burstSize);
+  }
+  if (this->hasRateLimit()) {
+    totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::RateLimit, m_rateLimit);
+  }
   if (this->hasMtu()) {
     totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::Mtu, m_mtu);
   }
@@ -238,6 +244,18 @@ ControlParameters::wireDecode(const Block& block)
   if (this->hasMtu()) {
     m_mtu = readNonNegativeInteger(*val);
   }
+
+  val = m_wire.find(tlv::nfd::RateLimit);
+  m_hasFields[CONTROL_PARAMETER_RATE_LIMIT] = val != m_wire.elements_end();
+  if (this->hasRateLimit()) {
+    m_rateLimit = readNonNegativeInteger(*val);
+  }
+
+  val = m_wire.find(tlv::nfd::BurstSize);
+  m_hasFields[CONTROL_PARAMETER_BURST_SIZE] = val != m_wire.elements_end();
+  if (this->hasBurstSize()) {
+    m_burstSize = readNonNegativeInteger(*val);
+  }
 }
 
 bool
@@ -382,6 +400,14 @@ operator<<(std::ostream& os, const ControlParameters& parameters)
     os << "Mtu: " << parameters.getMtu() << ", ";
   }
 
+  if (parameters.hasRateLimit()) {
+    os << "RateLimit: " << parameters.getRateLimit() << ", ";
+  }
+
+  if (parameters.hasBurstSize()) {
+    os << "BurstSize: " << parameters.getBurstSize() << ", ";
+  }
+
   os << ")";
   return os;
 }
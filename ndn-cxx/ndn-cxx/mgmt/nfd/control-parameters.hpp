@@ -50,6 +50,8 @@ enum ControlParameterField {
   CONTROL_PARAMETER_BASE_CONGESTION_MARKING_INTERVAL,
   CONTROL_PARAMETER_DEFAULT_CONGESTION_THRESHOLD,
   CONTROL_PARAMETER_MTU,
+  CONTROL_PARAMETER_RATE_LIMIT,
+  CONTROL_PARAMETER_BURST_SIZE,
   CONTROL_PARAMETER_UBOUND
 };
 
@@ -69,7 +71,9 @@ const std::string CONTROL_PARAMETER_FIELD[CONTROL_PARAMETER_UBOUND] = {
   "FacePersistency",
   "BaseCongestionMarkingInterval",
   "DefaultCongestionThreshold",
-  "Mtu"
+  "Mtu",
+  "RateLimit",
+  "BurstSize"
 };
 
 /**
@@ -595,6 +599,78 @@ public: // getters & setters
     return *this;
   }
 
+  bool
+  hasRateLimit() const
+  {
+    return m_hasFields[CONTROL_PARAMETER_RATE_LIMIT];
+  }
+
+  /** \brief get egress rate limit (measured in bytes per second)
+   *
+   *  Zero means the rate is unlimited.
+   */
+  uint64_t
+  getRateLimit() const
+  {
+    BOOST_ASSERT(this->hasRateLimit());
+    return m_rateLimit;
+  }
+
+  /** \brief set egress rate limit (measured in bytes per second)
+   *
+   *  Zero means the rate is unlimited.
+   */
+  ControlParameters&
+  setRateLimit(uint64_t rateLimit)
+  {
+    m_wire.reset();
+    m_rateLimit = rateLimit;
+    m_hasFields[CONTROL_PARAMETER_RATE_LIMIT] = true;
+    return *this;
+  }
+
+  ControlParameters&
+  unsetRateLimit()
+  {
+    m_wire.reset();
+    m_hasFields[CONTROL_PARAMETER_RATE_LIMIT] = false;
+    return *this;
+  }
+
+  bool
+  hasBurstSize() const
+  {
+    return m_hasFields[CONTROL_PARAMETER_BURST_SIZE];
+  }
+
+  /** \brief get burst size of the egress rate limit (measured in bytes)
+   */
+  uint64_t
+  getBurstSize() const
+  {
+    BOOST_ASSERT(this->hasBurstSize());
+    return m_burstSize;
+  }
+
+  /** \brief set burst size of the egress rate limit (measured in bytes)
+   */
+  ControlParameters&
+  setBurstSize(uint64_t burstSize)
+  {
+    m_wire.reset();
+    m_burstSize = burstSize;
+    m_hasFields[CONTROL_PARAMETER_BURST_SIZE] = true;
+    return *this;
+  }
+
+  ControlParameters&
+  unsetBurstSize()
+  {
+    m_wire.reset();
+    m_hasFields[CONTROL_PARAMETER_BURST_SIZE] = false;
+    return *this;
+  }
+
   const std::vector<bool>&
   getPresentFields() const
   {
@@ -652,6 +728,8 @@ private: // fields
   time::nanoseconds   m_baseCongestionMarkingInterval;
   uint64_t            m_defaultCongestionThreshold;
   uint64_t            m_mtu;
+  uint64_t            m_rateLimit;
+  uint64_t            m_burstSize;
 
 private:
   mutable Block m_wire;
@@ -182,6 +182,28 @@ BOOST_AUTO_TEST_CASE(FromTypeAndBuffer)
   BOOST_CHECK_EQUAL(b.value_size(), sizeof(VALUE));
 }
 
+BOOST_AUTO_TEST_CASE(FromTypeAndBufferRange)
+{
+  const uint8_t VALUE[] = {0x11, 0x12, 0x13, 0x14};
+  auto bufferPtr = make_shared<Buffer>(VALUE, sizeof(VALUE));
+
+  Block b(42, bufferPtr, bufferPtr->begin() + 1, bufferPtr->begin() + 3);
+  BOOST_CHECK_EQUAL(b.isValid(), true);
+  BOOST_CHECK_EQUAL(b.type(), 42);
+  BOOST_CHECK_EQUAL(b.size(), 4);
+  BOOST_CHECK_EQUAL(b.hasWire(), false);
+  BOOST_CHECK_EQUAL(b.hasValue(), true);
+  BOOST_CHECK_EQUAL(b.value_size(), 2);
+  BOOST_CHECK(b.value() == bufferPtr->data() + 1);
+
+  Block outer(84);
+  outer.push_back(b);
+  outer.encode();
+  const uint8_t EXPECTED[] = {0x54, 0x04, 0x2a, 0x02, 0x12, 0x13};
+  BOOST_CHECK_EQUAL_COLLECTIONS(outer.begin(), outer.end(), EXPECTED, EXPECTED + sizeof(EXPECTED));
+  BOOST_CHECK_EQUAL(bufferPtr->size(), sizeof(VALUE));
+}
+
 BOOST_AUTO_TEST_CASE(FromTypeAndBlock)
 {
   const uint8_t BUFFER[] = {0x80, 0x06, 0x81, 0x01, 0x01, 0x82, 0x01, 0x01};
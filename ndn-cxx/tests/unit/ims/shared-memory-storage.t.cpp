@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2018 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/ims/shared-memory-storage.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/make-interest-data.hpp"
+
+#include <unistd.h>
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Ims)
+BOOST_AUTO_TEST_SUITE(TestSharedMemoryStorage)
+
+static std::string
+makeSegmentName()
+{
+  return "/ndn-cxx-test-shms-" + to_string(::getpid());
+}
+
+static shared_ptr<Data>
+makeDataWithContent(const Name& name, uint8_t content, size_t contentSize = 1)
+{
+  auto data = makeData(name);
+  std::vector<uint8_t> buffer(contentSize, content);
+  data->setContent(buffer.data(), buffer.size());
+  signData(data);
+  return data;
+}
+
+BOOST_AUTO_TEST_CASE(InsertFind)
+{
+  auto owner = SharedMemoryStorage::create(makeSegmentName(), 4096, 16);
+  BOOST_CHECK_EQUAL(owner->getDataCapacity(), 4096);
+  BOOST_CHECK_EQUAL(owner->getNSlots(), 16);
+
+  auto producer = SharedMemoryStorage::open(makeSegmentName());
+  BOOST_CHECK_EQUAL(producer->getDataCapacity(), 4096);
+
+  auto data1 = makeDataWithContent("/A", 1);
+  auto data2 = makeDataWithContent("/B", 2);
+  BOOST_CHECK(producer->insert(*data1, "hash1"));
+  BOOST_CHECK(producer->insert(*data2, "hash2"));
+
+  auto found1 = owner->find("hash1");
+  BOOST_REQUIRE(found1 != nullptr);
+  BOOST_CHECK_EQUAL(found1->getName(), "/A");
+  BOOST_CHECK(found1->wireEncode() == data1->wireEncode());
+
+  auto found2 = owner->find("hash2");
+  BOOST_REQUIRE(found2 != nullptr);
+  BOOST_CHECK_EQUAL(found2->getName(), "/B");
+
+  BOOST_CHECK(owner->find("hash3") == nullptr);
+  BOOST_CHECK(owner->find("") == nullptr);
+
+  // same hash code replaces the previous Data
+  auto data3 = makeDataWithContent("/C", 3);
+  BOOST_CHECK(producer->insert(*data3, "hash1"));
+  auto found3 = owner->find("hash1");
+  BOOST_REQUIRE(found3 != nullptr);
+  BOOST_CHECK_EQUAL(found3->getName(), "/C");
+}
+
+BOOST_AUTO_TEST_CASE(Refuse)
+{
+  auto owner = SharedMemoryStorage::create(makeSegmentName(), 256, 4);
+
+  auto big = makeDataWithContent("/big", 0, 512);
+  BOOST_CHECK(!owner->insert(*big, "big"));
+  BOOST_CHECK(owner->find("big") == nullptr);
+
+  auto data = makeDataWithContent("/A", 1);
+  std::string longHashCode(SharedMemoryStorage::MAX_HASH_CODE_LENGTH + 1, 'h');
+  BOOST_CHECK(!owner->insert(*data, longHashCode));
+}
+
+BOOST_AUTO_TEST_CASE(Overwrite)
+{
+  // data area holds only a few Data packets, so older Data are overwritten
+  auto data = makeDataWithContent(Name("/A").appendNumber(0), 1, 100);
+  size_t dataSize = data->wireEncode().size();
+  auto owner = SharedMemoryStorage::create(makeSegmentName(), dataSize * 3, 64);
+
+  for (int i = 0; i < 10; ++i) {
+    BOOST_CHECK(owner->insert(*makeDataWithContent(Name("/A").appendNumber(i), 1, 100),
+                              "hash" + to_string(i)));
+  }
+
+  BOOST_CHECK(owner->find("hash0") == nullptr);
+  BOOST_CHECK(owner->find("hash6") == nullptr);
+  for (int i = 7; i < 10; ++i) {
+    auto found = owner->find("hash" + to_string(i));
+    BOOST_REQUIRE(found != nullptr);
+    BOOST_CHECK_EQUAL(found->getName(), Name("/A").appendNumber(i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CorruptHeader)
+{
+  auto owner = SharedMemoryStorage::create(makeSegmentName(), 4096, 16);
+  auto data = makeDataWithContent("/A", 1);
+  BOOST_CHECK(owner->insert(*data, "hash1"));
+
+  // the geometry cached at creation is used, not the one in the segment
+  owner->m_header->nSlots = 0;
+  owner->m_header->dataCapacity = 0;
+  BOOST_CHECK_EQUAL(owner->getNSlots(), 16);
+  BOOST_CHECK_EQUAL(owner->getDataCapacity(), 4096);
+  BOOST_CHECK(owner->find("hash1") != nullptr);
+  BOOST_CHECK(owner->find("hash2") == nullptr);
+  BOOST_CHECK(owner->insert(*data, "hash2"));
+
+  owner->m_header->nSlots = std::numeric_limits<uint32_t>::max();
+  BOOST_CHECK(owner->find("hash3") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(CorruptSlot)
+{
+  auto owner = SharedMemoryStorage::create(makeSegmentName(), 65536, 16);
+  auto data = makeDataWithContent("/A", 1);
+  BOOST_CHECK(owner->insert(*data, "hash1"));
+
+  SharedMemoryStorage::Slot* slot = nullptr;
+  for (size_t i = 0; i < owner->getNSlots(); ++i) {
+    if (owner->m_slots[i].dataLength > 0) {
+      slot = &owner->m_slots[i];
+    }
+  }
+  BOOST_REQUIRE(slot != nullptr);
+  BOOST_REQUIRE(owner->find("hash1") != nullptr);
+
+  // region extends past the end of the data area
+  slot->dataPos = owner->getDataCapacity() - 1;
+  BOOST_CHECK(owner->find("hash1") == nullptr);
+
+  // region within the data area, but longer than any packet
+  slot->dataPos = 0;
+  slot->dataLength = MAX_NDN_PACKET_SIZE + 1;
+  BOOST_CHECK(owner->find("hash1") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(OwnerUnlinks)
+{
+  std::string name = makeSegmentName();
+  SharedMemoryStorage::create(name, 4096, 16).reset();
+  BOOST_CHECK_THROW(SharedMemoryStorage::open(name), SharedMemoryStorage::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSharedMemoryStorage
+BOOST_AUTO_TEST_SUITE_END() // Ims
+
+} // namespace tests
+} // namespace ndn